@@ -0,0 +1,108 @@
+# This file is part of D3d12info project:
+# https://github.com/sawickiap/D3d12info
+#
+# Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+# License: MIT
+#
+# For more information, see files README.md, LICENSE.txt.
+
+# Converts IntelGfx.cfg from Intel GPU Detect library into a C++ table of default fidelity presets sorted by device ID,
+# so no text parsing is needed at runtime.
+# Usage: cmake -DINPUT_FILE=<IntelGfx.cfg> -DOUTPUT_FILE=<IntelGfxTableData.hpp> -P GenerateIntelGfxTable.cmake
+# Each meaningful line of the input has the form: VendorId, DeviceId, PresetLevel ; Comment
+
+if(NOT INPUT_FILE OR NOT OUTPUT_FILE)
+    message(FATAL_ERROR "INPUT_FILE and OUTPUT_FILE must be defined.")
+endif()
+
+set(INTEL_VENDOR_ID 32902) # 0x8086
+
+function(parse_hex HEX_STR OUT_VAR)
+    string(STRIP "${HEX_STR}" HEX_STR)
+    string(TOLOWER "${HEX_STR}" HEX_STR)
+    string(REGEX REPLACE "^0x" "" HEX_STR "${HEX_STR}")
+    if(NOT HEX_STR MATCHES "^[0-9a-f]+$")
+        set(${OUT_VAR} "" PARENT_SCOPE)
+        return()
+    endif()
+    math(EXPR VALUE "0x${HEX_STR}" OUTPUT_FORMAT DECIMAL)
+    set(${OUT_VAR} ${VALUE} PARENT_SCOPE)
+endfunction()
+
+file(STRINGS "${INPUT_FILE}" LINES)
+
+set(ENTRIES "")
+set(SEEN_DEVICE_IDS "")
+foreach(LINE IN LISTS LINES)
+    # Remove comment.
+    string(REGEX REPLACE ";.*$" "" LINE "${LINE}")
+    string(REPLACE "," ";" FIELDS "${LINE}")
+    list(LENGTH FIELDS FIELD_COUNT)
+    if(FIELD_COUNT LESS 3)
+        continue()
+    endif()
+    list(GET FIELDS 0 VENDOR_STR)
+    list(GET FIELDS 1 DEVICE_STR)
+    list(GET FIELDS 2 PRESET_STR)
+    parse_hex("${VENDOR_STR}" VENDOR_ID)
+    parse_hex("${DEVICE_STR}" DEVICE_ID)
+    if(NOT VENDOR_ID STREQUAL INTEL_VENDOR_ID OR DEVICE_ID STREQUAL "")
+        continue()
+    endif()
+
+    # Same matching as GPUDetect::GetDefaultFidelityPreset.
+    string(STRIP "${PRESET_STR}" PRESET_STR)
+    string(TOLOWER "${PRESET_STR}" PRESET_STR)
+    if(PRESET_STR MATCHES "^low")
+        set(PRESET "INTEL_GFX_PRESET_LEVEL_LOW")
+    elseif(PRESET_STR MATCHES "^medium\\+")
+        set(PRESET "INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS")
+    elseif(PRESET_STR MATCHES "^medium")
+        set(PRESET "INTEL_GFX_PRESET_LEVEL_MEDIUM")
+    elseif(PRESET_STR MATCHES "^high")
+        set(PRESET "INTEL_GFX_PRESET_LEVEL_HIGH")
+    else()
+        set(PRESET "INTEL_GFX_PRESET_LEVEL_NOT_COMPATIBLE")
+    endif()
+
+    # First entry for given device wins, like in the original line-by-line search.
+    list(FIND SEEN_DEVICE_IDS ${DEVICE_ID} SEEN_INDEX)
+    if(NOT SEEN_INDEX EQUAL -1)
+        continue()
+    endif()
+    list(APPEND SEEN_DEVICE_IDS ${DEVICE_ID})
+
+    # Zero-padded decimal key makes lexicographical sort equal to numerical one.
+    math(EXPR DEVICE_ID_HEX "${DEVICE_ID}" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING "${DEVICE_ID_HEX}" 2 -1 DEVICE_ID_HEX)
+    string(TOUPPER "${DEVICE_ID_HEX}" DEVICE_ID_HEX)
+    string(LENGTH "${DEVICE_ID}" KEY_LENGTH)
+    math(EXPR PAD_LENGTH "10 - ${KEY_LENGTH}")
+    string(REPEAT "0" ${PAD_LENGTH} PADDING)
+    list(APPEND ENTRIES "${PADDING}${DEVICE_ID}|${DEVICE_ID_HEX}|${PRESET}")
+endforeach()
+
+if(NOT ENTRIES)
+    message(FATAL_ERROR "No Intel device entries found in ${INPUT_FILE}.")
+endif()
+list(SORT ENTRIES)
+
+set(CONTENT "// Generated by Scripts/GenerateIntelGfxTable.cmake from IntelGfx.cfg. Do not edit.\n")
+string(APPEND CONTENT "#pragma once\n\n")
+string(APPEND CONTENT "inline constexpr IntelGfxTableEntry INTEL_GFX_TABLE[] = {\n")
+foreach(ENTRY IN LISTS ENTRIES)
+    string(REPLACE "|" ";" ENTRY_FIELDS "${ENTRY}")
+    list(GET ENTRY_FIELDS 1 DEVICE_ID_HEX)
+    list(GET ENTRY_FIELDS 2 PRESET)
+    string(APPEND CONTENT "    { 0x${DEVICE_ID_HEX}, ${PRESET} },\n")
+endforeach()
+string(APPEND CONTENT "};\n")
+
+# Don't touch the file if nothing changed, to avoid needless recompilation.
+if(EXISTS "${OUTPUT_FILE}")
+    file(READ "${OUTPUT_FILE}" OLD_CONTENT)
+    if(OLD_CONTENT STREQUAL CONTENT)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT_FILE}" "${CONTENT}")
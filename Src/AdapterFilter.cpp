@@ -0,0 +1,324 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "AdapterFilter.hpp"
+
+#include <algorithm>
+#include <cwchar>
+#include <cwctype>
+#include <format>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static std::wstring_view Trim(std::wstring_view str)
+{
+    const size_t begin = str.find_first_not_of(L' ');
+    if(begin == std::wstring_view::npos)
+        return {};
+    return str.substr(begin, str.find_last_not_of(L' ') + 1 - begin);
+}
+
+static std::wstring ToLower(std::wstring_view str)
+{
+    std::wstring result(str);
+    for(wchar_t& ch : result)
+        ch = (wchar_t)std::towlower(ch);
+    return result;
+}
+
+// For messages of exceptions, which are narrow. Other characters are replaced with '?'.
+static std::string ToAscii(std::wstring_view str)
+{
+    std::string result(str.size(), '?');
+    for(size_t i = 0; i < str.size(); ++i)
+    {
+        if(str[i] >= 0x20 && str[i] < 0x7F)
+            result[i] = (char)str[i];
+    }
+    return result;
+}
+
+[[noreturn]] static void ThrowInvalidTerm(std::wstring_view term, std::string_view reason)
+{
+    throw std::runtime_error(std::format("Adapter filter \"{}\": {}.", ToAscii(term), reason));
+}
+
+// Fails on an empty string, other characters or overflow.
+static bool ParseUnsigned(std::wstring_view str, uint32_t base, uint64_t& outValue)
+{
+    if(str.empty())
+        return false;
+    uint64_t value = 0;
+    for(wchar_t ch : str)
+    {
+        uint64_t digit;
+        if(ch >= L'0' && ch <= L'9')
+            digit = ch - L'0';
+        else if(base == 16 && ch >= L'a' && ch <= L'f')
+            digit = ch - L'a' + 10;
+        else if(base == 16 && ch >= L'A' && ch <= L'F')
+            digit = ch - L'A' + 10;
+        else
+            return false;
+        if(value > (UINT64_MAX - digit) / base)
+            return false;
+        value = value * base + digit;
+    }
+    outValue = value;
+    return true;
+}
+
+// With or without 0x.
+static bool ParseHex(std::wstring_view str, uint64_t& outValue)
+{
+    if(str.starts_with(L"0x") || str.starts_with(L"0X"))
+        str.remove_prefix(2);
+    return ParseUnsigned(str, 16, outValue);
+}
+
+// Decimal number of bytes followed by a unit, e.g. 8GiB.
+static bool ParseSize(std::wstring_view str, uint64_t& outValue)
+{
+    static const struct
+    {
+        const wchar_t* m_Name;
+        uint32_t m_Shift;
+    } UNITS[] = { { L"tib", 40 }, { L"gib", 30 }, { L"mib", 20 }, { L"kib", 10 }, { L"b", 0 } };
+
+    const std::wstring lower = ToLower(str);
+    for(const auto& unit : UNITS)
+    {
+        if(!lower.ends_with(unit.m_Name))
+            continue;
+        uint64_t value = 0;
+        if(!ParseUnsigned(Trim(str.substr(0, str.size() - wcslen(unit.m_Name))), 10, value) ||
+            value > (UINT64_MAX >> unit.m_Shift))
+        {
+            return false;
+        }
+        outValue = value << unit.m_Shift;
+        return true;
+    }
+    return ParseUnsigned(str, 10, outValue);
+}
+
+// Both in lowercase. On a mismatch, the last * takes one more character.
+static bool MatchPattern(std::wstring_view pattern, std::wstring_view str)
+{
+    size_t p = 0, s = 0;
+    size_t starP = std::wstring_view::npos, starS = 0;
+    while(s < str.size())
+    {
+        if(p < pattern.size() && (pattern[p] == L'?' || pattern[p] == str[s]))
+        {
+            ++p;
+            ++s;
+        }
+        else if(p < pattern.size() && pattern[p] == L'*')
+        {
+            starP = p++;
+            starS = s;
+        }
+        else if(starP != std::wstring_view::npos)
+        {
+            p = starP + 1;
+            s = ++starS;
+        }
+        else
+            return false;
+    }
+    while(p < pattern.size() && pattern[p] == L'*')
+        ++p;
+    return p == pattern.size();
+}
+
+// Whole name like "AMD/ATI", or any of its parts separated by '/'.
+static bool MatchVendorName(const wchar_t* vendorName, std::wstring_view name)
+{
+    if(vendorName == nullptr)
+        return false;
+    const std::wstring lower = ToLower(vendorName);
+    if(lower == name)
+        return true;
+    for(size_t begin = 0; begin <= lower.size();)
+    {
+        const size_t end = std::min(lower.find(L'/', begin), lower.size());
+        if(std::wstring_view(lower).substr(begin, end - begin) == name)
+            return true;
+        begin = end + 1;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void AdapterFilter::AddTerms(std::wstring_view terms)
+{
+    size_t begin = 0;
+    while(begin <= terms.size())
+    {
+        size_t end = terms.find(L',', begin);
+        if(end == std::wstring_view::npos)
+            end = terms.size();
+        const std::wstring_view term = Trim(terms.substr(begin, end - begin));
+        if(term.empty())
+            ThrowInvalidTerm(terms, "empty term");
+        m_Terms.push_back(ParseTerm(term));
+        begin = end + 1;
+    }
+}
+
+bool AdapterFilter::Matches(const AdapterFilterInput& adapter) const
+{
+    for(const Term& term : m_Terms)
+    {
+        if(MatchesTerm(term, adapter) == term.m_Negated)
+            return false;
+    }
+    return true;
+}
+
+AdapterFilter::Term AdapterFilter::ParseTerm(std::wstring_view term)
+{
+    Term result;
+    std::wstring_view str = term;
+    if(str.starts_with(L'!'))
+    {
+        result.m_Negated = true;
+        str = Trim(str.substr(1));
+    }
+
+    const size_t colon = str.find(L':');
+    if(colon != std::wstring_view::npos)
+    {
+        const std::wstring key = ToLower(Trim(str.substr(0, colon)));
+        const std::wstring_view value = Trim(str.substr(colon + 1));
+        if(value.empty())
+            ThrowInvalidTerm(term, "missing value");
+        if(key == L"vendor")
+        {
+            if(value.starts_with(L"0x") || value.starts_with(L"0X"))
+            {
+                result.m_Type = TERM_TYPE_VENDOR_ID;
+                if(!ParseHex(value, result.m_Value))
+                    ThrowInvalidTerm(term, "invalid vendor ID");
+            }
+            else
+            {
+                result.m_Type = TERM_TYPE_VENDOR_NAME;
+                result.m_Text = ToLower(value);
+            }
+        }
+        else if(key == L"device")
+        {
+            result.m_Type = TERM_TYPE_DEVICE_ID;
+            if(!ParseHex(value, result.m_Value))
+                ThrowInvalidTerm(term, "invalid device ID");
+        }
+        else if(key == L"luid")
+        {
+            result.m_Type = TERM_TYPE_LUID;
+            const size_t dash = value.find(L'-');
+            uint64_t high = 0, low = 0;
+            if(dash == std::wstring_view::npos || !ParseHex(value.substr(0, dash), high) ||
+                !ParseHex(value.substr(dash + 1), low) || high > UINT32_MAX || low > UINT32_MAX)
+            {
+                ThrowInvalidTerm(term, "LUID must be like 00000000-0001A2B3");
+            }
+            result.m_Value = high << 32 | low;
+        }
+        else if(key == L"name")
+        {
+            result.m_Type = TERM_TYPE_NAME;
+            result.m_Text = ToLower(value);
+        }
+        else
+            ThrowInvalidTerm(term, "unknown key");
+        return result;
+    }
+
+    const std::wstring lower = ToLower(str);
+    if(lower == L"software" || lower == L"remote")
+    {
+        result.m_Type = TERM_TYPE_FLAG;
+        result.m_Value = lower == L"software" ? ADAPTER_FILTER_FLAG_SOFTWARE : ADAPTER_FILTER_FLAG_REMOTE;
+        return result;
+    }
+
+    static const struct
+    {
+        const wchar_t* m_Str;
+        COMPARE_OP m_Op;
+    } OPS[] = {
+        // Longer first, so <= is not taken for <.
+        { L"==", COMPARE_OP_EQUAL },
+        { L"!=", COMPARE_OP_NOT_EQUAL },
+        { L"<=", COMPARE_OP_LESS_EQUAL },
+        { L">=", COMPARE_OP_GREATER_EQUAL },
+        { L"<", COMPARE_OP_LESS },
+        { L">", COMPARE_OP_GREATER },
+    };
+    if(lower.starts_with(L"dedicated"))
+    {
+        const std::wstring_view rest = Trim(str.substr(wcslen(L"dedicated")));
+        for(const auto& op : OPS)
+        {
+            if(!rest.starts_with(op.m_Str))
+                continue;
+            result.m_Type = TERM_TYPE_DEDICATED;
+            result.m_Op = op.m_Op;
+            if(!ParseSize(Trim(rest.substr(wcslen(op.m_Str))), result.m_Value))
+                ThrowInvalidTerm(term, "invalid size");
+            return result;
+        }
+    }
+    ThrowInvalidTerm(term, "unknown term");
+}
+
+bool AdapterFilter::MatchesTerm(const Term& term, const AdapterFilterInput& adapter)
+{
+    switch(term.m_Type)
+    {
+    case TERM_TYPE_VENDOR_NAME:
+        return MatchVendorName(adapter.m_VendorName, term.m_Text);
+    case TERM_TYPE_VENDOR_ID:
+        return adapter.m_VendorId == term.m_Value;
+    case TERM_TYPE_DEVICE_ID:
+        return adapter.m_DeviceId == term.m_Value;
+    case TERM_TYPE_LUID:
+        return adapter.m_Luid == term.m_Value;
+    case TERM_TYPE_NAME:
+        return MatchPattern(term.m_Text, ToLower(adapter.m_Description));
+    case TERM_TYPE_DEDICATED: {
+        const uint64_t size = adapter.m_DedicatedVideoMemory;
+        switch(term.m_Op)
+        {
+        case COMPARE_OP_EQUAL:
+            return size == term.m_Value;
+        case COMPARE_OP_NOT_EQUAL:
+            return size != term.m_Value;
+        case COMPARE_OP_LESS:
+            return size < term.m_Value;
+        case COMPARE_OP_LESS_EQUAL:
+            return size <= term.m_Value;
+        case COMPARE_OP_GREATER:
+            return size > term.m_Value;
+        case COMPARE_OP_GREATER_EQUAL:
+            return size >= term.m_Value;
+        }
+        return false;
+    }
+    case TERM_TYPE_FLAG:
+        return (adapter.m_Flags & term.m_Value) != 0;
+    }
+    return false;
+}
@@ -0,0 +1,95 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Filters choosing adapters with --Adapter, like "vendor:nvidia,dedicated>=8GiB,!software". Depends only on the C++
+// standard library, so it can be evaluated against made-up adapters.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Same values as DXGI_ADAPTER_FLAG.
+enum ADAPTER_FILTER_FLAG
+{
+    ADAPTER_FILTER_FLAG_REMOTE = 1,
+    ADAPTER_FILTER_FLAG_SOFTWARE = 2,
+};
+
+// What a filter is evaluated against, from DXGI_ADAPTER_DESC1.
+struct AdapterFilterInput
+{
+    std::wstring_view m_Description;
+    // From Enum_VendorId, like "AMD/ATI", or null if not known.
+    const wchar_t* m_VendorName = nullptr;
+    uint32_t m_VendorId = 0;
+    uint32_t m_DeviceId = 0;
+    uint64_t m_Luid = 0;
+    uint64_t m_DedicatedVideoMemory = 0;
+    uint32_t m_Flags = 0;
+};
+
+class AdapterFilter
+{
+public:
+    // Terms separated by commas, each of them optionally preceded by ! to negate it:
+    // - vendor:<Name or 0xID>, where the name is compared with the vendor name or its parts separated by '/'
+    // - device:<HexID>
+    // - luid:<High>-<Low>, as printed in the report
+    // - name:<Pattern>, where * matches any characters and ? one character
+    // - dedicated<Op><Size>, with operator ==, !=, <, <=, > or >=, and size in B, KiB, MiB, GiB or TiB
+    // - software, remote
+    // Names and units are not case-sensitive. Throws if a term is not valid.
+    void AddTerms(std::wstring_view terms);
+
+    bool IsEmpty() const
+    {
+        return m_Terms.empty();
+    }
+    // True if all terms match.
+    bool Matches(const AdapterFilterInput& adapter) const;
+
+private:
+    enum TERM_TYPE
+    {
+        TERM_TYPE_VENDOR_NAME,
+        TERM_TYPE_VENDOR_ID,
+        TERM_TYPE_DEVICE_ID,
+        TERM_TYPE_LUID,
+        TERM_TYPE_NAME,
+        TERM_TYPE_DEDICATED,
+        TERM_TYPE_FLAG,
+    };
+    enum COMPARE_OP
+    {
+        COMPARE_OP_EQUAL,
+        COMPARE_OP_NOT_EQUAL,
+        COMPARE_OP_LESS,
+        COMPARE_OP_LESS_EQUAL,
+        COMPARE_OP_GREATER,
+        COMPARE_OP_GREATER_EQUAL,
+    };
+    struct Term
+    {
+        TERM_TYPE m_Type = TERM_TYPE_FLAG;
+        bool m_Negated = false;
+        COMPARE_OP m_Op = COMPARE_OP_EQUAL;
+        // Number, or ADAPTER_FILTER_FLAG for TERM_TYPE_FLAG.
+        uint64_t m_Value = 0;
+        // Vendor name or pattern of the description, in lowercase.
+        std::wstring m_Text;
+    };
+
+    std::vector<Term> m_Terms;
+
+    static Term ParseTerm(std::wstring_view term);
+    static bool MatchesTerm(const Term& term, const AdapterFilterInput& adapter);
+};
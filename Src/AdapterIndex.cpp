@@ -0,0 +1,140 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "AdapterIndex.hpp"
+
+#include <cassert>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static uint64_t MakeVendorDeviceKey(uint32_t vendorId, uint32_t deviceId)
+{
+    return ((uint64_t)vendorId << 32) | deviceId;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+const wchar_t* GetAdapterSourceName(ADAPTER_SOURCE source)
+{
+    switch(source)
+    {
+    case ADAPTER_SOURCE_NVAPI:
+        return L"NVAPI";
+    case ADAPTER_SOURCE_AGS:
+        return L"AMD AGS";
+    case ADAPTER_SOURCE_AMD_DEVICE_INFO:
+        return L"AMD device_info";
+    case ADAPTER_SOURCE_VULKAN:
+        return L"Vulkan";
+    default:
+        assert(0);
+        return L"";
+    }
+}
+
+void AdapterIndex::SetSourceDevices(
+    ADAPTER_SOURCE source, std::vector<AdapterIdentity> devices, std::vector<ADAPTER_MATCH_KEY> keys)
+{
+    assert(source < ADAPTER_SOURCE_COUNT);
+    Source& dst = m_Sources[source];
+    dst = {};
+    dst.m_Devices = std::move(devices);
+    dst.m_Keys = std::move(keys);
+    for(size_t i = 0; i < dst.m_Devices.size(); ++i)
+    {
+        const AdapterIdentity& device = dst.m_Devices[i];
+        if(device.m_Luid)
+            dst.m_ByLuid[*device.m_Luid].push_back(i);
+        if(device.m_VendorId && device.m_DeviceId)
+            dst.m_ByVendorDevice[MakeVendorDeviceKey(*device.m_VendorId, *device.m_DeviceId)].push_back(i);
+    }
+    MatchAdapters(source);
+}
+
+void AdapterIndex::SetSourceResolver(ADAPTER_SOURCE source, Resolver resolver)
+{
+    assert(source < ADAPTER_SOURCE_COUNT);
+    m_Sources[source] = {};
+    m_Sources[source].m_Resolver = std::move(resolver);
+    MatchAdapters(source);
+}
+
+void AdapterIndex::AddAdapter(const AdapterIdentity& adapter)
+{
+    assert(adapter.m_Luid);
+    Adapter& dst = m_Adapters[*adapter.m_Luid];
+    dst.m_Identity = adapter;
+    for(size_t i = 0; i < ADAPTER_SOURCE_COUNT; ++i)
+        dst.m_Matches[i] = MatchSource(m_Sources[i], adapter);
+}
+
+AdapterMatch AdapterIndex::Find(uint64_t adapterLuid, ADAPTER_SOURCE source) const
+{
+    assert(source < ADAPTER_SOURCE_COUNT);
+    const auto it = m_Adapters.find(adapterLuid);
+    if(it == m_Adapters.end())
+        return {};
+    return it->second.m_Matches[source];
+}
+
+void AdapterIndex::MatchAdapters(ADAPTER_SOURCE source)
+{
+    for(auto& [luid, adapter] : m_Adapters)
+        adapter.m_Matches[source] = MatchSource(m_Sources[source], adapter.m_Identity);
+}
+
+AdapterMatch AdapterIndex::MatchSource(const Source& source, const AdapterIdentity& adapter)
+{
+    if(source.m_Resolver)
+        return source.m_Resolver(adapter);
+
+    for(ADAPTER_MATCH_KEY key : source.m_Keys)
+    {
+        const std::vector<size_t>* candidates = nullptr;
+        switch(key)
+        {
+        case ADAPTER_MATCH_KEY_LUID:
+            if(adapter.m_Luid)
+            {
+                if(const auto it = source.m_ByLuid.find(*adapter.m_Luid); it != source.m_ByLuid.end())
+                    candidates = &it->second;
+            }
+            break;
+        case ADAPTER_MATCH_KEY_VENDOR_DEVICE:
+        case ADAPTER_MATCH_KEY_VENDOR_DEVICE_REVISION:
+            if(adapter.m_VendorId && adapter.m_DeviceId)
+            {
+                const uint64_t vendorDeviceKey = MakeVendorDeviceKey(*adapter.m_VendorId, *adapter.m_DeviceId);
+                if(const auto it = source.m_ByVendorDevice.find(vendorDeviceKey); it != source.m_ByVendorDevice.end())
+                    candidates = &it->second;
+            }
+            break;
+        default:
+            assert(0);
+        }
+        if(!candidates)
+            continue;
+
+        AdapterMatch match;
+        for(size_t index : *candidates)
+        {
+            if(key == ADAPTER_MATCH_KEY_VENDOR_DEVICE_REVISION &&
+                (!adapter.m_RevisionId || source.m_Devices[index].m_RevisionId != adapter.m_RevisionId))
+                continue;
+            if(match.m_Result == AdapterMatch::RESULT_FOUND)
+                return { AdapterMatch::RESULT_AMBIGUOUS, SIZE_MAX };
+            match = { AdapterMatch::RESULT_FOUND, index };
+        }
+        if(match.m_Result == AdapterMatch::RESULT_FOUND)
+            return match;
+    }
+    return {};
+}
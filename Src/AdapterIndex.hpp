@@ -0,0 +1,106 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Correlates DXGI adapters with devices reported by other sources of information, built once per run.
+// Depends only on the C++ standard library, so the matching logic can be used with any identity tables.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+enum ADAPTER_SOURCE
+{
+    ADAPTER_SOURCE_NVAPI,
+    ADAPTER_SOURCE_AGS,
+    ADAPTER_SOURCE_AMD_DEVICE_INFO,
+    ADAPTER_SOURCE_VULKAN,
+    ADAPTER_SOURCE_COUNT
+};
+
+const wchar_t* GetAdapterSourceName(ADAPTER_SOURCE source);
+
+// What is known about a device. Members that a source doesn't report stay empty.
+struct AdapterIdentity
+{
+    std::optional<uint64_t> m_Luid;
+    std::optional<uint32_t> m_VendorId;
+    std::optional<uint32_t> m_DeviceId;
+    std::optional<uint32_t> m_RevisionId;
+};
+
+enum ADAPTER_MATCH_KEY
+{
+    ADAPTER_MATCH_KEY_LUID,
+    ADAPTER_MATCH_KEY_VENDOR_DEVICE,
+    ADAPTER_MATCH_KEY_VENDOR_DEVICE_REVISION,
+};
+
+struct AdapterMatch
+{
+    enum RESULT
+    {
+        RESULT_NONE,
+        RESULT_FOUND,
+        // Multiple devices of the source match the adapter, so none of them is used.
+        RESULT_AMBIGUOUS,
+    };
+    RESULT m_Result = RESULT_NONE;
+    // Index of the device in the list passed to SetSourceDevices or returned by the resolver.
+    size_t m_Index = SIZE_MAX;
+};
+
+class AdapterIndex
+{
+public:
+    using Resolver = std::function<AdapterMatch(const AdapterIdentity& adapter)>;
+
+    // Registers devices reported by the source. Keys are tried in order, first key giving any match decides.
+    // Adapters added before are matched again against this source, so a source can be registered when its library is
+    // initialized on first use. Only matches of this source change, so meanwhile other threads can Find matches of
+    // other sources.
+    void SetSourceDevices(
+        ADAPTER_SOURCE source, std::vector<AdapterIdentity> devices, std::vector<ADAPTER_MATCH_KEY> keys);
+    // For sources that find the device on their own, e.g. in a static table.
+    void SetSourceResolver(ADAPTER_SOURCE source, Resolver resolver);
+
+    // Matches the adapter against all sources registered so far. adapter.m_Luid must be set. Not thread-safe.
+    void AddAdapter(const AdapterIdentity& adapter);
+
+    // Returns RESULT_NONE also for adapters that were not added.
+    AdapterMatch Find(uint64_t adapterLuid, ADAPTER_SOURCE source) const;
+
+private:
+    struct Source
+    {
+        std::vector<AdapterIdentity> m_Devices;
+        std::vector<ADAPTER_MATCH_KEY> m_Keys;
+        // Indices into m_Devices, by LUID and by vendor and device ID.
+        std::unordered_map<uint64_t, std::vector<size_t>> m_ByLuid;
+        std::unordered_map<uint64_t, std::vector<size_t>> m_ByVendorDevice;
+        Resolver m_Resolver;
+    };
+
+    struct Adapter
+    {
+        AdapterIdentity m_Identity;
+        std::array<AdapterMatch, ADAPTER_SOURCE_COUNT> m_Matches;
+    };
+
+    std::array<Source, ADAPTER_SOURCE_COUNT> m_Sources;
+    std::unordered_map<uint64_t, Adapter> m_Adapters;
+
+    static AdapterMatch MatchSource(const Source& source, const AdapterIdentity& adapter);
+    void MatchAdapters(ADAPTER_SOURCE source);
+};
@@ -0,0 +1,159 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "AdapterWatcher.hpp"
+
+#include <cassert>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static bool IsSameDevice(const WatchedAdapter& lhs, const WatchedAdapter& rhs)
+{
+    return lhs.m_VendorId == rhs.m_VendorId && lhs.m_DeviceId == rhs.m_DeviceId && lhs.m_SubSysId == rhs.m_SubSysId;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+const wchar_t* GetAdapterChangeTypeName(ADAPTER_CHANGE_TYPE type)
+{
+    switch(type)
+    {
+    case ADAPTER_CHANGE_ADDED:
+        return L"Added";
+    case ADAPTER_CHANGE_REMOVED:
+        return L"Removed";
+    case ADAPTER_CHANGE_DRIVER:
+        return L"Driver";
+    default:
+        assert(0);
+        return L"";
+    }
+}
+
+bool ParseWatchInterval(std::wstring_view str, uint32_t& outSeconds)
+{
+    if(str.empty())
+        return false;
+    uint32_t seconds = 0;
+    for(wchar_t ch : str)
+    {
+        if(ch < L'0' || ch > L'9')
+            return false;
+        seconds = seconds * 10 + (uint32_t)(ch - L'0');
+        // Checked on every digit, so it can't overflow.
+        if(seconds > WATCH_INTERVAL_MAX_SECONDS)
+            return false;
+    }
+    if(seconds == 0)
+        return false;
+    outSeconds = seconds;
+    return true;
+}
+
+std::vector<AdapterChange> AdapterWatcher::Update(const std::vector<WatchedAdapter>& adapters)
+{
+    std::vector<AdapterChange> changes;
+    std::vector<bool> previousMatched(m_Adapters.size(), false);
+    std::vector<size_t> unmatched;
+
+    for(size_t i = 0; i < adapters.size(); ++i)
+    {
+        size_t prevIndex = 0;
+        while(prevIndex < m_Adapters.size() && m_Adapters[prevIndex].m_Luid != adapters[i].m_Luid)
+            ++prevIndex;
+        if(prevIndex == m_Adapters.size())
+        {
+            unmatched.push_back(i);
+            continue;
+        }
+        previousMatched[prevIndex] = true;
+        const WatchedAdapter& prev = m_Adapters[prevIndex];
+        if(!IsSameDevice(prev, adapters[i]) || prev.m_Revision != adapters[i].m_Revision ||
+            prev.m_UmdVersion != adapters[i].m_UmdVersion)
+        {
+            changes.push_back({ .m_Type = ADAPTER_CHANGE_DRIVER, .m_Adapter = adapters[i], .m_Previous = prev });
+        }
+    }
+
+    // A new LUID of a device that disappeared at the same time is most likely the same device.
+    for(size_t i : unmatched)
+    {
+        size_t prevIndex = 0;
+        while(prevIndex < m_Adapters.size() &&
+            (previousMatched[prevIndex] || !IsSameDevice(m_Adapters[prevIndex], adapters[i])))
+        {
+            ++prevIndex;
+        }
+        if(prevIndex == m_Adapters.size())
+        {
+            changes.push_back({ .m_Type = ADAPTER_CHANGE_ADDED, .m_Adapter = adapters[i] });
+            continue;
+        }
+        previousMatched[prevIndex] = true;
+        const WatchedAdapter& prev = m_Adapters[prevIndex];
+        if(auto report = m_Reports.extract(prev.m_Luid))
+        {
+            report.key() = adapters[i].m_Luid;
+            m_Reports.insert(std::move(report));
+        }
+        changes.push_back({ .m_Type = ADAPTER_CHANGE_DRIVER, .m_Adapter = adapters[i], .m_Previous = prev });
+    }
+
+    for(size_t prevIndex = 0; prevIndex < m_Adapters.size(); ++prevIndex)
+    {
+        if(!previousMatched[prevIndex])
+        {
+            m_Reports.erase(m_Adapters[prevIndex].m_Luid);
+            changes.push_back({ .m_Type = ADAPTER_CHANGE_REMOVED, .m_Adapter = m_Adapters[prevIndex] });
+        }
+    }
+
+    m_Adapters = adapters;
+    return changes;
+}
+
+std::vector<ReportFieldChange> AdapterWatcher::UpdateReport(uint64_t luid, std::vector<ReportField> report)
+{
+    std::vector<ReportFieldChange> changes;
+    std::vector<ReportField>& prevReport = m_Reports[luid];
+    if(!prevReport.empty())
+    {
+        std::unordered_map<std::wstring, size_t> prevIndices;
+        for(size_t i = 0; i < prevReport.size(); ++i)
+            prevIndices.emplace(prevReport[i].m_Path, i);
+        std::vector<bool> prevFound(prevReport.size(), false);
+
+        for(const ReportField& field : report)
+        {
+            const auto it = prevIndices.find(field.m_Path);
+            if(it == prevIndices.end())
+            {
+                changes.push_back({ .m_Path = field.m_Path, .m_NewValue = field.m_Value });
+                continue;
+            }
+            prevFound[it->second] = true;
+            const ReportField& prevField = prevReport[it->second];
+            if(prevField.m_Value != field.m_Value)
+            {
+                changes.push_back(
+                    { .m_Path = field.m_Path, .m_OldValue = prevField.m_Value, .m_NewValue = field.m_Value });
+            }
+        }
+
+        for(size_t i = 0; i < prevReport.size(); ++i)
+        {
+            if(!prevFound[i])
+                changes.push_back({ .m_Path = prevReport[i].m_Path, .m_OldValue = prevReport[i].m_Value });
+        }
+    }
+    prevReport = std::move(report);
+    return changes;
+}
@@ -0,0 +1,93 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+// Change detection for --Watch: which adapters appeared, disappeared or got a new driver since the previous check, and
+// which fields of their reports changed. Depends only on the C++ standard library, so it can be driven by scripted
+// adapters instead of DXGI.
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// What is cheap to query for an adapter on every check, as opposed to its report, which needs a D3D12 device.
+struct WatchedAdapter
+{
+    uint64_t m_Luid = 0;
+    uint32_t m_VendorId = 0;
+    uint32_t m_DeviceId = 0;
+    uint32_t m_SubSysId = 0;
+    uint32_t m_Revision = 0;
+    // UMD version from IDXGIAdapter::CheckInterfaceSupport.
+    uint64_t m_UmdVersion = 0;
+    std::wstring m_Description;
+};
+
+enum ADAPTER_CHANGE_TYPE
+{
+    ADAPTER_CHANGE_ADDED,
+    ADAPTER_CHANGE_REMOVED,
+    // Different driver version or revision, or a new LUID of the same device, e.g. after the driver was reinstalled.
+    ADAPTER_CHANGE_DRIVER,
+};
+
+const wchar_t* GetAdapterChangeTypeName(ADAPTER_CHANGE_TYPE type);
+
+// Longest interval of --Watch, one day. Its number of milliseconds fits in 32 bits, below the infinite timeout.
+static const uint32_t WATCH_INTERVAL_MAX_SECONDS = 24 * 60 * 60;
+
+// Parses the parameter of --Watch: decimal number of seconds, from 1 to WATCH_INTERVAL_MAX_SECONDS, with nothing after
+// it. Returns false if it is not valid.
+bool ParseWatchInterval(std::wstring_view str, uint32_t& outSeconds);
+
+struct AdapterChange
+{
+    ADAPTER_CHANGE_TYPE m_Type = ADAPTER_CHANGE_ADDED;
+    // Last known state for ADAPTER_CHANGE_REMOVED.
+    WatchedAdapter m_Adapter;
+    // State before ADAPTER_CHANGE_DRIVER.
+    WatchedAdapter m_Previous;
+};
+
+// Field of a report flattened to text: path made of names of its scopes and the value.
+struct ReportField
+{
+    std::wstring m_Path;
+    std::wstring m_Value;
+};
+
+// Empty m_OldValue means the field is new, empty m_NewValue that it is gone.
+struct ReportFieldChange
+{
+    std::wstring m_Path;
+    std::optional<std::wstring> m_OldValue;
+    std::optional<std::wstring> m_NewValue;
+};
+
+class AdapterWatcher
+{
+public:
+    // Compares with adapters passed in the previous call, so the first call reports all of them as added. Adapters are
+    // matched by LUID, then by vendor, device and subsystem ID. Unchanged adapters don't need to be probed again.
+    std::vector<AdapterChange> Update(const std::vector<WatchedAdapter>& adapters);
+
+    // Remembers the report of an adapter passed to the last Update and returns changes in comparison to its previous
+    // report, in order of fields in the new one, followed by the removed ones. Empty when there was no report before.
+    std::vector<ReportFieldChange> UpdateReport(uint64_t luid, std::vector<ReportField> report);
+
+private:
+    std::vector<WatchedAdapter> m_Adapters;
+    // By LUID.
+    std::unordered_map<uint64_t, std::vector<ReportField>> m_Reports;
+};
@@ -40,27 +40,6 @@ static AGSContext* g_AgsContext;
 static AGSGPUInfo g_GpuInfo;
 static bool g_DeviceCreatedWithAgs = false;
 
-static bool FindDevice(const AGS_Initialize_RAII::DeviceId& id, int& outIndex)
-{
-    bool found = false;
-    for(int i = 0; i < g_GpuInfo.numDevices; ++i)
-    {
-        if(g_GpuInfo.devices[i].vendorId == id.vendorId && g_GpuInfo.devices[i].deviceId == id.deviceId &&
-            g_GpuInfo.devices[i].revisionId == id.revisionId)
-        {
-            if(found)
-                // Multiple identical devices found.
-                return false;
-            else
-            {
-                outIndex = i;
-                found = true;
-            }
-        }
-    }
-    return found;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 // PUBLIC
 
@@ -68,9 +47,6 @@ void AGS_Initialize_RAII::PrintStaticParams()
 {
     ReportFormatter::GetInstance().AddFieldString(L"AMD_AGS_VERSION",
         std::format(L"{}.{}.{}", AMD_AGS_VERSION_MAJOR, AMD_AGS_VERSION_MINOR, AMD_AGS_VERSION_PATCH).c_str());
-
-    const uint32_t version = (uint32_t)agsGetVersionNumber();
-    ReportFormatter::GetInstance().AddFieldAMDVersion(L"agsGetVersionNumber", version);
 }
 
 AGS_Initialize_RAII::AGS_Initialize_RAII()
@@ -94,6 +70,9 @@ void AGS_Initialize_RAII::PrintData()
 {
     assert(m_Initialized);
 
+    const uint32_t version = (uint32_t)agsGetVersionNumber();
+    ReportFormatter::GetInstance().AddFieldAMDVersion(L"agsGetVersionNumber", version);
+
     if(IsStrEmpty(g_GpuInfo.driverVersion) && IsStrEmpty(g_GpuInfo.radeonSoftwareVersion))
         return;
 
@@ -103,13 +82,24 @@ void AGS_Initialize_RAII::PrintData()
         L"radeonSoftwareVersion", StrToWstr(g_GpuInfo.radeonSoftwareVersion, CP_ACP).c_str());
 }
 
-void AGS_Initialize_RAII::PrintAgsDeviceData(const DeviceId& id)
+void AGS_Initialize_RAII::GetDeviceIdentities(std::vector<AdapterIdentity>& outIdentities) const
+{
+    assert(IsInitialized());
+    outIdentities.resize((size_t)g_GpuInfo.numDevices);
+    for(int i = 0; i < g_GpuInfo.numDevices; ++i)
+    {
+        const AGSDeviceInfo& device = g_GpuInfo.devices[i];
+        outIdentities[i] = { .m_VendorId = (uint32_t)device.vendorId,
+            .m_DeviceId = (uint32_t)device.deviceId,
+            .m_RevisionId = (uint32_t)device.revisionId };
+    }
+}
+
+void AGS_Initialize_RAII::PrintAgsDeviceData(size_t deviceIndex)
 {
     assert(IsInitialized());
+    assert(deviceIndex < (size_t)g_GpuInfo.numDevices);
 
-    int deviceIndex = -1;
-    if(!FindDevice(id, deviceIndex))
-        return;
     const AGSDeviceInfo& device = g_GpuInfo.devices[deviceIndex];
 
     ReportScopeObject region(L"AGSDeviceInfo");
@@ -9,13 +9,15 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
+#include "AdapterIndex.hpp"
+
 // Macro set by Cmake.
 #if USE_AGS
 
 class AGS_Initialize_RAII
 {
 public:
-    // Prints parameters related to NVAPI itself, regardless of whether intialization succeeded.
+    // Prints parameters AGS was compiled with. Doesn't call AGS, so its DLL is not loaded.
     static void PrintStaticParams();
 
     AGS_Initialize_RAII();
@@ -28,11 +30,10 @@ public:
     // Prints structs from AGS unrelated to any specific GPU.
     void PrintData();
 
-    struct DeviceId
-    {
-        int vendorId, deviceId, revisionId;
-    };
-    void PrintAgsDeviceData(const DeviceId& id);
+    // One identity per AGSDeviceInfo, to be matched with DXGI adapters by vendor, device and revision ID.
+    void GetDeviceIdentities(std::vector<AdapterIdentity>& outIdentities) const;
+    // deviceIndex is index of the identity returned by GetDeviceIdentities.
+    void PrintAgsDeviceData(size_t deviceIndex);
 
     // If fails, return null pointer.
     ComPtr<ID3D12Device> CreateDeviceAndPrintData(IDXGIAdapter* adapter, D3D_FEATURE_LEVEL featureLevel);
@@ -9,7 +9,7 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "AmdDeviceInfoData.hpp"
 
-#include "Enums.hpp"
+#include "EnumItems.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
 #include "Utils.hpp"
 
@@ -119,19 +119,56 @@ ENUM_BEGIN(GDT_HW_GENERATION)
     ENUM_ITEM(GDT_HW_GENERATION_LAST)
 ENUM_END(GDT_HW_GENERATION)
 
-static const GDT_GfxCardInfo* FindCardInfo(const AmdDeviceInfo_Initialize_RAII::DeviceId& id)
+// Indices into gs_cardInfo sorted by (m_deviceID, m_revID). Entries with equal keys keep their order from the table.
+static const std::vector<uint32_t>& GetCardInfoIndex()
 {
-    for(size_t i = 0; i < gs_cardInfoSize; ++i)
-    {
-        const GDT_GfxCardInfo& info = gs_cardInfo[i];
-        if(info.m_deviceID == id.deviceId && (info.m_revID == id.revisionId || info.m_revID == REVISION_ID_ANY))
-        {
-            return &info;
-        }
-    }
+    static const std::vector<uint32_t> index = []() {
+        std::vector<uint32_t> result(gs_cardInfoSize);
+        std::iota(result.begin(), result.end(), 0u);
+        std::stable_sort(result.begin(), result.end(), [](uint32_t lhs, uint32_t rhs) {
+            const GDT_GfxCardInfo& lhsInfo = gs_cardInfo[lhs];
+            const GDT_GfxCardInfo& rhsInfo = gs_cardInfo[rhs];
+            if(lhsInfo.m_deviceID != rhsInfo.m_deviceID)
+                return lhsInfo.m_deviceID < rhsInfo.m_deviceID;
+            return lhsInfo.m_revID < rhsInfo.m_revID;
+        });
+        return result;
+    }();
+    return index;
+}
+
+static const GDT_GfxCardInfo* FindCardInfoExact(uint64_t deviceId, uint64_t revisionId)
+{
+    const std::vector<uint32_t>& index = GetCardInfoIndex();
+    const auto it = std::lower_bound(index.begin(), index.end(), std::make_pair(deviceId, revisionId),
+        [](uint32_t lhs, const std::pair<uint64_t, uint64_t>& rhs) {
+            const GDT_GfxCardInfo& lhsInfo = gs_cardInfo[lhs];
+            if(lhsInfo.m_deviceID != rhs.first)
+                return lhsInfo.m_deviceID < rhs.first;
+            return lhsInfo.m_revID < rhs.second;
+        });
+    if(it != index.end() && gs_cardInfo[*it].m_deviceID == deviceId && gs_cardInfo[*it].m_revID == revisionId)
+        return &gs_cardInfo[*it];
     return nullptr;
 }
 
+// Entry with matching revision takes precedence over the one with REVISION_ID_ANY.
+static const GDT_GfxCardInfo* FindCardInfo(const AmdDeviceInfo_Initialize_RAII::DeviceId& id)
+{
+    if(const GDT_GfxCardInfo* info = FindCardInfoExact(id.deviceId, id.revisionId))
+        return info;
+    return FindCardInfoExact(id.deviceId, REVISION_ID_ANY);
+}
+
+static void FillCardInfo(const GDT_GfxCardInfo& src, AmdDeviceInfo_Initialize_RAII::CardInfo& dst)
+{
+    dst.asicType = (uint32_t)src.m_asicType;
+    dst.generation = (uint32_t)src.m_generation;
+    dst.APU = src.m_bAPU;
+    dst.CALName = src.m_szCALName;
+    dst.marketingName = src.m_szMarketingName;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // PUBLIC
 
@@ -141,11 +178,39 @@ void AmdDeviceInfo_Initialize_RAII::PrintStaticParams()
         L"AMD device_info compiled version", AMD_DEVICE_INFO_COMPILED_VERSION);
 }
 
-void AmdDeviceInfo_Initialize_RAII::PrintDeviceData(const DeviceId& id)
+bool AmdDeviceInfo_Initialize_RAII::FindCardInfo(const DeviceId& id, CardInfo& outInfo)
 {
-    const GDT_GfxCardInfo* const cardInfo = FindCardInfo(id);
+    const GDT_GfxCardInfo* const cardInfo = ::FindCardInfo(id);
     if(!cardInfo)
-        return;
+        return false;
+    FillCardInfo(*cardInfo, outInfo);
+    return true;
+}
+
+void AmdDeviceInfo_Initialize_RAII::FindCardInfos(const DeviceId* ids, size_t count, CardInfo* outInfos, bool* outFound)
+{
+    const GDT_GfxCardInfo* cardInfo = nullptr;
+    for(size_t i = 0; i < count; ++i)
+    {
+        // Fleet data is often grouped by device, so reuse the previous result for a repeated ID.
+        if(i == 0 || ids[i].deviceId != ids[i - 1].deviceId || ids[i].revisionId != ids[i - 1].revisionId)
+            cardInfo = ::FindCardInfo(ids[i]);
+        outFound[i] = cardInfo != nullptr;
+        if(cardInfo)
+            FillCardInfo(*cardInfo, outInfos[i]);
+    }
+}
+
+size_t AmdDeviceInfo_Initialize_RAII::FindCardInfoIndex(const DeviceId& id)
+{
+    const GDT_GfxCardInfo* const cardInfo = ::FindCardInfo(id);
+    return cardInfo ? (size_t)(cardInfo - gs_cardInfo) : SIZE_MAX;
+}
+
+void AmdDeviceInfo_Initialize_RAII::PrintDeviceData(size_t cardInfoIndex)
+{
+    assert(cardInfoIndex < gs_cardInfoSize);
+    const GDT_GfxCardInfo* const cardInfo = &gs_cardInfo[cardInfoIndex];
 
     ReportFormatter& formatter = ReportFormatter::GetInstance();
 
@@ -153,9 +218,9 @@ void AmdDeviceInfo_Initialize_RAII::PrintDeviceData(const DeviceId& id)
         ReportScopeObject region{ L"AMD GDT_GfxCardInfo" };
         formatter.AddFieldEnum(L"asicType", cardInfo->m_asicType, Enum_GDT_HW_ASIC_TYPE);
         formatter.AddFieldEnum(L"generation", cardInfo->m_generation, Enum_GDT_HW_GENERATION);
-        formatter.AddFieldBool(L"APU", cardInfo->m_bAPU ? TRUE : FALSE);
-        formatter.AddFieldString(L"CALName", StrToWstr(cardInfo->m_szCALName, CP_UTF8).c_str());
-        formatter.AddFieldString(L"MarketingName", StrToWstr(cardInfo->m_szMarketingName, CP_UTF8).c_str());
+        formatter.AddFieldBool(L"APU", cardInfo->m_bAPU);
+        formatter.AddFieldString(L"CALName", Utf8ToWstr(cardInfo->m_szCALName ? cardInfo->m_szCALName : ""));
+        formatter.AddFieldString(L"MarketingName", Utf8ToWstr(cardInfo->m_szMarketingName ? cardInfo->m_szMarketingName : ""));
     }
 
     if(cardInfo->m_asicType >= 0 && cardInfo->m_asicType < gs_deviceInfoSize)
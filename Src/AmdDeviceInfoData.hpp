@@ -22,7 +22,23 @@ public:
     {
         uint32_t deviceId, revisionId;
     };
-    void PrintDeviceData(const DeviceId& id);
+    struct CardInfo
+    {
+        uint32_t asicType, generation;
+        bool APU;
+        const char* CALName;
+        const char* marketingName;
+    };
+    // Entry with matching revision takes precedence over the one matching any revision.
+    // Returns false if the device is unknown.
+    static bool FindCardInfo(const DeviceId& id, CardInfo& outInfo);
+    // Resolves many IDs in one call. outFound[i] tells whether outInfos[i] has been filled.
+    static void FindCardInfos(const DeviceId* ids, size_t count, CardInfo* outInfos, bool* outFound);
+
+    // Returns index of the entry to pass to PrintDeviceData, or SIZE_MAX if the device is unknown.
+    static size_t FindCardInfoIndex(const DeviceId& id);
+
+    void PrintDeviceData(size_t cardInfoIndex);
 };
 
 #else
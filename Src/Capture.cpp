@@ -0,0 +1,536 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Capture.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <sstream>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// E_NOTIMPL, returned for queries that are missing in the capture.
+static const int32_t RESULT_NOT_CAPTURED = (int32_t)0x80004001;
+
+// For fields of captured structures whose enum is not in the capture.
+static const EnumItem EMPTY_ENUM_ITEMS[] = { { nullptr, UINT32_MAX } };
+
+static uint64_t MakeTagKey(CAPTURE_TAG tag, uint32_t key)
+{
+    return ((uint64_t)tag << 32) | key;
+}
+
+// Builds data in the format of the capture file.
+class CaptureDataWriter
+{
+public:
+    std::vector<uint8_t> m_Data;
+
+    void WriteUint32(uint32_t value)
+    {
+        for(uint32_t i = 0; i < 4; ++i)
+            m_Data.push_back((uint8_t)(value >> (i * 8)));
+    }
+    void WriteUint64(uint64_t value)
+    {
+        WriteUint32((uint32_t)value);
+        WriteUint32((uint32_t)(value >> 32));
+    }
+    void WriteString(std::wstring_view str)
+    {
+        const std::u16string str16 = WstrToUtf16(str);
+        WriteUint32((uint32_t)str16.length());
+        for(char16_t ch : str16)
+        {
+            m_Data.push_back((uint8_t)ch);
+            m_Data.push_back((uint8_t)(ch >> 8));
+        }
+    }
+};
+
+// Reads data in the format of the capture file. Reads fail past the end of data.
+class CaptureDataReader
+{
+public:
+    CaptureDataReader(const uint8_t* data, size_t size)
+        : m_Data(data)
+        , m_Size(size)
+    {
+    }
+
+    size_t GetOffset() const { return m_Offset; }
+    bool IsAtEnd() const { return m_Offset == m_Size; }
+
+    bool Skip(size_t byteCount)
+    {
+        if(m_Size - m_Offset < byteCount)
+            return false;
+        m_Offset += byteCount;
+        return true;
+    }
+    bool ReadUint32(uint32_t& outValue)
+    {
+        if(m_Size - m_Offset < 4)
+            return false;
+        outValue = 0;
+        for(uint32_t i = 0; i < 4; ++i)
+            outValue |= (uint32_t)m_Data[m_Offset++] << (i * 8);
+        return true;
+    }
+    bool ReadUint64(uint64_t& outValue)
+    {
+        uint32_t low, high;
+        if(!ReadUint32(low) || !ReadUint32(high))
+            return false;
+        outValue = ((uint64_t)high << 32) | low;
+        return true;
+    }
+    bool ReadString(wstring& outStr)
+    {
+        uint32_t length;
+        if(!ReadUint32(length) || (m_Size - m_Offset) / 2 < length)
+            return false;
+        std::u16string str16(length, u'\0');
+        for(char16_t& ch : str16)
+        {
+            ch = (char16_t)(m_Data[m_Offset] | (m_Data[m_Offset + 1] << 8));
+            m_Offset += 2;
+        }
+        outStr = Utf16ToWstr(str16);
+        return true;
+    }
+
+private:
+    const uint8_t* const m_Data;
+    const size_t m_Size;
+    size_t m_Offset = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+CaptureWriter::CaptureWriter(const std::filesystem::path& filePath)
+    : m_File(filePath, std::ios::binary)
+{
+    if(!m_File.is_open())
+    {
+        const string pathStr = WstrToUtf8(filePath.wstring());
+        throw std::runtime_error(std::format("Could not open capture file \"{}\".", pathStr));
+    }
+    CaptureDataWriter fileHeader;
+    fileHeader.WriteUint32(CAPTURE_FILE_MAGIC);
+    fileHeader.WriteUint32(CAPTURE_FILE_VERSION);
+    m_File.write((const char*)fileHeader.m_Data.data(), (std::streamsize)fileHeader.m_Data.size());
+}
+
+void CaptureWriter::BeginAdapter(uint32_t adapterIndex)
+{
+    AddRecord(CAPTURE_TAG_ADAPTER, adapterIndex, nullptr, 0, nullptr, 0, 0);
+}
+
+void CaptureWriter::AddRecord(CAPTURE_TAG tag, uint32_t key, const void* input, uint32_t inputSize,
+    const void* output, uint32_t outputSize, int32_t result)
+{
+    CaptureDataWriter header;
+    header.WriteUint32(tag);
+    header.WriteUint32(key);
+    header.WriteUint32(inputSize);
+    header.WriteUint32(outputSize);
+    header.WriteUint32((uint32_t)result);
+    m_File.write((const char*)header.m_Data.data(), (std::streamsize)header.m_Data.size());
+    m_File.write((const char*)input, inputSize);
+    m_File.write((const char*)output, outputSize);
+    if(!m_File)
+        throw std::runtime_error("Could not write capture file.");
+}
+
+void CaptureWriter::AddUint32(CAPTURE_TAG tag, uint32_t key, uint32_t value, int32_t result)
+{
+    CaptureDataWriter data;
+    data.WriteUint32(value);
+    AddRecord(tag, key, nullptr, 0, data.m_Data.data(), (uint32_t)data.m_Data.size(), result);
+}
+
+void CaptureWriter::AddUint64(CAPTURE_TAG tag, uint32_t key, uint64_t value)
+{
+    CaptureDataWriter data;
+    data.WriteUint64(value);
+    AddRecord(tag, key, nullptr, 0, data.m_Data.data(), (uint32_t)data.m_Data.size(), 0);
+}
+
+void CaptureWriter::AddReportHeader(const ReportHeader& header)
+{
+    CaptureDataWriter data;
+    data.WriteString(header.m_ProgramVersion);
+    data.WriteString(header.m_BuildDate);
+    data.WriteString(header.m_Configuration);
+    data.WriteString(header.m_ConfigurationBits);
+    data.WriteString(header.m_GeneratedOn);
+    data.WriteUint32(header.m_D3D12SdkVersion);
+    data.WriteUint32(header.m_PreviewAgilitySdk ? 1 : 0);
+    AddRecord(CAPTURE_TAG_REPORT_HEADER, 0, nullptr, 0, data.m_Data.data(), (uint32_t)data.m_Data.size(), 0);
+}
+
+void CaptureWriter::AddAdapterDesc(uint32_t descVersion, const CaptureAdapterDesc& desc, int32_t result)
+{
+    CaptureDataWriter data;
+    data.WriteString(desc.m_Description);
+    data.WriteUint32(desc.m_VendorId);
+    data.WriteUint32(desc.m_DeviceId);
+    data.WriteUint32(desc.m_SubSysId);
+    data.WriteUint32(desc.m_Revision);
+    data.WriteUint64(desc.m_DedicatedVideoMemory);
+    data.WriteUint64(desc.m_DedicatedSystemMemory);
+    data.WriteUint64(desc.m_SharedSystemMemory);
+    data.WriteUint64(desc.m_AdapterLuid);
+    data.WriteUint32(desc.m_Flags);
+    data.WriteUint32(desc.m_GraphicsPreemptionGranularity);
+    data.WriteUint32(desc.m_ComputePreemptionGranularity);
+    AddRecord(CAPTURE_TAG_DXGI_ADAPTER_DESC, descVersion, nullptr, 0, data.m_Data.data(),
+        (uint32_t)data.m_Data.size(), result);
+}
+
+void CaptureWriter::AddVideoMemoryInfo(uint32_t memorySegmentGroup, const CaptureVideoMemoryInfo& videoMemoryInfo)
+{
+    CaptureDataWriter data;
+    data.WriteUint64(videoMemoryInfo.m_Budget);
+    data.WriteUint64(videoMemoryInfo.m_CurrentUsage);
+    data.WriteUint64(videoMemoryInfo.m_AvailableForReservation);
+    data.WriteUint64(videoMemoryInfo.m_CurrentReservation);
+    AddRecord(CAPTURE_TAG_DXGI_VIDEO_MEMORY_INFO, memorySegmentGroup, nullptr, 0, data.m_Data.data(),
+        (uint32_t)data.m_Data.size(), 0);
+}
+
+void CaptureWriter::AddReport(CAPTURE_REPORT report, const RecordingReportFormatter& recording)
+{
+    std::ostringstream stream;
+    recording.Save(stream);
+    const std::string data = stream.str();
+    AddRecord(CAPTURE_TAG_REPORT, report, nullptr, 0, data.data(), (uint32_t)data.size(), 0);
+}
+
+void CaptureWriter::AddEnum(std::wstring_view name, const EnumItem* items)
+{
+    uint32_t itemCount = 0;
+    while(items[itemCount].m_Name != nullptr)
+        ++itemCount;
+    CaptureDataWriter data;
+    data.WriteString(name);
+    data.WriteUint32(itemCount);
+    for(uint32_t i = 0; i < itemCount; ++i)
+    {
+        data.WriteString(items[i].m_Name);
+        data.WriteUint32(items[i].m_Value);
+    }
+    AddRecord(CAPTURE_TAG_ENUM, m_EnumCount++, nullptr, 0, data.m_Data.data(), (uint32_t)data.m_Data.size(), 0);
+}
+
+void CaptureWriter::AddStructDescs(const StructCollection& structs, const EnumCollection& enums)
+{
+    std::unordered_map<const EnumItem*, const wstring*> enumNames;
+    for(const auto& [name, items] : enums.m_Enums)
+        enumNames.insert({ items, &name });
+
+    // In order of IDs, so the capture doesn't depend on the order of registration.
+    std::vector<const StructDesc*> sortedStructs;
+    for(const auto& [structId, structDesc] : structs.GetStructs())
+        sortedStructs.push_back(structDesc);
+    std::sort(sortedStructs.begin(), sortedStructs.end(),
+        [](const StructDesc* lhs, const StructDesc* rhs) { return lhs->m_Id < rhs->m_Id; });
+
+    std::unordered_map<const EnumItem*, bool> addedEnums;
+    for(const StructDesc* structDesc : sortedStructs)
+    {
+        CaptureDataWriter data;
+        data.WriteString(structDesc->m_Name);
+        data.WriteUint32(structDesc->m_FieldCount);
+        for(uint32_t i = 0; i < structDesc->m_FieldCount; ++i)
+        {
+            const FieldDesc& field = structDesc->m_Fields[i];
+            data.WriteString(field.m_Name);
+            data.WriteUint32(field.m_Offset);
+            data.WriteUint32(field.m_Kind);
+            // A table that isn't registered is left out, so the field is printed as a number.
+            const auto enumNameIt = field.m_EnumItems ? enumNames.find(field.m_EnumItems) : enumNames.end();
+            if(enumNameIt == enumNames.end())
+            {
+                data.WriteString({});
+                continue;
+            }
+            data.WriteString(*enumNameIt->second);
+            if(addedEnums.insert({ field.m_EnumItems, true }).second)
+                AddEnum(*enumNameIt->second, field.m_EnumItems);
+        }
+        AddRecord(CAPTURE_TAG_STRUCT_DESC, structDesc->m_Id, nullptr, 0, data.m_Data.data(),
+            (uint32_t)data.m_Data.size(), 0);
+    }
+}
+
+bool CaptureRecord::CopyOutput(void* dst, size_t dstSize) const
+{
+    if(m_OutputSize > dstSize)
+        return false;
+    memcpy(dst, m_Output, m_OutputSize);
+    memset((uint8_t*)dst + m_OutputSize, 0, dstSize - m_OutputSize);
+    return true;
+}
+
+void CaptureSection::AddRecord(const CaptureRecord& record)
+{
+    m_ByTagKey[MakeTagKey(record.m_Tag, record.m_Key)].push_back((uint32_t)m_Records.size());
+    m_Records.push_back(record);
+}
+
+bool CaptureSection::Contains(CAPTURE_TAG tag, uint32_t key) const
+{
+    return m_ByTagKey.find(MakeTagKey(tag, key)) != m_ByTagKey.end();
+}
+
+const CaptureRecord* CaptureSection::Find(CAPTURE_TAG tag, uint32_t key, const void* input, uint32_t inputSize) const
+{
+    const auto it = m_ByTagKey.find(MakeTagKey(tag, key));
+    if(it == m_ByTagKey.end())
+        return nullptr;
+    for(uint32_t index : it->second)
+    {
+        const CaptureRecord& record = m_Records[index];
+        if(record.m_InputSize != inputSize)
+            continue;
+        if(inputSize == 0 || memcmp(record.m_Input, input, inputSize) == 0)
+            return &record;
+    }
+    return it->second.size() == 1 ? &m_Records[it->second[0]] : nullptr;
+}
+
+const CaptureRecord* CaptureSection::FindSucceeded(CAPTURE_TAG tag, uint32_t key) const
+{
+    const CaptureRecord* record = Find(tag, key);
+    return record && record->m_Result >= 0 ? record : nullptr;
+}
+
+bool CaptureSection::FindUint32(CAPTURE_TAG tag, uint32_t key, uint32_t& outValue) const
+{
+    const CaptureRecord* record = FindSucceeded(tag, key);
+    if(!record)
+        return false;
+    CaptureDataReader reader(record->m_Output, record->m_OutputSize);
+    return reader.ReadUint32(outValue) && reader.IsAtEnd();
+}
+
+bool CaptureSection::FindUint64(CAPTURE_TAG tag, uint32_t key, uint64_t& outValue) const
+{
+    const CaptureRecord* record = FindSucceeded(tag, key);
+    if(!record)
+        return false;
+    CaptureDataReader reader(record->m_Output, record->m_OutputSize);
+    return reader.ReadUint64(outValue) && reader.IsAtEnd();
+}
+
+bool CaptureSection::FindReportHeader(ReportHeader& outHeader) const
+{
+    const CaptureRecord* record = FindSucceeded(CAPTURE_TAG_REPORT_HEADER, 0);
+    if(!record)
+        return false;
+    CaptureDataReader reader(record->m_Output, record->m_OutputSize);
+    uint32_t previewAgilitySdk = 0;
+    const bool valid = reader.ReadString(outHeader.m_ProgramVersion) && reader.ReadString(outHeader.m_BuildDate) &&
+        reader.ReadString(outHeader.m_Configuration) && reader.ReadString(outHeader.m_ConfigurationBits) &&
+        reader.ReadString(outHeader.m_GeneratedOn) && reader.ReadUint32(outHeader.m_D3D12SdkVersion) &&
+        reader.ReadUint32(previewAgilitySdk) && reader.IsAtEnd();
+    outHeader.m_PreviewAgilitySdk = previewAgilitySdk != 0;
+    return valid;
+}
+
+bool CaptureSection::FindAdapterDesc(uint32_t descVersion, CaptureAdapterDesc& outDesc) const
+{
+    const CaptureRecord* record = FindSucceeded(CAPTURE_TAG_DXGI_ADAPTER_DESC, descVersion);
+    if(!record)
+        return false;
+    CaptureDataReader reader(record->m_Output, record->m_OutputSize);
+    return reader.ReadString(outDesc.m_Description) && reader.ReadUint32(outDesc.m_VendorId) &&
+        reader.ReadUint32(outDesc.m_DeviceId) && reader.ReadUint32(outDesc.m_SubSysId) &&
+        reader.ReadUint32(outDesc.m_Revision) && reader.ReadUint64(outDesc.m_DedicatedVideoMemory) &&
+        reader.ReadUint64(outDesc.m_DedicatedSystemMemory) && reader.ReadUint64(outDesc.m_SharedSystemMemory) &&
+        reader.ReadUint64(outDesc.m_AdapterLuid) && reader.ReadUint32(outDesc.m_Flags) &&
+        reader.ReadUint32(outDesc.m_GraphicsPreemptionGranularity) &&
+        reader.ReadUint32(outDesc.m_ComputePreemptionGranularity) && reader.IsAtEnd();
+}
+
+bool CaptureSection::FindVideoMemoryInfo(uint32_t memorySegmentGroup, CaptureVideoMemoryInfo& outVideoMemoryInfo) const
+{
+    const CaptureRecord* record = FindSucceeded(CAPTURE_TAG_DXGI_VIDEO_MEMORY_INFO, memorySegmentGroup);
+    if(!record)
+        return false;
+    CaptureDataReader reader(record->m_Output, record->m_OutputSize);
+    return reader.ReadUint64(outVideoMemoryInfo.m_Budget) && reader.ReadUint64(outVideoMemoryInfo.m_CurrentUsage) &&
+        reader.ReadUint64(outVideoMemoryInfo.m_AvailableForReservation) &&
+        reader.ReadUint64(outVideoMemoryInfo.m_CurrentReservation) && reader.IsAtEnd();
+}
+
+bool CaptureSection::FindReport(CAPTURE_REPORT report, RecordingReportFormatter& outRecording) const
+{
+    const CaptureRecord* record = FindSucceeded(CAPTURE_TAG_REPORT, report);
+    if(!record)
+        return false;
+    std::istringstream stream(std::string((const char*)record->m_Output, record->m_OutputSize));
+    return outRecording.Load(stream);
+}
+
+CaptureStructCollection::CaptureStructCollection(const CaptureSection& global)
+{
+    // Enums first, as fields of structures point to them.
+    for(const CaptureRecord& record : global.m_Records)
+    {
+        if(record.m_Tag == CAPTURE_TAG_ENUM && record.m_Result >= 0)
+            LoadEnum(record);
+    }
+    for(const CaptureRecord& record : global.m_Records)
+    {
+        if(record.m_Tag == CAPTURE_TAG_STRUCT_DESC && record.m_Result >= 0)
+            LoadStruct(record);
+    }
+}
+
+const StructDesc* CaptureStructCollection::FindStruct(uint32_t structId) const
+{
+    const auto it = m_Structs.find(structId);
+    return it != m_Structs.end() ? &it->second->m_Desc : nullptr;
+}
+
+const EnumItem* CaptureStructCollection::FindEnum(std::wstring_view name) const
+{
+    const auto it = m_Enums.find(wstring(name));
+    return it != m_Enums.end() ? it->second->m_Items.data() : nullptr;
+}
+
+void CaptureStructCollection::LoadEnum(const CaptureRecord& record)
+{
+    CaptureDataReader reader(record.m_Output, record.m_OutputSize);
+    wstring name;
+    uint32_t itemCount = 0;
+    if(!reader.ReadString(name) || !reader.ReadUint32(itemCount) || itemCount > record.m_OutputSize / 8)
+        return;
+    auto enumData = std::make_unique<Enum>();
+    enumData->m_Names.resize(itemCount);
+    std::vector<uint32_t> values(itemCount);
+    for(uint32_t i = 0; i < itemCount; ++i)
+    {
+        if(!reader.ReadString(enumData->m_Names[i]) || !reader.ReadUint32(values[i]))
+            return;
+    }
+    if(!reader.IsAtEnd())
+        return;
+
+    // Terminated like the tables of EnumItems.hpp.
+    enumData->m_Items.reserve(itemCount + 1);
+    for(uint32_t i = 0; i < itemCount; ++i)
+        enumData->m_Items.push_back({ enumData->m_Names[i].c_str(), values[i] });
+    enumData->m_Items.push_back({ nullptr, UINT32_MAX });
+    m_Enums[name] = std::move(enumData);
+}
+
+void CaptureStructCollection::LoadStruct(const CaptureRecord& record)
+{
+    CaptureDataReader reader(record.m_Output, record.m_OutputSize);
+    auto structData = std::make_unique<Struct>();
+    uint32_t fieldCount = 0;
+    if(!reader.ReadString(structData->m_Name) || !reader.ReadUint32(fieldCount) ||
+        fieldCount > record.m_OutputSize / 16)
+    {
+        return;
+    }
+    structData->m_FieldNames.resize(fieldCount);
+    structData->m_Fields.resize(fieldCount);
+    for(uint32_t i = 0; i < fieldCount; ++i)
+    {
+        FieldDesc& field = structData->m_Fields[i];
+        uint32_t kind = 0;
+        wstring enumName;
+        if(!reader.ReadString(structData->m_FieldNames[i]) || !reader.ReadUint32(field.m_Offset) ||
+            !reader.ReadUint32(kind) || kind > FIELD_KIND_FLAGS || !reader.ReadString(enumName))
+        {
+            return;
+        }
+        field.m_Name = structData->m_FieldNames[i].c_str();
+        field.m_Kind = (FIELD_KIND)kind;
+        if(kind == FIELD_KIND_ENUM || kind == FIELD_KIND_ENUM_SIGNED || kind == FIELD_KIND_FLAGS)
+        {
+            // Without the table, printed as a number.
+            field.m_EnumItems = FindEnum(enumName);
+            if(!field.m_EnumItems)
+                field.m_EnumItems = EMPTY_ENUM_ITEMS;
+        }
+    }
+    if(!reader.IsAtEnd())
+        return;
+
+    structData->m_Desc = { structData->m_Name.c_str(), record.m_Key, structData->m_Fields.data(), fieldCount };
+    m_Structs[record.m_Key] = std::move(structData);
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path& filePath)
+{
+    const string pathStr = WstrToUtf8(filePath.wstring());
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        throw std::runtime_error(std::format("Could not open capture file \"{}\".", pathStr));
+    m_Data.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read((char*)m_Data.data(), (std::streamsize)m_Data.size());
+    if(!file)
+        throw std::runtime_error(std::format("Could not read capture file \"{}\".", pathStr));
+
+    CaptureDataReader reader(m_Data.data(), m_Data.size());
+    uint32_t magic = 0, version = 0;
+    if(!reader.ReadUint32(magic) || magic != CAPTURE_FILE_MAGIC || !reader.ReadUint32(version))
+        throw std::runtime_error("Invalid capture file.");
+    if(version != CAPTURE_FILE_VERSION)
+        throw std::runtime_error(std::format("Unsupported capture file version {}.", version));
+
+    CaptureSection* section = &m_Global;
+    while(!reader.IsAtEnd())
+    {
+        CaptureRecord record = {};
+        uint32_t tag = 0, result = 0;
+        if(!reader.ReadUint32(tag) || !reader.ReadUint32(record.m_Key) || !reader.ReadUint32(record.m_InputSize) ||
+            !reader.ReadUint32(record.m_OutputSize) || !reader.ReadUint32(result))
+        {
+            throw std::runtime_error("Capture file is truncated.");
+        }
+        record.m_Tag = (CAPTURE_TAG)tag;
+        record.m_Result = (int32_t)result;
+        record.m_Input = m_Data.data() + reader.GetOffset();
+        record.m_Output = record.m_Input + record.m_InputSize;
+        if(!reader.Skip((uint64_t)record.m_InputSize + record.m_OutputSize))
+            throw std::runtime_error("Capture file is truncated.");
+
+        if(record.m_Tag == CAPTURE_TAG_ADAPTER)
+        {
+            section = &m_Adapters.emplace_back();
+            section->m_AdapterIndex = record.m_Key;
+        }
+        else
+            section->AddRecord(record);
+    }
+}
+
+int32_t ReplayFeatureSupportSource::CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize)
+{
+    const CaptureRecord* record = m_Section.Find(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, feature, data, dataSize);
+    if(!record)
+        return RESULT_NOT_CAPTURED;
+    if(record->m_Result >= 0 && !record->CopyOutput(data, dataSize))
+        return RESULT_NOT_CAPTURED;
+    return record->m_Result;
+}
@@ -0,0 +1,278 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Binary capture of results of capability queries and of parts of the report printed from vendor libraries, written
+// with --Capture and read back with --Replay or by CaptureReplay. Depends only on the C++ standard library, so
+// captures can be read on any platform.
+
+#include "EnumItems.hpp"
+#include "FeatureQuery.hpp"
+#include "StructDesc.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RecordingReportFormatter;
+
+/*
+File format. All values are fixed-width and little-endian, and strings are UTF-16, so a capture doesn't depend on
+the platform that wrote it:
+
+    uint32_t magic = CAPTURE_FILE_MAGIC
+    uint32_t version = CAPTURE_FILE_VERSION
+    Records until the end of file:
+        uint32_t tag, key, inputSize, outputSize
+        int32_t result
+        uint8_t input[inputSize]
+        uint8_t output[outputSize]
+
+Records before the first CAPTURE_TAG_ADAPTER are global. Each CAPTURE_TAG_ADAPTER starts records of next adapter.
+
+Output of most records is a structure below, written member by member in order of declaration, with
+string = uint32_t length, char16_t characters[length]. Only input and output of CAPTURE_TAG_CHECK_FEATURE_SUPPORT are
+D3D12 structures as they are in memory. These are defined by D3D12 with UINT, BOOL and enum members on little-endian
+platforms. Pointers they contain are meaningless in the capture. D3d12info decodes them with its declarations of the
+structures. Global records CAPTURE_TAG_STRUCT_DESC and CAPTURE_TAG_ENUM describe the structures that have a
+StructDesc, so they can be decoded also without the declarations, e.g. by CaptureReplay on another platform:
+
+    CAPTURE_TAG_ENUM: string name, uint32_t itemCount, { string name, uint32_t value } items[itemCount]
+    CAPTURE_TAG_STRUCT_DESC: string name, uint32_t fieldCount,
+        { string name, uint32_t offset, uint32_t FIELD_KIND, string enumName (empty if none) } fields[fieldCount]
+*/
+static const uint32_t CAPTURE_FILE_MAGIC = 0x43323144; // "D12C"
+static const uint32_t CAPTURE_FILE_VERSION = 2;
+
+enum CAPTURE_TAG : uint32_t
+{
+    // key = adapter index. No data.
+    CAPTURE_TAG_ADAPTER = 1,
+    // key = D3D12_FEATURE. input = structure before the call, output = structure after the call.
+    CAPTURE_TAG_CHECK_FEATURE_SUPPORT,
+    // key = DXGI_FEATURE. output = uint32_t BOOL.
+    CAPTURE_TAG_DXGI_FEATURE,
+    // key = 0 for DXGI_ADAPTER_DESC, 1 for DXGI_ADAPTER_DESC1, etc. output = CaptureAdapterDesc.
+    CAPTURE_TAG_DXGI_ADAPTER_DESC,
+    // key = DXGI_MEMORY_SEGMENT_GROUP. output = CaptureVideoMemoryInfo.
+    CAPTURE_TAG_DXGI_VIDEO_MEMORY_INFO,
+    // output = uint64_t UMD version from IDXGIAdapter::CheckInterfaceSupport.
+    CAPTURE_TAG_DXGI_UMD_VERSION,
+    // key = D3D12_DESCRIPTOR_HEAP_TYPE. output = uint32_t.
+    CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE,
+    // output = ReportHeader.
+    CAPTURE_TAG_REPORT_HEADER,
+    // key = CAPTURE_REPORT. output = RecordingReportFormatter::Save.
+    CAPTURE_TAG_REPORT,
+    // key = index. Table of enum items used by CAPTURE_TAG_STRUCT_DESC or by DXGI structures.
+    CAPTURE_TAG_ENUM,
+    // key = StructDesc::m_Id, which is D3D12_FEATURE for structures of CheckFeatureSupport.
+    CAPTURE_TAG_STRUCT_DESC,
+};
+
+// Parts of the report recorded as printed, as they come from libraries that can't be called again on replay.
+enum CAPTURE_REPORT : uint32_t
+{
+    // Versions of vendor libraries, in the header of the report.
+    CAPTURE_REPORT_VENDOR_PARAMS = 1,
+    // Information from the OS, at the beginning of System Info.
+    CAPTURE_REPORT_OS_INFO,
+    // Rest of System Info after DXGI_FEATURE: data of vendor libraries, experimental features, translation layers.
+    CAPTURE_REPORT_SYSTEM_DATA,
+    // Data of vendor libraries about the adapter.
+    CAPTURE_REPORT_ADAPTER_VENDOR_DATA,
+    // Printed by AGS when it creates the device.
+    CAPTURE_REPORT_DEVICE_CREATION,
+    // Queries that need the device, not only CheckFeatureSupport of one structure, after the other features.
+    CAPTURE_REPORT_DEVICE_FEATURES,
+    // Printed after descriptor sizes: meta commands, NVAPI data of the device, translation layers.
+    CAPTURE_REPORT_DEVICE_DATA,
+};
+
+// Header of the report: the program that printed it and when.
+struct ReportHeader
+{
+    wstring m_ProgramVersion;
+    wstring m_BuildDate;
+    wstring m_Configuration;
+    wstring m_ConfigurationBits;
+    // "YYYY-MM-DD".
+    wstring m_GeneratedOn;
+    uint32_t m_D3D12SdkVersion = 0;
+    // Stored as uint32_t.
+    bool m_PreviewAgilitySdk = false;
+};
+
+// Members of DXGI_ADAPTER_DESC3. Older versions of the structure have only some of them.
+struct CaptureAdapterDesc
+{
+    wstring m_Description;
+    uint32_t m_VendorId = 0;
+    uint32_t m_DeviceId = 0;
+    uint32_t m_SubSysId = 0;
+    uint32_t m_Revision = 0;
+    uint64_t m_DedicatedVideoMemory = 0;
+    uint64_t m_DedicatedSystemMemory = 0;
+    uint64_t m_SharedSystemMemory = 0;
+    // HighPart in the upper 32 bits.
+    uint64_t m_AdapterLuid = 0;
+    uint32_t m_Flags = 0;
+    uint32_t m_GraphicsPreemptionGranularity = 0;
+    uint32_t m_ComputePreemptionGranularity = 0;
+};
+
+// Members of DXGI_QUERY_VIDEO_MEMORY_INFO.
+struct CaptureVideoMemoryInfo
+{
+    uint64_t m_Budget = 0;
+    uint64_t m_CurrentUsage = 0;
+    uint64_t m_AvailableForReservation = 0;
+    uint64_t m_CurrentReservation = 0;
+};
+
+class CaptureWriter
+{
+public:
+    // Throws on error.
+    CaptureWriter(const std::filesystem::path& filePath);
+
+    void BeginAdapter(uint32_t adapterIndex);
+    void AddRecord(CAPTURE_TAG tag, uint32_t key, const void* input, uint32_t inputSize, const void* output,
+        uint32_t outputSize, int32_t result);
+    void AddUint32(CAPTURE_TAG tag, uint32_t key, uint32_t value, int32_t result = 0);
+    void AddUint64(CAPTURE_TAG tag, uint32_t key, uint64_t value);
+    void AddReportHeader(const ReportHeader& header);
+    void AddAdapterDesc(uint32_t descVersion, const CaptureAdapterDesc& desc, int32_t result);
+    void AddVideoMemoryInfo(uint32_t memorySegmentGroup, const CaptureVideoMemoryInfo& videoMemoryInfo);
+    void AddReport(CAPTURE_REPORT report, const RecordingReportFormatter& recording);
+    void AddEnum(std::wstring_view name, const EnumItem* items);
+    // Adds all the structures, and the enums used by their fields, found by address in enums.
+    void AddStructDescs(const StructCollection& structs, const EnumCollection& enums);
+
+private:
+    std::ofstream m_File;
+    uint32_t m_EnumCount = 0;
+};
+
+struct CaptureRecord
+{
+    CAPTURE_TAG m_Tag = CAPTURE_TAG_ADAPTER;
+    uint32_t m_Key = 0;
+    uint32_t m_InputSize = 0;
+    uint32_t m_OutputSize = 0;
+    // HRESULT of the call.
+    int32_t m_Result = 0;
+    // Point to data of CaptureReader.
+    const uint8_t* m_Input = nullptr;
+    const uint8_t* m_Output = nullptr;
+
+    // Copies output to dst, zeroing the rest if the captured structure was smaller. Returns false if it was larger.
+    bool CopyOutput(void* dst, size_t dstSize) const;
+};
+
+// Records of one adapter or the global ones.
+class CaptureSection
+{
+public:
+    uint32_t m_AdapterIndex = UINT32_MAX;
+    std::vector<CaptureRecord> m_Records;
+
+    void AddRecord(const CaptureRecord& record);
+    bool Contains(CAPTURE_TAG tag, uint32_t key) const;
+    // Prefers the record with the same input. Otherwise takes the only record with this tag and key, as input may
+    // contain pointers that differ between runs. If not found, returns null.
+    const CaptureRecord* Find(
+        CAPTURE_TAG tag, uint32_t key, const void* input = nullptr, uint32_t inputSize = 0) const;
+
+    // Return false if not found, if the call failed, or if the data is not valid.
+    bool FindUint32(CAPTURE_TAG tag, uint32_t key, uint32_t& outValue) const;
+    bool FindUint64(CAPTURE_TAG tag, uint32_t key, uint64_t& outValue) const;
+    bool FindReportHeader(ReportHeader& outHeader) const;
+    bool FindAdapterDesc(uint32_t descVersion, CaptureAdapterDesc& outDesc) const;
+    bool FindVideoMemoryInfo(uint32_t memorySegmentGroup, CaptureVideoMemoryInfo& outVideoMemoryInfo) const;
+    bool FindReport(CAPTURE_REPORT report, RecordingReportFormatter& outRecording) const;
+
+private:
+    // Indices into m_Records by tag and key.
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_ByTagKey;
+
+    // Output of the record with this tag and key, if found and the call succeeded.
+    const CaptureRecord* FindSucceeded(CAPTURE_TAG tag, uint32_t key) const;
+};
+
+// Descriptors of structures and tables of enum items read from CAPTURE_TAG_STRUCT_DESC and CAPTURE_TAG_ENUM records,
+// with the names they point to. Invalid records are skipped.
+class CaptureStructCollection
+{
+public:
+    CaptureStructCollection(const CaptureSection& global);
+    CaptureStructCollection(const CaptureStructCollection&) = delete;
+    CaptureStructCollection& operator=(const CaptureStructCollection&) = delete;
+
+    // If not found, returns null.
+    const StructDesc* FindStruct(uint32_t structId) const;
+    const EnumItem* FindEnum(std::wstring_view name) const;
+
+private:
+    struct Enum
+    {
+        std::vector<wstring> m_Names;
+        std::vector<EnumItem> m_Items;
+    };
+    struct Struct
+    {
+        wstring m_Name;
+        std::vector<wstring> m_FieldNames;
+        std::vector<FieldDesc> m_Fields;
+        StructDesc m_Desc = {};
+    };
+
+    // Pointers to the names must stay valid, so these are not moved.
+    std::unordered_map<wstring, std::unique_ptr<Enum>> m_Enums;
+    std::unordered_map<uint32_t, std::unique_ptr<Struct>> m_Structs;
+
+    void LoadEnum(const CaptureRecord& record);
+    void LoadStruct(const CaptureRecord& record);
+};
+
+class CaptureReader
+{
+public:
+    // Throws on error.
+    CaptureReader(const std::filesystem::path& filePath);
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    const CaptureSection& GetGlobal() const { return m_Global; }
+    const std::vector<CaptureSection>& GetAdapters() const { return m_Adapters; }
+
+private:
+    std::vector<uint8_t> m_Data;
+    CaptureSection m_Global;
+    std::vector<CaptureSection> m_Adapters;
+};
+
+// Answers CheckFeatureSupport from CAPTURE_TAG_CHECK_FEATURE_SUPPORT records of one adapter.
+class ReplayFeatureSupportSource : public FeatureSupportSource
+{
+public:
+    ReplayFeatureSupportSource(const CaptureSection& section)
+        : m_Section(section)
+    {
+    }
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override;
+
+private:
+    const CaptureSection& m_Section;
+};
@@ -0,0 +1,137 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+/*
+Command-line tool that prints the report from a file written by D3d12info --Capture,
+on any machine and any platform, as it depends only on the C++ standard library.
+Without D3D12 headers, structures of DXGI are printed member by member with numbers
+in place of enums and flags, and results of CheckFeatureSupport as bytes. Parts of
+the report from vendor libraries and the OS are printed as D3d12info printed them.
+*/
+
+#include "Capture.hpp"
+#include "Printer.hpp"
+#include "Replay.hpp"
+#include "Utils.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+static void PrintCommandLineSyntax()
+{
+    // clang-format off
+    ErrorPrinter::PrintString(L"Prints the report from a capture file written by D3d12info --Capture.\n");
+    ErrorPrinter::PrintString(L"Options:\n");
+    ErrorPrinter::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
+    ErrorPrinter::PrintString(L"  -i --InputFile=<FilePath>        Capture file to read. Required.\n");
+    ErrorPrinter::PrintString(L"  -o --OutputFile=<FilePath>       Write the report to specified file instead of standard output.\n");
+    ErrorPrinter::PrintString(L"  -j --JSON                        Print the report in JSON format.\n");
+    // clang-format on
+}
+
+static int wmain2(int argc, wchar_t** argv)
+{
+    CmdLineParser cmdLineParser(argc, argv);
+
+    enum CMD_LINE_PARAM
+    {
+        CMD_LINE_OPT_HELP,
+        CMD_LINE_OPT_INPUT_FILE,
+        CMD_LINE_OPT_OUTPUT_FILE,
+        CMD_LINE_OPT_JSON,
+    };
+
+    // clang-format off
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,        L"Help",       false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,        L'h',          false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_INPUT_FILE,  L"InputFile",  true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_INPUT_FILE,  L'i',          true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_FILE, L"OutputFile", true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_FILE, L'o',          true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_JSON,        L"JSON",       false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_JSON,        L'j',          false);
+    // clang-format on
+
+    std::wstring inputFilePath, outputFilePath;
+    bool useJson = false;
+    CmdLineParser::RESULT cmdLineResult;
+    while((cmdLineResult = cmdLineParser.ReadNextOpt()) != CmdLineParser::RESULT_END)
+    {
+        if(cmdLineResult != CmdLineParser::RESULT_OPT)
+        {
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+        }
+        switch(cmdLineParser.GetOptId())
+        {
+        case CMD_LINE_OPT_HELP:
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_SUCCESS;
+        case CMD_LINE_OPT_INPUT_FILE:
+            inputFilePath = cmdLineParser.GetParameter();
+            break;
+        case CMD_LINE_OPT_OUTPUT_FILE:
+            outputFilePath = cmdLineParser.GetParameter();
+            break;
+        case CMD_LINE_OPT_JSON:
+            useJson = true;
+            break;
+        default:
+            assert(0);
+        }
+    }
+    if(inputFilePath.empty())
+    {
+        PrintCommandLineSyntax();
+        return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+    }
+
+    // Read before the output file is created, so an invalid capture doesn't leave an empty report.
+    const CaptureReader reader(inputFilePath);
+
+    PrinterScope printerScope(!outputFilePath.empty(), outputFilePath);
+    ReportFormatter::FLAGS flags = ReportFormatter::FLAGS::FLAG_NONE;
+    if(useJson)
+    {
+        flags |= ReportFormatter::FLAGS::FLAG_JSON;
+        flags |= ReportFormatter::FLAGS::FLAG_JSON_PRETTY_PRINT;
+    }
+    ReportFormatterScope formatterScope(flags);
+
+    RawReplayDecoder decoder(reader.GetGlobal());
+    ReplayCapture(reader, decoder, ReplayOptions{});
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+int wmain(int argc, wchar_t** argv)
+{
+    try
+    {
+        return wmain2(argc, argv);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+}
+
+#ifndef _WIN32
+
+// Other platforms pass arguments as UTF-8.
+int main(int argc, char** argv)
+{
+    std::vector<wstring> args((size_t)argc);
+    std::transform(argv, argv + argc, args.begin(), [](const char* arg) { return Utf8ToWstr(arg); });
+    std::vector<wchar_t*> argPtrs(args.size());
+    std::transform(args.begin(), args.end(), argPtrs.begin(), [](wstring& arg) { return arg.data(); });
+    return wmain(argc, argPtrs.data());
+}
+
+#endif
@@ -0,0 +1,966 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "D3D12Data.hpp"
+#include "Enums.hpp"
+#include "ParallelInspection.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "StructDesc.hpp"
+
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const D3D_ROOT_SIGNATURE_VERSION HIGHEST_ROOT_SIGNATURE_VERSION = D3D_ROOT_SIGNATURE_VERSION_1_2;
+static const D3D_FEATURE_LEVEL FEATURE_LEVELS_ARRAY[] = {
+    D3D_FEATURE_LEVEL_12_2,
+    D3D_FEATURE_LEVEL_12_1,
+    D3D_FEATURE_LEVEL_12_0,
+    D3D_FEATURE_LEVEL_11_1,
+    D3D_FEATURE_LEVEL_11_0,
+};
+static const D3D_FEATURE_LEVEL MAX_FEATURE_LEVEL = D3D_FEATURE_LEVEL_12_2;
+
+static wstring LuidToStr(LUID value)
+{
+    wchar_t s[64];
+    swprintf_s(s, L"%08X-%08X", (uint32_t)value.HighPart, (uint32_t)value.LowPart);
+    return wstring{ s };
+}
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS)
+    STRUCT_FIELD(BOOL, DoublePrecisionFloatShaderOps)
+    STRUCT_FIELD(BOOL, OutputMergerLogicOp)
+    STRUCT_FIELD_ENUM(ENUM, MinPrecisionSupport, D3D12_SHADER_MIN_PRECISION_SUPPORT)
+    STRUCT_FIELD_ENUM(ENUM, TiledResourcesTier, D3D12_TILED_RESOURCES_TIER)
+    STRUCT_FIELD_ENUM(ENUM, ResourceBindingTier, D3D12_RESOURCE_BINDING_TIER)
+    STRUCT_FIELD(BOOL, PSSpecifiedStencilRefSupported)
+    STRUCT_FIELD(BOOL, TypedUAVLoadAdditionalFormats)
+    STRUCT_FIELD(BOOL, ROVsSupported)
+    STRUCT_FIELD_ENUM(ENUM, ConservativeRasterizationTier, D3D12_CONSERVATIVE_RASTERIZATION_TIER)
+    STRUCT_FIELD(UINT32, MaxGPUVirtualAddressBitsPerResource)
+    STRUCT_FIELD(BOOL, StandardSwizzle64KBSupported)
+    STRUCT_FIELD_ENUM(ENUM, CrossNodeSharingTier, D3D12_CROSS_NODE_SHARING_TIER)
+    STRUCT_FIELD(BOOL, CrossAdapterRowMajorTextureSupported)
+    STRUCT_FIELD(BOOL, VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation)
+    STRUCT_FIELD_ENUM(ENUM, ResourceHeapTier, D3D12_RESOURCE_HEAP_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS, D3D12_FEATURE_D3D12_OPTIONS)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_ARCHITECTURE)
+    STRUCT_FIELD(UINT32, NodeIndex)
+    STRUCT_FIELD(BOOL, TileBasedRenderer)
+    STRUCT_FIELD(BOOL, UMA)
+    STRUCT_FIELD(BOOL, CacheCoherentUMA)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_ARCHITECTURE, D3D12_FEATURE_ARCHITECTURE)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_ARCHITECTURE1)
+    STRUCT_FIELD(UINT32, NodeIndex)
+    STRUCT_FIELD(BOOL, TileBasedRenderer)
+    STRUCT_FIELD(BOOL, UMA)
+    STRUCT_FIELD(BOOL, CacheCoherentUMA)
+    STRUCT_FIELD(BOOL, IsolatedMMU)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_ARCHITECTURE1, D3D12_FEATURE_ARCHITECTURE1)
+
+// NumFeatureLevels and pFeatureLevelsRequested are IN parameters
+// They let the app to specify what enum values does the app expect
+// So same API can be used when new feature levels are added in the future
+// No need to print those IN parameters here
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_FEATURE_LEVELS)
+    STRUCT_FIELD_ENUM(ENUM, MaxSupportedFeatureLevel, D3D_FEATURE_LEVEL)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_FEATURE_LEVELS, D3D12_FEATURE_FEATURE_LEVELS)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT)
+    STRUCT_FIELD(UINT32, MaxGPUVirtualAddressBitsPerResource)
+    STRUCT_FIELD(UINT32, MaxGPUVirtualAddressBitsPerProcess)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT, D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_SHADER_MODEL)
+    STRUCT_FIELD_ENUM(ENUM, HighestShaderModel, D3D_SHADER_MODEL)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_SHADER_MODEL, D3D12_FEATURE_SHADER_MODEL)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS1)
+    STRUCT_FIELD(BOOL, WaveOps)
+    STRUCT_FIELD(UINT32, WaveLaneCountMin)
+    STRUCT_FIELD(UINT32, WaveLaneCountMax)
+    STRUCT_FIELD(UINT32, TotalLaneCount)
+    STRUCT_FIELD(BOOL, ExpandedComputeResourceStates)
+    STRUCT_FIELD(BOOL, Int64ShaderOps)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS1, D3D12_FEATURE_D3D12_OPTIONS1)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_ROOT_SIGNATURE)
+    STRUCT_FIELD_ENUM(ENUM, HighestVersion, D3D_ROOT_SIGNATURE_VERSION)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_ROOT_SIGNATURE, D3D12_FEATURE_ROOT_SIGNATURE)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS2)
+    STRUCT_FIELD(BOOL, DepthBoundsTestSupported)
+    STRUCT_FIELD_ENUM(ENUM, ProgrammableSamplePositionsTier, D3D12_PROGRAMMABLE_SAMPLE_POSITIONS_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS2, D3D12_FEATURE_D3D12_OPTIONS2)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_SHADER_CACHE)
+    STRUCT_FIELD_ENUM(FLAGS, SupportFlags, D3D12_SHADER_CACHE_SUPPORT_FLAGS)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_SHADER_CACHE, D3D12_FEATURE_SHADER_CACHE)
+
+static void Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(const std::array<bool, 9>& commandQueuePriority)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY");
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[0]);
+    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[1]);
+    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[2]);
+    formatter.AddFieldBool(L"TYPE_COMPUTE.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[3]);
+    formatter.AddFieldBool(L"TYPE_COMPUTE.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[4]);
+    formatter.AddFieldBool(
+        L"TYPE_COMPUTE.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[5]);
+    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[6]);
+    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[7]);
+    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[8]);
+}
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_SERIALIZATION)
+    STRUCT_FIELD_ENUM(ENUM, HeapSerializationTier, D3D12_HEAP_SERIALIZATION_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_SERIALIZATION, D3D12_FEATURE_SERIALIZATION)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_CROSS_NODE)
+    STRUCT_FIELD_ENUM(ENUM, SharingTier, D3D12_CROSS_NODE_SHARING_TIER)
+    STRUCT_FIELD(BOOL, AtomicShaderInstructions)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_CROSS_NODE, D3D12_FEATURE_CROSS_NODE)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_PREDICATION)
+    STRUCT_FIELD(BOOL, Supported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_PREDICATION, D3D12_FEATURE_PREDICATION)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_HARDWARE_COPY)
+    STRUCT_FIELD(BOOL, Supported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_HARDWARE_COPY, D3D12_FEATURE_HARDWARE_COPY)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE)
+    STRUCT_FIELD(BOOL, Supported)
+STRUCT_DESC_END(
+    D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE, D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS3)
+    STRUCT_FIELD(BOOL, CopyQueueTimestampQueriesSupported)
+    STRUCT_FIELD(BOOL, CastingFullyTypedFormatSupported)
+    STRUCT_FIELD_ENUM(FLAGS, WriteBufferImmediateSupportFlags, D3D12_COMMAND_LIST_SUPPORT_FLAGS)
+    STRUCT_FIELD_ENUM(ENUM, ViewInstancingTier, D3D12_VIEW_INSTANCING_TIER)
+    STRUCT_FIELD(BOOL, BarycentricsSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS3, D3D12_FEATURE_D3D12_OPTIONS3)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS4)
+    STRUCT_FIELD(BOOL, MSAA64KBAlignedTextureSupported)
+    STRUCT_FIELD_ENUM(ENUM, SharedResourceCompatibilityTier, D3D12_SHARED_RESOURCE_COMPATIBILITY_TIER)
+    STRUCT_FIELD(BOOL, Native16BitShaderOpsSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS4, D3D12_FEATURE_D3D12_OPTIONS4)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS5)
+    STRUCT_FIELD(BOOL, SRVOnlyTiledResourceTier3)
+    STRUCT_FIELD_ENUM(ENUM, RenderPassesTier, D3D12_RENDER_PASS_TIER)
+    STRUCT_FIELD_ENUM(ENUM, RaytracingTier, D3D12_RAYTRACING_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS5, D3D12_FEATURE_D3D12_OPTIONS5)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS6)
+    STRUCT_FIELD(BOOL, AdditionalShadingRatesSupported)
+    STRUCT_FIELD(BOOL, PerPrimitiveShadingRateSupportedWithViewportIndexing)
+    STRUCT_FIELD_ENUM(ENUM, VariableShadingRateTier, D3D12_VARIABLE_SHADING_RATE_TIER)
+    STRUCT_FIELD(UINT32, ShadingRateImageTileSize)
+    STRUCT_FIELD(BOOL, BackgroundProcessingSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS6, D3D12_FEATURE_D3D12_OPTIONS6)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS7)
+    STRUCT_FIELD_ENUM(ENUM, MeshShaderTier, D3D12_MESH_SHADER_TIER)
+    STRUCT_FIELD_ENUM(ENUM, SamplerFeedbackTier, D3D12_SAMPLER_FEEDBACK_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS7, D3D12_FEATURE_D3D12_OPTIONS7)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS8)
+    STRUCT_FIELD(BOOL, UnalignedBlockTexturesSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS8, D3D12_FEATURE_D3D12_OPTIONS8)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS9)
+    STRUCT_FIELD(BOOL, MeshShaderPipelineStatsSupported)
+    STRUCT_FIELD(BOOL, MeshShaderSupportsFullRangeRenderTargetArrayIndex)
+    STRUCT_FIELD(BOOL, AtomicInt64OnTypedResourceSupported)
+    STRUCT_FIELD(BOOL, AtomicInt64OnGroupSharedSupported)
+    STRUCT_FIELD(BOOL, DerivativesInMeshAndAmplificationShadersSupported)
+    STRUCT_FIELD_ENUM(ENUM, WaveMMATier, D3D12_WAVE_MMA_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS9, D3D12_FEATURE_D3D12_OPTIONS9)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS10)
+    STRUCT_FIELD(BOOL, VariableRateShadingSumCombinerSupported)
+    STRUCT_FIELD(BOOL, MeshShaderPerPrimitiveShadingRateSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS10, D3D12_FEATURE_D3D12_OPTIONS10)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS11)
+    STRUCT_FIELD(BOOL, AtomicInt64OnDescriptorHeapResourceSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS11, D3D12_FEATURE_D3D12_OPTIONS11)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS12)
+    STRUCT_FIELD_ENUM(ENUM_SIGNED, MSPrimitivesPipelineStatisticIncludesCulledPrimitives, D3D12_TRI_STATE)
+    STRUCT_FIELD(BOOL, EnhancedBarriersSupported)
+    STRUCT_FIELD(BOOL, RelaxedFormatCastingSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS12, D3D12_FEATURE_D3D12_OPTIONS12)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS13)
+    STRUCT_FIELD(BOOL, UnrestrictedBufferTextureCopyPitchSupported)
+    STRUCT_FIELD(BOOL, UnrestrictedVertexElementAlignmentSupported)
+    STRUCT_FIELD(BOOL, InvertedViewportHeightFlipsYSupported)
+    STRUCT_FIELD(BOOL, InvertedViewportDepthFlipsZSupported)
+    STRUCT_FIELD(BOOL, TextureCopyBetweenDimensionsSupported)
+    STRUCT_FIELD(BOOL, AlphaBlendFactorSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS13, D3D12_FEATURE_D3D12_OPTIONS13)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS14)
+    STRUCT_FIELD(BOOL, AdvancedTextureOpsSupported)
+    STRUCT_FIELD(BOOL, WriteableMSAATexturesSupported)
+    STRUCT_FIELD(BOOL, IndependentFrontAndBackStencilRefMaskSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS14, D3D12_FEATURE_D3D12_OPTIONS14)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS15)
+    STRUCT_FIELD(BOOL, TriangleFanSupported)
+    STRUCT_FIELD(BOOL, DynamicIndexBufferStripCutSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS15, D3D12_FEATURE_D3D12_OPTIONS15)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS16)
+    STRUCT_FIELD(BOOL, DynamicDepthBiasSupported)
+    STRUCT_FIELD(BOOL, GPUUploadHeapSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS16, D3D12_FEATURE_D3D12_OPTIONS16)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS17)
+    STRUCT_FIELD(BOOL, NonNormalizedCoordinateSamplersSupported)
+    STRUCT_FIELD(BOOL, ManualWriteTrackingResourceSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS17, D3D12_FEATURE_D3D12_OPTIONS17)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS18)
+    STRUCT_FIELD(BOOL, RenderPassesValid)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS18, D3D12_FEATURE_D3D12_OPTIONS18)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS19)
+    STRUCT_FIELD(BOOL, MismatchingOutputDimensionsSupported)
+    STRUCT_FIELD(UINT32, SupportedSampleCountsWithNoOutputs)
+    STRUCT_FIELD(BOOL, PointSamplingAddressesNeverRoundUp)
+    STRUCT_FIELD(BOOL, RasterizerDesc2Supported)
+    STRUCT_FIELD(BOOL, NarrowQuadrilateralLinesSupported)
+    STRUCT_FIELD(BOOL, AnisoFilterWithPointMipSupported)
+    STRUCT_FIELD(UINT32, MaxSamplerDescriptorHeapSize)
+    STRUCT_FIELD(UINT32, MaxSamplerDescriptorHeapSizeWithStaticSamplers)
+    STRUCT_FIELD(UINT32, MaxViewDescriptorHeapSize)
+    STRUCT_FIELD(BOOL, ComputeOnlyCustomHeapSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS19, D3D12_FEATURE_D3D12_OPTIONS19)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS20)
+    STRUCT_FIELD(BOOL, ComputeOnlyWriteWatchSupported)
+    STRUCT_FIELD_ENUM(ENUM, RecreateAtTier, D3D12_RECREATE_AT_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS20, D3D12_FEATURE_D3D12_OPTIONS20)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS21)
+    STRUCT_FIELD_ENUM(ENUM, WorkGraphsTier, D3D12_WORK_GRAPHS_TIER)
+    STRUCT_FIELD_ENUM(ENUM, ExecuteIndirectTier, D3D12_EXECUTE_INDIRECT_TIER)
+    STRUCT_FIELD(BOOL, SampleCmpGradientAndBiasSupported)
+    STRUCT_FIELD(BOOL, ExtendedCommandInfoSupported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS21, D3D12_FEATURE_D3D12_OPTIONS21)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED)
+    STRUCT_FIELD(BOOL, Supported)
+STRUCT_DESC_END(
+    D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED, D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_TIGHT_ALIGNMENT)
+    STRUCT_FIELD_ENUM(ENUM, SupportTier, D3D12_TIGHT_ALIGNMENT_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_TIGHT_ALIGNMENT, D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT)
+
+#ifndef USE_PREVIEW_AGILITY_SDK
+static void Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(
+    const D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT & shaderCacheABISupport)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT");
+    ReportFormatter::GetInstance().AddFieldString(L"szAdapterFamily", shaderCacheABISupport.szAdapterFamily);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"MinimumABISupportVersion", shaderCacheABISupport.MinimumABISupportVersion);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"MaximumABISupportVersion", shaderCacheABISupport.MaximumABISupportVersion);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"CompilerVersion", shaderCacheABISupport.CompilerVersion.Version);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"ApplicationProfileVersion", shaderCacheABISupport.ApplicationProfileVersion.Version);
+}
+#endif
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL)
+    STRUCT_FIELD_ENUM(ENUM, CooperativeVectorTier, D3D12_COOPERATIVE_VECTOR_TIER)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL, D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL)
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS)
+    STRUCT_FIELD(UINT32, ComputeQueuesPer3DQueue)
+STRUCT_DESC_END(
+    D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS)
+
+STRUCT_DESC_BEGIN(D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL)
+    STRUCT_FIELD_ENUM(ENUM, InputType, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD_ENUM(ENUM, InputInterpretation, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD_ENUM(ENUM, MatrixInterpretation, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD_ENUM(ENUM, BiasInterpretation, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD_ENUM(ENUM, OutputType, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD(BOOL, TransposeSupported)
+STRUCT_DESC_END(D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL, STRUCT_ID_OTHER_FIRST + 1)
+
+STRUCT_DESC_BEGIN(D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE)
+    STRUCT_FIELD_ENUM(ENUM, InputType, D3D12_LINEAR_ALGEBRA_DATATYPE)
+    STRUCT_FIELD_ENUM(ENUM, AccumulationType, D3D12_LINEAR_ALGEBRA_DATATYPE)
+STRUCT_DESC_END(D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE, STRUCT_ID_OTHER_FIRST + 2)
+#endif // #ifdef USE_PREVIEW_AGILITY_SDK
+
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_EXISTING_HEAPS)
+    STRUCT_FIELD(BOOL, Supported)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_EXISTING_HEAPS, D3D12_FEATURE_EXISTING_HEAPS)
+
+// Not printing CurrentUsage, CurrentReservation.
+STRUCT_DESC_BEGIN(DXGI_QUERY_VIDEO_MEMORY_INFO)
+    STRUCT_FIELD(SIZE, Budget)
+    STRUCT_FIELD(SIZE, AvailableForReservation)
+STRUCT_DESC_END(DXGI_QUERY_VIDEO_MEMORY_INFO, STRUCT_ID_OTHER_FIRST)
+
+static void PrintAdapterDescMembers(const DXGI_ADAPTER_DESC& desc)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldString(L"Description", desc.Description);
+    formatter.AddFieldVendorId(L"VendorId", desc.VendorId);
+    formatter.AddFieldHex32(L"DeviceId", desc.DeviceId);
+    formatter.AddFieldSubsystemId(L"SubSysId", desc.SubSysId);
+    formatter.AddFieldHex32(L"Revision", desc.Revision);
+    formatter.AddFieldSize(L"DedicatedVideoMemory", desc.DedicatedVideoMemory);
+    formatter.AddFieldSize(L"DedicatedSystemMemory", desc.DedicatedSystemMemory);
+    formatter.AddFieldSize(L"SharedSystemMemory", desc.SharedSystemMemory);
+    formatter.AddFieldString(L"AdapterLuid", LuidToStr(desc.AdapterLuid).c_str());
+}
+
+static void PrintAdapterDesc1Members(const DXGI_ADAPTER_DESC1& desc1)
+{
+    PrintAdapterDescMembers((const DXGI_ADAPTER_DESC&)desc1);
+    ReportFormatter::GetInstance().AddFieldFlags(L"Flags", desc1.Flags, Enum_DXGI_ADAPTER_FLAG);
+}
+
+static void PrintAdapterDesc2Members(const DXGI_ADAPTER_DESC2& desc2)
+{
+    PrintAdapterDesc1Members((const DXGI_ADAPTER_DESC1&)desc2);
+    ReportFormatter::GetInstance().AddFieldEnum(L"GraphicsPreemptionGranularity", desc2.GraphicsPreemptionGranularity,
+        Enum_DXGI_GRAPHICS_PREEMPTION_GRANULARITY);
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"ComputePreemptionGranularity", desc2.ComputePreemptionGranularity, Enum_DXGI_COMPUTE_PREEMPTION_GRANULARITY);
+}
+
+static void PrintAdapterDesc(const DXGI_ADAPTER_DESC& desc)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC");
+    PrintAdapterDescMembers(desc);
+}
+
+static void PrintAdapterDesc1(const DXGI_ADAPTER_DESC1& desc1)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC1");
+    PrintAdapterDesc1Members(desc1);
+}
+
+static void PrintAdapterDesc2(const DXGI_ADAPTER_DESC2& desc2)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC2");
+    PrintAdapterDesc2Members(desc2);
+}
+
+static void PrintAdapterDesc3(const DXGI_ADAPTER_DESC3& desc3)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC3");
+    // Same members as DESC2. They only added new items to Flags.
+    PrintAdapterDesc2Members((const DXGI_ADAPTER_DESC2&)desc3);
+}
+
+/*
+Microsoft documentation says:
+
+ID3D12Device::CheckFeatureSupport returns E_INVALIDARG if HighestShaderModel
+isn't known by the current runtime. For that reason, we recommend that you call
+this in a loop with decreasing shader models to determine the highest supported
+shader model.
+*/
+static bool QueryShaderModel(FeatureSupportSource& source, D3D12_FEATURE_DATA_SHADER_MODEL& shaderModel)
+{
+    for(size_t enumItemIndex = _countof(Enum_D3D_SHADER_MODEL) - 1; enumItemIndex--;)
+    {
+        shaderModel.HighestShaderModel = D3D_SHADER_MODEL(Enum_D3D_SHADER_MODEL[enumItemIndex].m_Value);
+        if(source.CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel)))
+            return true;
+    }
+    return false;
+}
+
+static void InitRootSignature(D3D12_FEATURE_DATA_ROOT_SIGNATURE& rootSignature)
+{
+    rootSignature.HighestVersion = HIGHEST_ROOT_SIGNATURE_VERSION;
+}
+
+static void InitFeatureLevels(D3D12_FEATURE_DATA_FEATURE_LEVELS& featureLevels)
+{
+    featureLevels = { _countof(FEATURE_LEVELS_ARRAY), FEATURE_LEVELS_ARRAY, MAX_FEATURE_LEVEL };
+}
+
+static bool QueryCommandQueuePriorities(FeatureSupportSource& source, std::array<bool, 9>& queuePrioritySupport)
+{
+    D3D12_COMMAND_LIST_TYPE cmdListTypes[] = { D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_TYPE_COMPUTE,
+        D3D12_COMMAND_LIST_TYPE_COPY };
+
+    D3D12_COMMAND_QUEUE_PRIORITY cmdQueuePriorities[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
+        D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
+
+    size_t queuePriorityIndex = 0;
+    for(auto cmdListType : cmdListTypes)
+    {
+        for(auto cmdQueuePriority : cmdQueuePriorities)
+        {
+            D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY commandQueuePriority = {};
+            commandQueuePriority.CommandListType = cmdListType;
+            commandQueuePriority.Priority = cmdQueuePriority;
+            if(!source.CheckFeatureSupport(
+                   D3D12_FEATURE_COMMAND_QUEUE_PRIORITY, &commandQueuePriority, sizeof(commandQueuePriority)))
+                return false;
+
+            queuePrioritySupport[queuePriorityIndex++] = commandQueuePriority.PriorityForTypeIsSupported;
+        }
+    }
+    return true;
+}
+
+// Function Print_<Name> prints a scope <Name>.
+static constexpr const wchar_t* GetPrintedScopeName(const wchar_t* printName)
+{
+    return printName + std::size(L"Print_") - 1;
+}
+
+#define FEATURE_QUERY(feature, print) \
+    MakeFeatureQuery<print>(feature, L"" #feature, GetPrintedScopeName(L"" #print))
+#define FEATURE_QUERY_EX(feature, print, init, query, flags) \
+    MakeFeatureQuery<print, init, query>(feature, L"" #feature, GetPrintedScopeName(L"" #print), flags)
+
+// Queries of ID3D12Device::CheckFeatureSupport for each adapter, in order of printing.
+static const FeatureQueryDesc DEVICE_FEATURE_QUERIES[] = {
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS),
+    FEATURE_QUERY(D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT, Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT),
+    FEATURE_QUERY_EX(D3D12_FEATURE_SHADER_MODEL, Print_D3D12_FEATURE_DATA_SHADER_MODEL, nullptr, QueryShaderModel,
+        FEATURE_QUERY_FLAG_NONE),
+    FEATURE_QUERY_EX(D3D12_FEATURE_ROOT_SIGNATURE, Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE, InitRootSignature,
+        nullptr, FEATURE_QUERY_FLAG_NONE),
+    FEATURE_QUERY(D3D12_FEATURE_ARCHITECTURE1, Print_D3D12_FEATURE_DATA_ARCHITECTURE1),
+    FEATURE_QUERY_EX(D3D12_FEATURE_ARCHITECTURE, Print_D3D12_FEATURE_DATA_ARCHITECTURE, nullptr, nullptr,
+        FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED),
+    FEATURE_QUERY_EX(D3D12_FEATURE_FEATURE_LEVELS, Print_D3D12_FEATURE_DATA_FEATURE_LEVELS, InitFeatureLevels,
+        nullptr, FEATURE_QUERY_FLAG_NONE),
+    FEATURE_QUERY(D3D12_FEATURE_SHADER_CACHE, Print_D3D12_FEATURE_DATA_SHADER_CACHE),
+    FEATURE_QUERY_EX(D3D12_FEATURE_COMMAND_QUEUE_PRIORITY, Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY, nullptr,
+        QueryCommandQueuePriorities, FEATURE_QUERY_FLAG_NONE),
+    FEATURE_QUERY(D3D12_FEATURE_SERIALIZATION, Print_D3D12_FEATURE_DATA_SERIALIZATION),
+    FEATURE_QUERY(D3D12_FEATURE_CROSS_NODE, Print_D3D12_FEATURE_DATA_CROSS_NODE),
+    FEATURE_QUERY(D3D12_FEATURE_PREDICATION, Print_D3D12_FEATURE_DATA_PREDICATION),
+    FEATURE_QUERY(D3D12_FEATURE_HARDWARE_COPY, Print_D3D12_FEATURE_DATA_HARDWARE_COPY),
+    FEATURE_QUERY(
+        D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE, Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE),
+
+    // TODO: In Agility SDK 1.715.0-preview how to query for D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL1?
+    // What is the corresponding structure?
+
+    // TODO: D3D12_FEATURE_PLACED_RESOURCE_SUPPORT_INFO - What is this? How to query it? What structure to use?
+
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS1, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS2, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS3, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3),
+    FEATURE_QUERY(D3D12_FEATURE_EXISTING_HEAPS, Print_D3D12_FEATURE_DATA_EXISTING_HEAPS),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS4, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS5, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS6, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS7, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS8, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS9, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS10, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS11, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS12, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS13, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS14, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS15, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS16, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS17, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS18, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS19, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS20, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS21, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21),
+    FEATURE_QUERY(
+        D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED, Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT),
+#ifndef USE_PREVIEW_AGILITY_SDK
+    FEATURE_QUERY(D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT),
+#endif
+#ifdef USE_PREVIEW_AGILITY_SDK
+    FEATURE_QUERY(D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS,
+        Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS),
+    FEATURE_QUERY(D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL),
+#endif
+};
+
+#undef FEATURE_QUERY
+#undef FEATURE_QUERY_EX
+
+// Described only for --Require, as formats are printed by PrintFormatInformation and PrintFormatMatrix.
+STRUCT_DESC_BEGIN(D3D12_FEATURE_DATA_FORMAT_SUPPORT)
+    STRUCT_FIELD_ENUM(ENUM, Format, DXGI_FORMAT)
+    STRUCT_FIELD_ENUM(FLAGS, Support1, D3D12_FORMAT_SUPPORT1)
+    STRUCT_FIELD_ENUM(FLAGS, Support2, D3D12_FORMAT_SUPPORT2)
+STRUCT_DESC_END(D3D12_FEATURE_DATA_FORMAT_SUPPORT, D3D12_FEATURE_FORMAT_SUPPORT)
+static_assert(offsetof(D3D12_FEATURE_DATA_FORMAT_SUPPORT, Format) == 0, "Format is set as the first member.");
+
+static const FeatureQueryDesc FORMAT_SUPPORT_QUERY = FEATURE_QUERY(
+    D3D12_FEATURE_FORMAT_SUPPORT, Print_D3D12_FEATURE_DATA_FORMAT_SUPPORT);
+
+static const wchar_t* const DESCRIPTOR_HEAP_TYPE_NAMES[] = { L"D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV",
+    L"D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER", L"D3D12_DESCRIPTOR_HEAP_TYPE_RTV", L"D3D12_DESCRIPTOR_HEAP_TYPE_DSV" };
+static_assert(_countof(DESCRIPTOR_HEAP_TYPE_NAMES) == D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES);
+
+// Results of queries about one format. All formats are queried before any is printed, so they can be queried in
+// parallel.
+struct FormatQueryResult
+{
+    int32_t m_FormatSupportResult = E_FAIL;
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT m_FormatSupport = {};
+    // Sample counts 1, 2, 4... until the first one not supported.
+    std::vector<D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS> m_MsQualityLevels;
+    bool m_FormatInfoSucceeded = false;
+    D3D12_FEATURE_DATA_FORMAT_INFO m_FormatInfo = {};
+};
+
+static void QueryFormat(FeatureSupportSource& source, DXGI_FORMAT format, FormatQueryResult& outResult)
+{
+    outResult.m_FormatSupport.Format = format;
+    outResult.m_FormatSupportResult = source.CheckFeatureSupportResult(
+        D3D12_FEATURE_FORMAT_SUPPORT, &outResult.m_FormatSupport, UINT(sizeof outResult.m_FormatSupport));
+    if(outResult.m_FormatSupportResult == FEATURE_SUPPORT_RESULT_CRASHED)
+        return;
+
+    if(SUCCEEDED(outResult.m_FormatSupportResult))
+    {
+        D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS msQualityLevels = {};
+        msQualityLevels.Format = format;
+        for(msQualityLevels.SampleCount = 1;; msQualityLevels.SampleCount *= 2)
+        {
+            if(source.CheckFeatureSupport(
+                   D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS, &msQualityLevels, UINT(sizeof msQualityLevels)) &&
+                msQualityLevels.NumQualityLevels > 0)
+                outResult.m_MsQualityLevels.push_back(msQualityLevels);
+            else
+                break;
+        }
+    }
+
+    outResult.m_FormatInfo.Format = format;
+    outResult.m_FormatInfoSucceeded = source.CheckFeatureSupport(
+        D3D12_FEATURE_FORMAT_INFO, &outResult.m_FormatInfo, UINT(sizeof outResult.m_FormatInfo));
+}
+
+static const size_t FORMAT_COUNT = _countof(Enum_DXGI_FORMAT) - 1;
+
+// Formats whose scope inside the one at scopePath could be printed, as told by IsReportScopeNeeded, e.g. only
+// DXGI_FORMAT_BC* with --Select=Formats.DXGI_FORMAT_BC*. Must be called on the thread printing the report.
+static std::vector<bool> FindNeededFormats(std::wstring_view scopePath)
+{
+    std::vector<bool> needed(FORMAT_COUNT);
+    for(size_t formatIndex = 0; formatIndex < FORMAT_COUNT; ++formatIndex)
+    {
+        const EnumItem& item = Enum_DXGI_FORMAT[formatIndex];
+        needed[formatIndex] = IsReportScopeNeeded(
+            std::format(L"{}.{}", scopePath, SelectString(item.m_Name, std::format(L"{}", item.m_Value))));
+    }
+    return needed;
+}
+
+// Queries all formats of Enum_DXGI_FORMAT, in parallel if the source allows it. Returns the number of formats to
+// print: formats after the first one that crashed are skipped, as the driver may be left in a bad state. Formats not
+// needed are not queried, so their results stay failed.
+static size_t QueryAllFormats(
+    FeatureSupportSource& source, const std::vector<bool>& formatsNeeded, std::vector<FormatQueryResult>& outResults)
+{
+    const size_t formatCount = FORMAT_COUNT;
+    assert(formatsNeeded.size() == formatCount);
+    outResults.resize(formatCount);
+    std::atomic<size_t> crashedFormatIndex = SIZE_MAX;
+    auto queryFormat = [&](size_t formatIndex) {
+        if(formatIndex > crashedFormatIndex || !formatsNeeded[formatIndex])
+            return;
+        QueryFormat(source, (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value, outResults[formatIndex]);
+        if(outResults[formatIndex].m_FormatSupportResult == FEATURE_SUPPORT_RESULT_CRASHED)
+        {
+            size_t prevCrashedFormatIndex = crashedFormatIndex;
+            while(formatIndex < prevCrashedFormatIndex &&
+                !crashedFormatIndex.compare_exchange_weak(prevCrashedFormatIndex, formatIndex))
+            {
+            }
+        }
+    };
+    if(source.ShouldQueryInParallel())
+        ParallelFor(formatCount, queryFormat);
+    else
+    {
+        for(size_t formatIndex = 0; formatIndex < formatCount; ++formatIndex)
+            queryFormat(formatIndex);
+    }
+
+    if(crashedFormatIndex == SIZE_MAX)
+        return formatCount;
+    ErrorPrinter::PrintFormat(L"ERROR: ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, {}) crashed.\n",
+        std::make_wformat_args(Enum_DXGI_FORMAT[crashedFormatIndex].m_Name));
+    return crashedFormatIndex;
+}
+
+// Scope of the format, only if any query succeeded.
+static void PrintFormatQueryResult(size_t formatIndex, const FormatQueryResult& result)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    const DXGI_FORMAT format = (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value;
+    const wchar_t* name = Enum_DXGI_FORMAT[formatIndex].m_Name;
+
+    ReportScopeObjectConditional scope(SelectString(name, std::format(L"{}", (size_t)format)));
+
+    if(SUCCEEDED(result.m_FormatSupportResult))
+    {
+        scope.Enable();
+        formatter.AddFieldFlags(L"Support1", result.m_FormatSupport.Support1, Enum_D3D12_FORMAT_SUPPORT1);
+        formatter.AddFieldFlags(L"Support2", result.m_FormatSupport.Support2, Enum_D3D12_FORMAT_SUPPORT2);
+
+        ReportScopeObjectConditional scope2(IsJsonOutput(), L"MultisampleQualityLevels");
+        for(const D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS& msQualityLevels : result.m_MsQualityLevels)
+        {
+            if(IsJsonOutput())
+            {
+                ReportScopeObject scope3(std::format(L"{}", msQualityLevels.SampleCount));
+                formatter.AddFieldUint32(L"NumQualityLevels", msQualityLevels.NumQualityLevels);
+                formatter.AddFieldUint32(L"Flags", uint32_t(msQualityLevels.Flags));
+            }
+            else
+            {
+                bool multisampleTiled =
+                    (msQualityLevels.Flags & D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE) != 0;
+                formatter.AddFieldString(L"SampleCount",
+                    std::format(L"{}: NumQualityLevels = {}{}", msQualityLevels.SampleCount,
+                        msQualityLevels.NumQualityLevels,
+                        multisampleTiled ? L"  D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE" : L""));
+            }
+        }
+    }
+
+    if(result.m_FormatInfoSucceeded)
+    {
+        scope.Enable();
+        formatter.AddFieldUint32(L"PlaneCount", result.m_FormatInfo.PlaneCount);
+    }
+}
+
+// Sample counts 1, 2, 4... D3D12_MAX_MULTISAMPLE_SAMPLE_COUNT.
+static const size_t FORMAT_MATRIX_SAMPLE_COUNT_NUM = 6;
+static_assert(1u << (FORMAT_MATRIX_SAMPLE_COUNT_NUM - 1) == D3D12_MAX_MULTISAMPLE_SAMPLE_COUNT);
+
+// Capabilities of formats as structure of arrays, with an element for each format that any query succeeded for.
+struct FormatMatrix
+{
+    std::vector<uint32_t> m_Formats;
+    std::vector<uint32_t> m_Support1;
+    std::vector<uint32_t> m_Support2;
+    std::vector<uint32_t> m_PlaneCount;
+    // Bit i is set if sample count 2^i is supported.
+    std::vector<uint32_t> m_SampleCounts;
+    // Bit i is set if sample count 2^i has D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE.
+    std::vector<uint32_t> m_TiledSampleCounts;
+    // Array i is for sample count 2^i, 0 if not supported.
+    std::array<std::vector<uint32_t>, FORMAT_MATRIX_SAMPLE_COUNT_NUM> m_NumQualityLevels;
+
+    size_t GetSize() const { return m_Formats.size(); }
+    void Add(DXGI_FORMAT format, const FormatQueryResult& result);
+};
+
+void FormatMatrix::Add(DXGI_FORMAT format, const FormatQueryResult& result)
+{
+    const bool supportSucceeded = SUCCEEDED(result.m_FormatSupportResult);
+    m_Formats.push_back((uint32_t)format);
+    m_Support1.push_back(supportSucceeded ? (uint32_t)result.m_FormatSupport.Support1 : 0);
+    m_Support2.push_back(supportSucceeded ? (uint32_t)result.m_FormatSupport.Support2 : 0);
+    m_PlaneCount.push_back(result.m_FormatInfoSucceeded ? result.m_FormatInfo.PlaneCount : 0);
+
+    uint32_t sampleCounts = 0;
+    uint32_t tiledSampleCounts = 0;
+    for(size_t i = 0; i < FORMAT_MATRIX_SAMPLE_COUNT_NUM; ++i)
+    {
+        // m_MsQualityLevels holds sample counts 1, 2, 4... so element i is for sample count 2^i.
+        uint32_t numQualityLevels = 0;
+        if(i < result.m_MsQualityLevels.size())
+        {
+            const D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS& msQualityLevels = result.m_MsQualityLevels[i];
+            numQualityLevels = msQualityLevels.NumQualityLevels;
+            sampleCounts |= 1u << i;
+            if((msQualityLevels.Flags & D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE) != 0)
+                tiledSampleCounts |= 1u << i;
+        }
+        m_NumQualityLevels[i].push_back(numQualityLevels);
+    }
+    m_SampleCounts.push_back(sampleCounts);
+    m_TiledSampleCounts.push_back(tiledSampleCounts);
+}
+
+static void PrintFormatMatrixTable(const FormatMatrix& matrix)
+{
+    size_t nameWidth = wcslen(L"Format");
+    for(uint32_t format : matrix.m_Formats)
+        nameWidth = std::max(nameWidth, wcslen(FindEnumItemName(format, Enum_DXGI_FORMAT)));
+
+    std::vector<wstring> rows;
+    rows.reserve(matrix.GetSize() + 1);
+    wstring header = std::format(L"{:<{}}  {:<10}  {:<10}  Planes", L"Format", nameWidth, L"Support1", L"Support2");
+    for(size_t i = 0; i < FORMAT_MATRIX_SAMPLE_COUNT_NUM; ++i)
+        header += std::format(L"  {:>4}", std::format(L"{}x", 1u << i));
+    rows.push_back(std::move(header));
+
+    for(size_t row = 0; row < matrix.GetSize(); ++row)
+    {
+        wstring line = std::format(L"{:<{}}  0x{:08X}  0x{:08X}  {:>6}",
+            FindEnumItemName(matrix.m_Formats[row], Enum_DXGI_FORMAT), nameWidth, matrix.m_Support1[row],
+            matrix.m_Support2[row], matrix.m_PlaneCount[row]);
+        for(size_t i = 0; i < FORMAT_MATRIX_SAMPLE_COUNT_NUM; ++i)
+        {
+            wstring cell = L"-";
+            if((matrix.m_SampleCounts[row] & (1u << i)) != 0)
+            {
+                cell = std::format(L"{}{}", matrix.m_NumQualityLevels[i][row],
+                    (matrix.m_TiledSampleCounts[row] & (1u << i)) != 0 ? L"T" : L"");
+            }
+            line += std::format(L"  {:>4}", cell);
+        }
+        rows.push_back(std::move(line));
+    }
+
+    ReportFormatter::GetInstance().AddFieldStringArray(L"FormatsMatrix", rows);
+}
+
+static void PrintFormatMatrixArrays(const FormatMatrix& matrix)
+{
+    ReportScopeObject scope(L"FormatsMatrix");
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    const size_t size = matrix.GetSize();
+    formatter.AddFieldUint32Array(L"Format", matrix.m_Formats.data(), size);
+    formatter.AddFieldUint32Array(L"Support1", matrix.m_Support1.data(), size);
+    formatter.AddFieldUint32Array(L"Support2", matrix.m_Support2.data(), size);
+    formatter.AddFieldUint32Array(L"PlaneCount", matrix.m_PlaneCount.data(), size);
+    formatter.AddFieldUint32Array(L"SampleCounts", matrix.m_SampleCounts.data(), size);
+    formatter.AddFieldUint32Array(L"TiledSampleCounts", matrix.m_TiledSampleCounts.data(), size);
+    for(size_t i = 0; i < FORMAT_MATRIX_SAMPLE_COUNT_NUM; ++i)
+    {
+        formatter.AddFieldUint32Array(
+            std::format(L"NumQualityLevels.{}", 1u << i), matrix.m_NumQualityLevels[i].data(), size);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void PrintDXGIFeatureInfo(const std::optional<BOOL>& allowTearing)
+{
+    ReportScopeObject scope(L"DXGI_FEATURE");
+    if(allowTearing)
+    {
+        ReportFormatter::GetInstance().AddFieldBool(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", *allowTearing);
+    }
+}
+
+void PrintAdapterDesc(uint32_t descVersion, const DXGI_ADAPTER_DESC3& desc)
+{
+    switch(descVersion)
+    {
+    case 0:
+        PrintAdapterDesc((const DXGI_ADAPTER_DESC&)desc);
+        break;
+    case 1:
+        PrintAdapterDesc1((const DXGI_ADAPTER_DESC1&)desc);
+        break;
+    case 2:
+        PrintAdapterDesc2((const DXGI_ADAPTER_DESC2&)desc);
+        break;
+    case 3:
+        PrintAdapterDesc3(desc);
+        break;
+    default:
+        assert(0);
+    }
+}
+
+void PrintAdapterMemoryInfo(uint32_t memorySegmentGroup, const DXGI_QUERY_VIDEO_MEMORY_INFO& videoMemoryInfo)
+{
+    const wchar_t* structName = nullptr;
+    switch(memorySegmentGroup)
+    {
+    case 0:
+        structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_LOCAL]";
+        break;
+    case 1:
+        structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL]";
+        break;
+    default:
+        assert(0);
+    }
+    ReportScopeObject scope(structName);
+    PrintStructFields(StructDesc_DXGI_QUERY_VIDEO_MEMORY_INFO, &videoMemoryInfo);
+}
+
+void PrintAdapterInterfaceSupport(uint64_t umdVersion)
+{
+    ReportScopeObject scope(L"CheckInterfaceSupport");
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(L"UMDVersion", umdVersion);
+}
+
+void PrintAdapterSummary(const DXGI_ADAPTER_DESC1& desc1)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldString(L"Description", desc1.Description);
+    formatter.AddFieldVendorId(L"VendorId", desc1.VendorId);
+    formatter.AddFieldHex32(L"DeviceId", desc1.DeviceId);
+    formatter.AddFieldString(L"AdapterLuid", LuidToStr(desc1.AdapterLuid).c_str());
+    formatter.AddFieldFlags(L"Flags", desc1.Flags, Enum_DXGI_ADAPTER_FLAG);
+    formatter.AddFieldSize(L"DedicatedVideoMemory", desc1.DedicatedVideoMemory);
+}
+
+void PrintDeviceFeatures(FeatureSupportSource& source)
+{
+    RunFeatureQueries(source, DEVICE_FEATURE_QUERIES, _countof(DEVICE_FEATURE_QUERIES),
+        [](const FeatureQueryDesc& query) { return IsReportScopeNeeded(query.m_ScopeName); });
+}
+
+const wchar_t* FindFeatureName(uint32_t feature)
+{
+    for(const FeatureQueryDesc& query : DEVICE_FEATURE_QUERIES)
+    {
+        if(query.m_Feature == feature)
+            return query.m_Name;
+    }
+    switch(feature)
+    {
+    case D3D12_FEATURE_FORMAT_SUPPORT:
+        return L"D3D12_FEATURE_FORMAT_SUPPORT";
+    case D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS:
+        return L"D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS";
+    case D3D12_FEATURE_FORMAT_INFO:
+        return L"D3D12_FEATURE_FORMAT_INFO";
+    default:
+        return nullptr;
+    }
+}
+
+RequirementSchema GetRequirementSchema()
+{
+    RequirementSchema schema;
+    for(const FeatureQueryDesc& query : DEVICE_FEATURE_QUERIES)
+    {
+        // Structures printed by their own functions, like D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY, can't be checked.
+        if(const StructDesc* const structDesc = StructCollection::GetInstance().FindStruct(query.m_Feature))
+            schema.m_Queries.push_back({ &query, structDesc });
+    }
+    schema.m_FormatQuery = { &FORMAT_SUPPORT_QUERY, &StructDesc_D3D12_FEATURE_DATA_FORMAT_SUPPORT };
+    schema.m_Formats = Enum_DXGI_FORMAT;
+    return schema;
+}
+
+void PrintDescriptorSizes(const std::array<uint32_t, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES>& sizes)
+{
+    ReportScopeObject scope(L"GetDescriptorHandleIncrementSize");
+    for(size_t i = 0; i < sizes.size(); ++i)
+        ReportFormatter::GetInstance().AddFieldUint32(DESCRIPTOR_HEAP_TYPE_NAMES[i], sizes[i]);
+}
+
+size_t GetFormatCount()
+{
+    return FORMAT_COUNT;
+}
+
+void PrintFormatInformation(FeatureSupportSource& source)
+{
+    if(!IsReportScopeNeeded(L"Formats"))
+        return;
+    std::vector<FormatQueryResult> results;
+    const size_t formatCount = QueryAllFormats(source, FindNeededFormats(L"Formats"), results);
+
+    ReportScopeObject scope(L"Formats");
+    for(size_t formatIndex = 0; formatIndex < formatCount; ++formatIndex)
+        PrintFormatQueryResult(formatIndex, results[formatIndex]);
+}
+
+void PrintSingleFormatInformation(FeatureSupportSource& source, size_t formatIndex)
+{
+    assert(formatIndex < FORMAT_COUNT);
+    FormatQueryResult result;
+    QueryFormat(source, (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value, result);
+    PrintFormatQueryResult(formatIndex, result);
+}
+
+void PrintFormatMatrix(FeatureSupportSource& source)
+{
+    // All formats are in the same arrays, so they are queried all or none.
+    if(!IsReportScopeNeeded(L"FormatsMatrix"))
+        return;
+    std::vector<FormatQueryResult> results;
+    const size_t formatCount = QueryAllFormats(source, std::vector<bool>(FORMAT_COUNT, true), results);
+
+    FormatMatrix matrix;
+    for(size_t formatIndex = 0; formatIndex < formatCount; ++formatIndex)
+    {
+        const FormatQueryResult& result = results[formatIndex];
+        if(SUCCEEDED(result.m_FormatSupportResult) || result.m_FormatInfoSucceeded)
+            matrix.Add((DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value, result);
+    }
+
+    if(IsJsonOutput())
+        PrintFormatMatrixArrays(matrix);
+    else
+        PrintFormatMatrixTable(matrix);
+}
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+void Print_D3D12_FEATURE_DATA_COOPERATIVE_VECTOR(const D3D12_FEATURE_DATA_COOPERATIVE_VECTOR& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COOPERATIVE_VECTOR");
+
+    {
+        ReportScopeArray scopeArray(L"pMatrixVectorMulAddProperties");
+        for(UINT i = 0; i < o.MatrixVectorMulAddPropCount; ++i)
+        {
+            ReportScopeArrayItem scopeItem;
+            PrintStructFields(StructDesc_D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL, &o.pMatrixVectorMulAddProperties[i]);
+        }
+    }
+
+    {
+        ReportScopeArray scopeArray(L"pOuterProductAccumulateProperties");
+        for(UINT i = 0; i < o.OuterProductAccumulatePropCount; ++i)
+        {
+            ReportScopeArrayItem scopeItem;
+            PrintStructFields(
+                StructDesc_D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE, &o.pOuterProductAccumulateProperties[i]);
+        }
+    }
+
+    {
+        ReportScopeArray scopeArray(L"pVectorAccumulateProperties");
+        for(UINT i = 0; i < o.VectorAccumulatePropCount; ++i)
+        {
+            ReportScopeArrayItem scopeItem;
+            PrintStructFields(
+                StructDesc_D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE, &o.pVectorAccumulateProperties[i]);
+        }
+    }
+}
+#endif
@@ -0,0 +1,45 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Printing of DXGI and D3D12 data from plain structures, separate from calls that query it. Used by D3d12info for
+// live queries and --Replay, and by ReportGenerator for made up data.
+
+#include "FeatureQuery.hpp"
+#include "Requirements.hpp"
+
+// Versions of the structure: DXGI_ADAPTER_DESC, DXGI_ADAPTER_DESC1 etc.
+static const uint32_t ADAPTER_DESC_VERSION_COUNT = 4;
+
+void PrintDXGIFeatureInfo(const std::optional<BOOL>& allowTearing);
+// Each version of the structure starts with members of the previous one, so desc can hold any of them.
+void PrintAdapterDesc(uint32_t descVersion, const DXGI_ADAPTER_DESC3& desc);
+void PrintAdapterMemoryInfo(uint32_t memorySegmentGroup, const DXGI_QUERY_VIDEO_MEMORY_INFO& videoMemoryInfo);
+void PrintAdapterInterfaceSupport(uint64_t umdVersion);
+// Only what identifies the adapter and its dedicated memory, as printed by --ListFast.
+void PrintAdapterSummary(const DXGI_ADAPTER_DESC1& desc1);
+// Runs all queries of ID3D12Device::CheckFeatureSupport printed for an adapter, in order of printing.
+void PrintDeviceFeatures(FeatureSupportSource& source);
+// Name of a D3D12_FEATURE queried by PrintDeviceFeatures or for formats, or null if unknown.
+const wchar_t* FindFeatureName(uint32_t feature);
+// What --Require can check: queries of PrintDeviceFeatures with structures described by StructDesc, and support of
+// formats.
+RequirementSchema GetRequirementSchema();
+void PrintDescriptorSizes(const std::array<uint32_t, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES>& sizes);
+void PrintFormatInformation(FeatureSupportSource& source);
+// Number of formats printed by PrintFormatInformation, in order of Enum_DXGI_FORMAT.
+size_t GetFormatCount();
+// Only the format at this index, without the scope of all formats around it.
+void PrintSingleFormatInformation(FeatureSupportSource& source, size_t formatIndex);
+// Same information as PrintFormatInformation, as parallel arrays with an element per format in JSON, or as a table.
+void PrintFormatMatrix(FeatureSupportSource& source);
+#ifdef USE_PREVIEW_AGILITY_SDK
+void Print_D3D12_FEATURE_DATA_COOPERATIVE_VECTOR(const D3D12_FEATURE_DATA_COOPERATIVE_VECTOR& o);
+#endif
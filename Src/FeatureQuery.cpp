@@ -0,0 +1,57 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "FeatureQuery.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+bool QueryFeature(FeatureSupportSource& source, const FeatureQueryDesc& query, void* data)
+{
+    if(query.m_Init)
+        query.m_Init(data);
+    return query.m_Query ? query.m_Query(source, data)
+                         : source.CheckFeatureSupport(query.m_Feature, data, query.m_DataSize);
+}
+
+void RunFeatureQueries(FeatureSupportSource& source, const FeatureQueryDesc* queries, size_t queryCount,
+    bool (*isNeeded)(const FeatureQueryDesc& query))
+{
+    // A query is made also when only a fallback following it is needed, as the fallback depends on its result.
+    std::vector<bool> needed(queryCount, true);
+    if(isNeeded)
+    {
+        for(size_t i = queryCount; i--;)
+        {
+            const bool fallbackNeeded = i + 1 < queryCount &&
+                (queries[i + 1].m_Flags & FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED) && needed[i + 1];
+            needed[i] = fallbackNeeded || isNeeded(queries[i]);
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char data[FEATURE_QUERY_MAX_DATA_SIZE];
+    bool previousSucceeded = false;
+    for(size_t i = 0; i < queryCount; ++i)
+    {
+        const FeatureQueryDesc& query = queries[i];
+        assert(query.m_DataSize <= FEATURE_QUERY_MAX_DATA_SIZE && query.m_Print);
+
+        if((query.m_Flags & FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED) && previousSucceeded)
+            // Keep previousSucceeded, so a chain of fallbacks stops at the first success.
+            continue;
+        if(!needed[i])
+            continue;
+
+        memset(data, 0, query.m_DataSize);
+        previousSucceeded = QueryFeature(source, query, data);
+        if(previousSucceeded)
+            query.m_Print(data);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Table-driven engine for ID3D12Device::CheckFeatureSupport queries. Each query is described by FeatureQueryDesc and
+// one function walks the whole table. Depends only on the C++ standard library, so it can run against a fake device.
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Failure returned by a source when the query crashed inside the driver.
+static const int32_t FEATURE_SUPPORT_RESULT_CRASHED = (int32_t)0xE0000001;
+
+// Anything that can answer ID3D12Device::CheckFeatureSupport.
+class FeatureSupportSource
+{
+public:
+    virtual ~FeatureSupportSource() = default;
+    // feature is a D3D12_FEATURE value. data is in/out like in ID3D12Device::CheckFeatureSupport.
+    // Returns HRESULT.
+    virtual int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) = 0;
+
+    // Returns true on success.
+    bool CheckFeatureSupport(uint32_t feature, void* data, uint32_t dataSize)
+    {
+        return CheckFeatureSupportResult(feature, data, dataSize) >= 0;
+    }
+
+    // If true, independent queries, like the ones for each DXGI_FORMAT, are made from multiple threads at once, so
+    // CheckFeatureSupportResult must be thread-safe.
+    virtual bool ShouldQueryInParallel() const { return false; }
+};
+
+enum FEATURE_QUERY_FLAGS
+{
+    FEATURE_QUERY_FLAG_NONE = 0,
+    // Query only if the previous query in the table failed, e.g. for an older version of the structure.
+    FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED = 0x1,
+};
+
+struct FeatureQueryDesc
+{
+    // Name of the D3D12_FEATURE.
+    const wchar_t* m_Name;
+    uint32_t m_Feature;
+    uint32_t m_DataSize;
+    // Optional. Sets input members of the structure, which is zeroed before.
+    void (*m_Init)(void* data);
+    // Optional. Replaces the single CheckFeatureSupport call, e.g. for queries that need a loop.
+    bool (*m_Query)(FeatureSupportSource& source, void* data);
+    // Called after successful query.
+    void (*m_Print)(const void* data);
+    // Name of the scope printed by m_Print.
+    const wchar_t* m_ScopeName;
+    uint32_t m_Flags;
+};
+
+// Largest structure that a FeatureQueryDesc can describe.
+static const size_t FEATURE_QUERY_MAX_DATA_SIZE = 1024;
+
+template <typename PrintFunc>
+struct FeatureQueryPrintTraits;
+template <typename T>
+struct FeatureQueryPrintTraits<void (*)(const T&)>
+{
+    using DataType = T;
+};
+
+// Creates FeatureQueryDesc with type-safe functions: Print(const T&), Init(T&), Query(FeatureSupportSource&, T&).
+template <auto Print, auto Init = nullptr, auto Query = nullptr>
+constexpr FeatureQueryDesc MakeFeatureQuery(
+    uint32_t feature, const wchar_t* name, const wchar_t* scopeName, uint32_t flags = 0)
+{
+    using T = typename FeatureQueryPrintTraits<decltype(Print)>::DataType;
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= FEATURE_QUERY_MAX_DATA_SIZE);
+
+    FeatureQueryDesc desc = { name, feature, (uint32_t)sizeof(T), nullptr, nullptr,
+        [](const void* data) { Print(*(const T*)data); }, scopeName, flags };
+    if constexpr(!std::is_null_pointer_v<decltype(Init)>)
+        desc.m_Init = [](void* data) { Init(*(T*)data); };
+    if constexpr(!std::is_null_pointer_v<decltype(Query)>)
+        desc.m_Query = [](FeatureSupportSource& source, void* data) { return Query(source, *(T*)data); };
+    return desc;
+}
+
+// Makes one query on data with input members set by the caller, like the format. Returns true on success.
+bool QueryFeature(FeatureSupportSource& source, const FeatureQueryDesc& query, void* data);
+
+// Runs the queries in order, printing results of the successful ones. If isNeeded is not null, queries it returns
+// false for are skipped, unless a fallback query following them is needed.
+void RunFeatureQueries(FeatureSupportSource& source, const FeatureQueryDesc* queries, size_t queryCount,
+    bool (*isNeeded)(const FeatureQueryDesc& query) = nullptr);
@@ -0,0 +1,169 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "FieldSelection.hpp"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+enum PATTERN_MATCH
+{
+    // Nothing inside the path can match.
+    PATTERN_MATCH_NONE,
+    // Some paths inside it could match, depending on the names that follow.
+    PATTERN_MATCH_PARTIAL,
+    // Matches the path, so everything inside it.
+    PATTERN_MATCH_FULL,
+};
+
+static std::vector<std::wstring_view> SplitPath(std::wstring_view path)
+{
+    std::vector<std::wstring_view> names;
+    size_t begin = 0;
+    for(;;)
+    {
+        const size_t end = path.find(L'.', begin);
+        if(end == std::wstring_view::npos)
+        {
+            names.push_back(path.substr(begin));
+            return names;
+        }
+        names.push_back(path.substr(begin, end - begin));
+        begin = end + 1;
+    }
+}
+
+static std::wstring_view Trim(std::wstring_view str)
+{
+    const size_t begin = str.find_first_not_of(L' ');
+    if(begin == std::wstring_view::npos)
+        return {};
+    return str.substr(begin, str.find_last_not_of(L' ') + 1 - begin);
+}
+
+static bool MatchName(std::wstring_view pattern, std::wstring_view name)
+{
+    // On a mismatch, the last * takes one more character.
+    size_t p = 0, n = 0;
+    size_t starP = std::wstring_view::npos, starN = 0;
+    while(n < name.size())
+    {
+        if(p < pattern.size() && (pattern[p] == L'?' || pattern[p] == name[n]))
+        {
+            ++p;
+            ++n;
+        }
+        else if(p < pattern.size() && pattern[p] == L'*')
+        {
+            starP = p++;
+            starN = n;
+        }
+        else if(starP != std::wstring_view::npos)
+        {
+            p = starP + 1;
+            n = ++starN;
+        }
+        else
+            return false;
+    }
+    while(p < pattern.size() && pattern[p] == L'*')
+        ++p;
+    return p == pattern.size();
+}
+
+// An item of an array, like "Adapters[0]", also matches the name of the array alone.
+static bool MatchPathName(std::wstring_view pattern, std::wstring_view name)
+{
+    if(MatchName(pattern, name))
+        return true;
+    const size_t bracket = name.ends_with(L']') ? name.rfind(L'[') : std::wstring_view::npos;
+    return bracket != std::wstring_view::npos && bracket > 0 && MatchName(pattern, name.substr(0, bracket));
+}
+
+static PATTERN_MATCH MatchPattern(const std::vector<std::wstring>& pattern, size_t patternIndex,
+    const std::vector<std::wstring_view>& names, size_t nameIndex)
+{
+    if(patternIndex == pattern.size())
+        return PATTERN_MATCH_FULL;
+    if(pattern[patternIndex] == L"**")
+    {
+        PATTERN_MATCH result = MatchPattern(pattern, patternIndex + 1, names, nameIndex);
+        if(result != PATTERN_MATCH_FULL && nameIndex < names.size())
+            result = std::max(result, MatchPattern(pattern, patternIndex, names, nameIndex + 1));
+        return result;
+    }
+    if(nameIndex == names.size())
+        return PATTERN_MATCH_PARTIAL;
+    if(!MatchPathName(pattern[patternIndex], names[nameIndex]))
+        return PATTERN_MATCH_NONE;
+    return MatchPattern(pattern, patternIndex + 1, names, nameIndex + 1);
+}
+
+static PATTERN_MATCH MatchAnyPattern(
+    const std::vector<std::vector<std::wstring>>& patterns, const std::vector<std::wstring_view>& names)
+{
+    PATTERN_MATCH result = PATTERN_MATCH_NONE;
+    for(const std::vector<std::wstring>& pattern : patterns)
+    {
+        result = std::max(result, MatchPattern(pattern, 0, names, 0));
+        if(result == PATTERN_MATCH_FULL)
+            break;
+    }
+    return result;
+}
+
+static void AddPatterns(std::wstring_view patterns, std::vector<std::vector<std::wstring>>& outPatterns)
+{
+    size_t begin = 0;
+    while(begin <= patterns.size())
+    {
+        size_t end = patterns.find(L',', begin);
+        if(end == std::wstring_view::npos)
+            end = patterns.size();
+        if(const std::wstring_view pattern = Trim(patterns.substr(begin, end - begin)); !pattern.empty())
+        {
+            std::vector<std::wstring> names;
+            for(std::wstring_view name : SplitPath(pattern))
+                names.emplace_back(name);
+            outPatterns.push_back(std::move(names));
+        }
+        begin = end + 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void FieldSelection::AddSelect(std::wstring_view patterns)
+{
+    AddPatterns(patterns, m_Selects);
+}
+
+void FieldSelection::AddExclude(std::wstring_view patterns)
+{
+    AddPatterns(patterns, m_Excludes);
+}
+
+bool FieldSelection::IsSelected(std::wstring_view path) const
+{
+    const std::vector<std::wstring_view> names = SplitPath(path);
+    if(!m_Selects.empty() && MatchAnyPattern(m_Selects, names) != PATTERN_MATCH_FULL)
+        return false;
+    return MatchAnyPattern(m_Excludes, names) != PATTERN_MATCH_FULL;
+}
+
+bool FieldSelection::IsScopeNeeded(std::wstring_view path) const
+{
+    const std::vector<std::wstring_view> names = SplitPath(path);
+    if(MatchAnyPattern(m_Excludes, names) == PATTERN_MATCH_FULL)
+        return false;
+    return m_Selects.empty() || MatchAnyPattern(m_Selects, names) != PATTERN_MATCH_NONE;
+}
@@ -0,0 +1,48 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Fields of the report chosen with --Select and --Exclude. Depends only on the C++ standard library.
+//
+// A path is made of names of scopes and the field as printed, separated by dots, with "[Index]" after the name of an
+// array for its items, e.g. "D3D12_FEATURE_DATA_D3D12_OPTIONS5.RaytracingTier". A pattern is matched against a
+// path from its beginning, one name at a time: * matches any characters within a name, ? matches one character, and
+// a name ** matches any number of names, also none. A pattern matching a scope matches everything inside it, and
+// the name of an array matches all its items.
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class FieldSelection
+{
+public:
+    // Each call adds one pattern, or multiple separated by commas. Empty ones are ignored.
+    void AddSelect(std::wstring_view patterns);
+    void AddExclude(std::wstring_view patterns);
+
+    // Nothing added, so everything is printed.
+    bool IsEmpty() const
+    {
+        return m_Selects.empty() && m_Excludes.empty();
+    }
+
+    // True if the field, or the whole scope, with this path is printed: it matches a pattern of --Select, or there
+    // are none, and doesn't match any of --Exclude.
+    bool IsSelected(std::wstring_view path) const;
+    // True if anything inside the scope with this path could be printed. If not, the data for it doesn't need to be
+    // gathered.
+    bool IsScopeNeeded(std::wstring_view path) const;
+
+private:
+    // Each pattern split into names.
+    std::vector<std::vector<std::wstring>> m_Selects;
+    std::vector<std::vector<std::wstring>> m_Excludes;
+};
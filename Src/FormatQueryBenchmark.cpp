@@ -0,0 +1,254 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+/*
+Command-line benchmark of the DXGI format sweep of D3d12info: PrintFormatInformation
+queried one format after another, and on the pool of threads of ParallelFor.
+
+It doesn't touch any GPU. A fake device answers CheckFeatureSupport after a
+configurable latency, like a slow driver, so the speedup of the parallel sweep can
+be measured on any machine. Reports printed both ways are also compared, as they
+must be the same. Like ReportGenerator, it needs declarations of D3D12.
+*/
+
+#include "D3D12Data.hpp"
+#include "Enums.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "Utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+struct BenchmarkConfig
+{
+    std::chrono::microseconds m_CallLatency = std::chrono::microseconds(50);
+    uint32_t m_IterationCount = 3;
+    ReportFormatter::FLAGS m_FormatterFlags = ReportFormatter::FLAG_JSON;
+};
+
+// Answers queries about formats with the same made up values for each format, after sleeping for the latency.
+class FakeFormatDevice : public FeatureSupportSource
+{
+public:
+    FakeFormatDevice(std::chrono::microseconds callLatency, bool queryInParallel)
+        : m_CallLatency(callLatency)
+        , m_QueryInParallel(queryInParallel)
+    {
+    }
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override;
+    bool ShouldQueryInParallel() const override { return m_QueryInParallel; }
+    size_t GetCallCount() const { return m_CallCount; }
+
+private:
+    const std::chrono::microseconds m_CallLatency;
+    const bool m_QueryInParallel;
+    std::atomic<size_t> m_CallCount = 0;
+};
+
+int32_t FakeFormatDevice::CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize)
+{
+    ++m_CallCount;
+    if(m_CallLatency.count() > 0)
+        std::this_thread::sleep_for(m_CallLatency);
+
+    switch(feature)
+    {
+    case D3D12_FEATURE_FORMAT_SUPPORT:
+    {
+        auto& formatSupport = *(D3D12_FEATURE_DATA_FORMAT_SUPPORT*)data;
+        if(formatSupport.Format == DXGI_FORMAT_UNKNOWN)
+            return E_INVALIDARG;
+        formatSupport.Support1 = D3D12_FORMAT_SUPPORT1_TEXTURE2D | D3D12_FORMAT_SUPPORT1_SHADER_LOAD;
+        if(formatSupport.Format % 2 == 0)
+        {
+            formatSupport.Support1 |=
+                D3D12_FORMAT_SUPPORT1_RENDER_TARGET | D3D12_FORMAT_SUPPORT1_MULTISAMPLE_RENDERTARGET;
+        }
+        formatSupport.Support2 = formatSupport.Format % 3 == 0 ? D3D12_FORMAT_SUPPORT2_UAV_TYPED_LOAD
+                                                               : D3D12_FORMAT_SUPPORT2_NONE;
+        return S_OK;
+    }
+    case D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS:
+    {
+        // Sample counts up to 8, like on most GPUs, so the sweep makes 5 calls per format.
+        auto& msQualityLevels = *(D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS*)data;
+        msQualityLevels.NumQualityLevels = msQualityLevels.SampleCount <= 8 ? 1 : 0;
+        return S_OK;
+    }
+    case D3D12_FEATURE_FORMAT_INFO:
+    {
+        auto& formatInfo = *(D3D12_FEATURE_DATA_FORMAT_INFO*)data;
+        formatInfo.PlaneCount = 1;
+        return S_OK;
+    }
+    default:
+        return E_INVALIDARG;
+    }
+}
+
+struct SweepResult
+{
+    std::chrono::microseconds m_Duration = {};
+    size_t m_CallCount = 0;
+    std::wstring m_Report;
+};
+
+static SweepResult RunSweep(const BenchmarkConfig& config, bool parallel)
+{
+    FakeFormatDevice device(config.m_CallLatency, parallel);
+    std::wostringstream stream;
+    const auto beginTime = std::chrono::steady_clock::now();
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(config.m_FormatterFlags);
+        PrintFormatInformation(device);
+    }
+    SweepResult result;
+    result.m_Duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - beginTime);
+    result.m_CallCount = device.GetCallCount();
+    result.m_Report = stream.str();
+    return result;
+}
+
+// Best of the iterations, as the slower ones are disturbed by other processes.
+static SweepResult RunSweeps(const BenchmarkConfig& config, bool parallel)
+{
+    SweepResult best;
+    for(uint32_t i = 0; i < config.m_IterationCount; ++i)
+    {
+        SweepResult result = RunSweep(config, parallel);
+        if(i == 0 || result.m_Duration < best.m_Duration)
+            best = std::move(result);
+    }
+    return best;
+}
+
+static int RunBenchmark(const BenchmarkConfig& config)
+{
+    const SweepResult serial = RunSweeps(config, false);
+    const SweepResult parallel = RunSweeps(config, true);
+
+    PrinterScope printerScope(false, {});
+    const size_t formatCount = GetFormatCount();
+    const long long callLatency = config.m_CallLatency.count();
+    const unsigned threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    Printer::PrintFormat(L"Formats: {}, CheckFeatureSupport calls: {}, latency of each: {} us, hardware threads: {}\n",
+        std::make_wformat_args(formatCount, serial.m_CallCount, callLatency, threadCount));
+    const double serialMs = serial.m_Duration.count() / 1000.0;
+    const double parallelMs = parallel.m_Duration.count() / 1000.0;
+    const double speedup = parallelMs > 0.0 ? serialMs / parallelMs : 0.0;
+    Printer::PrintFormat(L"Serial:   {:10.3f} ms\n", std::make_wformat_args(serialMs));
+    Printer::PrintFormat(L"Parallel: {:10.3f} ms\n", std::make_wformat_args(parallelMs));
+    Printer::PrintFormat(L"Speedup:  {:10.2f}x\n", std::make_wformat_args(speedup));
+
+    if(parallel.m_CallCount != serial.m_CallCount || parallel.m_Report != serial.m_Report)
+    {
+        ErrorPrinter::PrintString(L"ERROR: Formats queried in parallel are printed differently than in serial.\n");
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+static uint64_t ParseUint64(const wstring& str, const wchar_t* optionName)
+{
+    wchar_t* end = nullptr;
+    const uint64_t value = wcstoull(str.c_str(), &end, 10);
+    if(str.empty() || *end != L'\0')
+    {
+        const string optionNameStr = WstrToUtf8(optionName);
+        throw std::runtime_error(std::format("Invalid number in --{}.", optionNameStr));
+    }
+    return value;
+}
+
+static void PrintCommandLineSyntax()
+{
+    // clang-format off
+    ErrorPrinter::PrintString(L"Measures the DXGI format sweep of D3d12info, serial and parallel, against a fake device.\n");
+    ErrorPrinter::PrintString(L"Options:\n");
+    ErrorPrinter::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
+    ErrorPrinter::PrintString(L"  --CallLatency=<Microseconds>     Make each CheckFeatureSupport call take this long, like on a slow driver. Default is 50.\n");
+    ErrorPrinter::PrintString(L"  -n --Iterations=<N>              Run each sweep N times and report the fastest. Default is 3.\n");
+    ErrorPrinter::PrintString(L"  -t --Text                        Print the compared reports in text format instead of JSON.\n");
+    // clang-format on
+}
+
+static int wmain2(int argc, wchar_t** argv)
+{
+    CmdLineParser cmdLineParser(argc, argv);
+
+    enum CMD_LINE_PARAM
+    {
+        CMD_LINE_OPT_HELP,
+        CMD_LINE_OPT_CALL_LATENCY,
+        CMD_LINE_OPT_ITERATIONS,
+        CMD_LINE_OPT_TEXT,
+    };
+
+    // clang-format off
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,         L"Help",        false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,         L'h',           false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CALL_LATENCY, L"CallLatency", true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_ITERATIONS,   L"Iterations",  true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_ITERATIONS,   L'n',           true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TEXT,         L"Text",        false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TEXT,         L't',           false);
+    // clang-format on
+
+    BenchmarkConfig config;
+    CmdLineParser::RESULT cmdLineResult;
+    while((cmdLineResult = cmdLineParser.ReadNextOpt()) != CmdLineParser::RESULT_END)
+    {
+        if(cmdLineResult != CmdLineParser::RESULT_OPT)
+        {
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+        }
+        switch(cmdLineParser.GetOptId())
+        {
+        case CMD_LINE_OPT_HELP:
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_SUCCESS;
+        case CMD_LINE_OPT_CALL_LATENCY:
+            config.m_CallLatency =
+                std::chrono::microseconds(ParseUint64(cmdLineParser.GetParameter(), L"CallLatency"));
+            break;
+        case CMD_LINE_OPT_ITERATIONS:
+            config.m_IterationCount =
+                (uint32_t)std::clamp<uint64_t>(ParseUint64(cmdLineParser.GetParameter(), L"Iterations"), 1, 1000);
+            break;
+        case CMD_LINE_OPT_TEXT:
+            config.m_FormatterFlags = ReportFormatter::FLAG_NONE;
+            break;
+        default:
+            assert(0);
+        }
+    }
+
+    return RunBenchmark(config);
+}
+
+int wmain(int argc, wchar_t** argv)
+{
+    try
+    {
+        return wmain2(argc, argv);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+}
@@ -22,6 +22,9 @@ See the original library in directory: Src\ThirdParty\gpudetect
 // Macro set by Cmake.
 #if USE_INTEL_GPUDETECT
 
+// Generated from IntelGfx.cfg, which is available only together with the library.
+#include "IntelGfxTable.hpp"
+
 #include <d3d11.h>
 #ifdef _WIN32_WINNT_WIN10
 #include <d3d11_3.h>
@@ -91,6 +94,13 @@ namespace GPUDetect
     ENUM_END(PresetLevel)
 } // namespace GPUDetect
 
+static_assert(INTEL_GFX_PRESET_LEVEL_NOT_COMPATIBLE == GPUDetect::NotCompatible);
+static_assert(INTEL_GFX_PRESET_LEVEL_LOW == GPUDetect::Low);
+static_assert(INTEL_GFX_PRESET_LEVEL_MEDIUM == GPUDetect::Medium);
+static_assert(INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS == GPUDetect::MediumPlus);
+static_assert(INTEL_GFX_PRESET_LEVEL_HIGH == GPUDetect::High);
+static_assert(INTEL_GFX_PRESET_LEVEL_UNDEFINED == GPUDetect::Undefined);
+
 namespace IntelData
 {
 
@@ -102,6 +112,9 @@ namespace IntelData
 
     void PrintAdapterData(IDXGIAdapter* adapter)
     {
+        // Not even the device is created if the data would not be printed, e.g. with --Select.
+        if(!IsReportScopeNeeded(L"Intel GPUDetect::GPUData"))
+            return;
         ComPtr<ID3D11Device> device;
         int r = GPUDetect::InitDevice(adapter, &device);
         if(r != EXIT_SUCCESS)
@@ -134,7 +147,9 @@ namespace IntelData
 
         if(gpuData.vendorID == GPUDetect::INTEL_VENDOR_ID)
         {
-            const GPUDetect::PresetLevel presetLevel = GPUDetect::GetDefaultFidelityPreset(&gpuData);
+            // Looked up in the table generated from IntelGfx.cfg instead of GPUDetect::GetDefaultFidelityPreset,
+            // which parses the file on every call.
+            const INTEL_GFX_PRESET_LEVEL presetLevel = FindIntelGfxPresetLevel(gpuData.deviceID);
             formatter.AddFieldEnum(L"DefaultFidelityPreset", (uint32_t)presetLevel, GPUDetect::Enum_PresetLevel);
 
             r = GPUDetect::InitCounterInfo(&gpuData, device.Get());
@@ -165,6 +180,13 @@ namespace IntelData
         }
     }
 
+    ArchitectureInfo FindArchitecture(uint32_t deviceId)
+    {
+        const GPUDetect::IntelGPUArchitecture architecture = GPUDetect::GetIntelGPUArchitecture(deviceId);
+        return { GPUDetect::GetIntelGPUArchitectureString(architecture),
+            GPUDetect::GetIntelGraphicsGenerationString(GPUDetect::GetIntelGraphicsGeneration(architecture)) };
+    }
+
 } // namespace IntelData
 
 #endif // #if USE_INTEL_GPUDETECT
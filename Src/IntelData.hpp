@@ -20,6 +20,14 @@ namespace IntelData
 
     void PrintAdapterData(IDXGIAdapter* adapter);
 
+    // Derived from PCI device ID alone, without creating any device. Strings as returned by GPUDetect.
+    struct ArchitectureInfo
+    {
+        string architecture;
+        string graphicsGeneration;
+    };
+    ArchitectureInfo FindArchitecture(uint32_t deviceId);
+
 } // namespace IntelData
 
 #endif // #if USE_INTEL_GPUDETECT
@@ -0,0 +1,78 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Default fidelity presets of Intel GPUs from IntelGfx.cfg of Intel GPU Detect library, converted to a table at build
+// time by Scripts/GenerateIntelGfxTable.cmake. Doesn't depend on WinAPI, so it can also be used by offline tools.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Same values as GPUDetect::PresetLevel.
+enum INTEL_GFX_PRESET_LEVEL : uint8_t
+{
+    INTEL_GFX_PRESET_LEVEL_NOT_COMPATIBLE,
+    INTEL_GFX_PRESET_LEVEL_LOW,
+    INTEL_GFX_PRESET_LEVEL_MEDIUM,
+    INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS,
+    INTEL_GFX_PRESET_LEVEL_HIGH,
+    INTEL_GFX_PRESET_LEVEL_UNDEFINED,
+};
+
+struct IntelGfxTableEntry
+{
+    uint32_t m_DeviceId;
+    INTEL_GFX_PRESET_LEVEL m_PresetLevel;
+};
+
+// Generated, defines INTEL_GFX_TABLE sorted by m_DeviceId.
+#include "IntelGfxTableData.hpp"
+
+static_assert(std::is_sorted(std::begin(INTEL_GFX_TABLE), std::end(INTEL_GFX_TABLE),
+    [](const IntelGfxTableEntry& lhs, const IntelGfxTableEntry& rhs) { return lhs.m_DeviceId < rhs.m_DeviceId; }));
+
+// Returns INTEL_GFX_PRESET_LEVEL_UNDEFINED if the device is not listed.
+constexpr INTEL_GFX_PRESET_LEVEL FindIntelGfxPresetLevel(uint32_t deviceId)
+{
+    const auto it = std::lower_bound(std::begin(INTEL_GFX_TABLE), std::end(INTEL_GFX_TABLE), deviceId,
+        [](const IntelGfxTableEntry& lhs, uint32_t rhs) { return lhs.m_DeviceId < rhs; });
+    if(it != std::end(INTEL_GFX_TABLE) && it->m_DeviceId == deviceId)
+        return it->m_PresetLevel;
+    return INTEL_GFX_PRESET_LEVEL_UNDEFINED;
+}
+
+// Same names as GPUDetect::PresetLevel enum items.
+constexpr const char* GetIntelGfxPresetLevelName(INTEL_GFX_PRESET_LEVEL presetLevel)
+{
+    switch(presetLevel)
+    {
+    case INTEL_GFX_PRESET_LEVEL_NOT_COMPATIBLE:
+        return "NotCompatible";
+    case INTEL_GFX_PRESET_LEVEL_LOW:
+        return "Low";
+    case INTEL_GFX_PRESET_LEVEL_MEDIUM:
+        return "Medium";
+    case INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS:
+        return "MediumPlus";
+    case INTEL_GFX_PRESET_LEVEL_HIGH:
+        return "High";
+    default:
+        return "Undefined";
+    }
+}
+
+// Resolves many device IDs in one call.
+inline void FindIntelGfxPresetLevels(const uint32_t* deviceIds, size_t count, INTEL_GFX_PRESET_LEVEL* outPresetLevels)
+{
+    for(size_t i = 0; i < count; ++i)
+        outPresetLevels[i] = FindIntelGfxPresetLevel(deviceIds[i]);
+}
@@ -7,17 +7,39 @@ License: MIT
 
 For more information, see files README.md, LICENSE.txt.
 */
+#include "AdapterFilter.hpp"
+#include "AdapterIndex.hpp"
+#include "AdapterWatcher.hpp"
 #include "AgsData.hpp"
 #include "AmdDeviceInfoData.hpp"
+#include "Capture.hpp"
+#include "D3D12Data.hpp"
 #include "Enums.hpp"
+#include "FeatureQuery.hpp"
+#include "FieldSelection.hpp"
 #include "IntelData.hpp"
 #include "NvApiData.hpp"
+#include "ParallelInspection.hpp"
 #include "Printer.hpp"
+#include "ProbeSupervisor.hpp"
+#include "ReportCache.hpp"
+#include "ReportFormatter/FlatReportFormatter.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "ReportFormatter/SelectingReportFormatter.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "Replay.hpp"
+#include "Requirements.hpp"
+#include "Stats.hpp"
 #include "SystemData.hpp"
+#include "Timings.hpp"
 #include "Utils.hpp"
+#include "VendorLibraries.hpp"
 #include "VulkanData.hpp"
 
+#include <mutex>
+#include <random>
+#include <sstream>
+
 #define WIDE_CHAR_STRING_HELPER(x) L ## x
 #define WIDE_CHAR_STRING(x) WIDE_CHAR_STRING_HELPER(x)
 constexpr const wchar_t* BUILD_TIME = WIDE_CHAR_STRING(__DATE__) L" " WIDE_CHAR_STRING(__TIME__);
@@ -36,14 +58,6 @@ extern "C"
 #endif
 }
 
-// VendorIDs used for deciding whether to use Vendor specific APIs with each device
-enum VENDOR_ID
-{
-    VENDOR_ID_AMD = 0x1002,
-    VENDOR_ID_NVIDIA = 0x10de,
-    VENDOR_ID_INTEL = 0x8086
-};
-
 // #define AUTO_LINK_DX12    // use this on everything before Win10
 #if defined(AUTO_LINK_DX12)
 
@@ -57,15 +71,6 @@ typedef HRESULT(WINAPI* PFN_DXGI_CREATE_FACTORY1)(REFIID riid, _COM_Outptr_ void
 HMODULE g_DxgiLibrary = nullptr;
 HMODULE g_Dx12Library = nullptr;
 
-static const D3D_ROOT_SIGNATURE_VERSION HIGHEST_ROOT_SIGNATURE_VERSION = D3D_ROOT_SIGNATURE_VERSION_1_2;
-static const D3D_FEATURE_LEVEL FEATURE_LEVELS_ARRAY[] = {
-    D3D_FEATURE_LEVEL_12_2,
-    D3D_FEATURE_LEVEL_12_1,
-    D3D_FEATURE_LEVEL_12_0,
-    D3D_FEATURE_LEVEL_11_1,
-    D3D_FEATURE_LEVEL_11_0,
-};
-static const D3D_FEATURE_LEVEL MAX_FEATURE_LEVEL = D3D_FEATURE_LEVEL_12_2;
 static const D3D_FEATURE_LEVEL MIN_FEATURE_LEVEL = D3D_FEATURE_LEVEL_11_0;
 
 const wchar_t* const DYN_LIB_DXGI = L"dxgi.dll";
@@ -93,12 +98,14 @@ static bool g_ShowVersionAndQuit = false;
 static bool g_ShowCommandLineSyntaxAndQuit = false;
 static bool g_ShowCommandLineSyntaxAndFail = false;
 static bool g_ListAdapters = false;
+static bool g_ListAdaptersFast = false;
 static bool g_ShowAllAdapters = true;
 static bool g_SkipSoftwareAdapter = true;
 static bool g_UseJsonOutput = false;
 static bool g_UseJsonPrettyPrint = true;
 static bool g_OutputFile = false;
 static bool g_PrintFormats = false;
+static bool g_PrintFormatsMatrix = false;
 static bool g_PrintMetaCommands = false;
 static bool g_PrintEnums = false;
 static bool g_PureD3D12 = false;
@@ -110,470 +117,168 @@ static bool g_EnableExperimental = false;
 static bool g_ForceVendorAPI = false;
 static bool g_WARP = false;
 static std::wstring g_OutputFilePath;
+static bool g_WriteEnumDictionary = false;
+static std::wstring g_EnumDictionaryPath;
+static std::wstring g_CaptureFilePath;
+static std::wstring g_ReplayFilePath;
+static std::wstring g_CacheDirectoryPath;
+static bool g_RefreshCache = false;
+// 0 means not watching.
+static uint32_t g_WatchIntervalSeconds = 0;
+static bool g_PrintTimings = false;
+static std::wstring g_TraceFilePath;
+static bool g_PrintStats = false;
+static std::wstring g_RequirementsFilePath;
+// Patterns of --Select and --Exclude, for paths inside an adapter.
+static FieldSelection g_FieldSelection;
+// --Adapter given as a filter instead of an index. Then all matching adapters are inspected.
+static AdapterFilter g_AdapterFilter;
+static bool g_Isolate = false;
+// Set by --IsolatedWorker, only in worker processes started with --Isolate.
+struct IsolatedWorkerParams
+{
+    // Vendor data of System Info, otherwise data of the adapter.
+    bool m_System = false;
+    uint32_t m_AdapterIndex = 0;
+    uint32_t m_FirstItem = 0;
+};
+static std::optional<IsolatedWorkerParams> g_IsolatedWorker;
 
 // Derived flags
 static bool g_PrintAdaptersAsArray = true;
+static wstring g_EnumDictionaryHash;
 
-static wstring LuidToStr(LUID value)
-{
-    wchar_t s[64];
-    swprintf_s(s, L"%08X-%08X", (uint32_t)value.HighPart, (uint32_t)value.LowPart);
-    return wstring{ s };
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS(const D3D12_FEATURE_DATA_D3D12_OPTIONS& options)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"DoublePrecisionFloatShaderOps", options.DoublePrecisionFloatShaderOps);
-    formatter.AddFieldBool(L"OutputMergerLogicOp", options.OutputMergerLogicOp);
-    formatter.AddFieldEnum(
-        L"MinPrecisionSupport", options.MinPrecisionSupport, Enum_D3D12_SHADER_MIN_PRECISION_SUPPORT);
-    formatter.AddFieldEnum(L"TiledResourcesTier", options.TiledResourcesTier, Enum_D3D12_TILED_RESOURCES_TIER);
-    formatter.AddFieldEnum(L"ResourceBindingTier", options.ResourceBindingTier, Enum_D3D12_RESOURCE_BINDING_TIER);
-    formatter.AddFieldBool(L"PSSpecifiedStencilRefSupported", options.PSSpecifiedStencilRefSupported);
-    formatter.AddFieldBool(L"TypedUAVLoadAdditionalFormats", options.TypedUAVLoadAdditionalFormats);
-    formatter.AddFieldBool(L"ROVsSupported", options.ROVsSupported);
-    formatter.AddFieldEnum(L"ConservativeRasterizationTier", options.ConservativeRasterizationTier,
-        Enum_D3D12_CONSERVATIVE_RASTERIZATION_TIER);
-    formatter.AddFieldUint32(L"MaxGPUVirtualAddressBitsPerResource", options.MaxGPUVirtualAddressBitsPerResource);
-    formatter.AddFieldBool(L"StandardSwizzle64KBSupported", options.StandardSwizzle64KBSupported);
-    formatter.AddFieldEnum(L"CrossNodeSharingTier", options.CrossNodeSharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
-    formatter.AddFieldBool(L"CrossAdapterRowMajorTextureSupported", options.CrossAdapterRowMajorTextureSupported);
-    formatter.AddFieldBool(L"VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation",
-        options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation);
-    formatter.AddFieldEnum(L"ResourceHeapTier", options.ResourceHeapTier, Enum_D3D12_RESOURCE_HEAP_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_ARCHITECTURE(const D3D12_FEATURE_DATA_ARCHITECTURE& architecture)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"NodeIndex", architecture.NodeIndex);
-    formatter.AddFieldBool(L"TileBasedRenderer", architecture.TileBasedRenderer);
-    formatter.AddFieldBool(L"UMA", architecture.UMA);
-    formatter.AddFieldBool(L"CacheCoherentUMA", architecture.CacheCoherentUMA);
-}
-
-static void Print_D3D12_FEATURE_DATA_ARCHITECTURE1(const D3D12_FEATURE_DATA_ARCHITECTURE1& architecture1)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE1");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"NodeIndex", architecture1.NodeIndex);
-    formatter.AddFieldBool(L"TileBasedRenderer", architecture1.TileBasedRenderer);
-    formatter.AddFieldBool(L"UMA", architecture1.UMA);
-    formatter.AddFieldBool(L"CacheCoherentUMA", architecture1.CacheCoherentUMA);
-    formatter.AddFieldBool(L"IsolatedMMU", architecture1.IsolatedMMU);
-}
-
-static void Print_D3D12_FEATURE_DATA_FEATURE_LEVELS(const D3D12_FEATURE_DATA_FEATURE_LEVELS& featureLevels)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_FEATURE_LEVELS");
-
-    // NumFeatureLevels and pFeatureLevelsRequested are IN parameters
-    // They let the app to specify what enum values does the app expect
-    // So same API can be used when new feature levels are added in the future
-    // No need to print those IN parameters here
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"MaxSupportedFeatureLevel", featureLevels.MaxSupportedFeatureLevel, Enum_D3D_FEATURE_LEVEL);
-}
-
-static void Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT(
-    const D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT& virtualAddressSupport)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT");
-    ReportFormatter::GetInstance().AddFieldUint32(
-        L"MaxGPUVirtualAddressBitsPerResource", virtualAddressSupport.MaxGPUVirtualAddressBitsPerResource);
-    ReportFormatter::GetInstance().AddFieldUint32(
-        L"MaxGPUVirtualAddressBitsPerProcess", virtualAddressSupport.MaxGPUVirtualAddressBitsPerProcess);
-}
-
-static void Print_D3D12_FEATURE_DATA_SHADER_MODEL(const D3D12_FEATURE_DATA_SHADER_MODEL& shaderModel)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_MODEL");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HighestShaderModel", shaderModel.HighestShaderModel, Enum_D3D_SHADER_MODEL);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1(const D3D12_FEATURE_DATA_D3D12_OPTIONS1& options1)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS1");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"WaveOps", options1.WaveOps);
-    formatter.AddFieldUint32(L"WaveLaneCountMin", options1.WaveLaneCountMin);
-    formatter.AddFieldUint32(L"WaveLaneCountMax", options1.WaveLaneCountMax);
-    formatter.AddFieldUint32(L"TotalLaneCount", options1.TotalLaneCount);
-    formatter.AddFieldBool(L"ExpandedComputeResourceStates", options1.ExpandedComputeResourceStates);
-    formatter.AddFieldBool(L"Int64ShaderOps", options1.Int64ShaderOps);
-}
-
-static void Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE(const D3D12_FEATURE_DATA_ROOT_SIGNATURE& rootSignature)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ROOT_SIGNATURE");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HighestVersion", rootSignature.HighestVersion, Enum_D3D_ROOT_SIGNATURE_VERSION);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2(const D3D12_FEATURE_DATA_D3D12_OPTIONS2& options2)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS2");
-    ReportFormatter::GetInstance().AddFieldBool(L"DepthBoundsTestSupported", options2.DepthBoundsTestSupported);
-    ReportFormatter::GetInstance().AddFieldEnum(L"ProgrammableSamplePositionsTier",
-        options2.ProgrammableSamplePositionsTier, Enum_D3D12_PROGRAMMABLE_SAMPLE_POSITIONS_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_SHADER_CACHE(const D3D12_FEATURE_DATA_SHADER_CACHE& shaderCache)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_CACHE");
-    ReportFormatter::GetInstance().AddFieldFlags(
-        L"SupportFlags", shaderCache.SupportFlags, Enum_D3D12_SHADER_CACHE_SUPPORT_FLAGS);
-}
-
-static void Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(const std::array<bool, 9>& commandQueuePriority)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[0]);
-    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[1]);
-    formatter.AddFieldBool(L"TYPE_DIRECT.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[2]);
-    formatter.AddFieldBool(L"TYPE_COMPUTE.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[3]);
-    formatter.AddFieldBool(L"TYPE_COMPUTE.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[4]);
-    formatter.AddFieldBool(
-        L"TYPE_COMPUTE.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[5]);
-    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_NORMAL.PriorityForTypeIsSupported", commandQueuePriority[6]);
-    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_HIGH.PriorityForTypeIsSupported", commandQueuePriority[7]);
-    formatter.AddFieldBool(L"TYPE_COPY.PRIORITY_GLOBAL_REALTIME.PriorityForTypeIsSupported", commandQueuePriority[8]);
-}
-
-static void Print_D3D12_FEATURE_DATA_SERIALIZATION(const D3D12_FEATURE_DATA_SERIALIZATION& serialization)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SERIALIZATION");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HeapSerializationTier", serialization.HeapSerializationTier, Enum_D3D12_HEAP_SERIALIZATION_TIER);
-}
-
-static void Print_D3D12_FEATURE_CROSS_NODE(const D3D12_FEATURE_DATA_CROSS_NODE& crossNode)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_CROSS_NODE");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"SharingTier", crossNode.SharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
-    ReportFormatter::GetInstance().AddFieldBool(L"AtomicShaderInstructions", crossNode.AtomicShaderInstructions);
-}
-
-static void Print_D3D12_FEATURE_PREDICATION(const D3D12_FEATURE_DATA_PREDICATION& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_PREDICATION");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_HARDWARE_COPY(const D3D12_FEATURE_DATA_HARDWARE_COPY& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_COPY");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE(
-    const D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3(const D3D12_FEATURE_DATA_D3D12_OPTIONS3& options3)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS3");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"CopyQueueTimestampQueriesSupported", options3.CopyQueueTimestampQueriesSupported);
-    formatter.AddFieldBool(L"CastingFullyTypedFormatSupported", options3.CastingFullyTypedFormatSupported);
-    formatter.AddFieldFlags(L"WriteBufferImmediateSupportFlags", options3.WriteBufferImmediateSupportFlags,
-        Enum_D3D12_COMMAND_LIST_SUPPORT_FLAGS);
-    formatter.AddFieldEnum(L"ViewInstancingTier", options3.ViewInstancingTier, Enum_D3D12_VIEW_INSTANCING_TIER);
-    formatter.AddFieldBool(L"BarycentricsSupported", options3.BarycentricsSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4(const D3D12_FEATURE_DATA_D3D12_OPTIONS4& options4)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS4");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MSAA64KBAlignedTextureSupported", options4.MSAA64KBAlignedTextureSupported);
-    formatter.AddFieldEnum(L"SharedResourceCompatibilityTier", options4.SharedResourceCompatibilityTier,
-        Enum_D3D12_SHARED_RESOURCE_COMPATIBILITY_TIER);
-    formatter.AddFieldBool(L"Native16BitShaderOpsSupported", options4.Native16BitShaderOpsSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5(const D3D12_FEATURE_DATA_D3D12_OPTIONS5& options5)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS5");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"SRVOnlyTiledResourceTier3", options5.SRVOnlyTiledResourceTier3);
-    formatter.AddFieldEnum(L"RenderPassesTier", options5.RenderPassesTier, Enum_D3D12_RENDER_PASS_TIER);
-    formatter.AddFieldEnum(L"RaytracingTier", options5.RaytracingTier, Enum_D3D12_RAYTRACING_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6(const D3D12_FEATURE_DATA_D3D12_OPTIONS6& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS6");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"AdditionalShadingRatesSupported", o.AdditionalShadingRatesSupported);
-    formatter.AddFieldBool(L"PerPrimitiveShadingRateSupportedWithViewportIndexing",
-        o.PerPrimitiveShadingRateSupportedWithViewportIndexing);
-    formatter.AddFieldEnum(
-        L"VariableShadingRateTier", o.VariableShadingRateTier, Enum_D3D12_VARIABLE_SHADING_RATE_TIER);
-    formatter.AddFieldUint32(L"ShadingRateImageTileSize", o.ShadingRateImageTileSize);
-    formatter.AddFieldBool(L"BackgroundProcessingSupported", o.BackgroundProcessingSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7(const D3D12_FEATURE_DATA_D3D12_OPTIONS7& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS7");
-    ReportFormatter::GetInstance().AddFieldEnum(L"MeshShaderTier", o.MeshShaderTier, Enum_D3D12_MESH_SHADER_TIER);
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"SamplerFeedbackTier", o.SamplerFeedbackTier, Enum_D3D12_SAMPLER_FEEDBACK_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8(const D3D12_FEATURE_DATA_D3D12_OPTIONS8& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS8");
-    ReportFormatter::GetInstance().AddFieldBool(L"UnalignedBlockTexturesSupported", o.UnalignedBlockTexturesSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9(const D3D12_FEATURE_DATA_D3D12_OPTIONS9& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS9");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MeshShaderPipelineStatsSupported", o.MeshShaderPipelineStatsSupported);
-    formatter.AddFieldBool(
-        L"MeshShaderSupportsFullRangeRenderTargetArrayIndex", o.MeshShaderSupportsFullRangeRenderTargetArrayIndex);
-    formatter.AddFieldBool(L"AtomicInt64OnTypedResourceSupported", o.AtomicInt64OnTypedResourceSupported);
-    formatter.AddFieldBool(L"AtomicInt64OnGroupSharedSupported", o.AtomicInt64OnGroupSharedSupported);
-    formatter.AddFieldBool(
-        L"DerivativesInMeshAndAmplificationShadersSupported", o.DerivativesInMeshAndAmplificationShadersSupported);
-    formatter.AddFieldEnum(L"WaveMMATier", o.WaveMMATier, Enum_D3D12_WAVE_MMA_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10(const D3D12_FEATURE_DATA_D3D12_OPTIONS10& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS10");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"VariableRateShadingSumCombinerSupported", o.VariableRateShadingSumCombinerSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"MeshShaderPerPrimitiveShadingRateSupported", o.MeshShaderPerPrimitiveShadingRateSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11(const D3D12_FEATURE_DATA_D3D12_OPTIONS11& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS11");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"AtomicInt64OnDescriptorHeapResourceSupported", o.AtomicInt64OnDescriptorHeapResourceSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12(const D3D12_FEATURE_DATA_D3D12_OPTIONS12& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS12");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnumSigned(L"MSPrimitivesPipelineStatisticIncludesCulledPrimitives",
-        o.MSPrimitivesPipelineStatisticIncludesCulledPrimitives, Enum_D3D12_TRI_STATE);
-    formatter.AddFieldBool(L"EnhancedBarriersSupported", o.EnhancedBarriersSupported);
-    formatter.AddFieldBool(L"RelaxedFormatCastingSupported", o.RelaxedFormatCastingSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13(const D3D12_FEATURE_DATA_D3D12_OPTIONS13& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS13");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(
-        L"UnrestrictedBufferTextureCopyPitchSupported", o.UnrestrictedBufferTextureCopyPitchSupported);
-    formatter.AddFieldBool(
-        L"UnrestrictedVertexElementAlignmentSupported", o.UnrestrictedVertexElementAlignmentSupported);
-    formatter.AddFieldBool(L"InvertedViewportHeightFlipsYSupported", o.InvertedViewportHeightFlipsYSupported);
-    formatter.AddFieldBool(L"InvertedViewportDepthFlipsZSupported", o.InvertedViewportDepthFlipsZSupported);
-    formatter.AddFieldBool(L"TextureCopyBetweenDimensionsSupported", o.TextureCopyBetweenDimensionsSupported);
-    formatter.AddFieldBool(L"AlphaBlendFactorSupported", o.AlphaBlendFactorSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14(const D3D12_FEATURE_DATA_D3D12_OPTIONS14& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS14");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"AdvancedTextureOpsSupported", o.AdvancedTextureOpsSupported);
-    formatter.AddFieldBool(L"WriteableMSAATexturesSupported", o.WriteableMSAATexturesSupported);
-    formatter.AddFieldBool(
-        L"IndependentFrontAndBackStencilRefMaskSupported", o.IndependentFrontAndBackStencilRefMaskSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15(const D3D12_FEATURE_DATA_D3D12_OPTIONS15& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS15");
-    ReportFormatter::GetInstance().AddFieldBool(L"TriangleFanSupported", o.TriangleFanSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"DynamicIndexBufferStripCutSupported", o.DynamicIndexBufferStripCutSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16(const D3D12_FEATURE_DATA_D3D12_OPTIONS16& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS16");
-    ReportFormatter::GetInstance().AddFieldBool(L"DynamicDepthBiasSupported", o.DynamicDepthBiasSupported);
-    ReportFormatter::GetInstance().AddFieldBool(L"GPUUploadHeapSupported", o.GPUUploadHeapSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17(const D3D12_FEATURE_DATA_D3D12_OPTIONS17& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS17");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"NonNormalizedCoordinateSamplersSupported", o.NonNormalizedCoordinateSamplersSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"ManualWriteTrackingResourceSupported", o.ManualWriteTrackingResourceSupported);
-}
+// Built once per run, maps DXGI adapters to devices reported by vendor APIs and Vulkan.
+static AdapterIndex g_AdapterIndex;
+// Not null when --Capture is used.
+static std::unique_ptr<CaptureWriter> g_CaptureWriter;
 
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18(const D3D12_FEATURE_DATA_D3D12_OPTIONS18& o)
+// Created with --Cache, unless the report is captured or only adapters are listed.
+static std::unique_ptr<ReportCache> g_ReportCache;
+struct AdapterCacheEntry
 {
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS18");
-    ReportFormatter::GetInstance().AddFieldBool(L"RenderPassesValid", o.RenderPassesValid);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19(const D3D12_FEATURE_DATA_D3D12_OPTIONS19& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS19");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MismatchingOutputDimensionsSupported", o.MismatchingOutputDimensionsSupported);
-    formatter.AddFieldUint32(L"SupportedSampleCountsWithNoOutputs", o.SupportedSampleCountsWithNoOutputs);
-    formatter.AddFieldBool(L"PointSamplingAddressesNeverRoundUp", o.PointSamplingAddressesNeverRoundUp);
-    formatter.AddFieldBool(L"RasterizerDesc2Supported", o.RasterizerDesc2Supported);
-    formatter.AddFieldBool(L"NarrowQuadrilateralLinesSupported", o.NarrowQuadrilateralLinesSupported);
-    formatter.AddFieldBool(L"AnisoFilterWithPointMipSupported", o.AnisoFilterWithPointMipSupported);
-    formatter.AddFieldUint32(L"MaxSamplerDescriptorHeapSize", o.MaxSamplerDescriptorHeapSize);
-    formatter.AddFieldUint32(
-        L"MaxSamplerDescriptorHeapSizeWithStaticSamplers", o.MaxSamplerDescriptorHeapSizeWithStaticSamplers);
-    formatter.AddFieldUint32(L"MaxViewDescriptorHeapSize", o.MaxViewDescriptorHeapSize);
-    formatter.AddFieldBool(L"ComputeOnlyCustomHeapSupported", o.ComputeOnlyCustomHeapSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20(const D3D12_FEATURE_DATA_D3D12_OPTIONS20& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS20");
-    ReportFormatter::GetInstance().AddFieldBool(L"ComputeOnlyWriteWatchSupported", o.ComputeOnlyWriteWatchSupported);
-    ReportFormatter::GetInstance().AddFieldEnum(L"RecreateAtTier", o.RecreateAtTier, Enum_D3D12_RECREATE_AT_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21(const D3D12_FEATURE_DATA_D3D12_OPTIONS21& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS21");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnum(L"WorkGraphsTier", o.WorkGraphsTier, Enum_D3D12_WORK_GRAPHS_TIER);
-    formatter.AddFieldEnum(L"ExecuteIndirectTier", o.ExecuteIndirectTier, Enum_D3D12_EXECUTE_INDIRECT_TIER);
-    formatter.AddFieldBool(L"SampleCmpGradientAndBiasSupported", o.SampleCmpGradientAndBiasSupported);
-    formatter.AddFieldBool(L"ExtendedCommandInfoSupported", o.ExtendedCommandInfoSupported);
-}
+    ReportCacheKey m_Key;
+    // Null if not found in the cache.
+    std::unique_ptr<RecordingReportFormatter> m_Report;
+};
+// Looked up by BuildAdapterIndex, before vendor libraries are initialized, so they are skipped for adapters found in
+// the cache. Not modified later, so adapters inspected in parallel can read them.
+static std::unordered_map<uint64_t, AdapterCacheEntry> g_AdapterCacheEntries;
+// Keys of all adapters, as data of vendor libraries in System Info depends on all of them.
+static std::vector<ReportCacheKey> g_SystemCacheKeys;
+// Null if not found in the cache.
+static std::unique_ptr<RecordingReportFormatter> g_CachedSystemReport;
+
+// Created with --Timings, for phases not specific to an adapter. Each adapter has its own TimingRecorder.
+static std::unique_ptr<TimingRecorder> g_GlobalTimings;
+// Individual calls listed in Timings of each adapter.
+static const size_t TIMINGS_SLOWEST_CALL_COUNT = 10;
+
+// Vendor libraries don't promise to be thread-safe, so adapters inspected in parallel call them one at a time.
+static std::mutex g_VendorApiMutex;
+
+// Libraries of GPU vendors and Vulkan. Each is initialized on first use, and only if an adapter inspected needs it, so
+// e.g. NVAPI is not loaded and Vulkan instance not created when no adapter would print their data. Devices reported
+// by a library are registered in g_AdapterIndex when it is initialized.
+class VendorApis
+{
+public:
+    // Call for all adapters inspected before any Get function.
+    void AddAdapterVendor(uint32_t vendorId)
+    {
+        m_Selection.AddAdapterVendor(vendorId);
+    }
 
-static void Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED(
-    const D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
+    // Return null if the library is not needed. Otherwise it still may have failed to initialize.
+    NvAPI_Inititalize_RAII* GetNvApi();
+    AGS_Initialize_RAII* GetAgs();
+    AmdDeviceInfo_Initialize_RAII* GetAmdDeviceInfo();
+    Vulkan_Initialize_RAII* GetVulkan();
+
+private:
+    VendorLibrarySelection m_Selection{ g_ForceVendorAPI, g_PureD3D12 };
+    LazyVendorLibrary<NvAPI_Inititalize_RAII> m_NvApi{ L"NvAPI_Inititalize_RAII" };
+    LazyVendorLibrary<AGS_Initialize_RAII> m_Ags{ L"AGS_Initialize_RAII" };
+    LazyVendorLibrary<AmdDeviceInfo_Initialize_RAII> m_AmdDeviceInfo{ L"AmdDeviceInfo_Initialize_RAII" };
+    LazyVendorLibrary<Vulkan_Initialize_RAII> m_Vulkan{ L"Vulkan_Initialize_RAII" };
+};
 
-static void Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT(const D3D12_FEATURE_DATA_TIGHT_ALIGNMENT& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_TIGHT_ALIGNMENT");
-    ReportFormatter::GetInstance().AddFieldEnum(L"SupportTier", o.SupportTier, Enum_D3D12_TIGHT_ALIGNMENT_TIER);
-}
+// Initialization is timed globally, as it happens on whichever thread needs the library first.
 
-#ifndef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(
-    const D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT & shaderCacheABISupport)
+NvAPI_Inititalize_RAII* VendorApis::GetNvApi()
 {
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT");
-    ReportFormatter::GetInstance().AddFieldString(L"szAdapterFamily", shaderCacheABISupport.szAdapterFamily);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"MinimumABISupportVersion", shaderCacheABISupport.MinimumABISupportVersion);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"MaximumABISupportVersion", shaderCacheABISupport.MaximumABISupportVersion);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"CompilerVersion", shaderCacheABISupport.CompilerVersion.Version);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"ApplicationProfileVersion", shaderCacheABISupport.ApplicationProfileVersion.Version);
-}
+#if USE_NVAPI
+    return m_NvApi.Get(m_Selection.IsVendorNeeded(VENDOR_ID_NVIDIA), g_GlobalTimings.get(), []() {
+        auto nvApi = std::make_unique<NvAPI_Inititalize_RAII>();
+        if(nvApi->IsInitialized())
+        {
+            std::vector<AdapterIdentity> identities;
+            nvApi->GetPhysicalGpuIdentities(identities);
+            g_AdapterIndex.SetSourceDevices(ADAPTER_SOURCE_NVAPI, std::move(identities), { ADAPTER_MATCH_KEY_LUID });
+        }
+        return nvApi;
+    });
+#else
+    return nullptr;
 #endif
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL(const D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnum(L"CooperativeVectorTier", o.CooperativeVectorTier, Enum_D3D12_COOPERATIVE_VECTOR_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS(
-    const D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"ComputeQueuesPer3DQueue", o.ComputeQueuesPer3DQueue);
-}
-
-static void Print_D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL(const D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL& o)
-{
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnum(L"InputType", o.InputType, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldEnum(L"InputInterpretation", o.InputInterpretation, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldEnum(L"MatrixInterpretation", o.MatrixInterpretation, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldEnum(L"BiasInterpretation", o.BiasInterpretation, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldEnum(L"OutputType", o.OutputType, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldBool(L"TransposeSupported", o.TransposeSupported);
-}
-
-static void Print_D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE(
-    const D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE& o)
-{
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnum(L"InputType", o.InputType, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
-    formatter.AddFieldEnum(L"AccumulationType", o.AccumulationType, Enum_D3D12_LINEAR_ALGEBRA_DATATYPE);
 }
 
-static void Print_D3D12_FEATURE_DATA_COOPERATIVE_VECTOR(const D3D12_FEATURE_DATA_COOPERATIVE_VECTOR& o)
+AGS_Initialize_RAII* VendorApis::GetAgs()
 {
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COOPERATIVE_VECTOR");
-
-    {
-        ReportScopeArray scopeArray(L"pMatrixVectorMulAddProperties");
-        for(UINT i = 0; i < o.MatrixVectorMulAddPropCount; ++i)
-        {
-            ReportScopeArrayItem scopeItem;
-            Print_D3D12_COOPERATIVE_VECTOR_PROPERTIES_MUL(o.pMatrixVectorMulAddProperties[i]);
-        }
-    }
-
-    {
-        ReportScopeArray scopeArray(L"pOuterProductAccumulateProperties");
-        for(UINT i = 0; i < o.OuterProductAccumulatePropCount; ++i)
-        {
-            ReportScopeArrayItem scopeItem;
-            Print_D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE(o.pOuterProductAccumulateProperties[i]);
-        }
-    }
-
-    {
-        ReportScopeArray scopeArray(L"pVectorAccumulateProperties");
-        for(UINT i = 0; i < o.VectorAccumulatePropCount; ++i)
+#if USE_AGS
+    return m_Ags.Get(m_Selection.IsVendorNeeded(VENDOR_ID_AMD), g_GlobalTimings.get(), []() {
+        auto ags = std::make_unique<AGS_Initialize_RAII>();
+        if(ags->IsInitialized())
         {
-            ReportScopeArrayItem scopeItem;
-            Print_D3D12_COOPERATIVE_VECTOR_PROPERTIES_ACCUMULATE(o.pVectorAccumulateProperties[i]);
+            std::vector<AdapterIdentity> identities;
+            ags->GetDeviceIdentities(identities);
+            g_AdapterIndex.SetSourceDevices(
+                ADAPTER_SOURCE_AGS, std::move(identities), { ADAPTER_MATCH_KEY_VENDOR_DEVICE_REVISION });
         }
-    }
+        return ags;
+    });
+#else
+    return nullptr;
+#endif
 }
-#endif // #ifdef USE_PREVIEW_AGILITY_SDK
 
-static void Print_D3D12_FEATURE_DATA_EXISTING_HEAPS(const D3D12_FEATURE_DATA_EXISTING_HEAPS& existingHeaps)
+AmdDeviceInfo_Initialize_RAII* VendorApis::GetAmdDeviceInfo()
 {
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_EXISTING_HEAPS");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", existingHeaps.Supported);
+#if USE_AMD_DEVICE_INFO
+    return m_AmdDeviceInfo.Get(m_Selection.IsVendorNeeded(VENDOR_ID_AMD), g_GlobalTimings.get(), []() {
+        auto amdDeviceInfo = std::make_unique<AmdDeviceInfo_Initialize_RAII>();
+        g_AdapterIndex.SetSourceResolver(ADAPTER_SOURCE_AMD_DEVICE_INFO, [](const AdapterIdentity& adapter) {
+            const size_t index =
+                AmdDeviceInfo_Initialize_RAII::FindCardInfoIndex({ *adapter.m_DeviceId, *adapter.m_RevisionId });
+            if(index == SIZE_MAX)
+                return AdapterMatch{};
+            return AdapterMatch{ AdapterMatch::RESULT_FOUND, index };
+        });
+        return amdDeviceInfo;
+    });
+#else
+    return nullptr;
+#endif
 }
 
-static void Print_DXGI_QUERY_VIDEO_MEMORY_INFO(const DXGI_QUERY_VIDEO_MEMORY_INFO& videoMemoryInfo)
+Vulkan_Initialize_RAII* VendorApis::GetVulkan()
 {
-    // Not printing videoMemoryInfo.CurrentUsage, videoMemoryInfo.CurrentReservation.
-    ReportFormatter::GetInstance().AddFieldSize(L"Budget", videoMemoryInfo.Budget);
-    ReportFormatter::GetInstance().AddFieldSize(L"AvailableForReservation", videoMemoryInfo.AvailableForReservation);
+#if USE_VULKAN
+    // Data from Vulkan is printed for adapters of any vendor, but there is no Vulkan device for WARP.
+    return m_Vulkan.Get(!g_WARP && m_Selection.IsAnyVendorNeeded(), g_GlobalTimings.get(), []() {
+        auto vk = std::make_unique<Vulkan_Initialize_RAII>();
+        if(vk->IsInitialized())
+        {
+            std::vector<AdapterIdentity> identities;
+            vk->GetPhysicalDeviceIdentities(identities);
+            g_AdapterIndex.SetSourceDevices(ADAPTER_SOURCE_VULKAN, std::move(identities),
+                { ADAPTER_MATCH_KEY_LUID, ADAPTER_MATCH_KEY_VENDOR_DEVICE });
+        }
+        return vk;
+    });
+#else
+    return nullptr;
+#endif
 }
 
 #ifdef _DEBUG
@@ -598,73 +303,96 @@ static wstring MakeCurrentDate()
     return wstring{ dateStr };
 }
 
-static void PrintVersionHeader()
+static wstring MakeCurrentDateTime()
 {
-#ifdef USE_PREVIEW_AGILITY_SDK
-    const wchar_t* const AGILITY_SDK_NOTE = L" (preview Agility SDK)";
-#else
-    const wchar_t* const AGILITY_SDK_NOTE = L"";
-#endif
-    Printer::PrintString(L"============================\n");
-    Printer::PrintFormat(L"D3D12INFO {}{}\n", std::make_wformat_args(PROGRAM_VERSION, AGILITY_SDK_NOTE));
-    Printer::PrintFormat(L"BuildDate: {}\n", std::make_wformat_args(BUILD_TIME));
-    Printer::PrintFormat(L"Configuration: {}, {}\n", std::make_wformat_args(CONFIG_STR, CONFIG_BIT_STR));
-    Printer::PrintString(L"============================");
+    std::time_t time = std::time(nullptr);
+    std::tm time2;
+    localtime_s(&time2, &time);
+    wchar_t dateTimeStr[32];
+    std::wcsftime(dateTimeStr, _countof(dateTimeStr), L"%Y-%m-%d %H:%M:%S", &time2);
+    return wstring{ dateTimeStr };
 }
 
-static void PrintVersionData()
+// Prints what printFunc prints, and with --Capture also records it in the capture, to be replayed as it is.
+static void PrintCaptured(CAPTURE_REPORT report, const std::function<void()>& printFunc)
 {
-    if(IsTextOutput())
+    if(!g_CaptureWriter)
     {
-        PrintVersionHeader();
-        Printer::PrintNewLine();
-        Printer::PrintNewLine();
+        printFunc();
+        return;
     }
-
-    ReportScopeObject scope(SelectString(L"General", L"Header"));
     ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    if(IsJsonOutput())
-    {
-        formatter.AddFieldString(L"Program", L"D3d12info");
-        formatter.AddFieldString(L"Version", PROGRAM_VERSION);
-        formatter.AddFieldString(L"Build Date", BUILD_TIME);
-        formatter.AddFieldString(L"Configuration", CONFIG_STR);
-        formatter.AddFieldString(L"Configuration bits", CONFIG_BIT_STR);
-    }
-    formatter.AddFieldString(L"Generated on", MakeCurrentDate().c_str());
-#ifdef USE_PREVIEW_AGILITY_SDK
-    if(IsJsonOutput())
+    RecordingReportFormatter recording;
+    try
     {
-        formatter.AddFieldBool(L"Using preview Agility SDK", true);
+        ReportContext recordingContext(recording, ReportFormatter::GetFlags());
+        ReportContextScope contextScope(recordingContext);
+        printFunc();
     }
-    formatter.AddFieldUint32(L"D3D12_PREVIEW_SDK_VERSION", uint32_t(D3D12SDKVersion));
-#else
-    if(IsJsonOutput())
+    catch(...)
     {
-        formatter.AddFieldBool(L"Using preview Agility SDK", false);
+        recording.Replay(formatter);
+        throw;
     }
-    formatter.AddFieldUint32(L"D3D12_SDK_VERSION", uint32_t(D3D12SDKVersion));
+    recording.Replay(formatter);
+    g_CaptureWriter->AddReport(report, recording);
+}
+
+static ReportHeader MakeReportHeader()
+{
+    ReportHeader header;
+    header.m_ProgramVersion = PROGRAM_VERSION;
+    header.m_BuildDate = BUILD_TIME;
+    header.m_Configuration = CONFIG_STR;
+    header.m_ConfigurationBits = CONFIG_BIT_STR;
+    header.m_GeneratedOn = MakeCurrentDate();
+    header.m_D3D12SdkVersion = (uint32_t)D3D12SDKVersion;
+#ifdef USE_PREVIEW_AGILITY_SDK
+    header.m_PreviewAgilitySdk = true;
 #endif
+    return header;
+}
 
-    if(!g_PureD3D12)
-    {
+static void PrintVersionHeader()
+{
+    PrintReportBanner(MakeReportHeader());
+}
+
+static void PrintVendorStaticParams()
+{
+    if(g_PureD3D12)
+        return;
 #if USE_NVAPI
-        NvAPI_Inititalize_RAII::PrintStaticParams();
+    NvAPI_Inititalize_RAII::PrintStaticParams();
 #endif
 #if USE_AGS
-        AGS_Initialize_RAII::PrintStaticParams();
+    AGS_Initialize_RAII::PrintStaticParams();
 #endif
 #if USE_AMD_DEVICE_INFO
-        AmdDeviceInfo_Initialize_RAII::PrintStaticParams();
+    AmdDeviceInfo_Initialize_RAII::PrintStaticParams();
 #endif
 #if USE_VULKAN
-        Vulkan_Initialize_RAII::PrintStaticParams();
+    Vulkan_Initialize_RAII::PrintStaticParams();
 #endif
 #if USE_INTEL_GPUDETECT
-        IntelData::PrintStaticParams();
+    IntelData::PrintStaticParams();
 #endif
+}
+
+static void PrintVersionData()
+{
+    const ReportHeader header = MakeReportHeader();
+    if(g_CaptureWriter)
+    {
+        g_CaptureWriter->AddReportHeader(header);
+        // So the structures can be decoded without their declarations, e.g. by CaptureReplay on another platform.
+        g_CaptureWriter->AddStructDescs(StructCollection::GetInstance(), EnumCollection::GetInstance());
+        g_CaptureWriter->AddEnum(L"DXGI_ADAPTER_FLAG", Enum_DXGI_ADAPTER_FLAG);
+        g_CaptureWriter->AddEnum(L"DXGI_GRAPHICS_PREEMPTION_GRANULARITY", Enum_DXGI_GRAPHICS_PREEMPTION_GRANULARITY);
+        g_CaptureWriter->AddEnum(L"DXGI_COMPUTE_PREEMPTION_GRANULARITY", Enum_DXGI_COMPUTE_PREEMPTION_GRANULARITY);
     }
+    PrintReportHeader(
+        header, g_EnumDictionaryHash, []() { PrintCaptured(CAPTURE_REPORT_VENDOR_PARAMS, PrintVendorStaticParams); });
 }
 
 static void PrintEnums()
@@ -683,9 +411,77 @@ static void PrintEnums()
     }
 }
 
+// Serializes all registered enums to JSON, sorted by enum name, so the result depends only on the registry content.
+static string SerializeEnumDictionary()
+{
+    EnumCollection& enumCollection = EnumCollection::GetInstance();
+    std::vector<const std::pair<const wstring, const EnumItem*>*> enums;
+    enums.reserve(enumCollection.m_Enums.size());
+    for(const auto& it : enumCollection.m_Enums)
+        enums.push_back(&it);
+    std::sort(enums.begin(), enums.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+    string result = "{\n";
+    for(size_t enumIndex = 0; enumIndex < enums.size(); ++enumIndex)
+    {
+        result += std::format("    \"{}\": {{", WstrToStr(enums[enumIndex]->first.c_str(), CP_UTF8));
+        for(const EnumItem* item = enums[enumIndex]->second; item->m_Name != nullptr; ++item)
+        {
+            result += std::format("{}\n        \"{}\": {}", item == enums[enumIndex]->second ? "" : ",",
+                WstrToStr(item->m_Name, CP_UTF8), item->m_Value);
+        }
+        result += enumIndex + 1 < enums.size() ? "\n    },\n" : "\n    }\n";
+    }
+    result += "}\n";
+    return result;
+}
+
+// Writes the enum dictionary to file named by hash of its content, unless it already exists.
+// Returns the hash.
+static wstring WriteEnumDictionary(const wstring& directoryPath)
+{
+    const string dictionary = SerializeEnumDictionary();
+    const wstring hash = std::format(L"{:016X}", CalculateHash(dictionary.data(), dictionary.size()));
+
+    const std::filesystem::path filePath =
+        std::filesystem::path(directoryPath) / std::format(L"{}_Enums_{}.json", PROGRAM_NAME, hash);
+    // A file of different size was left partially written by an older version, which wrote it in place.
+    std::error_code errorCode;
+    if(std::filesystem::file_size(filePath, errorCode) == dictionary.size() && !errorCode)
+        return hash;
+
+    // Written under a unique name and then renamed, like entries of ReportCache, as multiple processes can write the
+    // same dictionary at once.
+    std::filesystem::create_directories(directoryPath, errorCode);
+    std::filesystem::path tempPath = filePath;
+    tempPath += std::format(L".{:08X}.tmp", std::random_device{}());
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error(std::format("Could not open enum dictionary file \"{}\".", tempPath.string()));
+        file.write(dictionary.data(), (std::streamsize)dictionary.size());
+        file.close();
+        if(!file)
+        {
+            std::filesystem::remove(tempPath, errorCode);
+            throw std::runtime_error(
+                std::format("Could not write enum dictionary file \"{}\".", tempPath.string()));
+        }
+    }
+    std::filesystem::rename(tempPath, filePath, errorCode);
+    if(errorCode)
+    {
+        std::filesystem::remove(tempPath, errorCode);
+        // Renaming fails when another process has the file open, after writing the same one.
+        if(std::filesystem::exists(filePath, errorCode))
+            return hash;
+        throw std::runtime_error(std::format("Could not write enum dictionary file \"{}\".", filePath.string()));
+    }
+    return hash;
+}
+
 static void PrintDXGIFeatureInfo()
 {
-    ReportScopeObject scope(L"DXGI_FEATURE");
     ComPtr<IDXGIFactory5> dxgiFactory = nullptr;
     HRESULT hr;
 #if defined(AUTO_LINK_DX12)
@@ -693,14 +489,20 @@ static void PrintDXGIFeatureInfo()
 #else
     hr = g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory));
 #endif
-    if(FAILED(hr) || !dxgiFactory)
-        return;
-    BOOL allowTearing = FALSE;
-    hr = dxgiFactory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
-    if(SUCCEEDED(hr))
+    std::optional<BOOL> allowTearing;
+    if(SUCCEEDED(hr) && dxgiFactory)
     {
-        ReportFormatter::GetInstance().AddFieldBool(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", allowTearing);
+        BOOL value = FALSE;
+        hr = dxgiFactory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &value, sizeof(value));
+        if(SUCCEEDED(hr))
+            allowTearing = value;
+        if(g_CaptureWriter)
+        {
+            g_CaptureWriter->AddUint32(
+                CAPTURE_TAG_DXGI_FEATURE, DXGI_FEATURE_PRESENT_ALLOW_TEARING, (uint32_t)value, hr);
+        }
     }
+    PrintDXGIFeatureInfo(allowTearing);
 }
 
 static void EnableExperimentalFeatures()
@@ -780,81 +582,70 @@ static void DetectTranslationLayersGlobal()
     }
 }
 
-static void PrintAdapterDescMembers(const DXGI_ADAPTER_DESC& desc)
-{
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldString(L"Description", desc.Description);
-    formatter.AddFieldVendorId(L"VendorId", desc.VendorId);
-    formatter.AddFieldHex32(L"DeviceId", desc.DeviceId);
-    formatter.AddFieldSubsystemId(L"SubSysId", desc.SubSysId);
-    formatter.AddFieldHex32(L"Revision", desc.Revision);
-    formatter.AddFieldSize(L"DedicatedVideoMemory", desc.DedicatedVideoMemory);
-    formatter.AddFieldSize(L"DedicatedSystemMemory", desc.DedicatedSystemMemory);
-    formatter.AddFieldSize(L"SharedSystemMemory", desc.SharedSystemMemory);
-    formatter.AddFieldString(L"AdapterLuid", LuidToStr(desc.AdapterLuid).c_str());
-}
-
-static void PrintAdapterDesc1Members(const DXGI_ADAPTER_DESC1& desc1)
-{
-    PrintAdapterDescMembers((const DXGI_ADAPTER_DESC&)desc1);
-    ReportFormatter::GetInstance().AddFieldFlags(L"Flags", desc1.Flags, Enum_DXGI_ADAPTER_FLAG);
-}
-
-static void PrintAdapterDesc2Members(const DXGI_ADAPTER_DESC2& desc2)
-{
-    PrintAdapterDesc1Members((const DXGI_ADAPTER_DESC1&)desc2);
-    ReportFormatter::GetInstance().AddFieldEnum(L"GraphicsPreemptionGranularity", desc2.GraphicsPreemptionGranularity,
-        Enum_DXGI_GRAPHICS_PREEMPTION_GRANULARITY);
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"ComputePreemptionGranularity", desc2.ComputePreemptionGranularity, Enum_DXGI_COMPUTE_PREEMPTION_GRANULARITY);
-}
-
-static void PrintAdapterDesc(const DXGI_ADAPTER_DESC& desc)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC");
-    PrintAdapterDescMembers(desc);
+static CaptureAdapterDesc MakeCaptureAdapterDesc(const DXGI_ADAPTER_DESC3& desc)
+{
+    CaptureAdapterDesc result;
+    result.m_Description = desc.Description;
+    result.m_VendorId = desc.VendorId;
+    result.m_DeviceId = desc.DeviceId;
+    result.m_SubSysId = desc.SubSysId;
+    result.m_Revision = desc.Revision;
+    result.m_DedicatedVideoMemory = desc.DedicatedVideoMemory;
+    result.m_DedicatedSystemMemory = desc.DedicatedSystemMemory;
+    result.m_SharedSystemMemory = desc.SharedSystemMemory;
+    result.m_AdapterLuid = LuidToUint64(desc.AdapterLuid);
+    result.m_Flags = (uint32_t)desc.Flags;
+    result.m_GraphicsPreemptionGranularity = (uint32_t)desc.GraphicsPreemptionGranularity;
+    result.m_ComputePreemptionGranularity = (uint32_t)desc.ComputePreemptionGranularity;
+    return result;
+}
+
+static DXGI_ADAPTER_DESC3 MakeAdapterDesc(const CaptureAdapterDesc& desc)
+{
+    DXGI_ADAPTER_DESC3 result = {};
+    wcsncpy_s(result.Description, desc.m_Description.c_str(), _TRUNCATE);
+    result.VendorId = desc.m_VendorId;
+    result.DeviceId = desc.m_DeviceId;
+    result.SubSysId = desc.m_SubSysId;
+    result.Revision = desc.m_Revision;
+    result.DedicatedVideoMemory = (SIZE_T)desc.m_DedicatedVideoMemory;
+    result.DedicatedSystemMemory = (SIZE_T)desc.m_DedicatedSystemMemory;
+    result.SharedSystemMemory = (SIZE_T)desc.m_SharedSystemMemory;
+    result.AdapterLuid.LowPart = (DWORD)desc.m_AdapterLuid;
+    result.AdapterLuid.HighPart = (LONG)(desc.m_AdapterLuid >> 32);
+    result.Flags = (DXGI_ADAPTER_FLAG3)desc.m_Flags;
+    result.GraphicsPreemptionGranularity = (DXGI_GRAPHICS_PREEMPTION_GRANULARITY)desc.m_GraphicsPreemptionGranularity;
+    result.ComputePreemptionGranularity = (DXGI_COMPUTE_PREEMPTION_GRANULARITY)desc.m_ComputePreemptionGranularity;
+    return result;
 }
 
-static void PrintAdapterDesc1(const DXGI_ADAPTER_DESC1& desc1)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC1");
-    PrintAdapterDesc1Members(desc1);
-}
-
-static void PrintAdapterDesc2(const DXGI_ADAPTER_DESC2& desc2)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC2");
-    PrintAdapterDesc2Members(desc2);
-}
-
-static void PrintAdapterDesc3(const DXGI_ADAPTER_DESC3& desc3)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC3");
-    // Same members as DESC2. They only added new items to Flags.
-    PrintAdapterDesc2Members((const DXGI_ADAPTER_DESC2&)desc3);
-}
-
-static void PrintAdapterDesc(IDXGIAdapter* adapter)
+static void PrintAdapterDesc(IDXGIAdapter* adapter)
 {
+    DXGI_ADAPTER_DESC3 desc = {};
+    uint32_t descVersion = 0;
+    HRESULT hr;
     if(ComPtr<IDXGIAdapter4> adapter4; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter4))))
     {
-        if(DXGI_ADAPTER_DESC3 desc3; SUCCEEDED(adapter4->GetDesc3(&desc3)))
-            PrintAdapterDesc3(desc3);
+        descVersion = 3;
+        hr = adapter4->GetDesc3(&desc);
     }
     else if(ComPtr<IDXGIAdapter2> adapter2; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter2))))
     {
-        if(DXGI_ADAPTER_DESC2 desc2; SUCCEEDED(adapter2->GetDesc2(&desc2)))
-            PrintAdapterDesc2(desc2);
+        descVersion = 2;
+        hr = adapter2->GetDesc2((DXGI_ADAPTER_DESC2*)&desc);
     }
     else if(ComPtr<IDXGIAdapter1> adapter1; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter1))))
     {
-        if(DXGI_ADAPTER_DESC1 desc1; SUCCEEDED(adapter1->GetDesc1(&desc1)))
-            PrintAdapterDesc1(desc1);
-    }
-    else if(DXGI_ADAPTER_DESC desc; SUCCEEDED(adapter->GetDesc(&desc)))
-    {
-        PrintAdapterDesc(desc);
+        descVersion = 1;
+        hr = adapter1->GetDesc1((DXGI_ADAPTER_DESC1*)&desc);
     }
+    else
+        hr = adapter->GetDesc((DXGI_ADAPTER_DESC*)&desc);
+
+    if(g_CaptureWriter)
+        g_CaptureWriter->AddAdapterDesc(descVersion, MakeCaptureAdapterDesc(desc), hr);
+    if(SUCCEEDED(hr))
+        PrintAdapterDesc(descVersion, desc);
 }
 
 static void PrintAdapterMemoryInfo(IDXGIAdapter* adapter)
@@ -868,22 +659,13 @@ static void PrintAdapterMemoryInfo(IDXGIAdapter* adapter)
             if(SUCCEEDED(
                    adapter3->QueryVideoMemoryInfo(0, (DXGI_MEMORY_SEGMENT_GROUP)memorySegmentGroup, &videoMemoryInfo)))
             {
-                const wchar_t* structName = nullptr;
-                switch(memorySegmentGroup)
-                {
-                case 0:
-                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_LOCAL]";
-                    break;
-                case 1:
-                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL]";
-                    break;
-                default:
-                    assert(0);
-                }
+                if(g_CaptureWriter)
                 {
-                    ReportScopeObject scope(structName);
-                    Print_DXGI_QUERY_VIDEO_MEMORY_INFO(videoMemoryInfo);
+                    g_CaptureWriter->AddVideoMemoryInfo(memorySegmentGroup,
+                        { videoMemoryInfo.Budget, videoMemoryInfo.CurrentUsage, videoMemoryInfo.AvailableForReservation,
+                            videoMemoryInfo.CurrentReservation });
                 }
+                PrintAdapterMemoryInfo(memorySegmentGroup, videoMemoryInfo);
             }
         }
     }
@@ -893,8 +675,9 @@ static void PrintAdapterInterfaceSupport(IDXGIAdapter* adapter)
 {
     if(LARGE_INTEGER i; SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &i)))
     {
-        ReportScopeObject scope(L"CheckInterfaceSupport");
-        ReportFormatter::GetInstance().AddFieldMicrosoftVersion(L"UMDVersion", i.QuadPart);
+        if(g_CaptureWriter)
+            g_CaptureWriter->AddUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, (uint64_t)i.QuadPart);
+        PrintAdapterInterfaceSupport((uint64_t)i.QuadPart);
     }
 }
 
@@ -906,97 +689,24 @@ static void PrintAdapterData(IDXGIAdapter* adapter)
     PrintAdapterInterfaceSupport(adapter);
 }
 
-enum class FormatSupportResult
-{
-    Ok,
-    Failed,
-    Crashed
-};
-
-static FormatSupportResult CheckFormatSupport(ID3D12Device* device, D3D12_FEATURE_DATA_FORMAT_SUPPORT& formatSupport)
+static bool MatchesAdapterFilter(const DXGI_ADAPTER_DESC1& desc)
 {
-    __try
-    {
-        const HRESULT hr =
-            device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, UINT(sizeof formatSupport));
-        return SUCCEEDED(hr) ? FormatSupportResult::Ok : FormatSupportResult::Failed;
-    }
-    // This is needed because latest (as of November 2023) AMD drivers crash when calling:
-    // ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, DXGI_FORMAT_A4B4G4R4_UNORM)
-    __except(EXCEPTION_EXECUTE_HANDLER)
-    {
-        return FormatSupportResult::Crashed;
-    }
+    return g_AdapterFilter.Matches({ .m_Description = desc.Description,
+        .m_VendorName = FindEnumItemName(desc.VendorId, Enum_VendorId),
+        .m_VendorId = desc.VendorId,
+        .m_DeviceId = desc.DeviceId,
+        .m_Luid = LuidToUint64(desc.AdapterLuid),
+        .m_DedicatedVideoMemory = desc.DedicatedVideoMemory,
+        .m_Flags = desc.Flags });
 }
 
-static void PrintFormatInformation(ID3D12Device* device)
+// When all adapters are shown: the ones matching the filter, or all except software ones, unless --AllAdapters is
+// used. Checked before a device is created for the adapter or vendor libraries are initialized for it.
+static bool IsAdapterInspected(const DXGI_ADAPTER_DESC1& desc)
 {
-    ReportScopeObject scope(L"Formats");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {};
-    D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS msQualityLevels = {};
-    D3D12_FEATURE_DATA_FORMAT_INFO formatInfo = {};
-    for(size_t formatIndex = 0; Enum_DXGI_FORMAT[formatIndex].m_Name != nullptr; ++formatIndex)
-    {
-        const DXGI_FORMAT format = (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value;
-        const wchar_t* name = Enum_DXGI_FORMAT[formatIndex].m_Name;
-
-        formatSupport.Format = format;
-
-        const FormatSupportResult formatSupportResult = CheckFormatSupport(device, formatSupport);
-        if(formatSupportResult == FormatSupportResult::Crashed)
-        {
-            ErrorPrinter::PrintFormat(
-                L"ERROR: ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, {}) crashed.\n",
-                std::make_wformat_args(name));
-            break;
-        }
-
-        ReportScopeObjectConditional scope2(SelectString(name, std::format(L"{}", (size_t)format)));
-
-        if(formatSupportResult == FormatSupportResult::Ok)
-        {
-            scope2.Enable();
-            formatter.AddFieldFlags(L"Support1", formatSupport.Support1, Enum_D3D12_FORMAT_SUPPORT1);
-            formatter.AddFieldFlags(L"Support2", formatSupport.Support2, Enum_D3D12_FORMAT_SUPPORT2);
-
-            ReportScopeObjectConditional scope3(IsJsonOutput(), L"MultisampleQualityLevels");
-            msQualityLevels.Format = format;
-            for(msQualityLevels.SampleCount = 1;; msQualityLevels.SampleCount *= 2)
-            {
-                if(SUCCEEDED(device->CheckFeatureSupport(
-                       D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS, &msQualityLevels, UINT(sizeof msQualityLevels))) &&
-                    msQualityLevels.NumQualityLevels > 0)
-                {
-                    if(IsJsonOutput())
-                    {
-                        ReportScopeObject scope4(std::format(L"{}", msQualityLevels.SampleCount));
-                        formatter.AddFieldUint32(L"NumQualityLevels", msQualityLevels.NumQualityLevels);
-                        formatter.AddFieldUint32(L"Flags", uint32_t(msQualityLevels.Flags));
-                    }
-                    else
-                    {
-                        bool multisampleTiled =
-                            (msQualityLevels.Flags & D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE) != 0;
-                        formatter.AddFieldString(L"SampleCount",
-                            std::format(L"{}: NumQualityLevels = {}{}", msQualityLevels.SampleCount,
-                                msQualityLevels.NumQualityLevels,
-                                multisampleTiled ? L"  D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE" : L""));
-                    }
-                }
-                else
-                    break;
-            }
-        }
-
-        formatInfo.Format = format;
-        if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_INFO, &formatInfo, UINT(sizeof formatInfo))))
-        {
-            scope2.Enable();
-            formatter.AddFieldUint32(L"PlaneCount", formatInfo.PlaneCount);
-        }
-    }
+    if(!g_AdapterFilter.IsEmpty())
+        return MatchesAdapterFilter(desc);
+    return !g_SkipSoftwareAdapter || (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) == 0;
 }
 
 void DetectTranslationLayersDevice(ID3D12Device* device)
@@ -1020,120 +730,10 @@ void DetectTranslationLayersDevice(ID3D12Device* device)
     }
 }
 
-static void PrintDeviceOptions(ID3D12Device* device)
-{
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1(options1);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS2 options2 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS2, &options2, sizeof(options2))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2(options2);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS3 options3 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS3, &options3, sizeof(options3))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3(options3);
-
-    if(D3D12_FEATURE_DATA_EXISTING_HEAPS existingHeaps = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_EXISTING_HEAPS, &existingHeaps, sizeof(existingHeaps))))
-        Print_D3D12_FEATURE_DATA_EXISTING_HEAPS(existingHeaps);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4(options4);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS5 options5 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options5, sizeof(options5))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5(options5);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6(options6);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7(options7);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS8 options8 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS8, &options8, sizeof(options8))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8(options8);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS9 options9 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS9, &options9, sizeof(options9))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9(options9);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS10 options10 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS10, &options10, sizeof(options10))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10(options10);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS11 options11 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS11, &options11, sizeof(options11))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11(options11);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12(options12);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS13 options13 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS13, &options13, sizeof(options13))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13(options13);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS14 options14 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS14, &options14, sizeof(options14))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14(options14);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS15 options15 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS15, &options15, sizeof(options15))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15(options15);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &options16, sizeof(options16))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16(options16);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS17 options17 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS17, &options17, sizeof(options17))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17(options17);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS18 options18 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS18, &options18, sizeof(options18))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18(options18);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS19 options19 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS19, &options19, sizeof(options19))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19(options19);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS20 options20 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS20, &options20, sizeof(options20))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20(options20);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS21 options21 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS21, &options21, sizeof(options21))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21(options21);
-
-    if(D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED bytecodeBypassHashSupported = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED,
-            &bytecodeBypassHashSupported, sizeof(bytecodeBypassHashSupported))))
-        Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED(bytecodeBypassHashSupported);
-
-    if (D3D12_FEATURE_DATA_TIGHT_ALIGNMENT tightAlignment = {}; SUCCEEDED(
-        device->CheckFeatureSupport(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, &tightAlignment, sizeof(tightAlignment))))
-        Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT(tightAlignment);
-
-#ifndef USE_PREVIEW_AGILITY_SDK
-    if (D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT shaderCacheABISupport = {}; SUCCEEDED(device->CheckFeatureSupport(
-        D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, &shaderCacheABISupport, sizeof(shaderCacheABISupport))))
-        Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(shaderCacheABISupport);
-#endif
-
 #ifdef USE_PREVIEW_AGILITY_SDK
-    if(D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS groupings = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, &groupings, sizeof(groupings))))
-        Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS(groupings);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL optionsExperimental = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL, &optionsExperimental, sizeof(optionsExperimental))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_EXPERIMENTAL(optionsExperimental);
-
+// Not in the table of feature queries, as it needs arrays of variable size allocated between two queries.
+static void PrintCooperativeVector(ID3D12Device* device)
+{
     if(D3D12_FEATURE_DATA_COOPERATIVE_VECTOR cooperativeVector = {}; SUCCEEDED(device->CheckFeatureSupport(
            D3D12_FEATURE_COOPERATIVE_VECTOR, &cooperativeVector, sizeof(cooperativeVector))))
     {
@@ -1159,21 +759,104 @@ static void PrintDeviceOptions(ID3D12Device* device)
                 Print_D3D12_FEATURE_DATA_COOPERATIVE_VECTOR(cooperativeVector);
         }
     }
+}
 #endif
+
+static HRESULT CheckFeatureSupportGuarded(ID3D12Device* device, D3D12_FEATURE feature, void* data, UINT dataSize)
+{
+    ADD_STAT(STAT_CHECK_FEATURE_SUPPORT_CALLS, 1);
+    __try
+    {
+        return device->CheckFeatureSupport(feature, data, dataSize);
+    }
+    // This is needed because latest (as of November 2023) AMD drivers crash when calling:
+    // ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, DXGI_FORMAT_A4B4G4R4_UNORM)
+    __except(EXCEPTION_EXECUTE_HANDLER)
+    {
+        return FEATURE_SUPPORT_RESULT_CRASHED;
+    }
+}
+
+// Format and sample count a query is for, to tell apart calls in Timings.
+static wstring MakeFeatureQueryArgs(uint32_t feature, const void* data)
+{
+    switch(feature)
+    {
+    case D3D12_FEATURE_FORMAT_SUPPORT:
+    case D3D12_FEATURE_FORMAT_INFO: {
+        // Both structures start with the format.
+        const DXGI_FORMAT format = *(const DXGI_FORMAT*)data;
+        const wchar_t* formatName = FindEnumItemName(format, Enum_DXGI_FORMAT);
+        return formatName ? formatName : std::format(L"{}", (uint32_t)format);
+    }
+    case D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS: {
+        const auto& levels = *(const D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS*)data;
+        const wchar_t* formatName = FindEnumItemName(levels.Format, Enum_DXGI_FORMAT);
+        return formatName ? std::format(L"{}, {}", formatName, levels.SampleCount)
+                          : std::format(L"{}, {}", (uint32_t)levels.Format, levels.SampleCount);
+    }
+    default:
+        return {};
+    }
 }
 
+// Queries the device, recording each call when --Capture is used, and timing it when --Timings is used.
+class DeviceFeatureSupportSource : public FeatureSupportSource
+{
+public:
+    // Calls are timed in TimingRecorder current when this object is created, also when made from other threads.
+    DeviceFeatureSupportSource(ID3D12Device* device)
+        : m_Device(device)
+        , m_TimingRecorder(TimingRecorder::GetCurrent())
+    {
+    }
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override
+    {
+        if(m_TimingRecorder || TraceWriter::GetInstance())
+        {
+            // Input members, as data is overwritten by the call.
+            const wstring args = MakeFeatureQueryArgs(feature, data);
+            const TimingClock::time_point begin = TimingClock::now();
+            const HRESULT hr = CheckFeatureSupportCaptured(feature, data, dataSize);
+            const TimingClock::time_point end = TimingClock::now();
+            const wchar_t* featureName = FindFeatureName(feature);
+            AddTimedCall(m_TimingRecorder, featureName ? featureName : std::format(L"D3D12_FEATURE {}", feature),
+                args, begin, end);
+            return hr;
+        }
+        return CheckFeatureSupportCaptured(feature, data, dataSize);
+    }
+    // Captured calls are recorded in order, so they are made from one thread.
+    bool ShouldQueryInParallel() const override { return !g_CaptureWriter; }
+
+private:
+    ID3D12Device* const m_Device;
+    TimingRecorder* const m_TimingRecorder;
+    std::vector<uint8_t> m_Input;
+
+    HRESULT CheckFeatureSupportCaptured(uint32_t feature, void* data, uint32_t dataSize)
+    {
+        if(!g_CaptureWriter)
+            return CheckFeatureSupportGuarded(m_Device, (D3D12_FEATURE)feature, data, dataSize);
+
+        m_Input.assign((const uint8_t*)data, (const uint8_t*)data + dataSize);
+        const HRESULT hr = CheckFeatureSupportGuarded(m_Device, (D3D12_FEATURE)feature, data, dataSize);
+        g_CaptureWriter->AddRecord(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, feature, m_Input.data(), dataSize, data,
+            SUCCEEDED(hr) ? dataSize : 0, hr);
+        return hr;
+    }
+};
+
 static void PrintDescriptorSizes(ID3D12Device* device)
 {
-    ReportScopeObject scope(L"GetDescriptorHandleIncrementSize");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV",
-        device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
-    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER",
-        device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER));
-    formatter.AddFieldUint32(
-        L"D3D12_DESCRIPTOR_HEAP_TYPE_RTV", device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
-    formatter.AddFieldUint32(
-        L"D3D12_DESCRIPTOR_HEAP_TYPE_DSV", device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV));
+    std::array<uint32_t, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> sizes;
+    for(uint32_t i = 0; i < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++i)
+    {
+        sizes[i] = device->GetDescriptorHandleIncrementSize((D3D12_DESCRIPTOR_HEAP_TYPE)i);
+        if(g_CaptureWriter)
+            g_CaptureWriter->AddUint32(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, i, sizes[i]);
+    }
+    PrintDescriptorSizes(sizes);
 }
 
 static void PrintMetaCommand(ID3D12Device5* device5, UINT index, const D3D12_META_COMMAND_DESC& desc)
@@ -1242,36 +925,11 @@ static void PrintMetaCommands(ID3D12Device5* device5)
         PrintMetaCommand(device5, i, descs[i]);
 }
 
-static void PrintCommandQueuePriorities(ID3D12Device* device)
-{
-    D3D12_COMMAND_LIST_TYPE cmdListTypes[] = { D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_TYPE_COMPUTE,
-        D3D12_COMMAND_LIST_TYPE_COPY };
-
-    D3D12_COMMAND_QUEUE_PRIORITY cmdQueuePriorities[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
-        D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
-
-    std::array<bool, 9> queuePrioritySupport = {};
-    size_t queuePriorityIndex = 0;
-    for(auto cmdListType : cmdListTypes)
-    {
-        for(auto cmdQueuePriority : cmdQueuePriorities)
-        {
-            D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY commandQueuePriority = {};
-            commandQueuePriority.CommandListType = cmdListType;
-            commandQueuePriority.Priority = cmdQueuePriority;
-            if(FAILED(device->CheckFeatureSupport(
-                   D3D12_FEATURE_COMMAND_QUEUE_PRIORITY, &commandQueuePriority, sizeof(commandQueuePriority))))
-                return;
-
-            queuePrioritySupport[queuePriorityIndex++] = commandQueuePriority.PriorityForTypeIsSupported;
-        }
-    }
-
-    Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(queuePrioritySupport);
-}
-
-static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* nvAPI, AGS_Initialize_RAII* ags)
+// Without printFormats, formats are not printed even if requested, as --Isolate probes them separately.
+static int PrintDeviceDetails(IDXGIAdapter1* adapter1, VendorApis& vendorApis, bool printFormats)
 {
+    NvAPI_Inititalize_RAII* const nvAPI = vendorApis.GetNvApi();
+    AGS_Initialize_RAII* const ags = vendorApis.GetAgs();
     ComPtr<ID3D12Device> device;
 
     DXGI_ADAPTER_DESC desc = {};
@@ -1285,18 +943,28 @@ static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* n
     {
         ComPtr<IDXGIAdapter> adapter;
         if(SUCCEEDED(adapter1->QueryInterface(IID_PPV_ARGS(&adapter))))
-            device = ags->CreateDeviceAndPrintData(adapter.Get(), MIN_FEATURE_LEVEL);
+        {
+            std::lock_guard lock(g_VendorApiMutex);
+            TimingScope timing(L"agsDriverExtensionsDX12_CreateDevice");
+            ADD_STAT(STAT_DEVICE_CREATIONS, 1);
+            PrintCaptured(CAPTURE_REPORT_DEVICE_CREATION,
+                [&]() { device = ags->CreateDeviceAndPrintData(adapter.Get(), MIN_FEATURE_LEVEL); });
+        }
     }
 #endif
 
     if(!device)
     {
         HRESULT hr;
+        {
+            TimingScope timing(L"D3D12CreateDevice");
+            ADD_STAT(STAT_DEVICE_CREATIONS, 1);
 #if defined(AUTO_LINK_DX12)
-        hr = ::D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+            hr = ::D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
 #else
-        hr = g_D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+            hr = g_D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
 #endif
+        }
         if(hr == 0x887E0003)
             throw std::runtime_error(
                 "D3D12CreateDevice returned 0x887E0003. Make sure Developer Mode is enabled in Windows settings.");
@@ -1306,114 +974,56 @@ static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* n
     if(!device)
         return PROGRAM_EXIT_ERROR_D3D12;
 
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS(options);
-
-    if(D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT gpuVirtualAddressSupport = {};
-        SUCCEEDED(device->CheckFeatureSupport(
-            D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT, &gpuVirtualAddressSupport, sizeof(gpuVirtualAddressSupport))))
-        Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT(gpuVirtualAddressSupport);
+    DeviceFeatureSupportSource featureSupportSource(device.Get());
+    {
+        TimingScope timing(L"DeviceFeatures");
+        PrintDeviceFeatures(featureSupportSource);
+    }
+#ifdef USE_PREVIEW_AGILITY_SDK
+    if(IsReportScopeNeeded(L"D3D12_FEATURE_DATA_COOPERATIVE_VECTOR"))
+        PrintCaptured(CAPTURE_REPORT_DEVICE_FEATURES, [&]() { PrintCooperativeVector(device.Get()); });
+#endif
 
-    /*
-    Microsoft documentation says:
+    PrintDescriptorSizes(device.Get());
 
-    ID3D12Device::CheckFeatureSupport returns E_INVALIDARG if HighestShaderModel
-    isn't known by the current runtime. For that reason, we recommend that you call
-    this in a loop with decreasing shader models to determine the highest supported
-    shader model.
-    */
-    {
-        D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = {};
-        for(size_t enumItemIndex = _countof(Enum_D3D_SHADER_MODEL) - 1; enumItemIndex--;)
+    PrintCaptured(CAPTURE_REPORT_DEVICE_DATA, [&]() {
+        if(g_PrintMetaCommands && IsReportScopeNeeded(L"EnumerateMetaCommands"))
         {
-            shaderModel.HighestShaderModel = D3D_SHADER_MODEL(Enum_D3D_SHADER_MODEL[enumItemIndex].m_Value);
-            if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))))
+            ComPtr<ID3D12Device5> device5;
+            if(SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&device5))))
             {
-                Print_D3D12_FEATURE_DATA_SHADER_MODEL(shaderModel);
-                break;
+                TimingScope timing(L"MetaCommands");
+                PrintMetaCommands(device5.Get());
             }
         }
-    }
-
-    if(D3D12_FEATURE_DATA_ROOT_SIGNATURE rootSignature = { .HighestVersion = HIGHEST_ROOT_SIGNATURE_VERSION };
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &rootSignature, sizeof(rootSignature))))
-        Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE(rootSignature);
-
-    if(D3D12_FEATURE_DATA_ARCHITECTURE1 architecture1 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ARCHITECTURE1, &architecture1, sizeof(architecture1))))
-        Print_D3D12_FEATURE_DATA_ARCHITECTURE1(architecture1);
-    else
-    {
-        if(D3D12_FEATURE_DATA_ARCHITECTURE architecture = {};
-            SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ARCHITECTURE, &architecture, sizeof(architecture))))
-            Print_D3D12_FEATURE_DATA_ARCHITECTURE(architecture);
-    }
-
-    {
-        D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevels = { _countof(FEATURE_LEVELS_ARRAY), FEATURE_LEVELS_ARRAY,
-            MAX_FEATURE_LEVEL };
-        if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_FEATURE_LEVELS, &featureLevels, sizeof(featureLevels))))
-            Print_D3D12_FEATURE_DATA_FEATURE_LEVELS(featureLevels);
-    }
-
-    if(D3D12_FEATURE_DATA_SHADER_CACHE shaderCache = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_CACHE, &shaderCache, sizeof(shaderCache))))
-        Print_D3D12_FEATURE_DATA_SHADER_CACHE(shaderCache);
-
-    PrintCommandQueuePriorities(device.Get());
-
-    if(D3D12_FEATURE_DATA_SERIALIZATION serialization = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SERIALIZATION, &serialization, sizeof(serialization))))
-        Print_D3D12_FEATURE_DATA_SERIALIZATION(serialization);
-
-    if(D3D12_FEATURE_DATA_CROSS_NODE crossNode = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_CROSS_NODE, &crossNode, sizeof(crossNode))))
-        Print_D3D12_FEATURE_CROSS_NODE(crossNode);
-
-    if(D3D12_FEATURE_DATA_PREDICATION predication = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_PREDICATION, &predication, sizeof(predication))))
-        Print_D3D12_FEATURE_PREDICATION(predication);
-
-    if(D3D12_FEATURE_DATA_HARDWARE_COPY hardwareCopy = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_HARDWARE_COPY, &hardwareCopy, sizeof(hardwareCopy))))
-        Print_D3D12_FEATURE_HARDWARE_COPY(hardwareCopy);
-
-    if(D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE appSpecificDriverState = {};
-        SUCCEEDED(device->CheckFeatureSupport(
-            D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE, &appSpecificDriverState, sizeof(appSpecificDriverState))))
-        Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE(appSpecificDriverState);
-
-    // TODO: In Agility SDK 1.715.0-preview how to query for D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL1?
-    // What is the corresponding structure?
-
-    // TODO: D3D12_FEATURE_PLACED_RESOURCE_SUPPORT_INFO - What is this? How to query it? What structure to use?
-
-    PrintDeviceOptions(device.Get());
-
-    PrintDescriptorSizes(device.Get());
-
-    if(g_PrintMetaCommands)
-    {
-        ComPtr<ID3D12Device5> device5;
-        if(SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&device5))))
-            PrintMetaCommands(device5.Get());
-    }
 
 #if USE_NVAPI
-    bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-    if(nvAPI && nvAPI->IsInitialized())
-        nvAPI->PrintD3d12DeviceData(device.Get());
+        if(nvAPI && nvAPI->IsInitialized())
+        {
+            std::lock_guard lock(g_VendorApiMutex);
+            TimingScope timing(L"NvAPI_D3D12DeviceData");
+            nvAPI->PrintD3d12DeviceData(device.Get());
+        }
 #endif
 
-    DetectTranslationLayersDevice(device.Get());
+        DetectTranslationLayersDevice(device.Get());
+    });
 
-    if(g_PrintFormats)
-        PrintFormatInformation(device.Get());
+    if(printFormats && (g_PrintFormatsMatrix || g_PrintFormats))
+    {
+        TimingScope timing(L"Formats");
+        if(g_PrintFormatsMatrix)
+            PrintFormatMatrix(featureSupportSource);
+        else
+            PrintFormatInformation(featureSupportSource);
+    }
 
 #if USE_AGS
     if(useAGS && ags && ags->IsInitialized())
+    {
+        std::lock_guard lock(g_VendorApiMutex);
         ags->DestroyDevice(std::move(device));
+    }
 #endif
 
     return PROGRAM_EXIT_SUCCESS;
@@ -1421,7 +1031,8 @@ static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* n
 
 #if !defined(AUTO_LINK_DX12)
 
-static bool LoadLibraries()
+// Without loadD3D12, only DXGI can be used.
+static bool LoadLibraries(bool loadD3D12 = true)
 {
     g_DxgiLibrary = ::LoadLibraryEx(DYN_LIB_DXGI, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
     if(!g_DxgiLibrary)
@@ -1430,17 +1041,22 @@ static bool LoadLibraries()
         return false;
     }
 
-    g_Dx12Library = ::LoadLibraryEx(DYN_LIB_DX12, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
-    if(!g_Dx12Library)
+    g_CreateDXGIFactory1 =
+        reinterpret_cast<PFN_DXGI_CREATE_FACTORY1>(::GetProcAddress(g_DxgiLibrary, "CreateDXGIFactory1"));
+    if(!g_CreateDXGIFactory1)
     {
-        ErrorPrinter::PrintFormat(L"could not load {}\n", std::make_wformat_args(DYN_LIB_DX12));
         return false;
     }
 
-    g_CreateDXGIFactory1 =
-        reinterpret_cast<PFN_DXGI_CREATE_FACTORY1>(::GetProcAddress(g_DxgiLibrary, "CreateDXGIFactory1"));
-    if(!g_CreateDXGIFactory1)
+    if(!loadD3D12)
+    {
+        return true;
+    }
+
+    g_Dx12Library = ::LoadLibraryEx(DYN_LIB_DX12, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
+    if(!g_Dx12Library)
     {
+        ErrorPrinter::PrintFormat(L"could not load {}\n", std::make_wformat_args(DYN_LIB_DX12));
         return false;
     }
 
@@ -1473,9 +1089,12 @@ static void UnloadLibraries()
     assert(rc);
     g_DxgiLibrary = nullptr;
 
-    rc = ::FreeLibrary(g_Dx12Library);
-    assert(rc);
-    g_Dx12Library = nullptr;
+    if(g_Dx12Library)
+    {
+        rc = ::FreeLibrary(g_Dx12Library);
+        assert(rc);
+        g_Dx12Library = nullptr;
+    }
 }
 
 #endif
@@ -1488,14 +1107,18 @@ void PrintCommandLineSyntax()
     PrinterClass::PrintString(L"  -v --Version                     Only print program version information.\n");
     PrinterClass::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
     PrinterClass::PrintString(L"  -l --List                        Only print the list of all adapters.\n");
+    PrinterClass::PrintString(L"  --ListFast                       Only print the list of all adapters with data from DXGI alone: description, IDs, LUID, flags and dedicated video memory. Doesn't load D3D12 nor vendor libraries.\n");
     PrinterClass::PrintString(L"  -a --Adapter=<Index>             Print details of adapter at specified index.\n");
+    PrinterClass::PrintString(L"  -a --Adapter=<Filter>            Print details of all adapters matching comma-separated terms, e.g. vendor:nvidia, device:2684, luid:00000000-0001A2B3, name:*RTX*, dedicated>=8GiB, !software. Others are skipped before creating a device.\n");
     PrinterClass::PrintString(L"  --AllAdapters                    Print details of all adapters.\n");
     PrinterClass::PrintString(L"  -j --JSON                        Print output in JSON format instead of human-friendly text.\n");
     PrinterClass::PrintString(L"  --MinimizeJson                   Print JSON in minimal size form.\n");
     PrinterClass::PrintString(L"  -o --OutputFile=<FilePath>       Output to specified file.\n");
     PrinterClass::PrintString(L"  -f --Formats                     Include information about DXGI format capabilities.\n");
+    PrinterClass::PrintString(L"  --FormatsMatrix                  Include DXGI format capabilities as compact parallel arrays in JSON, or a table in text.\n");
     PrinterClass::PrintString(L"  --MetaCommands                   Include information about meta commands.\n");
     PrinterClass::PrintString(L"  -e --Enums                       Include information about all known enums and their values.\n");
+    PrinterClass::PrintString(L"  --EnumDictionary=<DirPath>       Write all known enums to a file in specified directory, named by hash of its content. Report contains only the hash and numeric enum values.\n");
     PrinterClass::PrintString(L"  --PureD3D12                      Extract information only from D3D12 and no other sources.\n");
 #ifdef USE_PREVIEW_AGILITY_SDK
     PrinterClass::PrintString(L"  -x --EnableExperimental=<on/off> Whether to enable experimental features before querying device capabilities. Default is on (off for D3d12info and on for D3d12info_preview).\n");
@@ -1504,208 +1127,1169 @@ void PrintCommandLineSyntax()
 #endif
     PrinterClass::PrintString(L"  --ForceVendorAPI                 Tries to query info via vendor-specific APIs, even in case when vendor doesn't match.\n");
     PrinterClass::PrintString(L"  --WARP                           Use WARP adapter.\n");
+    PrinterClass::PrintString(L"  --Capture=<FilePath>             Also write raw results of DXGI and D3D12 queries, and the data of vendor APIs, to a binary capture file.\n");
+    PrinterClass::PrintString(L"  --Replay=<FilePath>              Print the report from a capture file instead of querying the system.\n");
+    PrinterClass::PrintString(L"  --Cache=<DirPath>                Reuse static data of adapters from cache in specified directory, invalidated by a change of adapter, driver or program version. Ignored with --Capture and --List.\n");
+    PrinterClass::PrintString(L"  --Refresh                        With --Cache, query all data again and replace the cached one.\n");
+    PrinterClass::PrintString(L"  --Timings                        Include durations of loading libraries, device creation, each CheckFeatureSupport call and other phases, with the slowest calls of each adapter.\n");
+    PrinterClass::PrintString(L"  --Trace=<FilePath>               Write a timeline of report scopes, phases, driver calls and output flushes on each thread to a file in Chrome trace event format, e.g. for Perfetto.\n");
+    PrinterClass::PrintString(L"  --Stats                          Print counters of heap allocations, formatter calls, enum lookups, escaped and printed characters, output flushes and driver calls to standard error at the end.\n");
+    PrinterClass::PrintString(L"  --Require=<FilePath>             Only check if the adapter meets requirements from a profile file, e.g. ResourceBindingTier>=3, and print a short JSON verdict. Exit code is 1 if not met.\n");
+    PrinterClass::PrintString(L"  --Select=<Patterns>              Print only fields of adapters with paths matching any of comma-separated patterns, e.g. D3D12_FEATURE_DATA_D3D12_OPTIONS5, Formats.DXGI_FORMAT_BC*, NvAPI_* or **.RaytracingTier. Queries of other fields are not made. Can be repeated.\n");
+    PrinterClass::PrintString(L"  --Exclude=<Patterns>             Don't print fields of adapters with paths matching any of comma-separated patterns, nor make their queries. Can be repeated.\n");
+    PrinterClass::PrintString(L"  --Watch=<Seconds>                Keep running and print only changes: adapters added, removed or with a new driver, and fields of their D3D12 data that changed. Checks when adapters change and every specified number of seconds, at most 86400.\n");
+    PrinterClass::PrintString(L"  --Isolate                        Probe vendor data, the device and each format of adapters in worker processes, which are restarted after the item that crashed them, so a driver crash loses only that item. Adapters are probed in parallel.\n");
     // clang-format on
 }
 
-static void ListAdapter(uint32_t adapterIndex, IDXGIAdapter* adapter, NvAPI_Inititalize_RAII* nvApi,
-    AGS_Initialize_RAII* ags, AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+// Bits of ReportCacheKey::m_Options.
+static uint32_t GetReportCacheOptions()
 {
-    ReportScopeArrayItem scope;
-
-    if(!g_WARP && !g_ShowAllAdapters)
+    const bool options[] = { g_UseJsonOutput, g_PrintFormats, g_PrintFormatsMatrix, g_PrintMetaCommands, g_PureD3D12,
+        g_ForceVendorAPI, g_EnableExperimental };
+    uint32_t result = 0;
+    for(size_t i = 0; i < _countof(options); ++i)
     {
-        // In case of WARP, we queried adapter via different API that didn't use adapter index
-        // In case we show all adapters, array index equals adapter index
-        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+        if(options[i])
+            result |= 1u << i;
     }
+    return result;
+}
 
-    PrintAdapterData(adapter);
+// Returns false if the adapter can't be identified, so it is not cached.
+static bool MakeReportCacheKey(IDXGIAdapter* adapter, const DXGI_ADAPTER_DESC1& desc, ReportCacheKey& outKey)
+{
+    LARGE_INTEGER umdVersion = {};
+    if(FAILED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion)))
+        return false;
+    outKey = { .m_AdapterLuid = LuidToUint64(desc.AdapterLuid),
+        .m_VendorId = desc.VendorId,
+        .m_DeviceId = desc.DeviceId,
+        .m_SubSysId = desc.SubSysId,
+        .m_Revision = desc.Revision,
+        .m_UmdVersion = (uint64_t)umdVersion.QuadPart,
+        .m_D3D12SdkVersion = D3D12SDKVersion,
+        .m_Options = GetReportCacheOptions() };
+    return true;
+}
 
-    DXGI_ADAPTER_DESC desc = {};
-    if(SUCCEEDED(adapter->GetDesc(&desc)))
+// Returns null if not found, and always with --Refresh.
+static std::unique_ptr<RecordingReportFormatter> LoadFromReportCache(std::span<const ReportCacheKey> keys)
+{
+    if(g_RefreshCache)
+        return nullptr;
+    TimingScope timing(L"ReportCacheLoad");
+    auto report = std::make_unique<RecordingReportFormatter>();
+    if(!g_ReportCache->Load(keys, *report))
+        return nullptr;
+    return report;
+}
+
+// Prints what printFunc prints and stores it in the cache, unless printFunc fails.
+static int PrintAndStoreInReportCache(std::span<const ReportCacheKey> keys, const std::function<int()>& printFunc)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    RecordingReportFormatter recording;
+    int result;
+    try
     {
-#if USE_NVAPI
-        bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-        if(useNVAPI && nvApi && nvApi->IsInitialized())
-        {
-            nvApi->PrintPhysicalGpuData(desc.AdapterLuid);
-        }
-#endif
-#if USE_AGS
-        bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAGS && ags && ags->IsInitialized())
+        ReportContext recordingContext(recording, ReportFormatter::GetFlags());
+        ReportContextScope contextScope(recordingContext);
+        result = printFunc();
+    }
+    catch(...)
+    {
+        recording.Replay(formatter);
+        throw;
+    }
+    recording.Replay(formatter);
+
+    if(result == PROGRAM_EXIT_SUCCESS)
+    {
+        try
         {
-            AGS_Initialize_RAII::DeviceId deviceId = {
-                .vendorId = (int)desc.VendorId, .deviceId = (int)desc.DeviceId, .revisionId = (int)desc.Revision
-            };
-            ags->PrintAgsDeviceData(deviceId);
+            TimingScope timing(L"ReportCacheStore");
+            g_ReportCache->Store(keys, recording);
         }
-#endif
-#if USE_AMD_DEVICE_INFO
-        bool useAmdDeviceInfo = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAmdDeviceInfo && amdDeviceInfo)
+        catch(const std::exception& ex)
         {
-            AmdDeviceInfo_Initialize_RAII::DeviceId deviceId = { desc.DeviceId, desc.Revision };
-            amdDeviceInfo->PrintDeviceData(deviceId);
+            // The report is complete without the cache.
+            const char* message = ex.what();
+            ErrorPrinter::PrintFormat("WARNING: {}\n", std::make_format_args(message));
         }
-#endif
-#if USE_VULKAN
-        if(vk && vk->IsInitialized())
-            vk->PrintData(desc);
-#endif
     }
+    return result;
 }
 
-static void ListAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+// Also tells vendorApis which adapters are inspected, so it must be called before any other use of vendorApis. With
+// onlyAdapterIndex, only that adapter is, otherwise the ones chosen by IsAdapterInspected. Adapters found in the report
+// cache don't need vendor libraries, unless data of System Info is not cached. Vendor libraries are initialized later,
+// on first use, and register their devices then.
+static void BuildAdapterIndex(
+    IDXGIFactory4* dxgiFactory, VendorApis& vendorApis, std::optional<uint32_t> onlyAdapterIndex)
 {
-    ComPtr<IDXGIAdapter> adapter;
+    std::vector<uint32_t> cachedAdapterVendorIds;
+    auto addAdapter = [&](IDXGIAdapter1* adapter, uint32_t adapterIndex) {
+        DXGI_ADAPTER_DESC1 desc = {};
+        if(FAILED(adapter->GetDesc1(&desc)))
+            return;
+        g_AdapterIndex.AddAdapter({ .m_Luid = LuidToUint64(desc.AdapterLuid),
+            .m_VendorId = desc.VendorId,
+            .m_DeviceId = desc.DeviceId,
+            .m_RevisionId = desc.Revision });
+        if(g_ReportCache)
+            g_ReportCache->AddPresentAdapter(LuidToUint64(desc.AdapterLuid));
+
+        // Not inspected, as in InspectAdapter or InspectAllAdapters, so they need neither vendor libraries nor cache
+        // entries.
+        if(onlyAdapterIndex ? adapterIndex != *onlyAdapterIndex
+                            : !g_ListAdapters && !g_WARP && g_ShowAllAdapters && !IsAdapterInspected(desc))
+            return;
+
+        if(AdapterCacheEntry entry; g_ReportCache && MakeReportCacheKey(adapter, desc, entry.m_Key))
+        {
+            g_SystemCacheKeys.push_back(entry.m_Key);
+            entry.m_Report = LoadFromReportCache({ &entry.m_Key, 1 });
+            const bool cached = entry.m_Report != nullptr;
+            g_AdapterCacheEntries.emplace(entry.m_Key.m_AdapterLuid, std::move(entry));
+            if(cached)
+            {
+                cachedAdapterVendorIds.push_back(desc.VendorId);
+                return;
+            }
+        }
+        vendorApis.AddAdapterVendor(desc.VendorId);
+    };
+    ComPtr<IDXGIAdapter1> adapter;
     if(!g_WARP)
     {
-        UINT adapterIndex = 0;
-        while(dxgiFactory->EnumAdapters(adapterIndex, &adapter) != DXGI_ERROR_NOT_FOUND)
+        for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter) != DXGI_ERROR_NOT_FOUND;
+            ++adapterIndex)
         {
-            ListAdapter(adapterIndex, adapter.Get(), nvApi, ags, amdDeviceInfo, vk);
+            addAdapter(adapter.Get(), adapterIndex);
             adapter.Reset();
-            ++adapterIndex;
         }
     }
-    else
+    else if(SUCCEEDED(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter))))
+        addAdapter(adapter.Get(), UINT32_MAX);
+
+    if(g_ReportCache)
+    {
+        g_CachedSystemReport = LoadFromReportCache(g_SystemCacheKeys);
+        if(!g_CachedSystemReport)
+        {
+            for(uint32_t vendorId : cachedAdapterVendorIds)
+                vendorApis.AddAdapterVendor(vendorId);
+        }
+    }
+}
+
+// Part of System Info. Returns PROGRAM_EXIT_SUCCESS, to be used with PrintAndStoreInReportCache.
+static int PrintVendorSystemData(VendorApis& vendorApis)
+{
+#if USE_NVAPI
+    NvAPI_Inititalize_RAII* const nvApi = vendorApis.GetNvApi();
+    if(nvApi && nvApi->IsInitialized())
+        nvApi->PrintData();
+#endif
+#if USE_AGS
+    AGS_Initialize_RAII* const ags = vendorApis.GetAgs();
+    if(ags && ags->IsInitialized())
+        ags->PrintData();
+#endif
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Returns false if the source has no device matching the adapter. Warns if there are multiple.
+static bool FindAdapterSourceDevice(const DXGI_ADAPTER_DESC& desc, ADAPTER_SOURCE source, size_t& outIndex)
+{
+    const AdapterMatch match = g_AdapterIndex.Find(LuidToUint64(desc.AdapterLuid), source);
+    if(match.m_Result == AdapterMatch::RESULT_AMBIGUOUS)
+    {
+        const wchar_t* sourceName = GetAdapterSourceName(source);
+        const wchar_t* adapterName = desc.Description;
+        ErrorPrinter::PrintFormat(L"WARNING: Multiple {} devices match adapter \"{}\", skipping their data.\n",
+            std::make_wformat_args(sourceName, adapterName));
+    }
+    if(match.m_Result != AdapterMatch::RESULT_FOUND)
+        return false;
+    outIndex = match.m_Index;
+    return true;
+}
+
+static void PrintAdapterSourceData(const DXGI_ADAPTER_DESC& desc, VendorApis& vendorApis)
+{
+    NvAPI_Inititalize_RAII* const nvApi = vendorApis.GetNvApi();
+    AGS_Initialize_RAII* const ags = vendorApis.GetAgs();
+    AmdDeviceInfo_Initialize_RAII* const amdDeviceInfo = vendorApis.GetAmdDeviceInfo();
+    Vulkan_Initialize_RAII* const vk = vendorApis.GetVulkan();
+    size_t sourceDeviceIndex = SIZE_MAX;
+#if USE_NVAPI
+    bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
+    if(useNVAPI && nvApi && nvApi->IsInitialized() &&
+        FindAdapterSourceDevice(desc, ADAPTER_SOURCE_NVAPI, sourceDeviceIndex))
+    {
+        nvApi->PrintPhysicalGpuData(sourceDeviceIndex);
+    }
+#endif
+#if USE_AGS
+    bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
+    if(useAGS && ags && ags->IsInitialized() && FindAdapterSourceDevice(desc, ADAPTER_SOURCE_AGS, sourceDeviceIndex))
+    {
+        ags->PrintAgsDeviceData(sourceDeviceIndex);
+    }
+#endif
+#if USE_AMD_DEVICE_INFO
+    bool useAmdDeviceInfo = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
+    if(useAmdDeviceInfo && amdDeviceInfo &&
+        FindAdapterSourceDevice(desc, ADAPTER_SOURCE_AMD_DEVICE_INFO, sourceDeviceIndex))
+    {
+        amdDeviceInfo->PrintDeviceData(sourceDeviceIndex);
+    }
+#endif
+#if USE_VULKAN
+    if(vk && vk->IsInitialized() && FindAdapterSourceDevice(desc, ADAPTER_SOURCE_VULKAN, sourceDeviceIndex))
+        vk->PrintData(sourceDeviceIndex);
+#endif
+}
+
+static void ListAdapter(uint32_t adapterIndex, IDXGIAdapter* adapter, VendorApis& vendorApis)
+{
+    ReportScopeArrayItem scope;
+
+    if(g_CaptureWriter)
+        g_CaptureWriter->BeginAdapter(adapterIndex);
+
+    if(!g_WARP && !g_ShowAllAdapters)
+    {
+        // In case of WARP, we queried adapter via different API that didn't use adapter index
+        // In case we show all adapters, array index equals adapter index
+        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+    }
+
+    PrintAdapterData(adapter);
+
+    DXGI_ADAPTER_DESC desc = {};
+    if(SUCCEEDED(adapter->GetDesc(&desc)))
+    {
+        PrintCaptured(CAPTURE_REPORT_ADAPTER_VENDOR_DATA, [&]() { PrintAdapterSourceData(desc, vendorApis); });
+    }
+}
+
+static void ListAdapters(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis)
+{
+    ComPtr<IDXGIAdapter> adapter;
+    if(!g_WARP)
+    {
+        UINT adapterIndex = 0;
+        while(dxgiFactory->EnumAdapters(adapterIndex, &adapter) != DXGI_ERROR_NOT_FOUND)
+        {
+            ListAdapter(adapterIndex, adapter.Get(), vendorApis);
+            adapter.Reset();
+            ++adapterIndex;
+        }
+    }
+    else
+    {
+        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter)));
+        ListAdapter(0, adapter.Get(), vendorApis);
+    }
+}
+
+// Uses only DXGI, without D3D12, vendor libraries or Vulkan, so it is cheap enough to be called each time an adapter is
+// to be chosen. Items of the array are in order of adapter indices, also the ones whose description can't be queried.
+static int ListAdaptersFast(ReportFormatter::FLAGS flags)
+{
+    ComPtr<IDXGIFactory1> dxgiFactory;
+#if defined(AUTO_LINK_DX12)
+    CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+    CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+
+    ReportFormatterScope formatterScope(flags);
+    PrintVersionData();
+    ReportScopeArray scopeArray(SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        DXGI_ADAPTER_DESC1 desc = {};
+        const bool descQueried = SUCCEEDED(adapter1->GetDesc1(&desc));
+        adapter1.Reset();
+        if(!g_AdapterFilter.IsEmpty() && (!descQueried || !MatchesAdapterFilter(desc)))
+            continue;
+
+        ReportScopeArrayItem scopeItem;
+        // With a filter, array index no longer equals adapter index.
+        if(!g_AdapterFilter.IsEmpty())
+            ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+        if(descQueried)
+            PrintAdapterSummary(desc);
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+static void PrintAdapterVendorData(IDXGIAdapter1* adapter1, VendorApis& vendorApis)
+{
+    DXGI_ADAPTER_DESC desc = {};
+    if(FAILED(adapter1->GetDesc(&desc)))
+        return;
+
+    std::lock_guard lock(g_VendorApiMutex);
+    TimingScope timing(L"VendorAdapterData");
+    PrintAdapterSourceData(desc, vendorApis);
+#if USE_INTEL_GPUDETECT
+    bool useGPUDetect = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_INTEL;
+    if(useGPUDetect && !g_PureD3D12)
+    {
+        ComPtr<IDXGIAdapter> adapter;
+        adapter1->QueryInterface(IID_PPV_ARGS(&adapter));
+        IntelData::PrintAdapterData(adapter.Get());
+    }
+#endif
+}
+
+// Everything about the adapter except PrintAdapterData, which contains dynamic data like current memory usage.
+static int PrintAdapterStaticData(IDXGIAdapter1* adapter1, VendorApis& vendorApis)
+{
+    PrintCaptured(CAPTURE_REPORT_ADAPTER_VENDOR_DATA, [&]() { PrintAdapterVendorData(adapter1, vendorApis); });
+    return PrintDeviceDetails(adapter1, vendorApis, true);
+}
+
+// PrintAdapterStaticData, or its copy from the report cache.
+static int PrintAdapterStaticDataCached(IDXGIAdapter1* adapter1, VendorApis& vendorApis)
+{
+    const AdapterCacheEntry* cacheEntry = nullptr;
+    if(DXGI_ADAPTER_DESC desc = {}; g_ReportCache && SUCCEEDED(adapter1->GetDesc(&desc)))
+    {
+        const auto it = g_AdapterCacheEntries.find(LuidToUint64(desc.AdapterLuid));
+        if(it != g_AdapterCacheEntries.end())
+            cacheEntry = &it->second;
+    }
+
+    if(!cacheEntry)
+        return PrintAdapterStaticData(adapter1, vendorApis);
+    if(cacheEntry->m_Report)
+    {
+        cacheEntry->m_Report->Replay(ReportFormatter::GetInstance());
+        return PROGRAM_EXIT_SUCCESS;
+    }
+    // A cached report is replayed through the selection, but one printed with queries skipped would be incomplete.
+    if(!g_FieldSelection.IsEmpty())
+        return PrintAdapterStaticData(adapter1, vendorApis);
+    return PrintAndStoreInReportCache(
+        { &cacheEntry->m_Key, 1 }, [&]() { return PrintAdapterStaticData(adapter1, vendorApis); });
+}
+
+int InspectAdapter(VendorApis& vendorApis, uint32_t& adapterIndex, ComPtr<IDXGIAdapter1>& adapter1)
+{
+    ReportScopeArrayItemConditional scope(g_PrintAdaptersAsArray);
+
+    // Each adapter has its own Timings, also when adapters are inspected in parallel.
+    std::unique_ptr<TimingRecorder> timings;
+    if(g_GlobalTimings)
+        timings = std::make_unique<TimingRecorder>();
+
+    int result;
+    {
+        // Timings are printed after it, so they are not dropped by --Select.
+        FieldSelectionScope selectionScope(g_FieldSelection);
+
+        if(g_CaptureWriter)
+            g_CaptureWriter->BeginAdapter(adapterIndex);
+
+        if(!g_WARP && (!g_ShowAllAdapters || !g_AdapterFilter.IsEmpty()))
+        {
+            // In case of WARP, we queried adapter via different API that didn't use adapter index
+            // In case we show all adapters, array index equals adapter index, unless they are filtered
+            ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+        }
+
+        PrintAdapterData(adapter1.Get());
+
+        TimingRecorderScope timingScope(timings.get());
+        result = PrintAdapterStaticDataCached(adapter1.Get(), vendorApis);
+    }
+    if(timings)
+        timings->Print(TIMINGS_SLOWEST_CALL_COUNT);
+    return result;
+}
+
+// Adapters shown when all adapters are shown, with their indices. Throws if there are none.
+static void EnumInspectedAdapters(IDXGIFactory4* dxgiFactory, std::vector<uint32_t>& outAdapterIndices,
+    std::vector<ComPtr<IDXGIAdapter1>>& outAdapters)
+{
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(uint32_t adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        DXGI_ADAPTER_DESC1 desc = {};
+        adapter1->GetDesc1(&desc);
+        if(!IsAdapterInspected(desc))
+        {
+            adapter1.Reset();
+            continue;
+        }
+        outAdapterIndices.push_back(adapterIndex);
+        outAdapters.push_back(std::move(adapter1));
+    }
+
+    if(outAdapters.empty())
+    {
+        if(!g_AdapterFilter.IsEmpty())
+            throw std::runtime_error("No adapters match the filter of --Adapter.");
+        throw std::runtime_error("No D3D12 adapters to show.");
+    }
+}
+
+// Adapters are inspected in parallel, except with --Capture, which records them one after another.
+static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis)
+{
+    std::vector<uint32_t> adapterIndices;
+    std::vector<ComPtr<IDXGIAdapter1>> adapters;
+    EnumInspectedAdapters(dxgiFactory, adapterIndices, adapters);
+
+    auto inspect = [&](size_t i) {
+        return InspectAdapter(vendorApis, adapterIndices[i], adapters[i]);
+    };
+    if(!g_CaptureWriter)
+        return InspectInParallel(adapters.size(), inspect);
+    for(size_t i = 0; i < adapters.size(); ++i)
+    {
+        if(int result = inspect(i); result != PROGRAM_EXIT_SUCCESS)
+            return result;
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// adapterIndex == UINT_MAX means first adapter matching the filter of --Adapter, or first non-software and non-remote
+// adapter without a filter, and then is set to its index. Returns null if there is no such adapter.
+static ComPtr<IDXGIAdapter1> ChooseAdapter(IDXGIFactory4* dxgiFactory, uint32_t& adapterIndex)
+{
+    ComPtr<IDXGIAdapter1> adapter1;
+    if(g_WARP)
+    {
+        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
+    }
+    else if(adapterIndex != UINT32_MAX)
+        dxgiFactory->EnumAdapters1(adapterIndex, &adapter1);
+    else if(!g_AdapterFilter.IsEmpty())
+    {
+        // First one matching the filter. Enumeration stops there.
+        adapterIndex = 0;
+        DXGI_ADAPTER_DESC1 desc = {};
+        while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
+        {
+            if(SUCCEEDED(adapter1->GetDesc1(&desc)) && MatchesAdapterFilter(desc))
+                break;
+            adapter1.Reset();
+            ++adapterIndex;
+        }
+    }
+    else
+    {
+        // No explicit adapter requested: Choose first non-software and non-remote.
+        adapterIndex = 0;
+        DXGI_ADAPTER_DESC1 desc = {};
+        while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
+        {
+            adapter1->GetDesc1(&desc);
+            if(desc.Flags == 0)
+                break;
+            adapter1.Reset();
+            ++adapterIndex;
+        }
+    }
+    return adapter1;
+}
+
+// Index of the adapter when only one is inspected, chosen like in InspectAdapter, so that only the vendor libraries it
+// needs are initialized. Empty when all adapters are inspected or listed, and with --WARP.
+static std::optional<uint32_t> FindOnlyInspectedAdapter(IDXGIFactory4* dxgiFactory, uint32_t adapterIndex)
+{
+    if(g_ShowAllAdapters || g_ListAdapters || g_WARP)
+        return std::nullopt;
+    // If there is no such adapter, none needs vendor libraries, and InspectAdapter fails later.
+    ChooseAdapter(dxgiFactory, adapterIndex);
+    return adapterIndex;
+}
+
+// adapterIndex == UINT_MAX means first non-software and non-remote adapter.
+static int InspectAdapter(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis, uint32_t adapterIndex)
+{
+    if(ComPtr<IDXGIAdapter1> adapter1 = ChooseAdapter(dxgiFactory, adapterIndex))
+    {
+        return InspectAdapter(vendorApis, adapterIndex, adapter1);
+    }
+
+    throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
+}
+
+// Decodes DXGI and D3D12 structures of the capture with the same functions that print them from live queries.
+class D3D12ReplayDecoder : public ReplayDecoder
+{
+public:
+    void PrintDXGIFeatureInfo(const CaptureSection& global) override
+    {
+        std::optional<BOOL> allowTearing;
+        if(uint32_t value = 0; global.FindUint32(CAPTURE_TAG_DXGI_FEATURE, DXGI_FEATURE_PRESENT_ALLOW_TEARING, value))
+            allowTearing = (BOOL)value;
+        ::PrintDXGIFeatureInfo(allowTearing);
+    }
+    void PrintEnums() override
+    {
+        if(g_PrintEnums)
+            ::PrintEnums();
+    }
+    void PrintAdapterData(const CaptureSection& section) override
+    {
+        for(uint32_t descVersion = ADAPTER_DESC_VERSION_COUNT; descVersion--;)
+        {
+            if(CaptureAdapterDesc desc; section.FindAdapterDesc(descVersion, desc))
+            {
+                PrintAdapterDesc(descVersion, MakeAdapterDesc(desc));
+                break;
+            }
+        }
+        for(uint32_t memorySegmentGroup = 0; memorySegmentGroup < 2; ++memorySegmentGroup)
+        {
+            if(CaptureVideoMemoryInfo info; section.FindVideoMemoryInfo(memorySegmentGroup, info))
+            {
+                const DXGI_QUERY_VIDEO_MEMORY_INFO videoMemoryInfo = { info.m_Budget, info.m_CurrentUsage,
+                    info.m_AvailableForReservation, info.m_CurrentReservation };
+                PrintAdapterMemoryInfo(memorySegmentGroup, videoMemoryInfo);
+            }
+        }
+        if(uint64_t umdVersion = 0; section.FindUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, umdVersion))
+            PrintAdapterInterfaceSupport(umdVersion);
+    }
+    void PrintDeviceFeatures(const CaptureSection& section) override
+    {
+        ReplayFeatureSupportSource featureSupportSource(section);
+        ::PrintDeviceFeatures(featureSupportSource);
+    }
+    void PrintDescriptorSizes(const CaptureSection& section) override
+    {
+        std::array<uint32_t, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> descriptorSizes = {};
+        for(uint32_t i = 0; i < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++i)
+        {
+            if(!section.FindUint32(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, i, descriptorSizes[i]))
+                return;
+        }
+        ::PrintDescriptorSizes(descriptorSizes);
+    }
+    void PrintFormats(const CaptureSection& section) override
+    {
+        if((!g_PrintFormats && !g_PrintFormatsMatrix) ||
+            !section.Contains(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, D3D12_FEATURE_FORMAT_SUPPORT))
+        {
+            return;
+        }
+        ReplayFeatureSupportSource featureSupportSource(section);
+        if(g_PrintFormatsMatrix)
+            PrintFormatMatrix(featureSupportSource);
+        else
+            PrintFormatInformation(featureSupportSource);
+    }
+};
+
+// Prints the report from a file written with --Capture, without calling DXGI, D3D12 or vendor libraries.
+static int ReplayCapture(const wstring& filePath)
+{
+    const CaptureReader reader(filePath);
+    D3D12ReplayDecoder decoder;
+    ReplayOptions options;
+    options.m_PrintAdaptersAsArray = g_PrintAdaptersAsArray;
+    options.m_PrintAdapterIndex = !g_ShowAllAdapters;
+    options.m_EnumDictionaryHash = g_EnumDictionaryHash;
+    options.m_FieldSelection = g_FieldSelection;
+    ReplayCapture(reader, decoder, options);
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Adapters inspected by InspectAllAdapters, with what AdapterWatcher compares.
+static void EnumWatchedAdapters(IDXGIFactory4* dxgiFactory, std::vector<WatchedAdapter>& outAdapters,
+    std::unordered_map<uint64_t, ComPtr<IDXGIAdapter1>>& outDxgiAdapters)
+{
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(uint32_t adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        DXGI_ADAPTER_DESC1 desc = {};
+        if(FAILED(adapter1->GetDesc1(&desc)) || !IsAdapterInspected(desc))
+        {
+            adapter1.Reset();
+            continue;
+        }
+        // Stays 0 if it can't be queried, so a driver update is then detected only by a change of LUID.
+        LARGE_INTEGER umdVersion = {};
+        adapter1->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion);
+        const uint64_t luid = LuidToUint64(desc.AdapterLuid);
+        outAdapters.push_back({ .m_Luid = luid,
+            .m_VendorId = desc.VendorId,
+            .m_DeviceId = desc.DeviceId,
+            .m_SubSysId = desc.SubSysId,
+            .m_Revision = desc.Revision,
+            .m_UmdVersion = (uint64_t)umdVersion.QuadPart,
+            .m_Description = desc.Description });
+        outDxgiAdapters[luid] = std::move(adapter1);
+    }
+}
+
+static void PrintWatchedAdapter(const WatchedAdapter& adapter, const WatchedAdapter* previous)
+{
+    ReportScopeObject scope(L"Adapter");
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldString(L"Description", adapter.m_Description);
+    formatter.AddFieldVendorId(L"VendorId", adapter.m_VendorId);
+    formatter.AddFieldHex32(L"DeviceId", adapter.m_DeviceId);
+    formatter.AddFieldSubsystemId(L"SubSysId", adapter.m_SubSysId);
+    formatter.AddFieldHex32(L"Revision", adapter.m_Revision);
+    formatter.AddFieldString(
+        L"AdapterLuid", std::format(L"{:08X}-{:08X}", adapter.m_Luid >> 32, adapter.m_Luid & 0xFFFFFFFF));
+    formatter.AddFieldMicrosoftVersion(L"UMDVersion", adapter.m_UmdVersion);
+    if(previous)
+    {
+        if(previous->m_Revision != adapter.m_Revision)
+            formatter.AddFieldHex32(L"PreviousRevision", previous->m_Revision);
+        if(previous->m_Luid != adapter.m_Luid)
+        {
+            formatter.AddFieldString(L"PreviousAdapterLuid",
+                std::format(L"{:08X}-{:08X}", previous->m_Luid >> 32, previous->m_Luid & 0xFFFFFFFF));
+        }
+        if(previous->m_UmdVersion != adapter.m_UmdVersion)
+            formatter.AddFieldMicrosoftVersion(L"PreviousUMDVersion", previous->m_UmdVersion);
+    }
+}
+
+static void PrintReportFieldChanges(const std::vector<ReportFieldChange>& changes)
+{
+    if(changes.empty())
+        return;
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    if(IsJsonOutput())
+    {
+        ReportScopeArray scopeArray(L"Fields");
+        for(const ReportFieldChange& change : changes)
+        {
+            ReportScopeArrayItem scopeItem;
+            formatter.AddFieldString(L"Name", change.m_Path);
+            if(change.m_OldValue)
+                formatter.AddFieldString(L"Old", *change.m_OldValue);
+            if(change.m_NewValue)
+                formatter.AddFieldString(L"New", *change.m_NewValue);
+        }
+    }
+    else
+    {
+        ReportScopeObject scope(L"Fields");
+        for(const ReportFieldChange& change : changes)
+        {
+            formatter.AddFieldString(change.m_Path,
+                std::format(L"{} -> {}", change.m_OldValue.value_or(L"(none)"), change.m_NewValue.value_or(L"(none)")));
+        }
+    }
+}
+
+// Each record is a separate JSON object or text block, printed as soon as the change is detected.
+static void PrintAdapterChangeRecord(
+    ReportFormatter::FLAGS flags, const AdapterChange& change, const std::vector<ReportFieldChange>& fieldChanges)
+{
+    ReportFormatterScope formatterScope(flags);
+    ReportScopeObject scope(L"AdapterChange");
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldString(L"Time", MakeCurrentDateTime());
+    formatter.AddFieldString(L"Change", GetAdapterChangeTypeName(change.m_Type));
+    PrintWatchedAdapter(change.m_Adapter, change.m_Type == ADAPTER_CHANGE_DRIVER ? &change.m_Previous : nullptr);
+    PrintReportFieldChanges(fieldChanges);
+}
+
+// Only D3D12 data, as vendor libraries see the adapters and drivers present when they were initialized.
+static std::vector<ReportField> ProbeWatchedAdapter(ReportFormatter::FLAGS flags, IDXGIAdapter1* adapter1)
+{
+    VendorApis noVendorApis;
+    FlatReportFormatter flatFormatter;
+    {
+        ReportContext context(flatFormatter, flags);
+        ReportContextScope contextScope(context);
+        FieldSelectionScope selectionScope(g_FieldSelection);
+        PrintDeviceDetails(adapter1, noVendorApis, true);
+    }
+    return flatFormatter.TakeFields();
+}
+
+// Runs until the process is terminated or an error occurs. The factory and libraries stay loaded, and only adapters
+// that are new or have a different driver are inspected again.
+static int WatchAdapters(ReportFormatter::FLAGS flags)
+{
+    // Compact records, one per line in JSON.
+    flags = ReportFormatter::FLAGS(flags & ~ReportFormatter::FLAG_JSON_PRETTY_PRINT);
+
+    {
+        ReportFormatterScope formatterScope(flags);
+        PrintVersionData();
+        ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+        EnableExperimentalFeatures();
+    }
+
+    AdapterWatcher watcher;
+    ComPtr<IDXGIFactory4> dxgiFactory;
+    // Signaled when adapters are added or removed, if supported by the OS.
+    std::unique_ptr<void, decltype(&::CloseHandle)> changeEvent(
+        ::CreateEvent(nullptr, FALSE, FALSE, nullptr), &::CloseHandle);
+    if(!changeEvent)
+        throw std::runtime_error("CreateEvent failed.");
+    DWORD changeEventCookie = 0;
+    ComPtr<IDXGIFactory7> changeEventFactory;
+
+    for(;;)
+    {
+        if(!dxgiFactory || !dxgiFactory->IsCurrent())
+        {
+            if(changeEventFactory)
+                changeEventFactory->UnregisterAdaptersChangedEvent(changeEventCookie);
+            changeEventFactory.Reset();
+            dxgiFactory.Reset();
+#if defined(AUTO_LINK_DX12)
+            CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+            CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+            if(SUCCEEDED(dxgiFactory->QueryInterface(IID_PPV_ARGS(&changeEventFactory))) &&
+                FAILED(changeEventFactory->RegisterAdaptersChangedEvent(changeEvent.get(), &changeEventCookie)))
+            {
+                changeEventFactory.Reset();
+            }
+        }
+
+        std::vector<WatchedAdapter> adapters;
+        std::unordered_map<uint64_t, ComPtr<IDXGIAdapter1>> dxgiAdapters;
+        EnumWatchedAdapters(dxgiFactory.Get(), adapters, dxgiAdapters);
+
+        for(const AdapterChange& change : watcher.Update(adapters))
+        {
+            std::vector<ReportFieldChange> fieldChanges;
+            if(change.m_Type != ADAPTER_CHANGE_REMOVED)
+            {
+                try
+                {
+                    fieldChanges = watcher.UpdateReport(change.m_Adapter.m_Luid,
+                        ProbeWatchedAdapter(flags, dxgiAdapters[change.m_Adapter.m_Luid].Get()));
+                }
+                catch(const std::exception& ex)
+                {
+                    // The adapter may be just going away. Watching continues.
+                    const char* message = ex.what();
+                    ErrorPrinter::PrintFormat("WARNING: {}\n", std::make_format_args(message));
+                }
+            }
+            PrintAdapterChangeRecord(flags, change, fieldChanges);
+        }
+
+        static_assert(WATCH_INTERVAL_MAX_SECONDS * 1000ull < INFINITE);
+        ::WaitForSingleObject(changeEvent.get(), g_WatchIntervalSeconds * 1000);
+    }
+}
+
+static wstring LoadRequirementsProfile(const std::filesystem::path& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        throw std::runtime_error(std::format("Could not open requirements profile \"{}\".", filePath.string()));
+    std::string text((size_t)file.tellg(), '\0');
+    file.seekg(0);
+    file.read(text.data(), (std::streamsize)text.size());
+    if(!file)
+        throw std::runtime_error(std::format("Could not read requirements profile \"{}\".", filePath.string()));
+    return StrToWstr(text.c_str(), CP_UTF8);
+}
+
+// Prints only a short verdict, so a launcher can check the adapter without running and parsing the whole report.
+// Makes only the queries needed by the profile, until the first requirement that is not met.
+static int CheckRequirements(uint32_t adapterIndex)
+{
+    const std::vector<RequirementCheck> checks =
+        CompileRequirements(LoadRequirementsProfile(g_RequirementsFilePath), GetRequirementSchema());
+
+    // Needed before the device is created, but only the verdict is printed.
+    {
+        RecordingReportFormatter discarded;
+        ReportContext context(discarded, ReportFormatter::FLAG_JSON);
+        ReportContextScope contextScope(context);
+        EnableExperimentalFeatures();
+    }
+
+    ComPtr<IDXGIFactory4> dxgiFactory;
+#if defined(AUTO_LINK_DX12)
+    CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+    CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+    const ComPtr<IDXGIAdapter1> adapter1 = ChooseAdapter(dxgiFactory.Get(), adapterIndex);
+    if(!adapter1)
+        throw std::runtime_error("No valid adapter chosen to check requirements.");
+    DXGI_ADAPTER_DESC1 desc = {};
+    adapter1->GetDesc1(&desc);
+
+    ComPtr<ID3D12Device> device;
+    ADD_STAT(STAT_DEVICE_CREATIONS, 1);
+#if defined(AUTO_LINK_DX12)
+    const HRESULT hr = ::D3D12CreateDevice(adapter1.Get(), MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+#else
+    const HRESULT hr = g_D3D12CreateDevice(adapter1.Get(), MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+#endif
+    RequirementVerdict verdict;
+    if(SUCCEEDED(hr))
+    {
+        DeviceFeatureSupportSource source(device.Get());
+        verdict = EvaluateRequirements(source, checks);
+    }
+    const bool passed = SUCCEEDED(hr) && !verdict.m_FailedCheck;
+
+    ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"Passed", passed);
+    if(adapterIndex != UINT32_MAX)
+        formatter.AddFieldUint32(L"AdapterIndex", adapterIndex);
+    if(desc.Description[0] != L'\0')
+        formatter.AddFieldString(L"Description", desc.Description);
+    formatter.AddFieldUint32(L"Checked", verdict.m_CheckedCount);
+    formatter.AddFieldUint32(L"Total", (uint32_t)checks.size());
+    if(FAILED(hr))
+        formatter.AddFieldString(L"Error", std::format(L"D3D12CreateDevice returned 0x{:08X}", (uint32_t)hr));
+    else if(verdict.m_FailedCheck)
+    {
+        ReportScopeObject scope(L"Failed");
+        formatter.AddFieldUint32(L"Line", verdict.m_FailedCheck->m_Line);
+        formatter.AddFieldString(L"Requirement", verdict.m_FailedCheck->m_Text);
+        if(verdict.m_QueryFailed)
+            formatter.AddFieldString(L"QueryFailed", verdict.m_FailedCheck->m_Query->m_Name);
+        else
+        {
+            formatter.AddFieldString(
+                L"Value", FormatRequirementValue(*verdict.m_FailedCheck->m_Field, verdict.m_Value));
+        }
+    }
+    return passed ? PROGRAM_EXIT_SUCCESS : PROGRAM_EXIT_REQUIREMENTS_NOT_MET;
+}
+
+// Items of an adapter probed with --Isolate, in order of printing. Each format is a separate item, so a crash on one
+// of them skips only that format, while the matrix is printed as a whole, as one item.
+enum ADAPTER_PROBE_ITEM
+{
+    ADAPTER_PROBE_ITEM_VENDOR_DATA,
+    ADAPTER_PROBE_ITEM_DEVICE,
+    ADAPTER_PROBE_ITEM_FORMATS,
+};
+
+static uint32_t GetAdapterProbeItemCount()
+{
+    if(g_PrintFormatsMatrix)
+        return ADAPTER_PROBE_ITEM_FORMATS + 1;
+    if(g_PrintFormats)
+        return ADAPTER_PROBE_ITEM_FORMATS + (uint32_t)GetFormatCount();
+    return ADAPTER_PROBE_ITEM_FORMATS;
+}
+
+// Runs print with a RecordingReportFormatter and returns what it recorded, serialized.
+static std::string RecordProbeItem(ReportFormatter::FLAGS flags, const std::function<void()>& print)
+{
+    RecordingReportFormatter recording;
+    {
+        ReportContext context(recording, flags);
+        ReportContextScope contextScope(context);
+        print();
+    }
+    std::ostringstream stream;
+    recording.Save(stream);
+    return stream.str();
+}
+
+// To standard output of the worker, which is a pipe read by the supervisor.
+static void WriteProbeFrame(const std::string& frame)
+{
+    DWORD written = 0;
+    if(!::WriteFile(::GetStdHandle(STD_OUTPUT_HANDLE), frame.data(), (DWORD)frame.size(), &written, nullptr) ||
+        written != frame.size())
     {
-        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter)));
-        ListAdapter(0, adapter.Get(), nvApi, ags, amdDeviceInfo, vk);
+        throw std::runtime_error("Could not write to the pipe of --Isolate.");
     }
 }
 
-int InspectAdapter(NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk, uint32_t& adapterIndex,
-    ComPtr<IDXGIAdapter1>& adapter1)
+static int ProbeIsolatedAdapter(ReportFormatter::FLAGS flags, IDXGIFactory4* dxgiFactory, VendorApis& vendorApis,
+    const IsolatedWorkerParams& params)
 {
-    ReportScopeArrayItemConditional scope(g_PrintAdaptersAsArray);
+    uint32_t adapterIndex = params.m_AdapterIndex;
+    const ComPtr<IDXGIAdapter1> adapter1 = ChooseAdapter(dxgiFactory, adapterIndex);
+    if(!adapter1)
+        throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
+    // Vendor libraries are not needed when restarted at formats.
+    if(params.m_FirstItem <= ADAPTER_PROBE_ITEM_DEVICE)
+        BuildAdapterIndex(dxgiFactory, vendorApis, adapterIndex);
 
-    int programResult = PROGRAM_EXIT_SUCCESS;
+    // For formats, created when the first of them is probed. It is a part of the setup of a worker restarted at
+    // formats, so crashes creating it count as crashes in a row, not as crashes of the format.
+    ComPtr<ID3D12Device> device;
+    std::optional<DeviceFeatureSupportSource> featureSupportSource;
+    auto createDevice = [&]() {
+        ADD_STAT(STAT_DEVICE_CREATIONS, 1);
+#if defined(AUTO_LINK_DX12)
+        CHECK_HR(::D3D12CreateDevice(adapter1.Get(), MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device)));
+#else
+        CHECK_HR(g_D3D12CreateDevice(adapter1.Get(), MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device)));
+#endif
+        featureSupportSource.emplace(device.Get());
+    };
 
-    if(!g_WARP && !g_ShowAllAdapters)
+    const uint32_t itemCount = GetAdapterProbeItemCount();
+    if(params.m_FirstItem >= ADAPTER_PROBE_ITEM_FORMATS && params.m_FirstItem < itemCount)
+        createDevice();
+    WriteProbeFrame(MakeProbeReadyFrame());
+
+    for(uint32_t item = params.m_FirstItem; item < itemCount; ++item)
     {
-        // In case of WARP, we queried adapter via different API that didn't use adapter index
-        // In case we show all adapters, array index equals adapter index
-        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+        if(item >= ADAPTER_PROBE_ITEM_FORMATS && !device)
+            createDevice();
+
+        int result = PROGRAM_EXIT_SUCCESS;
+        const std::string data = RecordProbeItem(flags, [&]() {
+            switch(item)
+            {
+            case ADAPTER_PROBE_ITEM_VENDOR_DATA:
+                PrintAdapterVendorData(adapter1.Get(), vendorApis);
+                break;
+            case ADAPTER_PROBE_ITEM_DEVICE:
+                result = PrintDeviceDetails(adapter1.Get(), vendorApis, false);
+                break;
+            default:
+                if(g_PrintFormatsMatrix)
+                    PrintFormatMatrix(*featureSupportSource);
+                else
+                    PrintSingleFormatInformation(*featureSupportSource, item - ADAPTER_PROBE_ITEM_FORMATS);
+                break;
+            }
+        });
+        WriteProbeFrame(MakeProbeFrame(item, data));
+        // The supervisor marks the next item as failed with this exit code, and continues after it.
+        if(result != PROGRAM_EXIT_SUCCESS)
+            return result;
     }
+    return PROGRAM_EXIT_SUCCESS;
+}
 
-    PrintAdapterData(adapter1.Get());
+// Worker process of --Isolate, started with --IsolatedWorker. Prints nothing but frames of its items to standard
+// output. A crash ends it with the code of the exception, returned by wmain. adapterIndex is of --Adapter, like in the
+// supervisor, to initialize vendor libraries for System Info only for the adapters inspected.
+static int RunIsolatedWorker(ReportFormatter::FLAGS flags, uint32_t adapterIndex)
+{
+    // Crashes are reported by the supervisor, not in a dialog waiting for the user.
+    ::SetErrorMode(SEM_FAILCRITICALERRORS | SEM_NOGPFAULTERRORBOX);
+    // Standard error is shared with the supervisor.
+    g_PrintStats = false;
 
-    DXGI_ADAPTER_DESC desc = {};
-    if(SUCCEEDED(adapter1->GetDesc(&desc)))
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries())
+        throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
+#endif
+
+    // Printed by the supervisor, but needed here before any device is created.
     {
-#if USE_NVAPI
-        bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-        if(useNVAPI && nvApi && nvApi->IsInitialized())
-        {
-            nvApi->PrintPhysicalGpuData(desc.AdapterLuid);
-        }
+        RecordingReportFormatter discarded;
+        ReportContext context(discarded, flags);
+        ReportContextScope contextScope(context);
+        EnableExperimentalFeatures();
+    }
+
+    VendorApis vendorApis;
+    int result = PROGRAM_EXIT_SUCCESS;
+    // Scope for COM objects.
+    {
+        ComPtr<IDXGIFactory4> dxgiFactory;
+#if defined(AUTO_LINK_DX12)
+        CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+        CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
 #endif
-#if USE_AGS
-        bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAGS && ags && ags->IsInitialized())
+        const IsolatedWorkerParams& params = *g_IsolatedWorker;
+        if(params.m_System)
         {
-            AGS_Initialize_RAII::DeviceId deviceId = {
-                .vendorId = (int)desc.VendorId, .deviceId = (int)desc.DeviceId, .revisionId = (int)desc.Revision
-            };
-            ags->PrintAgsDeviceData(deviceId);
+            BuildAdapterIndex(dxgiFactory.Get(), vendorApis, FindOnlyInspectedAdapter(dxgiFactory.Get(), adapterIndex));
+            WriteProbeFrame(MakeProbeReadyFrame());
+            WriteProbeFrame(MakeProbeFrame(0, RecordProbeItem(flags, [&]() { PrintVendorSystemData(vendorApis); })));
         }
+        else
+            result = ProbeIsolatedAdapter(flags, dxgiFactory.Get(), vendorApis, params);
+    }
+
+#if !defined(AUTO_LINK_DX12)
+    UnloadLibraries();
 #endif
-#if USE_AMD_DEVICE_INFO
-        bool useAmdDeviceInfo = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAmdDeviceInfo && amdDeviceInfo)
+    return result;
+}
+
+// Pipes are created and workers started one at a time, as otherwise a worker could inherit the write end of a pipe
+// of another worker, which would then stay open after that worker exits.
+static std::mutex g_ProbeWorkerLaunchMutex;
+
+// This program started again with --IsolatedWorker, writing frames to a pipe.
+class ProcessProbeWorker : public ProbeWorker
+{
+public:
+    ProcessProbeWorker(std::wstring commandLine)
+    {
+        SECURITY_ATTRIBUTES securityAttributes = { sizeof(securityAttributes), nullptr, TRUE };
+        STARTUPINFOW startupInfo = { sizeof(startupInfo) };
+        startupInfo.dwFlags = STARTF_USESTDHANDLES;
+        startupInfo.hStdInput = ::GetStdHandle(STD_INPUT_HANDLE);
+        startupInfo.hStdError = ::GetStdHandle(STD_ERROR_HANDLE);
+        PROCESS_INFORMATION processInfo = {};
+        BOOL created = FALSE;
         {
-            AmdDeviceInfo_Initialize_RAII::DeviceId deviceId = { desc.DeviceId, desc.Revision };
-            amdDeviceInfo->PrintDeviceData(deviceId);
+            std::lock_guard lock(g_ProbeWorkerLaunchMutex);
+            HANDLE outputWrite = nullptr;
+            if(!::CreatePipe(&m_OutputRead, &outputWrite, &securityAttributes, 0))
+                throw std::runtime_error("CreatePipe failed.");
+            // Only the write end is inherited by the worker.
+            ::SetHandleInformation(m_OutputRead, HANDLE_FLAG_INHERIT, 0);
+            startupInfo.hStdOutput = outputWrite;
+            created = ::CreateProcessW(nullptr, commandLine.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr,
+                &startupInfo, &processInfo);
+            // Closed here, so the pipe ends when the worker exits.
+            ::CloseHandle(outputWrite);
         }
-#endif
-#if USE_VULKAN
-        if(vk && vk->IsInitialized())
-            vk->PrintData(desc);
-#endif
-#if USE_INTEL_GPUDETECT
-        bool useGPUDetect = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_INTEL;
-        if(useGPUDetect && !g_PureD3D12)
+        if(!created)
         {
-            ComPtr<IDXGIAdapter> adapter;
-            adapter1->QueryInterface(IID_PPV_ARGS(&adapter));
-            IntelData::PrintAdapterData(adapter.Get());
+            ::CloseHandle(m_OutputRead);
+            throw std::runtime_error("Could not start a worker process of --Isolate.");
         }
-#endif
+        ::CloseHandle(processInfo.hThread);
+        m_Process = processInfo.hProcess;
+    }
+    ~ProcessProbeWorker() override
+    {
+        ::CloseHandle(m_OutputRead);
+        ::CloseHandle(m_Process);
+    }
+    size_t Read(void* buffer, size_t size) override
+    {
+        DWORD readSize = 0;
+        // Fails with ERROR_BROKEN_PIPE when the worker exited.
+        if(!::ReadFile(m_OutputRead, buffer, (DWORD)std::min<size_t>(size, MAXDWORD), &readSize, nullptr))
+            return 0;
+        return readSize;
+    }
+    void Terminate() override
+    {
+        ::TerminateProcess(m_Process, ERROR_INVALID_DATA);
+    }
+    uint32_t Wait() override
+    {
+        ::WaitForSingleObject(m_Process, INFINITE);
+        DWORD exitCode = 0;
+        ::GetExitCodeProcess(m_Process, &exitCode);
+        return exitCode;
     }
 
-    programResult = PrintDeviceDetails(adapter1.Get(), nvApi, ags);
+private:
+    HANDLE m_OutputRead = nullptr;
+    HANDLE m_Process = nullptr;
+};
 
-    return programResult;
-}
+// Adapters of the report with --Isolate, and results of their items probed by workers.
+struct IsolatedProbes
+{
+    std::vector<uint32_t> m_AdapterIndices;
+    std::vector<ComPtr<IDXGIAdapter1>> m_Adapters;
+    // Vendor data of System Info first, then a section per adapter.
+    std::vector<ProbeSectionResult> m_Sections;
+};
 
-static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+// Chooses adapters like without --Isolate and probes them in workers, before anything is printed. This process uses
+// only DXGI to print data of the adapters, so it doesn't initialize vendor libraries nor create devices.
+static void RunIsolatedProbes(IDXGIFactory4* dxgiFactory, uint32_t adapterIndex, IsolatedProbes& outProbes)
 {
-    uint32_t adapterIndex = 0;
-    bool anyInspected = false;
-    ComPtr<IDXGIAdapter1> adapter1;
-    while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
+    if(g_WARP || !g_ShowAllAdapters)
     {
-        if(g_SkipSoftwareAdapter)
-        {
-            DXGI_ADAPTER_DESC1 desc = {};
-            adapter1->GetDesc1(&desc);
-            if(desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE)
-            {
-                ++adapterIndex;
-                continue;
-            }
-        }
-
-        int result = InspectAdapter(nvApi, ags, amdDeviceInfo, vk, adapterIndex, adapter1);
-        anyInspected = true;
-        if(result != PROGRAM_EXIT_SUCCESS)
-            return result;
-        ++adapterIndex;
+        ComPtr<IDXGIAdapter1> adapter1 = ChooseAdapter(dxgiFactory, adapterIndex);
+        if(!adapter1)
+            throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
+        outProbes.m_AdapterIndices.push_back(adapterIndex);
+        outProbes.m_Adapters.push_back(std::move(adapter1));
     }
+    else
+        EnumInspectedAdapters(dxgiFactory, outProbes.m_AdapterIndices, outProbes.m_Adapters);
 
-    if(!anyInspected)
-        throw std::runtime_error("No D3D12 adapters to show.");
+    std::vector<uint32_t> itemCounts(1 + outProbes.m_Adapters.size(), GetAdapterProbeItemCount());
+    // Vendor libraries print nothing with --PureD3D12.
+    itemCounts[0] = g_PureD3D12 ? 0 : 1;
 
-    return PROGRAM_EXIT_SUCCESS;
+    // Same options, so workers print the same way.
+    const wstring commandLine = ::GetCommandLineW();
+    outProbes.m_Sections = RunProbeSections(itemCounts, [&](size_t sectionIndex, uint32_t firstItem) {
+        const wstring section = sectionIndex == 0 ? wstring(L"System")
+                                                  : std::format(L"{}", outProbes.m_AdapterIndices[sectionIndex - 1]);
+        return std::make_unique<ProcessProbeWorker>(
+            std::format(L"{} --IsolatedWorker={},{}", commandLine, section, firstItem));
+    });
 }
 
-// adapterIndex == UINT_MAX means first non-software and non-remote adapter.
-static int InspectAdapter(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk, uint32_t adapterIndex)
+// Replays the result of the item, or prints a field named after it telling why it is missing.
+static void PrintProbeItem(const ProbeItemResult& item, std::wstring_view name, std::wstring_view sectionName)
 {
-    ComPtr<IDXGIAdapter1> adapter1;
-    if(g_WARP)
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    switch(item.m_Status)
     {
-        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
+    case PROBE_ITEM_STATUS_DONE: {
+        RecordingReportFormatter recording;
+        std::istringstream stream(item.m_Data);
+        if(!recording.Load(stream))
+            throw std::runtime_error("Invalid output of a worker process of --Isolate.");
+        recording.Replay(formatter);
     }
-    else if(adapterIndex != UINT32_MAX)
-        dxgiFactory->EnumAdapters1(adapterIndex, &adapter1);
-    else
-    {
-        // No explicit adapter requested: Choose first non-software and non-remote.
-        adapterIndex = 0;
-        DXGI_ADAPTER_DESC1 desc = {};
-        while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
-        {
-            adapter1->GetDesc1(&desc);
-            if(desc.Flags == 0)
-                break;
-            adapter1.Reset();
-            ++adapterIndex;
-        }
+    break;
+    case PROBE_ITEM_STATUS_CRASHED: {
+        const uint32_t exitCode = item.m_ExitCode;
+        ErrorPrinter::PrintFormat(L"WARNING: Probing {} of {} failed with exit code 0x{:08X}.\n",
+            std::make_wformat_args(name, sectionName, exitCode));
+        formatter.AddFieldString(name, std::format(L"Probe failed with exit code 0x{:08X}", exitCode));
     }
+    break;
+    case PROBE_ITEM_STATUS_SKIPPED:
+        formatter.AddFieldString(name, L"Not probed after repeated failures");
+        break;
+    }
+}
 
-    if(adapter1)
+static void PrintIsolatedAdapters(const IsolatedProbes& probes)
+{
+    for(size_t i = 0; i < probes.m_Adapters.size(); ++i)
     {
-        return InspectAdapter(nvApi, ags, amdDeviceInfo, vk, adapterIndex, adapter1);
+        const uint32_t adapterIndex = probes.m_AdapterIndices[i];
+        const std::vector<ProbeItemResult>& items = probes.m_Sections[i + 1].m_Items;
+        const wstring sectionName = g_WARP ? wstring(L"WARP adapter") : std::format(L"adapter {}", adapterIndex);
+
+        ReportScopeArrayItemConditional scope(g_PrintAdaptersAsArray);
+        // Same as in InspectAdapter.
+        if(!g_WARP && (!g_ShowAllAdapters || !g_AdapterFilter.IsEmpty()))
+            ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+
+        PrintAdapterData(probes.m_Adapters[i].Get());
+        PrintProbeItem(items[ADAPTER_PROBE_ITEM_VENDOR_DATA], L"VendorAdapterData", sectionName);
+        PrintProbeItem(items[ADAPTER_PROBE_ITEM_DEVICE], L"Device", sectionName);
+        if(g_PrintFormatsMatrix)
+            PrintProbeItem(items[ADAPTER_PROBE_ITEM_FORMATS], L"FormatsMatrix", sectionName);
+        else if(g_PrintFormats)
+        {
+            ReportScopeObject scopeFormats(L"Formats");
+            for(size_t formatIndex = 0; formatIndex < GetFormatCount(); ++formatIndex)
+            {
+                const EnumItem& format = Enum_DXGI_FORMAT[formatIndex];
+                PrintProbeItem(items[ADAPTER_PROBE_ITEM_FORMATS + formatIndex],
+                    SelectString(format.m_Name, std::format(L"{}", format.m_Value)), sectionName);
+            }
+        }
     }
-
-    throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
 }
 
 int wmain3(int argc, wchar_t** argv)
@@ -1719,18 +2303,34 @@ int wmain3(int argc, wchar_t** argv)
         CMD_LINE_OPT_VERSION,
         CMD_LINE_OPT_HELP,
         CMD_LINE_OPT_LIST,
+        CMD_LINE_OPT_LIST_FAST,
         CMD_LINE_OPT_ADAPTER,
         CMD_LINE_OPT_ALL_ADAPTERS,
         CMD_LINE_OPT_JSON,
         CMD_LINE_OPT_MINIMIZE_JSON,
         CMD_LINE_OPT_OUTPUT_TO_FILE,
         CMD_LINE_OPT_FORMATS,
+        CMD_LINE_OPT_FORMATS_MATRIX,
         CMD_LINE_OPT_META_COMMANDS,
         CMD_LINE_OPT_ENUMS,
         CMD_LINE_OPT_PURE_D3D12,
         CMD_LINE_OPT_ENABLE_EXPERIMENTAL,
         CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC,
         CMD_LINE_OPT_WARP,
+        CMD_LINE_OPT_ENUM_DICTIONARY,
+        CMD_LINE_OPT_CAPTURE,
+        CMD_LINE_OPT_REPLAY,
+        CMD_LINE_OPT_CACHE,
+        CMD_LINE_OPT_REFRESH,
+        CMD_LINE_OPT_WATCH,
+        CMD_LINE_OPT_TIMINGS,
+        CMD_LINE_OPT_TRACE,
+        CMD_LINE_OPT_STATS,
+        CMD_LINE_OPT_REQUIRE,
+        CMD_LINE_OPT_SELECT,
+        CMD_LINE_OPT_EXCLUDE,
+        CMD_LINE_OPT_ISOLATE,
+        CMD_LINE_OPT_ISOLATED_WORKER,
     };
 
     // clang-format off
@@ -1740,6 +2340,7 @@ int wmain3(int argc, wchar_t** argv)
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,                  L'h',                   false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST,                  L"List",                false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST,                  L'l',                   false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST_FAST,             L"ListFast",            false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ADAPTER,               L"Adapter",             true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ADAPTER,               L'a',                   true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ALL_ADAPTERS,          L"AllAdapters",         false);
@@ -1750,6 +2351,7 @@ int wmain3(int argc, wchar_t** argv)
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_TO_FILE,        L"OutputFile",          true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS,               L"Formats",             false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS,               L'f',                   false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS_MATRIX,        L"FormatsMatrix",       false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_META_COMMANDS,         L"MetaCommands",        false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ENUMS,                 L"Enums",               false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ENUMS,                 L'e',                   false);
@@ -1758,6 +2360,21 @@ int wmain3(int argc, wchar_t** argv)
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ENABLE_EXPERIMENTAL,   L'x',                   true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC, L"ForceVendorAPI",      false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_WARP,                  L"WARP",                false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_ENUM_DICTIONARY,       L"EnumDictionary",      true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CAPTURE,               L"Capture",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_REPLAY,                L"Replay",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CACHE,                 L"Cache",               true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_REFRESH,               L"Refresh",             false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_WATCH,                 L"Watch",               true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TIMINGS,               L"Timings",             false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TRACE,                 L"Trace",               true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_STATS,                 L"Stats",               false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_REQUIRE,               L"Require",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SELECT,                L"Select",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_EXCLUDE,               L"Exclude",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_ISOLATE,               L"Isolate",             false);
+    // Internal, added by --Isolate to the command line of its worker processes.
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_ISOLATED_WORKER,       L"IsolatedWorker",      true);
     // clang-format on
 
     CmdLineParser::RESULT cmdLineResult;
@@ -1788,7 +2405,10 @@ int wmain3(int argc, wchar_t** argv)
                 }
                 g_ListAdapters = true;
                 break;
-            case CMD_LINE_OPT_ADAPTER:
+            case CMD_LINE_OPT_LIST_FAST:
+                g_ListAdaptersFast = true;
+                break;
+            case CMD_LINE_OPT_ADAPTER: {
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_LIST) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ALL_ADAPTERS) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_WARP))
@@ -1796,9 +2416,17 @@ int wmain3(int argc, wchar_t** argv)
                     g_ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_ShowAllAdapters = false;
-                adapterIndex = _wtoi(cmdLineParser.GetParameter().c_str());
-                break;
+                // Index of the adapter, or a filter, which throws if it is not valid.
+                const std::wstring param = cmdLineParser.GetParameter();
+                if(!param.empty() && param.find_first_not_of(L"0123456789") == std::wstring::npos)
+                {
+                    g_ShowAllAdapters = false;
+                    adapterIndex = _wtoi(param.c_str());
+                }
+                else
+                    g_AdapterFilter.AddTerms(param);
+            }
+            break;
             case CMD_LINE_OPT_ALL_ADAPTERS:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_LIST) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ADAPTER) ||
@@ -1824,6 +2452,9 @@ int wmain3(int argc, wchar_t** argv)
             case CMD_LINE_OPT_FORMATS:
                 g_PrintFormats = true;
                 break;
+            case CMD_LINE_OPT_FORMATS_MATRIX:
+                g_PrintFormatsMatrix = true;
+                break;
             case CMD_LINE_OPT_META_COMMANDS:
                 g_PrintMetaCommands = true;
                 break;
@@ -1868,6 +2499,74 @@ int wmain3(int argc, wchar_t** argv)
                 }
                 g_WARP = true;
                 break;
+            case CMD_LINE_OPT_ENUM_DICTIONARY:
+                g_WriteEnumDictionary = true;
+                g_EnumDictionaryPath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_CAPTURE:
+                if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_REPLAY))
+                {
+                    g_ShowCommandLineSyntaxAndFail = true;
+                    break;
+                }
+                g_CaptureFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_REPLAY:
+                if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_CAPTURE))
+                {
+                    g_ShowCommandLineSyntaxAndFail = true;
+                    break;
+                }
+                g_ReplayFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_CACHE:
+                g_CacheDirectoryPath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_REFRESH:
+                g_RefreshCache = true;
+                break;
+            case CMD_LINE_OPT_WATCH:
+                if(!ParseWatchInterval(cmdLineParser.GetParameter(), g_WatchIntervalSeconds))
+                    g_ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_TIMINGS:
+                g_PrintTimings = true;
+                break;
+            case CMD_LINE_OPT_TRACE:
+                g_TraceFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_STATS:
+                g_PrintStats = true;
+                break;
+            case CMD_LINE_OPT_REQUIRE:
+                g_RequirementsFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_SELECT:
+                g_FieldSelection.AddSelect(cmdLineParser.GetParameter());
+                break;
+            case CMD_LINE_OPT_EXCLUDE:
+                g_FieldSelection.AddExclude(cmdLineParser.GetParameter());
+                break;
+            case CMD_LINE_OPT_ISOLATE:
+                g_Isolate = true;
+                break;
+            case CMD_LINE_OPT_ISOLATED_WORKER: {
+                // <System or AdapterIndex>,<FirstItem>
+                const std::wstring param = cmdLineParser.GetParameter();
+                const size_t comma = param.find(L',');
+                if(comma == std::wstring::npos)
+                {
+                    g_ShowCommandLineSyntaxAndFail = true;
+                    break;
+                }
+                IsolatedWorkerParams params;
+                params.m_System = param.compare(0, comma, L"System") == 0;
+                if(!params.m_System)
+                    params.m_AdapterIndex = (uint32_t)wcstoul(param.c_str(), nullptr, 10);
+                params.m_FirstItem = (uint32_t)wcstoul(param.c_str() + comma + 1, nullptr, 10);
+                g_IsolatedWorker = params;
+            }
+            break;
             default:
                 g_ShowCommandLineSyntaxAndFail = true;
                 break;
@@ -1880,6 +2579,45 @@ int wmain3(int argc, wchar_t** argv)
         }
     }
 
+    // Watching inspects all adapters with D3D12 only, and nothing is captured or cached.
+    if(g_WatchIntervalSeconds > 0 &&
+        (g_ListAdapters || !g_ShowAllAdapters || g_WARP || g_ForceVendorAPI || !g_CaptureFilePath.empty() ||
+            !g_ReplayFilePath.empty() || !g_CacheDirectoryPath.empty()))
+    {
+        g_ShowCommandLineSyntaxAndFail = true;
+    }
+    // Checking requirements queries one adapter with D3D12 only, and prints no report.
+    if(!g_RequirementsFilePath.empty() &&
+        (g_ListAdapters || g_WatchIntervalSeconds > 0 || !g_CaptureFilePath.empty() || !g_ReplayFilePath.empty() ||
+            !g_CacheDirectoryPath.empty()))
+    {
+        g_ShowCommandLineSyntaxAndFail = true;
+    }
+    // A capture with queries skipped couldn't be replayed with other options, and --List and --Require print no
+    // device data.
+    if(!g_FieldSelection.IsEmpty() && (g_ListAdapters || !g_CaptureFilePath.empty() || !g_RequirementsFilePath.empty()))
+    {
+        g_ShowCommandLineSyntaxAndFail = true;
+    }
+
+    // Fast listing prints all adapters with DXGI only, and nothing is captured, cached or checked.
+    if(g_ListAdaptersFast &&
+        (g_ListAdapters || !g_ShowAllAdapters || g_WARP || g_WatchIntervalSeconds > 0 || !g_CaptureFilePath.empty() ||
+            !g_ReplayFilePath.empty() || !g_CacheDirectoryPath.empty() || !g_RequirementsFilePath.empty() ||
+            !g_FieldSelection.IsEmpty()))
+    {
+        g_ShowCommandLineSyntaxAndFail = true;
+    }
+
+    // Isolation covers the full report, printed once.
+    if(g_Isolate &&
+        (g_ListAdapters || g_ListAdaptersFast || g_WatchIntervalSeconds > 0 || !g_RequirementsFilePath.empty() ||
+            !g_CaptureFilePath.empty() || !g_ReplayFilePath.empty() || !g_CacheDirectoryPath.empty() ||
+            !g_FieldSelection.IsEmpty() || g_PrintTimings))
+    {
+        g_ShowCommandLineSyntaxAndFail = true;
+    }
+
     if(g_ShowCommandLineSyntaxAndFail)
     {
         PrinterScope scope(false, {});
@@ -1889,8 +2627,6 @@ int wmain3(int argc, wchar_t** argv)
 
     g_PrintAdaptersAsArray = g_ShowAllAdapters || g_UseJsonOutput;
 
-    PrinterScope printerScope(g_OutputFile, g_OutputFilePath);
-
     ReportFormatter::FLAGS flags = ReportFormatter::FLAGS::FLAG_NONE;
 
     if(g_UseJsonOutput)
@@ -1901,6 +2637,61 @@ int wmain3(int argc, wchar_t** argv)
     {
         flags |= ReportFormatter::FLAGS::FLAG_JSON_PRETTY_PRINT;
     }
+    if(g_WriteEnumDictionary)
+    {
+        // Names of enum items can be re-attached later from the dictionary.
+        flags |= ReportFormatter::FLAGS::FLAG_NUMERIC_ENUMS;
+    }
+
+    // Before the output file is opened, as it belongs to the supervisor.
+    if(g_IsolatedWorker)
+        return RunIsolatedWorker(flags, adapterIndex);
+
+    PrinterScope printerScope(g_OutputFile, g_OutputFilePath);
+
+    // Created before the report, so it has events until the end of printing.
+    std::unique_ptr<TraceWriter> traceWriter;
+    if(!g_TraceFilePath.empty() && !g_ShowVersionAndQuit && !g_ShowCommandLineSyntaxAndQuit)
+        traceWriter = std::make_unique<TraceWriter>(g_TraceFilePath);
+
+    if(g_ListAdaptersFast && !g_ShowVersionAndQuit && !g_ShowCommandLineSyntaxAndQuit)
+    {
+#if !defined(AUTO_LINK_DX12)
+        if(!LoadLibraries(false))
+            throw std::runtime_error("Could not load DXGI library.");
+#endif
+        const int result = ListAdaptersFast(flags);
+#if !defined(AUTO_LINK_DX12)
+        UnloadLibraries();
+#endif
+        return result;
+    }
+
+    // Prints separate records instead of one report.
+    if(g_WatchIntervalSeconds > 0 && !g_ShowVersionAndQuit && !g_ShowCommandLineSyntaxAndQuit)
+    {
+        g_PureD3D12 = true;
+        if(g_WriteEnumDictionary)
+            g_EnumDictionaryHash = WriteEnumDictionary(g_EnumDictionaryPath);
+#if !defined(AUTO_LINK_DX12)
+        if(!LoadLibraries())
+            throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
+#endif
+        return WatchAdapters(flags);
+    }
+
+    if(!g_RequirementsFilePath.empty() && !g_ShowVersionAndQuit && !g_ShowCommandLineSyntaxAndQuit)
+    {
+#if !defined(AUTO_LINK_DX12)
+        if(!LoadLibraries())
+            throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
+#endif
+        const int result = CheckRequirements(adapterIndex);
+#if !defined(AUTO_LINK_DX12)
+        UnloadLibraries();
+#endif
+        return result;
+    }
 
     ReportFormatterScope formatterScope(flags);
 
@@ -1923,110 +2714,161 @@ int wmain3(int argc, wchar_t** argv)
         return PROGRAM_EXIT_SUCCESS;
     }
 
-    PrintVersionData();
+    if(g_WriteEnumDictionary)
+        g_EnumDictionaryHash = WriteEnumDictionary(g_EnumDictionaryPath);
 
-#if !defined(AUTO_LINK_DX12)
-    if(!LoadLibraries())
-        throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
-#endif
+    // The header of the report is taken from the capture.
+    if(!g_ReplayFilePath.empty())
+        return ReplayCapture(g_ReplayFilePath);
 
-    std::unique_ptr<NvAPI_Inititalize_RAII> nvApiObjPtr;
-#if USE_NVAPI
-    if(!g_PureD3D12)
-        nvApiObjPtr = std::make_unique<NvAPI_Inititalize_RAII>();
-#endif
+    // Before the header, which is captured too.
+    if(!g_CaptureFilePath.empty())
+        g_CaptureWriter = std::make_unique<CaptureWriter>(g_CaptureFilePath);
+    else if(!g_CacheDirectoryPath.empty() && !g_ListAdapters)
+        g_ReportCache = std::make_unique<ReportCache>(g_CacheDirectoryPath);
 
-    std::unique_ptr<AGS_Initialize_RAII> agsObjPtr;
-#if USE_AGS
-    if(!g_PureD3D12)
-        agsObjPtr = std::make_unique<AGS_Initialize_RAII>();
-#endif
+    PrintVersionData();
 
-    std::unique_ptr<AmdDeviceInfo_Initialize_RAII> amdDeviceInfoObjPtr;
-#if USE_AMD_DEVICE_INFO
-    if(!g_PureD3D12)
-        amdDeviceInfoObjPtr = std::make_unique<AmdDeviceInfo_Initialize_RAII>();
-#endif
+    if(g_PrintTimings)
+        g_GlobalTimings = std::make_unique<TimingRecorder>();
+    TimingRecorderScope timingScope(g_GlobalTimings.get());
 
-    std::unique_ptr<Vulkan_Initialize_RAII> vkObjPtr;
-#if USE_VULKAN
-    if(!g_PureD3D12)
-        vkObjPtr = std::make_unique<Vulkan_Initialize_RAII>();
+#if !defined(AUTO_LINK_DX12)
+    {
+        TimingScope timing(L"LoadLibraries");
+        if(!LoadLibraries())
+            throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
+    }
 #endif
 
+    VendorApis vendorApis;
+    int programResult = PROGRAM_EXIT_SUCCESS;
+
+    // Scope for COM objects.
     {
-        ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+        ComPtr<IDXGIFactory4> dxgiFactory = nullptr;
+        {
+            TimingScope timing(L"CreateDXGIFactory1");
+#if defined(AUTO_LINK_DX12)
+            CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+            CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+        }
+        assert(dxgiFactory != nullptr);
 
-        if(!g_PureD3D12)
+        // Adapters need to be known before vendor libraries are used, to initialize only the ones needed. Also looks
+        // them up in the report cache. With --Isolate, vendor libraries are used only by workers.
+        IsolatedProbes isolatedProbes;
+        if(g_Isolate)
+            RunIsolatedProbes(dxgiFactory.Get(), adapterIndex, isolatedProbes);
+        else
         {
-            PrintOsVersionInfo();
-            PrintSystemMemoryInfo();
+            TimingScope timing(L"BuildAdapterIndex");
+            BuildAdapterIndex(dxgiFactory.Get(), vendorApis, FindOnlyInspectedAdapter(dxgiFactory.Get(), adapterIndex));
         }
 
-        PrintDXGIFeatureInfo();
+        {
+            ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+            TimingScope timing(L"SystemInfo");
 
-#if USE_NVAPI
-        if(nvApiObjPtr && nvApiObjPtr->IsInitialized())
-            nvApiObjPtr->PrintData();
-#endif
-#if USE_AGS
-        if(agsObjPtr && agsObjPtr->IsInitialized())
-            agsObjPtr->PrintData();
-#endif
+            if(!g_PureD3D12)
+            {
+                PrintCaptured(CAPTURE_REPORT_OS_INFO, []() {
+                    PrintOsVersionInfo();
+                    PrintSystemMemoryInfo();
+                });
+            }
 
-        EnableExperimentalFeatures();
+            PrintDXGIFeatureInfo();
 
-        DetectTranslationLayersGlobal();
-    }
+            PrintCaptured(CAPTURE_REPORT_SYSTEM_DATA, [&]() {
+                if(g_Isolate)
+                {
+                    if(!isolatedProbes.m_Sections[0].m_Items.empty())
+                        PrintProbeItem(isolatedProbes.m_Sections[0].m_Items[0], L"VendorSystemData", L"System Info");
+                }
+                else if(!g_ReportCache)
+                    PrintVendorSystemData(vendorApis);
+                else if(g_CachedSystemReport)
+                    g_CachedSystemReport->Replay(ReportFormatter::GetInstance());
+                else
+                    PrintAndStoreInReportCache(g_SystemCacheKeys, [&]() { return PrintVendorSystemData(vendorApis); });
 
-    if(g_PrintEnums)
-        PrintEnums();
+                EnableExperimentalFeatures();
 
-    int programResult = PROGRAM_EXIT_SUCCESS;
+                DetectTranslationLayersGlobal();
+            });
+        }
 
-    // Scope for COM objects.
-    {
-        ComPtr<IDXGIFactory4> dxgiFactory = nullptr;
-#if defined(AUTO_LINK_DX12)
-        CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
-#else
-        CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
-#endif
-        assert(dxgiFactory != nullptr);
+        if(g_PrintEnums)
+            PrintEnums();
 
         ReportScopeArrayConditional scopeArray(
             g_PrintAdaptersAsArray, SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
         ReportScopeObjectConditional scopeObject(!g_PrintAdaptersAsArray, L"Adapter");
 
+        TimingScope timing(L"Adapters");
         if(g_ListAdapters)
-            ListAdapters(
-                dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(), vkObjPtr.get());
+            ListAdapters(dxgiFactory.Get(), vendorApis);
+        else if(g_Isolate)
+            PrintIsolatedAdapters(isolatedProbes);
         else
         {
             if(g_WARP)
-                InspectAdapter(dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(),
-                    vkObjPtr.get(), UINT32_MAX);
+                InspectAdapter(dxgiFactory.Get(), vendorApis, UINT32_MAX);
             else if(!g_ShowAllAdapters)
-                InspectAdapter(dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(),
-                    vkObjPtr.get(), adapterIndex);
+                InspectAdapter(dxgiFactory.Get(), vendorApis, adapterIndex);
             else
-                InspectAllAdapters(
-                    dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(), vkObjPtr.get());
+                InspectAllAdapters(dxgiFactory.Get(), vendorApis);
         }
     }
 
+    if(g_GlobalTimings)
+        g_GlobalTimings->Print(TIMINGS_SLOWEST_CALL_COUNT);
+
 #if !defined(AUTO_LINK_DX12)
     UnloadLibraries();
 #endif
 
+    g_CaptureWriter.reset();
+    g_AdapterCacheEntries.clear();
+    g_CachedSystemReport.reset();
+    g_ReportCache.reset();
+    g_GlobalTimings.reset();
+
     return programResult;
 }
 
+// To standard error, so the report stays the same, also in JSON.
+static void PrintStats()
+{
+#if USE_STATS
+    // Taken before printing, which allocates memory too.
+    uint64_t values[STAT_COUNT];
+    for(uint32_t i = 0; i < STAT_COUNT; ++i)
+        values[i] = GetStatValue((STAT)i);
+
+    ErrorPrinter::PrintString(L"Stats:\n");
+    for(uint32_t i = 0; i < STAT_COUNT; ++i)
+    {
+        const wchar_t* const name = GetStatName((STAT)i);
+        ErrorPrinter::PrintFormat(L"  {}: {}\n", std::make_wformat_args(name, values[i]));
+    }
+#else
+    ErrorPrinter::PrintString("WARNING: --Stats is not available, as the program was built without ENABLE_STATS.\n");
+#endif
+}
+
 int wmain2(int argc, wchar_t** argv)
 {
     try
     {
-        return wmain3(argc, argv);
+        // After wmain3 returns, so the counters include closing the report and releasing everything.
+        const int result = wmain3(argc, argv);
+        if(g_PrintStats)
+            PrintStats();
+        return result;
     }
     catch(const std::exception& ex)
     {
@@ -2051,6 +2893,9 @@ int wmain(int argc, wchar_t** argv)
     {
         unsigned long exceptionCode = GetExceptionCode();
         ErrorPrinter::PrintFormat("STRUCTURED EXCEPTION: 0x{:08X}\n", std::make_format_args(exceptionCode));
+        // Reported by the supervisor of --Isolate for the item being probed.
+        if(g_IsolatedWorker)
+            return (int)exceptionCode;
         return PROGRAM_EXIT_ERROR_SEH_EXCEPTION;
     }
 }
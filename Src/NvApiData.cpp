@@ -485,7 +485,8 @@ static NvU32 g_LogicalGpuCount = 0;
 static NvLogicalGpuHandle g_LogicalGpuHandles[NVAPI_MAX_LOGICAL_GPUS];
 static NV_LOGICAL_GPU_DATA g_LogicalGpuData[NVAPI_MAX_LOGICAL_GPUS];
 static LUID g_LogicalGpuLuids[NVAPI_MAX_LOGICAL_GPUS];
-static NV_PHYSICAL_GPUS g_PhysicalGpus;
+// Adapter type of the only physical GPU of each logical GPU, if known.
+static std::optional<NV_ADAPTER_TYPE> g_LogicalGpuAdapterTypes[NVAPI_MAX_LOGICAL_GPUS];
 
 static wstring NvShortStringToStr(NvAPI_ShortString str)
 {
@@ -506,49 +507,19 @@ static void LoadGpus()
     }
 
     // Success in fetching this structure is optional.
-    g_PhysicalGpus.version = NV_PHYSICAL_GPUS_VER;
-    if(NvAPI_SYS_GetPhysicalGPUs(&g_PhysicalGpus) != NVAPI_OK)
-    {
-        ZeroMemory(&g_PhysicalGpus, sizeof g_PhysicalGpus);
-    }
-}
-
-static bool FindPhysicalGpu(const LUID& adapterLuid, NvPhysicalGpuHandle& outGpu)
-{
-    NvU32 foundIndex = UINT32_MAX;
+    NV_PHYSICAL_GPUS physicalGpus = { .version = NV_PHYSICAL_GPUS_VER };
+    if(NvAPI_SYS_GetPhysicalGPUs(&physicalGpus) != NVAPI_OK)
+        return;
+    std::unordered_map<NvPhysicalGpuHandle, NV_ADAPTER_TYPE> adapterTypes;
+    for(NvU32 i = 0; i < physicalGpus.gpuHandleCount; ++i)
+        adapterTypes.emplace(physicalGpus.gpuHandleData[i].hPhysicalGpu, physicalGpus.gpuHandleData[i].adapterType);
     for(NvU32 i = 0; i < g_LogicalGpuCount; ++i)
     {
-        if(memcmp(&g_LogicalGpuLuids[i], &adapterLuid, sizeof(LUID)) == 0)
-        {
-            if(g_LogicalGpuData[i].physicalGpuCount != 1)
-                // A logical GPU with multiple physical GPUs not supported by this tool.
-                return false;
-            if(foundIndex != UINT32_MAX)
-                // Found multiple GPUs with same LUID.
-                return false;
-            else
-                foundIndex = i;
-        }
-    }
-    if(foundIndex != UINT32_MAX)
-    {
-        outGpu = g_LogicalGpuData[foundIndex].physicalGpuHandles[0];
-        return true;
+        if(g_LogicalGpuData[i].physicalGpuCount != 1)
+            continue;
+        if(const auto it = adapterTypes.find(g_LogicalGpuData[i].physicalGpuHandles[0]); it != adapterTypes.end())
+            g_LogicalGpuAdapterTypes[i] = it->second;
     }
-    return false;
-}
-
-static bool FindPhysicalGpuAdapterType(NvPhysicalGpuHandle physicalGpuHandle, NV_ADAPTER_TYPE& outAdapterType)
-{
-    for(size_t i = 0; i < g_PhysicalGpus.gpuHandleCount; ++i)
-    {
-        if(g_PhysicalGpus.gpuHandleData[i].hPhysicalGpu == physicalGpuHandle)
-        {
-            outAdapterType = g_PhysicalGpus.gpuHandleData[i].adapterType;
-            return true;
-        }
-    }
-    return false;
 }
 
 static void PrintCooperativeVectorProperty(size_t index, const NVAPI_COOPERATIVE_VECTOR_PROPERTIES& props)
@@ -586,10 +557,6 @@ void NvAPI_Inititalize_RAII::PrintStaticParams()
     ReportFormatter& formatter = ReportFormatter::GetInstance();
     formatter.AddFieldString(L"NvAPI compiled version", NVAPI_COMPILED_VERSION);
     formatter.AddFieldUint32(L"NVAPI_SDK_VERSION", NVAPI_SDK_VERSION);
-
-    NvAPI_ShortString nvShortString;
-    if(NvAPI_GetInterfaceVersionString(nvShortString) == NVAPI_OK)
-        formatter.AddFieldString(L"NvAPI_GetInterfaceVersionString", NvShortStringToStr(nvShortString).c_str());
 }
 
 NvAPI_Inititalize_RAII::NvAPI_Inititalize_RAII()
@@ -610,6 +577,10 @@ void NvAPI_Inititalize_RAII::PrintData()
     assert(m_Initialized);
     ReportFormatter& formatter = ReportFormatter::GetInstance();
 
+    NvAPI_ShortString nvShortString;
+    if(NvAPI_GetInterfaceVersionString(nvShortString) == NVAPI_OK)
+        formatter.AddFieldString(L"NvAPI_GetInterfaceVersionString", NvShortStringToStr(nvShortString).c_str());
+
     NvU32 pDriverVersion = UINT32_MAX;
     NvAPI_ShortString szBuildBranchString = {};
     if(NvAPI_SYS_GetDriverAndBranchVersion(&pDriverVersion, szBuildBranchString) == NVAPI_OK)
@@ -645,6 +616,8 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
 
     wstring s;
 
+    // Each call is made only if its scope could be printed, e.g. with --Select.
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_QueryCpuVisibleVidmem"))
     {
         NvU64 totalBytes = 0, freeBytes = 0;
         if(NvAPI_D3D12_QueryCpuVisibleVidmem(device, &totalBytes, &freeBytes) == NVAPI_OK)
@@ -654,6 +627,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_IsNvShaderExtnOpCodeSupported"))
     {
         ReportScopeObjectConditional scope(L"NvAPI_D3D12_IsNvShaderExtnOpCodeSupported");
         for(const EnumItem* ei = Enum_NV_EXTN_OP; ei->m_Name != nullptr; ++ei)
@@ -667,6 +641,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_GetOptimalThreadCountForMesh"))
     {
         NvU32 threadCount = 0;
         if(NvAPI_D3D12_GetOptimalThreadCountForMesh(device, &threadCount) == NVAPI_OK)
@@ -676,6 +651,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_GetRaytracingCaps"))
     {
         ReportScopeObjectConditional scope(L"NvAPI_D3D12_GetRaytracingCaps");
         NVAPI_D3D12_RAYTRACING_THREAD_REORDERING_CAPS threadReorderingCaps = {};
@@ -742,6 +718,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_QueryWorkstationFeatureProperties"))
     {
         ReportScopeObjectConditional scope(L"NvAPI_D3D12_QueryWorkstationFeatureProperties");
         NVAPI_D3D12_WORKSTATION_FEATURE_PROPERTIES_PARAMS params = {
@@ -769,6 +746,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
+    if(IsReportScopeNeeded(L"NvAPI_D3D12_GetNeedsAppFPBlendClamping"))
     {
         bool appClampNeeded = false;
         if(NvAPI_D3D12_GetNeedsAppFPBlendClamping(device, &appClampNeeded) == NVAPI_OK)
@@ -778,7 +756,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
     }
 
-    if(NvU32 count = 0;
+    if(NvU32 count = 0; IsReportScopeNeeded(L"NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties") &&
         NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties(device, &count, nullptr) == NVAPI_OK && count > 0)
     {
         if(std::vector<NVAPI_COOPERATIVE_VECTOR_PROPERTIES> props(count);
@@ -789,22 +767,32 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
     }
 }
 
-void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
+void NvAPI_Inititalize_RAII::GetPhysicalGpuIdentities(std::vector<AdapterIdentity>& outIdentities) const
 {
     assert(m_Initialized);
+    outIdentities.resize(g_LogicalGpuCount);
+    for(NvU32 i = 0; i < g_LogicalGpuCount; ++i)
+        outIdentities[i] = { .m_Luid = LuidToUint64(g_LogicalGpuLuids[i]) };
+}
 
-    NvPhysicalGpuHandle gpu = {};
-    // This will always fail on non Nvidia GPUs
-    // so NVAPI can't be forced to run on non Nvidia GPU
-    if(!FindPhysicalGpu(adapterLuid, gpu))
+void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(size_t logicalGpuIndex)
+{
+    assert(m_Initialized);
+    assert(logicalGpuIndex < g_LogicalGpuCount);
+
+    // A logical GPU with multiple physical GPUs not supported by this tool.
+    if(g_LogicalGpuData[logicalGpuIndex].physicalGpuCount != 1)
         return;
+    NvPhysicalGpuHandle gpu = g_LogicalGpuData[logicalGpuIndex].physicalGpuHandles[0];
 
+    if(!IsReportScopeNeeded(L"NvPhysicalGpuHandle"))
+        return;
     ReportScopeObject scope(L"NvPhysicalGpuHandle");
     ReportFormatter& formatter = ReportFormatter::GetInstance();
 
-    if(NV_ADAPTER_TYPE adapterType; FindPhysicalGpuAdapterType(gpu, adapterType))
+    if(const std::optional<NV_ADAPTER_TYPE>& adapterType = g_LogicalGpuAdapterTypes[logicalGpuIndex])
     {
-        formatter.AddFieldFlags(L"adapterType", (uint32_t)adapterType, Enum_NV_ADAPTER_TYPE);
+        formatter.AddFieldFlags(L"adapterType", (uint32_t)*adapterType, Enum_NV_ADAPTER_TYPE);
     }
 
     NV_SYSTEM_TYPE systemType = {};
@@ -9,13 +9,15 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
+#include "AdapterIndex.hpp"
+
 // Macro set by Cmake.
 #if USE_NVAPI
 
 class NvAPI_Inititalize_RAII
 {
 public:
-    // Prints parameters related to NVAPI itself, regardless of whether intialization succeeded.
+    // Prints parameters NVAPI was compiled with. Doesn't call NVAPI, so it can be used before initialization.
     static void PrintStaticParams();
 
     NvAPI_Inititalize_RAII();
@@ -28,7 +30,10 @@ public:
     // Prints structs from NVAPI unrelated to any specific GPU.
     void PrintData();
     void PrintD3d12DeviceData(ID3D12Device* device);
-    void PrintPhysicalGpuData(const LUID& adapterLuid);
+    // One identity per logical GPU, to be matched with DXGI adapters by LUID.
+    void GetPhysicalGpuIdentities(std::vector<AdapterIdentity>& outIdentities) const;
+    // logicalGpuIndex is index of the identity returned by GetPhysicalGpuIdentities.
+    void PrintPhysicalGpuData(size_t logicalGpuIndex);
 
 private:
     bool m_Initialized = false;
@@ -0,0 +1,101 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ParallelInspection.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct InspectionResult
+{
+    RecordingReportFormatter m_Output;
+    int m_Result = PROGRAM_EXIT_SUCCESS;
+    std::exception_ptr m_Exception;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+int InspectInParallel(size_t count, const std::function<int(size_t)>& inspect)
+{
+    ReportContext& context = ReportContext::GetCurrent();
+    const ReportFormatter::FLAGS flags = context.GetFlags();
+
+    std::vector<std::future<std::unique_ptr<InspectionResult>>> futures;
+    futures.reserve(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        futures.push_back(std::async(std::launch::async, [&inspect, flags, i]() {
+            auto result = std::make_unique<InspectionResult>();
+            ReportContext recordingContext(result->m_Output, flags);
+            ReportContextScope contextScope(recordingContext);
+            try
+            {
+                result->m_Result = inspect(i);
+            }
+            catch(...)
+            {
+                result->m_Exception = std::current_exception();
+            }
+            return result;
+        }));
+    }
+
+    // Remaining futures wait for their threads when destroyed, also on early return.
+    for(auto& future : futures)
+    {
+        const std::unique_ptr<InspectionResult> result = future.get();
+        result->m_Output.Replay(context.GetFormatter());
+        if(result->m_Exception)
+            std::rethrow_exception(result->m_Exception);
+        if(result->m_Result != PROGRAM_EXIT_SUCCESS)
+            return result->m_Result;
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+void ParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+    std::atomic<size_t> nextIndex = 0;
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+    auto work = [&]() {
+        for(size_t i; (i = nextIndex++) < count;)
+        {
+            try
+            {
+                func(i);
+            }
+            catch(...)
+            {
+                nextIndex = count;
+                std::lock_guard lock(exceptionMutex);
+                if(!exception)
+                    exception = std::current_exception();
+            }
+        }
+    };
+
+    const size_t threadCount = std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1u));
+    {
+        std::vector<std::jthread> threads;
+        for(size_t i = 1; i < threadCount; ++i)
+            threads.emplace_back(work);
+        work();
+    }
+
+    if(exception)
+        std::rethrow_exception(exception);
+}
@@ -0,0 +1,28 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Inspection of multiple adapters at once, printed as if done one after another. Depends only on ReportFormatter
+// and the C++ standard library, so it can run with fake adapters.
+
+#include <cstddef>
+#include <functional>
+
+// Calls inspect(i) for each i in [0, count), each on a separate thread printing into its own buffer. Buffers are
+// printed to the current ReportFormatter in order of i, as soon as all before them are done, so the output is the
+// same as of a serial loop. Like a serial loop, stops after the first call that returns other than
+// PROGRAM_EXIT_SUCCESS or throws, and returns its result or rethrows its exception. Output of later calls is
+// discarded, but they still run to the end.
+int InspectInParallel(size_t count, const std::function<int(size_t)>& inspect);
+
+// Calls func(i) for each i in [0, count) on a pool of threads, including the calling one, and waits for all of them.
+// Indices are taken in increasing order. func must not print, as it runs outside of the current ReportContext. If
+// any call throws, the remaining indices are skipped and the first exception is rethrown.
+void ParallelFor(size_t count, const std::function<void(size_t)>& func);
@@ -0,0 +1,431 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+/*
+Command-line tool that resolves PCI IDs collected from many machines to names,
+using the same tables that D3d12info uses: Enum_VendorId, Enum_SubsystemVendorId,
+AMD device_info, IntelGfx.cfg and Intel GPU Detect. It doesn't touch any GPU, so it
+can run anywhere, and it builds on any platform - only Intel architecture names need
+Intel GPU Detect, available on Windows. Architecture of NVIDIA GPUs is not reported,
+as only NVAPI knows it, and only for GPUs present in the system.
+
+Input is either CSV with columns VendorId,DeviceId,SubSysId,Revision (hexadecimal,
+optional header line, further columns ignored) or NDJSON with objects having these keys (numbers or
+hexadecimal strings). The format is detected from the first non-empty line and
+the output is written in the same format, one output row per input row. Rows that
+could not be parsed have all columns empty in the output.
+*/
+
+#include "AmdDeviceInfoData.hpp"
+#include "EnumItems.hpp"
+#include "IntelData.hpp"
+#include "ParallelInspection.hpp"
+#include "Printer.hpp"
+#include "Utils.hpp"
+
+#if USE_INTEL_GFX_TABLE
+#include "IntelGfxTable.hpp"
+#endif
+
+#include <charconv>
+
+// Rows are resolved in parallel in chunks of this size.
+static const size_t ROW_CHUNK_SIZE = 4096;
+
+static const char* const OUTPUT_COLUMNS[] = {
+    "VendorId",
+    "DeviceId",
+    "SubSysId",
+    "Revision",
+    "Vendor",
+    "SubsystemVendor",
+    "AmdAsicType",
+    "AmdGeneration",
+    "AmdMarketingName",
+    "IntelArchitecture",
+    "IntelGraphicsGeneration",
+    "IntelDefaultFidelityPreset",
+};
+static const size_t OUTPUT_COLUMN_COUNT = std::size(OUTPUT_COLUMNS);
+
+enum class InputFormat
+{
+    CSV,
+    NDJSON,
+};
+
+struct PciIdRow
+{
+    uint32_t vendorId, deviceId, subSysId, revision;
+    // False for a line that could not be parsed. It still gets its output row, with all columns empty.
+    bool parsed;
+};
+
+// Values of OUTPUT_COLUMNS, UTF-8. Empty if not applicable or unknown.
+using ResolvedRow = std::array<string, OUTPUT_COLUMN_COUNT>;
+
+static std::string_view TrimStr(std::string_view str)
+{
+    const size_t begin = str.find_first_not_of(" \t\r");
+    if(begin == std::string_view::npos)
+        return {};
+    const size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+static bool ParseUint32(std::string_view str, int base, uint32_t& outValue)
+{
+    str = TrimStr(str);
+    if(base == 16 && str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+        str.remove_prefix(2);
+    if(str.empty())
+        return false;
+    const std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), outValue, base);
+    return result.ec == std::errc{} && result.ptr == str.data() + str.size();
+}
+
+static bool ParseCsvRow(std::string_view line, PciIdRow& outRow)
+{
+    uint32_t* const dst[] = { &outRow.vendorId, &outRow.deviceId, &outRow.subSysId, &outRow.revision };
+    for(size_t i = 0; i < std::size(dst); ++i)
+    {
+        const size_t comma = line.find(',');
+        if(comma == std::string_view::npos && i + 1 < std::size(dst))
+            return false;
+        if(!ParseUint32(line.substr(0, comma), 16, *dst[i]))
+            return false;
+        line = comma == std::string_view::npos ? std::string_view{} : line.substr(comma + 1);
+    }
+    return true;
+}
+
+// Minimal lookup of a top-level "key": value pair. Value may be a decimal number or a string with hexadecimal number.
+static bool FindJsonUint32(std::string_view line, std::string_view key, uint32_t& outValue)
+{
+    const string quotedKey = std::format("\"{}\"", key);
+    size_t pos = line.find(quotedKey);
+    if(pos == std::string_view::npos)
+        return false;
+    pos = line.find_first_not_of(" \t", pos + quotedKey.size());
+    if(pos == std::string_view::npos || line[pos] != ':')
+        return false;
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if(pos == std::string_view::npos)
+        return false;
+    if(line[pos] == '"')
+    {
+        const size_t end = line.find('"', pos + 1);
+        return end != std::string_view::npos && ParseUint32(line.substr(pos + 1, end - pos - 1), 16, outValue);
+    }
+    const size_t end = line.find_first_of(",} \t", pos);
+    return ParseUint32(line.substr(pos, end == std::string_view::npos ? end : end - pos), 10, outValue);
+}
+
+static bool ParseJsonRow(std::string_view line, PciIdRow& outRow)
+{
+    return FindJsonUint32(line, "VendorId", outRow.vendorId) && FindJsonUint32(line, "DeviceId", outRow.deviceId) &&
+           FindJsonUint32(line, "SubSysId", outRow.subSysId) && FindJsonUint32(line, "Revision", outRow.revision);
+}
+
+#if USE_AMD_DEVICE_INFO
+static const EnumItem* FindEnumItems(const wchar_t* enumName)
+{
+    const std::unordered_map<wstring, const EnumItem*>& enums = EnumCollection::GetInstance().m_Enums;
+    const auto it = enums.find(enumName);
+    return it != enums.end() ? it->second : nullptr;
+}
+#endif
+
+static string EnumItemNameToStr(uint32_t value, const EnumItem* items)
+{
+    const wchar_t* name = items ? FindEnumItemName(value, items) : nullptr;
+    return name ? WstrToUtf8(name) : string{};
+}
+
+static void ResolveRows(const PciIdRow* rows, size_t count, ResolvedRow* outRows)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        const PciIdRow& row = rows[i];
+        if(!row.parsed)
+            continue;
+        ResolvedRow& dst = outRows[i];
+        dst[0] = std::format("0x{:04X}", row.vendorId);
+        dst[1] = std::format("0x{:04X}", row.deviceId);
+        dst[2] = std::format("0x{:08X}", row.subSysId);
+        dst[3] = std::format("0x{:02X}", row.revision);
+        dst[4] = EnumItemNameToStr(row.vendorId, Enum_VendorId);
+        dst[5] = EnumItemNameToStr(row.subSysId & 0xFFFF, Enum_SubsystemVendorId);
+        if(row.vendorId == VENDOR_ID_INTEL)
+        {
+#if USE_INTEL_GPUDETECT
+            const IntelData::ArchitectureInfo archInfo = IntelData::FindArchitecture(row.deviceId);
+            dst[9] = archInfo.architecture;
+            dst[10] = archInfo.graphicsGeneration;
+#endif
+#if USE_INTEL_GFX_TABLE
+            dst[11] = GetIntelGfxPresetLevelName(FindIntelGfxPresetLevel(row.deviceId));
+#endif
+        }
+    }
+
+#if USE_AMD_DEVICE_INFO
+    // Batched, as rows from fleet data often repeat the same device.
+    std::vector<AmdDeviceInfo_Initialize_RAII::DeviceId> amdIds;
+    std::vector<size_t> amdRowIndices;
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(rows[i].parsed && rows[i].vendorId == VENDOR_ID_AMD)
+        {
+            amdIds.push_back({ rows[i].deviceId, rows[i].revision });
+            amdRowIndices.push_back(i);
+        }
+    }
+    std::vector<AmdDeviceInfo_Initialize_RAII::CardInfo> amdInfos(amdIds.size());
+    std::unique_ptr<bool[]> amdFound = std::make_unique<bool[]>(amdIds.size());
+    AmdDeviceInfo_Initialize_RAII::FindCardInfos(amdIds.data(), amdIds.size(), amdInfos.data(), amdFound.get());
+    static const EnumItem* const asicTypeItems = FindEnumItems(L"GDT_HW_ASIC_TYPE");
+    static const EnumItem* const generationItems = FindEnumItems(L"GDT_HW_GENERATION");
+    for(size_t i = 0; i < amdIds.size(); ++i)
+    {
+        if(!amdFound[i])
+            continue;
+        ResolvedRow& dst = outRows[amdRowIndices[i]];
+        dst[6] = EnumItemNameToStr(amdInfos[i].asicType, asicTypeItems);
+        dst[7] = EnumItemNameToStr(amdInfos[i].generation, generationItems);
+        dst[8] = amdInfos[i].marketingName ? amdInfos[i].marketingName : "";
+    }
+#endif
+}
+
+static void WriteCsvValue(std::ostream& out, const string& value)
+{
+    if(value.find_first_of(",\"\r\n") == string::npos)
+    {
+        out << value;
+        return;
+    }
+    out << '"';
+    for(char ch : value)
+    {
+        if(ch == '"')
+            out << '"';
+        out << ch;
+    }
+    out << '"';
+}
+
+static void WriteJsonString(std::ostream& out, const string& value)
+{
+    out << '"';
+    for(char ch : value)
+    {
+        if(ch == '"' || ch == '\\')
+            out << '\\' << ch;
+        else if((unsigned char)ch < 0x20)
+            out << std::format("\\u{:04x}", (unsigned)ch);
+        else
+            out << ch;
+    }
+    out << '"';
+}
+
+static void WriteRow(std::ostream& out, InputFormat format, const ResolvedRow& row)
+{
+    if(format == InputFormat::CSV)
+    {
+        for(size_t i = 0; i < OUTPUT_COLUMN_COUNT; ++i)
+        {
+            if(i > 0)
+                out << ',';
+            WriteCsvValue(out, row[i]);
+        }
+    }
+    else
+    {
+        out << '{';
+        bool first = true;
+        for(size_t i = 0; i < OUTPUT_COLUMN_COUNT; ++i)
+        {
+            if(row[i].empty())
+                continue;
+            if(!first)
+                out << ',';
+            first = false;
+            out << '"' << OUTPUT_COLUMNS[i] << "\":";
+            WriteJsonString(out, row[i]);
+        }
+        out << '}';
+    }
+    out << '\n';
+}
+
+static void ReadRows(std::istream& in, InputFormat& outFormat, std::vector<PciIdRow>& outRows)
+{
+    outFormat = InputFormat::CSV;
+    bool formatDetected = false;
+    string line;
+    for(size_t lineNumber = 1; std::getline(in, line); ++lineNumber)
+    {
+        const std::string_view trimmedLine = TrimStr(line);
+        if(trimmedLine.empty())
+            continue;
+        const bool firstLine = !formatDetected;
+        if(firstLine)
+        {
+            outFormat = trimmedLine[0] == '{' ? InputFormat::NDJSON : InputFormat::CSV;
+            formatDetected = true;
+        }
+
+        PciIdRow row = {};
+        row.parsed = outFormat == InputFormat::CSV ? ParseCsvRow(trimmedLine, row) : ParseJsonRow(trimmedLine, row);
+        // First line of CSV which is not a row of numbers is a header.
+        if(!row.parsed && firstLine && outFormat == InputFormat::CSV)
+            continue;
+        if(!row.parsed)
+            ErrorPrinter::PrintFormat(L"WARNING: Could not parse line {}, its output row is empty.\n",
+                std::make_wformat_args(lineNumber));
+        outRows.push_back(row);
+    }
+}
+
+static void PrintCommandLineSyntax()
+{
+    // clang-format off
+    ErrorPrinter::PrintString(L"Resolves PCI IDs to vendor names and GPU families using tables built into D3d12info.\n");
+    ErrorPrinter::PrintString(L"Input rows are CSV \"VendorId,DeviceId,SubSysId,Revision\" or NDJSON objects with these keys.\n");
+    ErrorPrinter::PrintString(L"Options:\n");
+    ErrorPrinter::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
+    ErrorPrinter::PrintString(L"  -i --InputFile=<FilePath>        Read rows from specified file instead of standard input.\n");
+    ErrorPrinter::PrintString(L"  -o --OutputFile=<FilePath>       Write results to specified file instead of standard output.\n");
+    // clang-format on
+}
+
+static int wmain2(int argc, wchar_t** argv)
+{
+    CmdLineParser cmdLineParser(argc, argv);
+
+    enum CMD_LINE_PARAM
+    {
+        CMD_LINE_OPT_HELP,
+        CMD_LINE_OPT_INPUT_FILE,
+        CMD_LINE_OPT_OUTPUT_FILE,
+    };
+
+    // clang-format off
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,        L"Help",       false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,        L'h',          false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_INPUT_FILE,  L"InputFile",  true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_INPUT_FILE,  L'i',          true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_FILE, L"OutputFile", true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_FILE, L'o',          true);
+    // clang-format on
+
+    std::wstring inputFilePath, outputFilePath;
+    CmdLineParser::RESULT cmdLineResult;
+    while((cmdLineResult = cmdLineParser.ReadNextOpt()) != CmdLineParser::RESULT_END)
+    {
+        if(cmdLineResult != CmdLineParser::RESULT_OPT)
+        {
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+        }
+        switch(cmdLineParser.GetOptId())
+        {
+        case CMD_LINE_OPT_HELP:
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_SUCCESS;
+        case CMD_LINE_OPT_INPUT_FILE:
+            inputFilePath = cmdLineParser.GetParameter();
+            break;
+        case CMD_LINE_OPT_OUTPUT_FILE:
+            outputFilePath = cmdLineParser.GetParameter();
+            break;
+        default:
+            assert(0);
+        }
+    }
+
+    InputFormat format = InputFormat::CSV;
+    std::vector<PciIdRow> rows;
+    if(inputFilePath.empty())
+        ReadRows(std::cin, format, rows);
+    else
+    {
+        std::ifstream inputFile(std::filesystem::path(inputFilePath), std::ios::binary);
+        if(!inputFile.is_open())
+        {
+            const string pathStr = WstrToUtf8(inputFilePath);
+            throw std::runtime_error(std::format("Could not open input file \"{}\".", pathStr));
+        }
+        ReadRows(inputFile, format, rows);
+    }
+
+    std::vector<ResolvedRow> resolvedRows(rows.size());
+    const size_t chunkCount = (rows.size() + ROW_CHUNK_SIZE - 1) / ROW_CHUNK_SIZE;
+    ParallelFor(chunkCount, [&](size_t chunkIndex) {
+        const size_t firstRow = chunkIndex * ROW_CHUNK_SIZE;
+        const size_t rowCount = std::min(ROW_CHUNK_SIZE, rows.size() - firstRow);
+        ResolveRows(rows.data() + firstRow, rowCount, resolvedRows.data() + firstRow);
+    });
+
+    std::ofstream outputFile;
+    if(!outputFilePath.empty())
+    {
+        outputFile.open(std::filesystem::path(outputFilePath), std::ios::binary);
+        if(!outputFile.is_open())
+        {
+            const string pathStr = WstrToUtf8(outputFilePath);
+            throw std::runtime_error(std::format("Could not open output file \"{}\".", pathStr));
+        }
+    }
+    std::ostream& out = outputFilePath.empty() ? std::cout : outputFile;
+    if(format == InputFormat::CSV)
+    {
+        for(size_t i = 0; i < OUTPUT_COLUMN_COUNT; ++i)
+            out << (i > 0 ? "," : "") << OUTPUT_COLUMNS[i];
+        out << '\n';
+    }
+    for(const ResolvedRow& row : resolvedRows)
+        WriteRow(out, format, row);
+    out.flush();
+    if(!out)
+        throw std::runtime_error("Could not write output.");
+
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+int wmain(int argc, wchar_t** argv)
+{
+    try
+    {
+        return wmain2(argc, argv);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+}
+
+#ifndef _WIN32
+
+// Other platforms pass arguments as UTF-8.
+int main(int argc, char** argv)
+{
+    std::vector<wstring> args((size_t)argc);
+    std::transform(argv, argv + argc, args.begin(), [](const char* arg) { return Utf8ToWstr(arg); });
+    std::vector<wchar_t*> argPtrs(args.size());
+    std::transform(args.begin(), args.end(), argPtrs.begin(), [](wstring& arg) { return arg.data(); });
+    return wmain(argc, argPtrs.data());
+}
+
+#endif
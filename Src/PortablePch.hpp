@@ -0,0 +1,50 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Precompiled header of modules that depend only on the C++ standard library. Included by pch.hpp, and used directly
+// by tools and tests that also build on platforms other than Windows.
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <cwctype>
+
+using std::string;
+using std::wstring;
+
+static const int PROGRAM_EXIT_SUCCESS = 0;
+static const int PROGRAM_EXIT_ERROR_INIT = -1;
+static const int PROGRAM_EXIT_ERROR_COMMAND_LINE = -2;
+static const int PROGRAM_EXIT_ERROR_EXCEPTION = -3;
+static const int PROGRAM_EXIT_ERROR_SEH_EXCEPTION = -4;
+static const int PROGRAM_EXIT_ERROR_D3D12 = -5;
+// --Require ran correctly, but the adapter doesn't meet the requirements.
+static const int PROGRAM_EXIT_REQUIREMENTS_NOT_MET = 1;
@@ -9,24 +9,27 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "Printer.hpp"
 
+#include "Stats.hpp"
+#include "Timings.hpp"
 #include "Utils.hpp"
 
-bool Printer::m_IsInitialized = false;
-bool Printer::m_WritingToFile = false;
-std::wostream* Printer::m_Output = nullptr;
+thread_local bool Printer::m_IsInitialized = false;
+thread_local bool Printer::m_WritingToFile = false;
+thread_local std::wostream* Printer::m_Output = nullptr;
 
 bool Printer::Initialize(bool writeToFile, std::wstring_view name)
 {
     assert(!m_IsInitialized);
     if(writeToFile)
     {
-        m_Output = new std::wofstream(name.data(), std::ios_base::out);
+        m_Output = new std::wofstream(std::filesystem::path(name), std::ios_base::out);
         if(!m_Output->good())
         {
             delete m_Output;
             m_Output = nullptr;
             return false;
         }
+        m_WritingToFile = true;
     }
     else
     {
@@ -36,6 +39,13 @@ bool Printer::Initialize(bool writeToFile, std::wstring_view name)
     return true;
 }
 
+void Printer::Initialize(std::wostream& output)
+{
+    assert(!m_IsInitialized);
+    m_Output = &output;
+    m_IsInitialized = true;
+}
+
 void Printer::Release()
 {
     assert(m_IsInitialized);
@@ -51,12 +61,23 @@ void Printer::Release()
 void Printer::PrintNewLine()
 {
     assert(m_IsInitialized);
-    *m_Output << std::endl;
+    ADD_STAT(STAT_PRINTED_CHARS, 1);
+    ADD_STAT(STAT_PRINTER_FLUSHES, 1);
+    // Each new line flushes the output, so this is where printing takes time.
+    if(TimingRecorder* const timings = TimingRecorder::GetCurrent(); timings || TraceWriter::GetInstance())
+    {
+        const TimingClock::time_point begin = TimingClock::now();
+        *m_Output << std::endl;
+        AddTimedCall(timings, L"OutputFlush", {}, begin, TimingClock::now());
+    }
+    else
+        *m_Output << std::endl;
 }
 
 void Printer::PrintString(const std::string& line)
 {
     assert(m_IsInitialized);
+    ADD_STAT(STAT_PRINTED_CHARS, line.length());
 
     *m_Output << line.c_str();
 }
@@ -64,6 +85,7 @@ void Printer::PrintString(const std::string& line)
 void Printer::PrintString(std::wstring_view line)
 {
     assert(m_IsInitialized);
+    ADD_STAT(STAT_PRINTED_CHARS, line.length());
 
     *m_Output << line;
 }
@@ -86,8 +108,7 @@ PrinterScope::PrinterScope(bool writeToFile, std::wstring_view name)
     {
         if(writeToFile)
         {
-            std::wstring nameNullTerminated(name.begin(), name.end());
-            std::string narrowName = WstrToStr(nameNullTerminated.c_str(), CP_ACP);
+            std::string narrowName = WstrToUtf8(name);
             throw std::runtime_error(std::format("Could not open {} for writing.", narrowName));
         }
         else
@@ -97,6 +118,11 @@ PrinterScope::PrinterScope(bool writeToFile, std::wstring_view name)
     }
 }
 
+PrinterScope::PrinterScope(std::wostream& output)
+{
+    Printer::Initialize(output);
+}
+
 PrinterScope::~PrinterScope()
 {
     Printer::Release();
@@ -12,10 +12,13 @@ For more information, see files README.md, LICENSE.txt.
 
 #include <format>
 
+// State is per thread, so multiple threads can each print a separate report.
 class Printer
 {
 public:
     static bool Initialize(bool writeToFile, std::wstring_view name);
+    // Prints to the stream, which must stay alive until Release.
+    static void Initialize(std::wostream& output);
     static void Release();
 
     static void PrintNewLine();
@@ -27,15 +30,16 @@ public:
     static void PrintFormat(std::wstring_view format, std::wformat_args&& args);
 
 private:
-    static bool m_IsInitialized;
-    static bool m_WritingToFile;
-    static std::wostream* m_Output;
+    static thread_local bool m_IsInitialized;
+    static thread_local bool m_WritingToFile;
+    static thread_local std::wostream* m_Output;
 };
 
 class PrinterScope
 {
 public:
     PrinterScope(bool writeToFile, std::wstring_view name);
+    PrinterScope(std::wostream& output);
     ~PrinterScope();
 };
 
@@ -0,0 +1,140 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ProbeSupervisor.hpp"
+#include "ParallelInspection.hpp"
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const size_t PROBE_FRAME_HEADER_SIZE = 3 * sizeof(uint32_t);
+static const size_t PROBE_READ_BUFFER_SIZE = 64 * 1024;
+
+static void AppendUint32(std::string& str, uint32_t value)
+{
+    str.append((const char*)&value, sizeof(value));
+}
+
+static uint32_t ReadUint32(const char* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Reads frames until the worker closes its output, storing results of items starting from ioNextItem, which is
+// advanced after each one. outReady tells if the ready frame came. Returns false if the output is not valid.
+static bool ReadProbeFrames(
+    ProbeWorker& worker, uint32_t& ioNextItem, std::vector<ProbeItemResult>& items, bool& outReady)
+{
+    outReady = false;
+    std::string pending;
+    std::vector<char> buffer(PROBE_READ_BUFFER_SIZE);
+    for(;;)
+    {
+        const size_t readSize = worker.Read(buffer.data(), buffer.size());
+        if(readSize == 0)
+        {
+            // A frame cut in the middle is from a worker that crashed while writing it.
+            return true;
+        }
+        pending.append(buffer.data(), readSize);
+
+        size_t offset = 0;
+        while(pending.size() - offset >= PROBE_FRAME_HEADER_SIZE)
+        {
+            const char* const header = pending.data() + offset;
+            const uint32_t itemIndex = ReadUint32(header + sizeof(uint32_t));
+            const uint32_t dataSize = ReadUint32(header + 2 * sizeof(uint32_t));
+            if(ReadUint32(header) != PROBE_FRAME_MAGIC)
+                return false;
+            if(!outReady)
+            {
+                if(itemIndex != PROBE_READY_ITEM_INDEX || dataSize != 0)
+                    return false;
+                outReady = true;
+                offset += PROBE_FRAME_HEADER_SIZE;
+                continue;
+            }
+            if(itemIndex != ioNextItem || itemIndex >= items.size() || dataSize > PROBE_FRAME_MAX_DATA_SIZE)
+                return false;
+            if(pending.size() - offset - PROBE_FRAME_HEADER_SIZE < dataSize)
+                break;
+
+            ProbeItemResult& item = items[itemIndex];
+            item.m_Status = PROBE_ITEM_STATUS_DONE;
+            item.m_Data.assign(header + PROBE_FRAME_HEADER_SIZE, dataSize);
+            offset += PROBE_FRAME_HEADER_SIZE + dataSize;
+            ++ioNextItem;
+        }
+        pending.erase(0, offset);
+    }
+}
+
+static void RunProbeSection(size_t sectionIndex, const ProbeWorkerLauncher& launch, ProbeSectionResult& result)
+{
+    const uint32_t itemCount = (uint32_t)result.m_Items.size();
+    uint32_t nextItem = 0;
+    uint32_t crashesInARow = 0;
+    while(nextItem < itemCount && crashesInARow < PROBE_MAX_CRASHES_IN_A_ROW)
+    {
+        const std::unique_ptr<ProbeWorker> worker = launch(sectionIndex, nextItem);
+        ++result.m_WorkerCount;
+        bool ready = false;
+        if(!ReadProbeFrames(*worker, nextItem, result.m_Items, ready))
+            worker->Terminate();
+        const uint32_t exitCode = worker->Wait();
+        if(nextItem == itemCount)
+            break;
+
+        // Ended before all items. If it was set up, it crashed on the next one, which is given up. Otherwise the same
+        // item is tried again by a new worker, unless the setup failed too many times.
+        if(!ready && ++crashesInARow < PROBE_MAX_CRASHES_IN_A_ROW)
+            continue;
+        ProbeItemResult& item = result.m_Items[nextItem];
+        item.m_Status = PROBE_ITEM_STATUS_CRASHED;
+        item.m_ExitCode = exitCode;
+        if(ready)
+            crashesInARow = 0;
+        ++nextItem;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::string MakeProbeFrame(uint32_t itemIndex, std::string_view data)
+{
+    std::string frame;
+    frame.reserve(PROBE_FRAME_HEADER_SIZE + data.size());
+    AppendUint32(frame, PROBE_FRAME_MAGIC);
+    AppendUint32(frame, itemIndex);
+    AppendUint32(frame, (uint32_t)data.size());
+    frame.append(data);
+    return frame;
+}
+
+std::string MakeProbeReadyFrame()
+{
+    return MakeProbeFrame(PROBE_READY_ITEM_INDEX, {});
+}
+
+std::vector<ProbeSectionResult> RunProbeSections(
+    std::span<const uint32_t> sectionItemCounts, const ProbeWorkerLauncher& launch)
+{
+    std::vector<ProbeSectionResult> results(sectionItemCounts.size());
+    for(size_t i = 0; i < sectionItemCounts.size(); ++i)
+        results[i].m_Items.resize(sectionItemCounts[i]);
+    ParallelFor(results.size(), [&](size_t sectionIndex) {
+        RunProbeSection(sectionIndex, launch, results[sectionIndex]);
+    });
+    return results;
+}
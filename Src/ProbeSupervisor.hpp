@@ -0,0 +1,98 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Probing in worker processes with --Isolate. The report is split into sections, like data of an adapter, each made
+// of items probed in order, like a single format. A worker probes items of a section starting from a given one and
+// streams the result of each as soon as it is done. If it crashes, the item it was probing is given up and a new
+// worker continues after it. Depends only on ParallelInspection and the C++ standard library, so workers can be
+// stand-ins that crash on demand.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+Output of a worker is a sequence of frames: first the ready frame, with itemIndex = PROBE_READY_ITEM_INDEX and no
+data, written when the worker is set up, e.g. has created the device, then one frame per item, in order of items
+without gaps:
+
+    uint32_t magic = PROBE_FRAME_MAGIC
+    uint32_t itemIndex
+    uint32_t dataSize
+    uint8_t data[dataSize]
+
+Anything else makes the worker terminated and treated as crashed.
+*/
+static const uint32_t PROBE_FRAME_MAGIC = 0x50323144; // "D12P"
+static const uint32_t PROBE_FRAME_MAX_DATA_SIZE = 256 * 1024 * 1024;
+static const uint32_t PROBE_READY_ITEM_INDEX = UINT32_MAX;
+
+// A crash before the ready frame is blamed on the setup, not on an item, so the worker is started again for the same
+// item. After this many workers in a row crash like that, the item is given up and the remaining ones are skipped.
+static const uint32_t PROBE_MAX_CRASHES_IN_A_ROW = 3;
+
+// Frame with the result of an item, to be written by a worker.
+std::string MakeProbeFrame(uint32_t itemIndex, std::string_view data);
+// Frame telling that the worker is set up, to be written by a worker before frames of items.
+std::string MakeProbeReadyFrame();
+
+// Worker process started by RunProbeSections.
+class ProbeWorker
+{
+public:
+    virtual ~ProbeWorker() = default;
+    // Blocks until some of the output is available. Returns 0 when the worker closed it, e.g. exited.
+    virtual size_t Read(void* buffer, size_t size) = 0;
+    // Called when the output is not valid.
+    virtual void Terminate() = 0;
+    // Waits until the worker exits. Returns its exit code, e.g. code of the exception that crashed it.
+    virtual uint32_t Wait() = 0;
+};
+
+// Starts a worker probing items of the section starting from firstItem. Throws if it can't be started. Called from
+// multiple threads at once.
+using ProbeWorkerLauncher = std::function<std::unique_ptr<ProbeWorker>(size_t sectionIndex, uint32_t firstItem)>;
+
+enum PROBE_ITEM_STATUS
+{
+    // Not probed, as workers crashed PROBE_MAX_CRASHES_IN_A_ROW times in their setup before it.
+    PROBE_ITEM_STATUS_SKIPPED,
+    PROBE_ITEM_STATUS_DONE,
+    // The worker probing it crashed, or ended without its result. Also the item for which workers crashed
+    // PROBE_MAX_CRASHES_IN_A_ROW times in their setup.
+    PROBE_ITEM_STATUS_CRASHED,
+};
+
+struct ProbeItemResult
+{
+    PROBE_ITEM_STATUS m_Status = PROBE_ITEM_STATUS_SKIPPED;
+    // Data of the frame, for PROBE_ITEM_STATUS_DONE.
+    std::string m_Data;
+    // Of the worker, for PROBE_ITEM_STATUS_CRASHED.
+    uint32_t m_ExitCode = 0;
+};
+
+struct ProbeSectionResult
+{
+    std::vector<ProbeItemResult> m_Items;
+    // Including the restarted ones.
+    uint32_t m_WorkerCount = 0;
+};
+
+// Sections are probed in parallel, each by one worker at a time, with the number of items given for each. Returns
+// results of all items, which are missing only for items that crashed or were skipped. Rethrows the first exception
+// of the launcher.
+std::vector<ProbeSectionResult> RunProbeSections(
+    std::span<const uint32_t> sectionItemCounts, const ProbeWorkerLauncher& launch);
@@ -0,0 +1,258 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Replay.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportFormatter/SelectingReportFormatter.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Number of D3D12_DESCRIPTOR_HEAP_TYPE values.
+static const uint32_t DESCRIPTOR_HEAP_TYPE_COUNT = 4;
+
+// All fields are within the captured data.
+static bool IsStructInside(const StructDesc& structDesc, uint32_t dataSize)
+{
+    for(uint32_t i = 0; i < structDesc.m_FieldCount; ++i)
+    {
+        const FieldDesc& field = structDesc.m_Fields[i];
+        if(field.m_Offset > dataSize || dataSize - field.m_Offset < GetFieldKindSize(field.m_Kind))
+            return false;
+    }
+    return true;
+}
+
+// As a number if the enum is not in the capture.
+static void AddCapturedEnum(const CaptureStructCollection& structs, std::wstring_view name, uint32_t value,
+    std::wstring_view enumName, bool isFlags = false)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    const EnumItem* const enumItems = structs.FindEnum(enumName);
+    if(!enumItems)
+    {
+        if(isFlags)
+            formatter.AddFieldHex32(name, value);
+        else
+            formatter.AddFieldUint32(name, value);
+    }
+    else if(isFlags)
+        formatter.AddFieldFlags(name, value, enumItems);
+    else
+        formatter.AddFieldEnum(name, value, enumItems);
+}
+
+static void ReplayAdapter(const CaptureSection& section, ReplayDecoder& decoder, const ReplayOptions& options)
+{
+    ReportScopeArrayItemConditional scope(options.m_PrintAdaptersAsArray);
+    FieldSelectionScope selectionScope(options.m_FieldSelection);
+
+    if(options.m_PrintAdapterIndex)
+        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", section.m_AdapterIndex);
+
+    decoder.PrintAdapterData(section);
+    PrintCapturedReport(section, CAPTURE_REPORT_ADAPTER_VENDOR_DATA);
+
+    // Adapters captured with --List have no device data.
+    if(!section.Contains(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, 0))
+        return;
+
+    PrintCapturedReport(section, CAPTURE_REPORT_DEVICE_CREATION);
+    decoder.PrintDeviceFeatures(section);
+    PrintCapturedReport(section, CAPTURE_REPORT_DEVICE_FEATURES);
+    decoder.PrintDescriptorSizes(section);
+    PrintCapturedReport(section, CAPTURE_REPORT_DEVICE_DATA);
+    decoder.PrintFormats(section);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void PrintReportBanner(const ReportHeader& header)
+{
+    const wchar_t* const agilitySdkNote = header.m_PreviewAgilitySdk ? L" (preview Agility SDK)" : L"";
+    Printer::PrintString(L"============================\n");
+    Printer::PrintFormat(L"D3D12INFO {}{}\n", std::make_wformat_args(header.m_ProgramVersion, agilitySdkNote));
+    Printer::PrintFormat(L"BuildDate: {}\n", std::make_wformat_args(header.m_BuildDate));
+    Printer::PrintFormat(
+        L"Configuration: {}, {}\n", std::make_wformat_args(header.m_Configuration, header.m_ConfigurationBits));
+    Printer::PrintString(L"============================");
+}
+
+void PrintReportHeader(
+    const ReportHeader& header, std::wstring_view enumDictionaryHash, const std::function<void()>& printVendorParams)
+{
+    if(IsTextOutput())
+    {
+        PrintReportBanner(header);
+        Printer::PrintNewLine();
+        Printer::PrintNewLine();
+    }
+
+    ReportScopeObject scope(SelectString(L"General", L"Header"));
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+
+    if(IsJsonOutput())
+    {
+        formatter.AddFieldString(L"Program", L"D3d12info");
+        formatter.AddFieldString(L"Version", header.m_ProgramVersion);
+        formatter.AddFieldString(L"Build Date", header.m_BuildDate);
+        formatter.AddFieldString(L"Configuration", header.m_Configuration);
+        formatter.AddFieldString(L"Configuration bits", header.m_ConfigurationBits);
+    }
+    formatter.AddFieldString(L"Generated on", header.m_GeneratedOn);
+    if(!enumDictionaryHash.empty())
+        formatter.AddFieldString(L"EnumDictionary", enumDictionaryHash);
+    if(IsJsonOutput())
+        formatter.AddFieldBool(L"Using preview Agility SDK", header.m_PreviewAgilitySdk);
+    formatter.AddFieldUint32(
+        header.m_PreviewAgilitySdk ? L"D3D12_PREVIEW_SDK_VERSION" : L"D3D12_SDK_VERSION", header.m_D3D12SdkVersion);
+
+    if(printVendorParams)
+        printVendorParams();
+}
+
+void RawReplayDecoder::PrintDXGIFeatureInfo(const CaptureSection& global)
+{
+    ReportScopeObject scope(L"DXGI_FEATURE");
+    // DXGI_FEATURE_PRESENT_ALLOW_TEARING is the only one.
+    if(uint32_t allowTearing = 0; global.FindUint32(CAPTURE_TAG_DXGI_FEATURE, 0, allowTearing))
+        ReportFormatter::GetInstance().AddFieldBool(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", allowTearing != 0);
+}
+
+void RawReplayDecoder::PrintAdapterData(const CaptureSection& section)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    for(uint32_t descVersion = 4; descVersion--;)
+    {
+        CaptureAdapterDesc desc;
+        if(!section.FindAdapterDesc(descVersion, desc))
+            continue;
+        ReportScopeObject scope(
+            descVersion > 0 ? std::format(L"DXGI_ADAPTER_DESC{}", descVersion) : wstring(L"DXGI_ADAPTER_DESC"));
+        formatter.AddFieldString(L"Description", desc.m_Description);
+        formatter.AddFieldVendorId(L"VendorId", desc.m_VendorId);
+        formatter.AddFieldHex32(L"DeviceId", desc.m_DeviceId);
+        formatter.AddFieldSubsystemId(L"SubSysId", desc.m_SubSysId);
+        formatter.AddFieldHex32(L"Revision", desc.m_Revision);
+        formatter.AddFieldSize(L"DedicatedVideoMemory", desc.m_DedicatedVideoMemory);
+        formatter.AddFieldSize(L"DedicatedSystemMemory", desc.m_DedicatedSystemMemory);
+        formatter.AddFieldSize(L"SharedSystemMemory", desc.m_SharedSystemMemory);
+        formatter.AddFieldString(L"AdapterLuid",
+            std::format(L"{:08X}-{:08X}", (uint32_t)(desc.m_AdapterLuid >> 32), (uint32_t)desc.m_AdapterLuid));
+        if(descVersion >= 1)
+            AddCapturedEnum(m_Structs, L"Flags", desc.m_Flags, L"DXGI_ADAPTER_FLAG", true);
+        if(descVersion >= 2)
+        {
+            AddCapturedEnum(m_Structs, L"GraphicsPreemptionGranularity", desc.m_GraphicsPreemptionGranularity,
+                L"DXGI_GRAPHICS_PREEMPTION_GRANULARITY");
+            AddCapturedEnum(m_Structs, L"ComputePreemptionGranularity", desc.m_ComputePreemptionGranularity,
+                L"DXGI_COMPUTE_PREEMPTION_GRANULARITY");
+        }
+        break;
+    }
+
+    static const wchar_t* const MEMORY_SEGMENT_GROUP_NAMES[] = {
+        L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_LOCAL]",
+        L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL]",
+    };
+    for(uint32_t memorySegmentGroup = 0; memorySegmentGroup < 2; ++memorySegmentGroup)
+    {
+        if(CaptureVideoMemoryInfo videoMemoryInfo;
+            section.FindVideoMemoryInfo(memorySegmentGroup, videoMemoryInfo))
+        {
+            ReportScopeObject scope(MEMORY_SEGMENT_GROUP_NAMES[memorySegmentGroup]);
+            formatter.AddFieldSize(L"Budget", videoMemoryInfo.m_Budget);
+            formatter.AddFieldSize(L"AvailableForReservation", videoMemoryInfo.m_AvailableForReservation);
+        }
+    }
+
+    if(uint64_t umdVersion = 0; section.FindUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, umdVersion))
+    {
+        ReportScopeObject scope(L"CheckInterfaceSupport");
+        formatter.AddFieldMicrosoftVersion(L"UMDVersion", umdVersion);
+    }
+}
+
+void RawReplayDecoder::PrintDeviceFeatures(const CaptureSection& section)
+{
+    // Successful queries of described structures are printed like by D3d12info, failed ones are skipped like there.
+    std::vector<const CaptureRecord*> undecodedRecords;
+    for(const CaptureRecord& record : section.m_Records)
+    {
+        if(record.m_Tag != CAPTURE_TAG_CHECK_FEATURE_SUPPORT)
+            continue;
+        const StructDesc* const structDesc = m_Structs.FindStruct(record.m_Key);
+        if(!structDesc || !IsStructInside(*structDesc, record.m_OutputSize))
+            undecodedRecords.push_back(&record);
+        else if(record.m_Result >= 0)
+            PrintStruct(*structDesc, record.m_Output);
+    }
+    if(undecodedRecords.empty())
+        return;
+
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportScopeArray scope(L"CheckFeatureSupport");
+    for(const CaptureRecord* const undecodedRecord : undecodedRecords)
+    {
+        const CaptureRecord& record = *undecodedRecord;
+        ReportScopeArrayItem itemScope;
+        formatter.AddFieldUint32(L"Feature", record.m_Key);
+        formatter.AddFieldHex32(L"Result", (uint32_t)record.m_Result);
+        formatter.AddFieldHexBytes(L"Input", record.m_Input, record.m_InputSize);
+        formatter.AddFieldHexBytes(L"Output", record.m_Output, record.m_OutputSize);
+    }
+}
+
+void RawReplayDecoder::PrintDescriptorSizes(const CaptureSection& section)
+{
+    uint32_t sizes[DESCRIPTOR_HEAP_TYPE_COUNT] = {};
+    for(uint32_t i = 0; i < DESCRIPTOR_HEAP_TYPE_COUNT; ++i)
+        section.FindUint32(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, i, sizes[i]);
+    ReportFormatter::GetInstance().AddFieldUint32Array(L"GetDescriptorHandleIncrementSize", sizes, std::size(sizes));
+}
+
+void RawReplayDecoder::PrintFormats(const CaptureSection& section)
+{
+    // Queries of formats are printed with the other ones by PrintDeviceFeatures.
+}
+
+void ReplayCapture(const CaptureReader& reader, ReplayDecoder& decoder, const ReplayOptions& options)
+{
+    const CaptureSection& global = reader.GetGlobal();
+    ReportHeader header;
+    if(!global.FindReportHeader(header))
+        throw std::runtime_error("Capture file has no valid header of the report.");
+    PrintReportHeader(header, options.m_EnumDictionaryHash,
+        [&global]() { PrintCapturedReport(global, CAPTURE_REPORT_VENDOR_PARAMS); });
+
+    {
+        ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+        PrintCapturedReport(global, CAPTURE_REPORT_OS_INFO);
+        decoder.PrintDXGIFeatureInfo(global);
+        PrintCapturedReport(global, CAPTURE_REPORT_SYSTEM_DATA);
+    }
+
+    decoder.PrintEnums();
+
+    ReportScopeArrayConditional scopeArray(
+        options.m_PrintAdaptersAsArray, SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+    ReportScopeObjectConditional scopeObject(!options.m_PrintAdaptersAsArray, L"Adapter");
+    for(const CaptureSection& section : reader.GetAdapters())
+        ReplayAdapter(section, decoder, options);
+}
+
+void PrintCapturedReport(const CaptureSection& section, CAPTURE_REPORT report)
+{
+    RecordingReportFormatter recording;
+    if(section.FindReport(report, recording))
+        recording.Replay(ReportFormatter::GetInstance());
+}
@@ -0,0 +1,82 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Printing of the report from a capture. Depends only on the C++ standard library. Parts of the report made from
+// DXGI and D3D12 structures are printed by ReplayDecoder: D3d12info --Replay decodes them with the same functions as
+// live queries, and CaptureReplay, which builds on any platform, prints them with RawReplayDecoder, using descriptors
+// of the structures stored in the capture.
+
+#include "Capture.hpp"
+#include "FieldSelection.hpp"
+
+#include <functional>
+
+// Banner at the beginning of text output.
+void PrintReportBanner(const ReportHeader& header);
+// The banner in text output, then the General or Header scope. printVendorParams is called inside it.
+void PrintReportHeader(
+    const ReportHeader& header, std::wstring_view enumDictionaryHash, const std::function<void()>& printVendorParams);
+
+class ReplayDecoder
+{
+public:
+    virtual ~ReplayDecoder() = default;
+
+    // DXGI_FEATURE in System Info, from the global records.
+    virtual void PrintDXGIFeatureInfo(const CaptureSection& global) = 0;
+    // Printed before the adapters, like with --Enums.
+    virtual void PrintEnums() {}
+    // DXGI_ADAPTER_DESC, memory info and UMD version.
+    virtual void PrintAdapterData(const CaptureSection& section) = 0;
+    // The rest are called only for adapters captured with a device, so not with --List.
+    // Queries of ID3D12Device::CheckFeatureSupport other than formats.
+    virtual void PrintDeviceFeatures(const CaptureSection& section) = 0;
+    virtual void PrintDescriptorSizes(const CaptureSection& section) = 0;
+    virtual void PrintFormats(const CaptureSection& section) = 0;
+};
+
+// Prints DXGI structures member by member, and results of CheckFeatureSupport as structures named and laid out as in
+// the descriptors of the capture, like D3d12info prints them. As it has no declarations of the structures, results of
+// queries without a descriptor, like those of formats, are printed as bytes, and all enums as numbers in captures
+// written before the descriptors were added.
+class RawReplayDecoder : public ReplayDecoder
+{
+public:
+    RawReplayDecoder(const CaptureSection& global)
+        : m_Structs(global)
+    {
+    }
+
+    void PrintDXGIFeatureInfo(const CaptureSection& global) override;
+    void PrintAdapterData(const CaptureSection& section) override;
+    void PrintDeviceFeatures(const CaptureSection& section) override;
+    void PrintDescriptorSizes(const CaptureSection& section) override;
+    void PrintFormats(const CaptureSection& section) override;
+
+private:
+    const CaptureStructCollection m_Structs;
+};
+
+struct ReplayOptions
+{
+    // Adapters as an array named "Adapters", otherwise as a single object named "Adapter".
+    bool m_PrintAdaptersAsArray = true;
+    bool m_PrintAdapterIndex = false;
+    // Of the program that replays the capture, as it prints the enums.
+    wstring m_EnumDictionaryHash;
+    // Applied to each adapter, like --Select and --Exclude.
+    FieldSelection m_FieldSelection;
+};
+
+// Prints the whole report, with the header of the program that wrote the capture. Throws on error.
+void ReplayCapture(const CaptureReader& reader, ReplayDecoder& decoder, const ReplayOptions& options);
+// Part of the report recorded in the capture, if present.
+void PrintCapturedReport(const CaptureSection& section, CAPTURE_REPORT report);
@@ -0,0 +1,159 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportCache.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static_assert(sizeof(ReportCacheKey) == 40, "ReportCacheKey must have no padding.");
+
+static void WriteHeader(std::ostream& stream, std::span<const ReportCacheKey> keys)
+{
+    const size_t programVersionLength = wcslen(PROGRAM_VERSION);
+    const uint32_t header[] = { REPORT_CACHE_FILE_MAGIC, REPORT_CACHE_FILE_VERSION, (uint32_t)programVersionLength };
+    stream.write((const char*)header, sizeof(header));
+    stream.write((const char*)PROGRAM_VERSION, (std::streamsize)(programVersionLength * sizeof(wchar_t)));
+    const uint32_t keyCount = (uint32_t)keys.size();
+    stream.write((const char*)&keyCount, sizeof(keyCount));
+    stream.write((const char*)keys.data(), (std::streamsize)keys.size_bytes());
+}
+
+// Reads keys from the header written by WriteHeader, of any version of the program. Returns false if it is not valid.
+static bool ReadHeaderKeys(std::istream& stream, std::vector<ReportCacheKey>& outKeys)
+{
+    uint32_t header[3] = {};
+    if(!stream.read((char*)header, sizeof(header)) || header[0] != REPORT_CACHE_FILE_MAGIC ||
+        header[1] != REPORT_CACHE_FILE_VERSION)
+        return false;
+    stream.seekg((std::streamoff)(header[2] * sizeof(wchar_t)), std::ios::cur);
+    uint32_t keyCount = 0;
+    // Much more than adapters in any system, so a broken file doesn't allocate much.
+    if(!stream.read((char*)&keyCount, sizeof(keyCount)) || keyCount > 256)
+        return false;
+    outKeys.resize(keyCount);
+    return (bool)stream.read((char*)outKeys.data(), (std::streamsize)(keyCount * sizeof(ReportCacheKey)));
+}
+
+static bool IsSameHardware(const ReportCacheKey& lhs, const ReportCacheKey& rhs)
+{
+    return lhs.m_VendorId == rhs.m_VendorId && lhs.m_DeviceId == rhs.m_DeviceId && lhs.m_SubSysId == rhs.m_SubSysId;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool ReportCache::Load(std::span<const ReportCacheKey> keys, RecordingReportFormatter& outRecording) const
+{
+    std::ifstream file(GetEntryPath(keys), std::ios::binary);
+    if(!file.is_open())
+        return false;
+
+    // Header of this entry must be exactly the expected one.
+    std::ostringstream expectedStream;
+    WriteHeader(expectedStream, keys);
+    const string expectedHeader = expectedStream.str();
+    string header(expectedHeader.size(), '\0');
+    if(!file.read(header.data(), (std::streamsize)header.size()) || header != expectedHeader)
+        return false;
+
+    return outRecording.Load(file);
+}
+
+void ReportCache::Store(std::span<const ReportCacheKey> keys, const RecordingReportFormatter& recording) const
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_DirectoryPath, errorCode);
+
+    // Written under a unique name and then renamed, so no process can read a partially written entry.
+    const std::filesystem::path entryPath = GetEntryPath(keys);
+    std::filesystem::path tempPath = entryPath;
+    tempPath += std::format(L".{:08X}.tmp", std::random_device{}());
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error(std::format("Could not open cache file \"{}\".", tempPath.string()));
+        WriteHeader(file, keys);
+        recording.Save(file);
+        file.close();
+        if(!file)
+        {
+            std::filesystem::remove(tempPath, errorCode);
+            throw std::runtime_error(std::format("Could not write cache file \"{}\".", tempPath.string()));
+        }
+    }
+    std::filesystem::rename(tempPath, entryPath, errorCode);
+    if(errorCode)
+    {
+        std::filesystem::remove(tempPath, errorCode);
+        // Renaming fails when another process has the entry open, after storing the same one.
+        if(std::filesystem::exists(entryPath, errorCode))
+            return;
+        throw std::runtime_error(std::format("Could not write cache file \"{}\".", entryPath.string()));
+    }
+
+    DeleteEntriesOfAbsentAdapters(keys, entryPath);
+}
+
+std::filesystem::path ReportCache::GetEntryPath(std::span<const ReportCacheKey> keys) const
+{
+    uint64_t hash = CalculateHash(keys.data(), keys.size_bytes());
+    hash = CalculateHash(PROGRAM_VERSION, wcslen(PROGRAM_VERSION) * sizeof(wchar_t), hash);
+    return m_DirectoryPath / std::format(L"{}_Cache_{:016X}.bin", PROGRAM_NAME, hash);
+}
+
+bool ReportCache::IsAdapterPresent(uint64_t adapterLuid) const
+{
+    return std::find(m_PresentAdapterLuids.begin(), m_PresentAdapterLuids.end(), adapterLuid) !=
+        m_PresentAdapterLuids.end();
+}
+
+void ReportCache::DeleteEntriesOfAbsentAdapters(
+    std::span<const ReportCacheKey> keys, const std::filesystem::path& entryPath) const
+{
+    if(m_PresentAdapterLuids.empty())
+        return;
+
+    // Errors are ignored, as the entry is already stored, and another process may be deleting the same files.
+    const std::wstring prefix = std::format(L"{}_Cache_", PROGRAM_NAME);
+    std::error_code errorCode;
+    std::vector<ReportCacheKey> entryKeys;
+    for(const std::filesystem::directory_entry& dirEntry :
+        std::filesystem::directory_iterator(m_DirectoryPath, errorCode))
+    {
+        const std::filesystem::path& path = dirEntry.path();
+        if(path == entryPath || path.extension() != L".bin" || !path.filename().wstring().starts_with(prefix))
+            continue;
+        bool absent = false;
+        {
+            std::ifstream file(path, std::ios::binary);
+            if(!file.is_open() || !ReadHeaderKeys(file, entryKeys))
+                continue;
+            for(const ReportCacheKey& entryKey : entryKeys)
+            {
+                if(IsAdapterPresent(entryKey.m_AdapterLuid))
+                    continue;
+                for(const ReportCacheKey& key : keys)
+                    absent = absent || IsSameHardware(entryKey, key);
+            }
+        }
+        if(absent)
+            std::filesystem::remove(path, errorCode);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+// On-disk cache of static parts of the report, written and read with --Cache.
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+class RecordingReportFormatter;
+
+// Identity of an adapter, its driver and the options that change the report. A change in any of them, or in the
+// version of the program, makes a new cache entry. No padding, as it is hashed and compared as bytes.
+struct ReportCacheKey
+{
+    uint64_t m_AdapterLuid = 0;
+    uint32_t m_VendorId = 0;
+    uint32_t m_DeviceId = 0;
+    uint32_t m_SubSysId = 0;
+    uint32_t m_Revision = 0;
+    // UMD version from IDXGIAdapter::CheckInterfaceSupport.
+    uint64_t m_UmdVersion = 0;
+    uint32_t m_D3D12SdkVersion = 0;
+    // Bits of command line options, defined by the caller.
+    uint32_t m_Options = 0;
+};
+
+/*
+Each entry is a file named by hash of its keys, containing RecordingReportFormatter saved after a header:
+
+    uint32_t magic = REPORT_CACHE_FILE_MAGIC
+    uint32_t version = REPORT_CACHE_FILE_VERSION
+    uint32_t programVersionLength
+    wchar_t programVersion[programVersionLength]
+    uint32_t keyCount
+    ReportCacheKey keys[keyCount]
+
+The header is compared on load, so a hash collision gives a miss and not a wrong report.
+
+LUID of an adapter changes on every reboot, so entries of adapters no longer present are never loaded again. Store
+deletes them when it stores an entry for the same hardware, identified by VendorId, DeviceId and SubSysId.
+*/
+static const uint32_t REPORT_CACHE_FILE_MAGIC = 0x4B323144; // "D12K"
+static const uint32_t REPORT_CACHE_FILE_VERSION = 1;
+
+class ReportCache
+{
+public:
+    // The directory is created when the first entry is stored.
+    ReportCache(const std::filesystem::path& directoryPath)
+        : m_DirectoryPath(directoryPath)
+    {
+    }
+
+    // Adapter present in the system now. Entries with keys of other adapters of the same hardware are deleted on Store.
+    // Not thread-safe, call before Store. If none are added, no entries are deleted.
+    void AddPresentAdapter(uint64_t adapterLuid)
+    {
+        m_PresentAdapterLuids.push_back(adapterLuid);
+    }
+
+    // Returns false if there is no valid entry for these keys.
+    bool Load(std::span<const ReportCacheKey> keys, RecordingReportFormatter& outRecording) const;
+    // Replaces the entry. Safe when other processes store or load it at the same time. Throws on error.
+    void Store(std::span<const ReportCacheKey> keys, const RecordingReportFormatter& recording) const;
+
+private:
+    const std::filesystem::path m_DirectoryPath;
+    std::vector<uint64_t> m_PresentAdapterLuids;
+
+    std::filesystem::path GetEntryPath(std::span<const ReportCacheKey> keys) const;
+    bool IsAdapterPresent(uint64_t adapterLuid) const;
+    // Deletes other entries having a key of an adapter that is not present, with the same hardware as one of keys.
+    void DeleteEntriesOfAbsentAdapters(
+        std::span<const ReportCacheKey> keys, const std::filesystem::path& entryPath) const;
+};
@@ -0,0 +1,198 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "FlatReportFormatter.hpp"
+
+#include "EnumItems.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static std::wstring FormatEnum(uint32_t value, const EnumItem* enumItems)
+{
+    const wchar_t* enumItemName = enumItems != nullptr ? FindEnumItemName(value, enumItems) : nullptr;
+    if(enumItemName != nullptr)
+        return enumItemName;
+    return std::format(L"0x{:X}", value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+FlatReportFormatter::FlatReportFormatter() = default;
+
+FlatReportFormatter::~FlatReportFormatter()
+{
+    assert(m_Scopes.empty());
+}
+
+void FlatReportFormatter::PushObject(std::wstring_view name)
+{
+    PushScope(name, false);
+}
+
+void FlatReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    PushScope(name, true);
+}
+
+void FlatReportFormatter::PushArrayItem()
+{
+    assert(!m_Scopes.empty() && m_Scopes.back().m_IsArray);
+    const size_t index = m_Scopes.back().m_ItemCount++;
+    m_Scopes.push_back({ .m_ParentPathLength = m_Path.size() });
+    // Replaces the dot after the array name.
+    m_Path.pop_back();
+    m_Path += std::format(L"[{}].", index);
+}
+
+void FlatReportFormatter::PopScope()
+{
+    assert(!m_Scopes.empty());
+    m_Path.resize(m_Scopes.back().m_ParentPathLength);
+    m_Scopes.pop_back();
+}
+
+void FlatReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    AddField(name, std::wstring(value));
+}
+
+void FlatReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    for(size_t i = 0; i < value.size(); ++i)
+        AddField(std::format(L"{}[{}]", name, i), value[i]);
+}
+
+void FlatReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    AddField(name, value ? L"TRUE" : L"FALSE");
+}
+
+void FlatReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    AddFieldUint64(name, value, unit);
+}
+
+void FlatReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    AddField(name, unit.empty() ? std::format(L"{}", value) : std::format(L"{} {}", value, unit));
+}
+
+void FlatReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    AddField(name, std::format(L"{} B", value));
+}
+
+void FlatReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    AddFieldSize(name, value * 1024);
+}
+
+void FlatReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    AddField(name, std::format(L"0x{:X}", value));
+}
+
+void FlatReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    AddField(name, unit.empty() ? std::format(L"{}", value) : std::format(L"{} {}", value, unit));
+}
+
+void FlatReportFormatter::AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count)
+{
+    for(size_t i = 0; i < count; ++i)
+        AddField(std::format(L"{}[{}]", name, i), std::format(L"{}", values[i]));
+}
+
+void FlatReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    AddField(name, unit.empty() ? std::format(L"{}", value) : std::format(L"{} {}", value, unit));
+}
+
+void FlatReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    AddField(name, FormatEnum(value, enumItems));
+}
+
+void FlatReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    const wchar_t* enumItemName = enumItems != nullptr ? FindEnumItemName(value, enumItems) : nullptr;
+    AddField(name, enumItemName != nullptr ? std::wstring(enumItemName) : std::format(L"{}", value));
+}
+
+void FlatReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    for(size_t i = 0; i < count; ++i)
+        AddField(std::format(L"{}[{}]", name, i), FormatEnum(values[i], enumItems));
+}
+
+void FlatReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    // Whole value as one field, so a change shows both states. Names of individual flags would only make it longer.
+    AddField(name, std::format(L"0x{:X}", value));
+}
+
+void FlatReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    std::wstring valStr;
+    for(size_t i = 0; i < byteCount; ++i)
+        valStr += std::format(L"{:02X}", *((const uint8_t*)data + i));
+    AddField(name, std::move(valStr));
+}
+
+void FlatReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    AddFieldHex32(name, value);
+}
+
+void FlatReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    AddFieldHex32(name, value);
+}
+
+void FlatReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    AddField(name,
+        std::format(L"{}.{}.{}.{}", value >> 48, (value >> 32) & 0xFFFF, (value >> 16) & 0xFFFF, value & 0xFFFF));
+}
+
+void FlatReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    AddField(name, std::format(L"{}.{}.{}", value >> 22, (value >> 12) & 0b11'1111'1111, value & 0b1111'1111'1111));
+}
+
+void FlatReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    AddFieldHex32(name, implementationId);
+}
+
+void FlatReportFormatter::PushScope(std::wstring_view name, bool isArray)
+{
+    assert(!name.empty());
+    m_Scopes.push_back({ .m_ParentPathLength = m_Path.size(), .m_IsArray = isArray });
+    m_Path += name;
+    // Objects repeated under the same name, like "Format" in a loop, get the same suffix as repeated fields.
+    const uint32_t count = ++m_PathCounts[m_Path];
+    if(count > 1)
+        m_Path += std::format(L"#{}", count);
+    m_Path += L'.';
+}
+
+void FlatReportFormatter::AddField(std::wstring_view name, std::wstring value)
+{
+    assert(!name.empty());
+    std::wstring path = m_Path + std::wstring(name);
+    const uint32_t count = ++m_PathCounts[path];
+    if(count > 1)
+        path += std::format(L"#{}", count);
+    m_Fields.push_back({ .m_Path = std::move(path), .m_Value = std::move(value) });
+}
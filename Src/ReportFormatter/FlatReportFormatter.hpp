@@ -0,0 +1,75 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+#include "ReportFormatter.hpp"
+#include "AdapterWatcher.hpp"
+
+// Doesn't print anything, only collects fields as "Scope.Subscope[Index].Name" paths with their values as text, to be
+// compared by AdapterWatcher. Enums and flags are stored by name, so the values are readable in change records.
+class FlatReportFormatter final : public ReportFormatter
+{
+public:
+    FlatReportFormatter();
+    ~FlatReportFormatter();
+
+    std::vector<ReportField> TakeFields()
+    {
+        return std::move(m_Fields);
+    }
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    struct Scope
+    {
+        // Length of m_Path before this scope was entered.
+        size_t m_ParentPathLength = 0;
+        bool m_IsArray = false;
+        size_t m_ItemCount = 0;
+    };
+
+    std::vector<ReportField> m_Fields;
+    // Path of the current scope, with a trailing dot if not empty.
+    std::wstring m_Path;
+    std::vector<Scope> m_Scopes;
+    // How many times each path was added, to make repeated ones unique.
+    std::unordered_map<std::wstring, uint32_t> m_PathCounts;
+
+    void PushScope(std::wstring_view name, bool isArray);
+    void AddField(std::wstring_view name, std::wstring value);
+};
@@ -10,6 +10,7 @@ For more information, see files README.md, LICENSE.txt.
 #include "JSONReportFormatter.hpp"
 
 #include "Printer.hpp"
+#include "Stats.hpp"
 
 JSONReportFormatter::JSONReportFormatter(FLAGS flags)
     : m_PrettyPrint((flags & FLAGS::FLAG_JSON_PRETTY_PRINT) != FLAGS::FLAG_NONE)
@@ -27,6 +28,7 @@ JSONReportFormatter::~JSONReportFormatter()
 
 void JSONReportFormatter::PushObject(std::wstring_view name)
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_OBJECT, 1);
     assert(!name.empty());
 
     PushNewElement();
@@ -39,6 +41,7 @@ void JSONReportFormatter::PushObject(std::wstring_view name)
 
 void JSONReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix /* = ArraySuffix::SquareBrackets */)
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_ARRAY, 1);
     assert(!name.empty());
 
     PushNewElement();
@@ -51,6 +54,7 @@ void JSONReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix
 
 void JSONReportFormatter::PushArrayItem()
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_ARRAY_ITEM, 1);
     assert(!m_ScopeStack.empty());
     assert(m_ScopeStack.top().Type == ScopeType::Array);
 
@@ -63,6 +67,7 @@ void JSONReportFormatter::PushArrayItem()
 
 void JSONReportFormatter::PopScope()
 {
+    ADD_STAT(STAT_FORMATTER_POP_SCOPE, 1);
     assert(!m_ScopeStack.empty());
 
     ScopeInfo scope = m_ScopeStack.top();
@@ -79,6 +84,7 @@ void JSONReportFormatter::PopScope()
 
 void JSONReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
 {
+    ADD_STAT(STAT_FORMATTER_STRING, 1);
     assert(!name.empty());
     assert(!value.empty());
     PushNewElement();
@@ -91,6 +97,7 @@ void JSONReportFormatter::AddFieldString(std::wstring_view name, std::wstring_vi
 
 void JSONReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
 {
+    ADD_STAT(STAT_FORMATTER_STRING_ARRAY, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -114,6 +121,7 @@ void JSONReportFormatter::AddFieldStringArray(std::wstring_view name, const std:
 
 void JSONReportFormatter::AddFieldBool(std::wstring_view name, bool value)
 {
+    ADD_STAT(STAT_FORMATTER_BOOL, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -124,6 +132,7 @@ void JSONReportFormatter::AddFieldBool(std::wstring_view name, bool value)
 
 void JSONReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit /* = {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_UINT32, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -133,26 +142,31 @@ void JSONReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value,
 
 void JSONReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit /* = {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_UINT64, 1);
     AddFieldString(name, std::to_wstring(value));
 }
 
 void JSONReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SIZE, 1);
     AddFieldUint64(name, value);
 }
 
 void JSONReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SIZE_KILOBYTES, 1);
     AddFieldUint64(name, value);
 }
 
 void JSONReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_HEX32, 1);
     AddFieldUint32(name, value);
 }
 
 void JSONReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit /* = {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_INT32, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -160,8 +174,29 @@ void JSONReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, s
     Printer::PrintFormat(m_PrettyPrint ? L"\"{}\": {}" : L"\"{}\":{}", std::make_wformat_args(escapedName, value));
 }
 
+void JSONReportFormatter::AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count)
+{
+    ADD_STAT(STAT_FORMATTER_UINT32_ARRAY, 1);
+    assert(!name.empty());
+    PushNewElement();
+
+    std::wstring escapedName = EscapeString(name);
+    Printer::PrintFormat(m_PrettyPrint ? L"\"{}\": [" : L"\"{}\":[", std::make_wformat_args(escapedName));
+    const wchar_t* const separator = m_PrettyPrint ? L", " : L",";
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(i > 0)
+        {
+            Printer::PrintString(separator);
+        }
+        Printer::PrintFormat(L"{}", std::make_wformat_args(values[i]));
+    }
+    Printer::PrintString(L"]");
+}
+
 void JSONReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit /* = {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_FLOAT, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -171,17 +206,20 @@ void JSONReportFormatter::AddFieldFloat(std::wstring_view name, float value, std
 
 void JSONReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM, 1);
     AddFieldUint32(name, value);
 }
 
 void JSONReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM_SIGNED, 1);
     AddFieldInt32(name, value);
 }
 
 void JSONReportFormatter::AddEnumArray(
     std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM_ARRAY, 1);
     assert(!name.empty());
     PushNewElement();
 
@@ -204,11 +242,13 @@ void JSONReportFormatter::AddEnumArray(
 
 void JSONReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_FLAGS, 1);
     AddFieldUint32(name, value);
 }
 
 void JSONReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
 {
+    ADD_STAT(STAT_FORMATTER_HEX_BYTES, 1);
     std::wstring valStr;
     for(size_t i = 0; i < byteCount; ++i)
     {
@@ -219,27 +259,32 @@ void JSONReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* d
 
 void JSONReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_VENDOR_ID, 1);
     AddFieldUint32(name, value);
 }
 
 void JSONReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SUBSYSTEM_ID, 1);
     AddFieldUint32(name, value);
 }
 
 void JSONReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_MICROSOFT_VERSION, 1);
     AddFieldUint64(name, value);
 }
 
 void JSONReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_AMD_VERSION, 1);
     AddFieldUint64(name, value);
 }
 
 void JSONReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
     uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
 {
+    ADD_STAT(STAT_FORMATTER_NVIDIA_IMPLEMENTATION_ID, 1);
     AddFieldUint32(name, implementationId);
 }
 
@@ -306,5 +351,7 @@ std::wstring JSONReportFormatter::EscapeString(std::wstring_view str)
             escapedStr += ch;
         }
     }
+    // Each escape sequence is one character longer than the character it replaces.
+    ADD_STAT(STAT_ESCAPED_CHARS, escapedStr.size() - str.size());
     return escapedStr;
 }
@@ -0,0 +1,518 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "RecordingReportFormatter.hpp"
+
+#include "EnumItems.hpp"
+#include "Utils.hpp"
+
+#include <bit>
+#include <istream>
+#include <ostream>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+/*
+Format of Save, all values little-endian and strings UTF-16, so it can be read on another platform, e.g. in a capture:
+
+    uint32_t magic = RECORDING_MAGIC
+    uint32_t version = RECORDING_VERSION
+    uint32_t enumTableCount
+    Enum tables:
+        uint32_t itemCount
+        Items: string name, uint32_t value
+    uint32_t callCount
+    Calls:
+        uint32_t type, string name, string string, uint64_t value, uint64_t value2, uint32_t enumIndex
+        uint32_t stringCount, string strings[stringCount]
+        uint32_t valueCount, uint32_t values[valueCount]
+        uint32_t byteCount, uint8_t bytes[byteCount]
+
+string = uint32_t length, char16_t characters[length]
+*/
+static const uint32_t RECORDING_MAGIC = 0x52323144; // "D12R"
+static const uint32_t RECORDING_VERSION = 2;
+
+static void WriteUint32(std::ostream& stream, uint32_t value)
+{
+    const uint8_t bytes[] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    stream.write((const char*)bytes, sizeof(bytes));
+}
+
+static void WriteUint64(std::ostream& stream, uint64_t value)
+{
+    WriteUint32(stream, (uint32_t)value);
+    WriteUint32(stream, (uint32_t)(value >> 32));
+}
+
+static void WriteString(std::ostream& stream, std::wstring_view str)
+{
+    const std::u16string str16 = WstrToUtf16(str);
+    WriteUint32(stream, (uint32_t)str16.length());
+    for(char16_t ch : str16)
+    {
+        const uint8_t bytes[] = { (uint8_t)ch, (uint8_t)(ch >> 8) };
+        stream.write((const char*)bytes, sizeof(bytes));
+    }
+}
+
+static void WriteArray(std::ostream& stream, const std::vector<uint32_t>& arr)
+{
+    WriteUint32(stream, (uint32_t)arr.size());
+    for(uint32_t value : arr)
+        WriteUint32(stream, value);
+}
+
+static void WriteArray(std::ostream& stream, const std::vector<uint8_t>& arr)
+{
+    WriteUint32(stream, (uint32_t)arr.size());
+    stream.write((const char*)arr.data(), (std::streamsize)arr.size());
+}
+
+// Fails on arrays longer than the rest of the stream, so corrupted data can't make it allocate a lot of memory.
+class RecordingReader
+{
+public:
+    RecordingReader(std::istream& stream)
+        : m_Stream(stream)
+    {
+        const std::streampos begin = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        m_End = stream.tellg();
+        stream.seekg(begin);
+    }
+
+    bool Read(uint32_t& outValue)
+    {
+        uint8_t bytes[4];
+        if(!m_Stream.read((char*)bytes, sizeof(bytes)))
+            return false;
+        outValue = bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+        return true;
+    }
+    bool Read(uint64_t& outValue)
+    {
+        uint32_t low, high;
+        if(!Read(low) || !Read(high))
+            return false;
+        outValue = ((uint64_t)high << 32) | low;
+        return true;
+    }
+    bool ReadString(wstring& outStr)
+    {
+        uint32_t length;
+        if(!ReadArraySize(length, sizeof(char16_t)))
+            return false;
+        std::vector<uint8_t> bytes((size_t)length * sizeof(char16_t));
+        if(!m_Stream.read((char*)bytes.data(), (std::streamsize)bytes.size()))
+            return false;
+        std::u16string str16(length, u'\0');
+        for(size_t i = 0; i < length; ++i)
+            str16[i] = (char16_t)(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+        outStr = Utf16ToWstr(str16);
+        return true;
+    }
+    bool ReadArray(std::vector<uint32_t>& outArr)
+    {
+        uint32_t size;
+        if(!ReadArraySize(size, sizeof(uint32_t)))
+            return false;
+        outArr.resize(size);
+        for(uint32_t& value : outArr)
+        {
+            if(!Read(value))
+                return false;
+        }
+        return true;
+    }
+    bool ReadArray(std::vector<uint8_t>& outArr)
+    {
+        uint32_t size;
+        if(!ReadArraySize(size, 1))
+            return false;
+        outArr.resize(size);
+        return (bool)m_Stream.read((char*)outArr.data(), (std::streamsize)size);
+    }
+
+private:
+    std::istream& m_Stream;
+    std::streampos m_End;
+
+    bool ReadArraySize(uint32_t& outSize, size_t elementSize)
+    {
+        if(!Read(outSize))
+            return false;
+        const std::streampos pos = m_Stream.tellg();
+        return pos != std::streampos(-1) && (uint64_t)outSize * elementSize <= (uint64_t)(m_End - pos);
+    }
+};
+
+struct RecordingReportFormatter::LoadedEnum
+{
+    std::vector<wstring> m_Names;
+    // Terminated with null name, like static enum tables. Point to m_Names.
+    std::vector<EnumItem> m_Items;
+};
+
+RecordingReportFormatter::Call& RecordingReportFormatter::AddCall(CALL_TYPE type, std::wstring_view name)
+{
+    Call& call = m_Calls.emplace_back();
+    call.m_Type = type;
+    call.m_Name = name;
+    return call;
+}
+
+uint32_t RecordingReportFormatter::FindOrAddEnumTable(const EnumItem* enumItems)
+{
+    if(enumItems == nullptr)
+        return UINT32_MAX;
+    const auto it = std::find(m_EnumTables.begin(), m_EnumTables.end(), enumItems);
+    if(it != m_EnumTables.end())
+        return (uint32_t)(it - m_EnumTables.begin());
+    m_EnumTables.push_back(enumItems);
+    return (uint32_t)(m_EnumTables.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+RecordingReportFormatter::RecordingReportFormatter() = default;
+RecordingReportFormatter::~RecordingReportFormatter() = default;
+
+void RecordingReportFormatter::Replay(ReportFormatter& target) const
+{
+    for(const Call& call : m_Calls)
+    {
+        const EnumItem* const enumItems = call.m_EnumIndex != UINT32_MAX ? m_EnumTables[call.m_EnumIndex] : nullptr;
+        switch(call.m_Type)
+        {
+        case CALL_PUSH_OBJECT:
+            target.PushObject(call.m_Name);
+            break;
+        case CALL_PUSH_ARRAY:
+            target.PushArray(call.m_Name, (ARRAY_SUFFIX)call.m_Value);
+            break;
+        case CALL_PUSH_ARRAY_ITEM:
+            target.PushArrayItem();
+            break;
+        case CALL_POP_SCOPE:
+            target.PopScope();
+            break;
+        case CALL_STRING:
+            target.AddFieldString(call.m_Name, call.m_String);
+            break;
+        case CALL_STRING_ARRAY:
+            target.AddFieldStringArray(call.m_Name, call.m_Strings);
+            break;
+        case CALL_BOOL:
+            target.AddFieldBool(call.m_Name, call.m_Value != 0);
+            break;
+        case CALL_UINT32:
+            target.AddFieldUint32(call.m_Name, (uint32_t)call.m_Value, call.m_String);
+            break;
+        case CALL_UINT64:
+            target.AddFieldUint64(call.m_Name, call.m_Value, call.m_String);
+            break;
+        case CALL_SIZE:
+            target.AddFieldSize(call.m_Name, call.m_Value);
+            break;
+        case CALL_SIZE_KILOBYTES:
+            target.AddFieldSizeKilobytes(call.m_Name, call.m_Value);
+            break;
+        case CALL_HEX32:
+            target.AddFieldHex32(call.m_Name, (uint32_t)call.m_Value);
+            break;
+        case CALL_INT32:
+            target.AddFieldInt32(call.m_Name, (int32_t)(uint32_t)call.m_Value, call.m_String);
+            break;
+        case CALL_UINT32_ARRAY:
+            target.AddFieldUint32Array(call.m_Name, call.m_Values.data(), call.m_Values.size());
+            break;
+        case CALL_FLOAT:
+            target.AddFieldFloat(call.m_Name, std::bit_cast<float>((uint32_t)call.m_Value), call.m_String);
+            break;
+        case CALL_ENUM:
+            target.AddFieldEnum(call.m_Name, (uint32_t)call.m_Value, enumItems);
+            break;
+        case CALL_ENUM_SIGNED:
+            target.AddFieldEnumSigned(call.m_Name, (int32_t)(uint32_t)call.m_Value, enumItems);
+            break;
+        case CALL_ENUM_ARRAY:
+            target.AddEnumArray(call.m_Name, call.m_Values.data(), call.m_Values.size(), enumItems);
+            break;
+        case CALL_FLAGS:
+            target.AddFieldFlags(call.m_Name, (uint32_t)call.m_Value, enumItems);
+            break;
+        case CALL_HEX_BYTES:
+            target.AddFieldHexBytes(call.m_Name, call.m_Bytes.data(), call.m_Bytes.size());
+            break;
+        case CALL_VENDOR_ID:
+            target.AddFieldVendorId(call.m_Name, (uint32_t)call.m_Value);
+            break;
+        case CALL_SUBSYSTEM_ID:
+            target.AddFieldSubsystemId(call.m_Name, (uint32_t)call.m_Value);
+            break;
+        case CALL_MICROSOFT_VERSION:
+            target.AddFieldMicrosoftVersion(call.m_Name, call.m_Value);
+            break;
+        case CALL_AMD_VERSION:
+            target.AddFieldAMDVersion(call.m_Name, call.m_Value);
+            break;
+        case CALL_NVIDIA_IMPLEMENTATION_ID:
+            target.AddFieldNvidiaImplementationID(
+                call.m_Name, (uint32_t)call.m_Value, (uint32_t)call.m_Value2, enumItems);
+            break;
+        default:
+            assert(0);
+        }
+    }
+}
+
+void RecordingReportFormatter::Save(std::ostream& stream) const
+{
+    WriteUint32(stream, RECORDING_MAGIC);
+    WriteUint32(stream, RECORDING_VERSION);
+
+    WriteUint32(stream, (uint32_t)m_EnumTables.size());
+    for(const EnumItem* enumItems : m_EnumTables)
+    {
+        uint32_t itemCount = 0;
+        while(enumItems[itemCount].m_Name != nullptr)
+            ++itemCount;
+        WriteUint32(stream, itemCount);
+        for(uint32_t i = 0; i < itemCount; ++i)
+        {
+            WriteString(stream, enumItems[i].m_Name);
+            WriteUint32(stream, enumItems[i].m_Value);
+        }
+    }
+
+    WriteUint32(stream, (uint32_t)m_Calls.size());
+    for(const Call& call : m_Calls)
+    {
+        WriteUint32(stream, call.m_Type);
+        WriteString(stream, call.m_Name);
+        WriteString(stream, call.m_String);
+        WriteUint64(stream, call.m_Value);
+        WriteUint64(stream, call.m_Value2);
+        WriteUint32(stream, call.m_EnumIndex);
+        WriteUint32(stream, (uint32_t)call.m_Strings.size());
+        for(const wstring& str : call.m_Strings)
+            WriteString(stream, str);
+        WriteArray(stream, call.m_Values);
+        WriteArray(stream, call.m_Bytes);
+    }
+}
+
+bool RecordingReportFormatter::Load(std::istream& stream)
+{
+    m_Calls.clear();
+    m_EnumTables.clear();
+    m_LoadedEnums.clear();
+
+    // Counts are not used to reserve memory, as on corrupted data they are wrong until reading runs out of data.
+    RecordingReader reader(stream);
+    uint32_t magic = 0, version = 0, enumTableCount = 0;
+    if(!reader.Read(magic) || magic != RECORDING_MAGIC || !reader.Read(version) || version != RECORDING_VERSION ||
+        !reader.Read(enumTableCount))
+    {
+        return false;
+    }
+
+    bool valid = true;
+    for(uint32_t tableIndex = 0; valid && tableIndex < enumTableCount; ++tableIndex)
+    {
+        auto loadedEnum = std::make_unique<LoadedEnum>();
+        uint32_t itemCount = 0;
+        valid = reader.Read(itemCount);
+        for(uint32_t i = 0; valid && i < itemCount; ++i)
+        {
+            uint32_t value = 0;
+            valid = reader.ReadString(loadedEnum->m_Names.emplace_back()) && reader.Read(value);
+            loadedEnum->m_Items.push_back({ nullptr, value });
+        }
+        // Names are pointed to when m_Names no longer grows.
+        for(size_t i = 0; i < loadedEnum->m_Items.size(); ++i)
+            loadedEnum->m_Items[i].m_Name = loadedEnum->m_Names[i].c_str();
+        loadedEnum->m_Items.push_back({ nullptr, UINT32_MAX });
+        m_EnumTables.push_back(loadedEnum->m_Items.data());
+        m_LoadedEnums.push_back(std::move(loadedEnum));
+    }
+
+    uint32_t callCount = 0;
+    valid = valid && reader.Read(callCount);
+    for(uint32_t callIndex = 0; valid && callIndex < callCount; ++callIndex)
+    {
+        Call& call = m_Calls.emplace_back();
+        uint32_t type = 0, stringCount = 0;
+        valid = reader.Read(type) && type < CALL_COUNT && reader.ReadString(call.m_Name) &&
+            reader.ReadString(call.m_String) && reader.Read(call.m_Value) && reader.Read(call.m_Value2) &&
+            reader.Read(call.m_EnumIndex) && reader.Read(stringCount);
+        call.m_Type = (CALL_TYPE)type;
+        for(uint32_t i = 0; valid && i < stringCount; ++i)
+            valid = reader.ReadString(call.m_Strings.emplace_back());
+        valid = valid && reader.ReadArray(call.m_Values) && reader.ReadArray(call.m_Bytes);
+        valid = valid && (call.m_EnumIndex == UINT32_MAX || call.m_EnumIndex < m_EnumTables.size());
+    }
+
+    if(!valid)
+    {
+        m_Calls.clear();
+        m_EnumTables.clear();
+        m_LoadedEnums.clear();
+    }
+    return valid;
+}
+
+void RecordingReportFormatter::PushObject(std::wstring_view name)
+{
+    AddCall(CALL_PUSH_OBJECT, name);
+}
+
+void RecordingReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    AddCall(CALL_PUSH_ARRAY, name).m_Value = suffix;
+}
+
+void RecordingReportFormatter::PushArrayItem()
+{
+    AddCall(CALL_PUSH_ARRAY_ITEM, {});
+}
+
+void RecordingReportFormatter::PopScope()
+{
+    AddCall(CALL_POP_SCOPE, {});
+}
+
+void RecordingReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    AddCall(CALL_STRING, name).m_String = value;
+}
+
+void RecordingReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    AddCall(CALL_STRING_ARRAY, name).m_Strings = value;
+}
+
+void RecordingReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    AddCall(CALL_BOOL, name).m_Value = value ? 1 : 0;
+}
+
+void RecordingReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    Call& call = AddCall(CALL_UINT32, name);
+    call.m_Value = value;
+    call.m_String = unit;
+}
+
+void RecordingReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    Call& call = AddCall(CALL_UINT64, name);
+    call.m_Value = value;
+    call.m_String = unit;
+}
+
+void RecordingReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    AddCall(CALL_SIZE, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    AddCall(CALL_SIZE_KILOBYTES, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    AddCall(CALL_HEX32, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    Call& call = AddCall(CALL_INT32, name);
+    call.m_Value = (uint32_t)value;
+    call.m_String = unit;
+}
+
+void RecordingReportFormatter::AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count)
+{
+    AddCall(CALL_UINT32_ARRAY, name).m_Values.assign(values, values + count);
+}
+
+void RecordingReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    Call& call = AddCall(CALL_FLOAT, name);
+    call.m_Value = std::bit_cast<uint32_t>(value);
+    call.m_String = unit;
+}
+
+void RecordingReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    Call& call = AddCall(CALL_ENUM, name);
+    call.m_Value = value;
+    call.m_EnumIndex = FindOrAddEnumTable(enumItems);
+}
+
+void RecordingReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    Call& call = AddCall(CALL_ENUM_SIGNED, name);
+    call.m_Value = (uint32_t)value;
+    call.m_EnumIndex = FindOrAddEnumTable(enumItems);
+}
+
+void RecordingReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    Call& call = AddCall(CALL_ENUM_ARRAY, name);
+    call.m_Values.assign(values, values + count);
+    call.m_EnumIndex = FindOrAddEnumTable(enumItems);
+}
+
+void RecordingReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    Call& call = AddCall(CALL_FLAGS, name);
+    call.m_Value = value;
+    call.m_EnumIndex = FindOrAddEnumTable(enumItems);
+}
+
+void RecordingReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    AddCall(CALL_HEX_BYTES, name).m_Bytes.assign((const uint8_t*)data, (const uint8_t*)data + byteCount);
+}
+
+void RecordingReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    AddCall(CALL_VENDOR_ID, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    AddCall(CALL_SUBSYSTEM_ID, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    AddCall(CALL_MICROSOFT_VERSION, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    AddCall(CALL_AMD_VERSION, name).m_Value = value;
+}
+
+void RecordingReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    Call& call = AddCall(CALL_NVIDIA_IMPLEMENTATION_ID, name);
+    call.m_Value = architectureId;
+    call.m_Value2 = implementationId;
+    call.m_EnumIndex = FindOrAddEnumTable(architecturePlusImplementationIDEnum);
+}
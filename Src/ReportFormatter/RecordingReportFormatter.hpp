@@ -0,0 +1,119 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+#include "ReportFormatter.hpp"
+
+#include <iosfwd>
+
+// Doesn't print anything, only remembers calls to replay them later on another formatter. Lets a part of the report
+// be gathered on a separate thread and then printed in its place, with the same output as if printed directly.
+// Calls can also be saved to a binary stream and loaded back, e.g. by ReportCache.
+class RecordingReportFormatter final : public ReportFormatter
+{
+public:
+    RecordingReportFormatter();
+    ~RecordingReportFormatter();
+
+    void Replay(ReportFormatter& target) const;
+
+    // Enum tables are saved by content, as their addresses are different in another run.
+    void Save(std::ostream& stream) const;
+    // Replaces recorded calls. Returns false if the data is not valid or has a different version of the format.
+    bool Load(std::istream& stream);
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    enum CALL_TYPE : uint32_t
+    {
+        CALL_PUSH_OBJECT,
+        CALL_PUSH_ARRAY,
+        CALL_PUSH_ARRAY_ITEM,
+        CALL_POP_SCOPE,
+        CALL_STRING,
+        CALL_STRING_ARRAY,
+        CALL_BOOL,
+        CALL_UINT32,
+        CALL_UINT64,
+        CALL_SIZE,
+        CALL_SIZE_KILOBYTES,
+        CALL_HEX32,
+        CALL_INT32,
+        CALL_UINT32_ARRAY,
+        CALL_FLOAT,
+        CALL_ENUM,
+        CALL_ENUM_SIGNED,
+        CALL_ENUM_ARRAY,
+        CALL_FLAGS,
+        CALL_HEX_BYTES,
+        CALL_VENDOR_ID,
+        CALL_SUBSYSTEM_ID,
+        CALL_MICROSOFT_VERSION,
+        CALL_AMD_VERSION,
+        CALL_NVIDIA_IMPLEMENTATION_ID,
+        CALL_COUNT
+    };
+
+    // Strings are copied, as views passed to the formatter often point to temporaries.
+    struct Call
+    {
+        CALL_TYPE m_Type = CALL_COUNT;
+        wstring m_Name;
+        // Value of a string field or unit of a numeric one.
+        wstring m_String;
+        // Value of a scalar field: signed ones cast, float as bits, array suffix, NVIDIA architecture ID.
+        uint64_t m_Value = 0;
+        // NVIDIA implementation ID.
+        uint64_t m_Value2 = 0;
+        std::vector<wstring> m_Strings;
+        std::vector<uint32_t> m_Values;
+        std::vector<uint8_t> m_Bytes;
+        // Index into m_EnumTables, or UINT32_MAX.
+        uint32_t m_EnumIndex = UINT32_MAX;
+    };
+
+    struct LoadedEnum;
+
+    std::vector<Call> m_Calls;
+    // Distinct enum tables used by the calls. Static ones when recorded, items of m_LoadedEnums when loaded.
+    std::vector<const EnumItem*> m_EnumTables;
+    std::vector<std::unique_ptr<LoadedEnum>> m_LoadedEnums;
+
+    Call& AddCall(CALL_TYPE type, std::wstring_view name);
+    uint32_t FindOrAddEnumTable(const EnumItem* enumItems);
+};
@@ -12,40 +12,29 @@ For more information, see files README.md, LICENSE.txt.
 #include "JSONReportFormatter.hpp"
 #include "TextReportFormatter.hpp"
 
-static ReportFormatter* s_Instance = nullptr;
-static ReportFormatter::FLAGS s_Flags = ReportFormatter::FLAGS::FLAG_NONE;
+// Per thread, so multiple threads can each print a separate report.
+static thread_local ReportContext* s_CurrentContext = nullptr;
 
-void ReportFormatter::CreateInstance(FLAGS flags)
+std::unique_ptr<ReportFormatter> ReportFormatter::Create(FLAGS flags)
 {
-    assert(s_Instance == nullptr);
     if((flags & FLAGS::FLAG_JSON) != FLAGS::FLAG_NONE)
     {
-        s_Instance = new JSONReportFormatter(flags);
+        return std::make_unique<JSONReportFormatter>(flags);
     }
     else
     {
-        s_Instance = new TextReportFormatter(flags);
+        return std::make_unique<TextReportFormatter>(flags);
     }
-    s_Flags = flags;
-}
-
-void ReportFormatter::DestroyInstance()
-{
-    assert(s_Instance != nullptr);
-    delete s_Instance;
-    s_Instance = nullptr;
 }
 
 ReportFormatter& ReportFormatter::GetInstance()
 {
-    assert(s_Instance != nullptr);
-    return *s_Instance;
+    return ReportContext::GetCurrent().GetFormatter();
 }
 
 ReportFormatter::FLAGS ReportFormatter::GetFlags()
 {
-    assert(s_Instance != nullptr);
-    return s_Flags;
+    return ReportContext::GetCurrent().GetFlags();
 }
 
 ReportFormatter::FLAGS& operator|=(ReportFormatter::FLAGS& lhs, ReportFormatter::FLAGS rhs)
@@ -54,13 +43,50 @@ ReportFormatter::FLAGS& operator|=(ReportFormatter::FLAGS& lhs, ReportFormatter:
     return lhs;
 }
 
+ReportContext::ReportContext(ReportFormatter::FLAGS flags)
+    : m_OwnedFormatter(ReportFormatter::Create(flags))
+    , m_Formatter(m_OwnedFormatter.get())
+    , m_Flags(flags)
+{
+}
+
+ReportContext::ReportContext(ReportFormatter& formatter, ReportFormatter::FLAGS flags)
+    : m_Formatter(&formatter)
+    , m_Flags(flags)
+{
+}
+
+ReportContext& ReportContext::GetCurrent()
+{
+    assert(s_CurrentContext != nullptr);
+    return *s_CurrentContext;
+}
+
+ReportContextScope::ReportContextScope(ReportContext& context)
+    : m_Previous(s_CurrentContext)
+{
+    s_CurrentContext = &context;
+}
+
+ReportContextScope::~ReportContextScope()
+{
+    s_CurrentContext = m_Previous;
+}
+
 ReportScopeObjectConditional::ReportScopeObjectConditional(std::wstring_view name)
-    : m_Name(name)
+    : ReportScopeObjectConditional(ReportFormatter::GetInstance(), false, name)
 {
 }
 
 ReportScopeObjectConditional::ReportScopeObjectConditional(bool enable, std::wstring_view name)
-    : ReportScopeObjectConditional(name)
+    : ReportScopeObjectConditional(ReportFormatter::GetInstance(), enable, name)
+{
+}
+
+ReportScopeObjectConditional::ReportScopeObjectConditional(
+    ReportFormatter& formatter, bool enable, std::wstring_view name)
+    : m_Formatter(formatter)
+    , m_Name(name)
 {
     if(enable)
     {
@@ -72,7 +98,7 @@ ReportScopeObjectConditional::~ReportScopeObjectConditional()
 {
     if(m_Enabled)
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
 }
 
@@ -80,21 +106,28 @@ void ReportScopeObjectConditional::Enable()
 {
     if(!m_Enabled)
     {
-        ReportFormatter::GetInstance().PushObject(m_Name);
+        m_Formatter.PushObject(m_Name);
         m_Enabled = true;
     }
 }
 
 ReportScopeArrayConditional::ReportScopeArrayConditional(
     std::wstring_view name, ReportFormatter::ARRAY_SUFFIX suffix /*= ReportFormatter::SquareBrackets*/)
-    : m_Name(name)
-    , m_Suffix(suffix)
+    : ReportScopeArrayConditional(ReportFormatter::GetInstance(), false, name, suffix)
 {
 }
 
 ReportScopeArrayConditional::ReportScopeArrayConditional(
     bool enable, std::wstring_view name, ReportFormatter::ARRAY_SUFFIX suffix /*= ReportFormatter::SquareBrackets*/)
-    : ReportScopeArrayConditional(name, suffix)
+    : ReportScopeArrayConditional(ReportFormatter::GetInstance(), enable, name, suffix)
+{
+}
+
+ReportScopeArrayConditional::ReportScopeArrayConditional(ReportFormatter& formatter, bool enable,
+    std::wstring_view name, ReportFormatter::ARRAY_SUFFIX suffix /*= ReportFormatter::SquareBrackets*/)
+    : m_Formatter(formatter)
+    , m_Name(name)
+    , m_Suffix(suffix)
 {
     if(enable)
     {
@@ -106,7 +139,7 @@ ReportScopeArrayConditional::~ReportScopeArrayConditional()
 {
     if(m_Enabled)
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
 }
 
@@ -114,16 +147,23 @@ void ReportScopeArrayConditional::Enable()
 {
     if(!m_Enabled)
     {
-        ReportFormatter::GetInstance().PushArray(m_Name, m_Suffix);
+        m_Formatter.PushArray(m_Name, m_Suffix);
         m_Enabled = true;
     }
 }
 
 ReportScopeArrayItemConditional::ReportScopeArrayItemConditional()
+    : ReportScopeArrayItemConditional(ReportFormatter::GetInstance(), false)
 {
 }
 
 ReportScopeArrayItemConditional::ReportScopeArrayItemConditional(bool enable)
+    : ReportScopeArrayItemConditional(ReportFormatter::GetInstance(), enable)
+{
+}
+
+ReportScopeArrayItemConditional::ReportScopeArrayItemConditional(ReportFormatter& formatter, bool enable)
+    : m_Formatter(formatter)
 {
     if(enable)
     {
@@ -135,7 +175,7 @@ ReportScopeArrayItemConditional::~ReportScopeArrayItemConditional()
 {
     if(m_Enabled)
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
 }
 
@@ -143,14 +183,14 @@ void ReportScopeArrayItemConditional::Enable()
 {
     if(!m_Enabled)
     {
-        ReportFormatter::GetInstance().PushArrayItem();
+        m_Formatter.PushArrayItem();
         m_Enabled = true;
     }
 }
 
 bool IsTextOutput()
 {
-    return (ReportFormatter::GetFlags() & ReportFormatter::FLAGS::FLAG_JSON) == ReportFormatter::FLAGS::FLAG_NONE;
+    return !ReportContext::GetCurrent().IsJsonOutput();
 }
 
 bool IsJsonOutput()
@@ -181,3 +221,8 @@ std::string_view SelectString(std::string_view textString, std::string_view json
         return textString;
     }
 }
+
+bool IsReportScopeNeeded(std::wstring_view path)
+{
+    return ReportFormatter::GetInstance().IsScopeNeeded(path);
+}
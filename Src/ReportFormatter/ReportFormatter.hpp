@@ -10,6 +10,10 @@ For more information, see files README.md, LICENSE.txt.
 
 #pragma once
 
+#include "Timings.hpp"
+
+#include <memory>
+
 struct EnumItem;
 
 class ReportFormatter
@@ -19,7 +23,9 @@ public:
     {
         FLAG_NONE = 0,
         FLAG_JSON = 1 << 0,
-        FLAG_JSON_PRETTY_PRINT = 1 << 1
+        FLAG_JSON_PRETTY_PRINT = 1 << 1,
+        // Print enums and flags as numeric values only, without names of their items.
+        FLAG_NUMERIC_ENUMS = 1 << 2
     };
 
     enum ARRAY_SUFFIX
@@ -28,13 +34,21 @@ public:
         ARRAY_SUFFIX_NONE
     };
 
-    static void CreateInstance(FLAGS flags);
-    static void DestroyInstance();
+    // Creates JSONReportFormatter or TextReportFormatter, depending on flags.
+    static std::unique_ptr<ReportFormatter> Create(FLAGS flags);
+    // Formatter and flags of the current ReportContext of this thread.
     static ReportFormatter& GetInstance();
     static FLAGS GetFlags();
 
     virtual ~ReportFormatter() = default;
 
+    // False if nothing inside the scope at this path, relative to the current scope, would be printed, so the data
+    // for it doesn't need to be gathered. Only SelectingReportFormatter drops anything.
+    virtual bool IsScopeNeeded(std::wstring_view path) const
+    {
+        return true;
+    }
+
     virtual void PushObject(std::wstring_view name) = 0;
     virtual void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) = 0;
     virtual void PushArrayItem() = 0;
@@ -53,6 +67,8 @@ public:
     virtual void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) = 0;
     virtual void AddFieldHex32(std::wstring_view name, uint32_t value) = 0;
     virtual void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) = 0;
+    // For long columns of numbers, so in JSON it is printed on a single line.
+    virtual void AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count) = 0;
     // Floats
     virtual void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) = 0;
     // Enums
@@ -74,32 +90,96 @@ public:
 
 ReportFormatter::FLAGS& operator|=(ReportFormatter::FLAGS& lhs, ReportFormatter::FLAGS rhs);
 
-class ReportFormatterScope
+// Report being printed: its formatter and flags. Each thread has its own current context, so multiple reports can be
+// printed at the same time on separate threads, and scope helpers, IsJsonOutput, SelectString of one don't see the
+// others.
+class ReportContext
 {
 public:
-    ReportFormatterScope(ReportFormatter::FLAGS flags)
+    // Creates a formatter printing through Printer of the current thread.
+    ReportContext(ReportFormatter::FLAGS flags);
+    // Uses a formatter owned by the caller, e.g. RecordingReportFormatter.
+    ReportContext(ReportFormatter& formatter, ReportFormatter::FLAGS flags);
+    ReportContext(const ReportContext&) = delete;
+    ReportContext& operator=(const ReportContext&) = delete;
+
+    // Asserts that the current thread has one.
+    static ReportContext& GetCurrent();
+
+    ReportFormatter& GetFormatter() const
     {
-        ReportFormatter::CreateInstance(flags);
+        return *m_Formatter;
     }
+    ReportFormatter::FLAGS GetFlags() const
+    {
+        return m_Flags;
+    }
+    bool IsJsonOutput() const
+    {
+        return (m_Flags & ReportFormatter::FLAG_JSON) != ReportFormatter::FLAG_NONE;
+    }
+
+private:
+    std::unique_ptr<ReportFormatter> m_OwnedFormatter;
+    ReportFormatter* const m_Formatter;
+    const ReportFormatter::FLAGS m_Flags;
+};
 
-    ~ReportFormatterScope()
+// Makes the context current for this thread. At the end of the scope, the previous one is current again.
+class ReportContextScope
+{
+public:
+    ReportContextScope(ReportContext& context);
+    ~ReportContextScope();
+    ReportContextScope(const ReportContextScope&) = delete;
+    ReportContextScope& operator=(const ReportContextScope&) = delete;
+
+private:
+    ReportContext* const m_Previous;
+};
+
+// Creates a context with a new formatter and makes it current.
+class ReportFormatterScope
+{
+public:
+    ReportFormatterScope(ReportFormatter::FLAGS flags)
+        : m_Context(flags)
+        , m_ContextScope(m_Context)
     {
-        ReportFormatter::DestroyInstance();
     }
+
+private:
+    ReportContext m_Context;
+    ReportContextScope m_ContextScope;
 };
 
+// Scope helpers print to the formatter of the current context, or the one passed explicitly. They end the scope on
+// the same formatter, even if the current context changes in between.
+
 class ReportScopeObject
 {
 public:
     ReportScopeObject(std::wstring_view name)
+        : ReportScopeObject(ReportFormatter::GetInstance(), name)
     {
-        ReportFormatter::GetInstance().PushObject(name);
+    }
+
+    ReportScopeObject(ReportFormatter& formatter, std::wstring_view name)
+        : m_Formatter(formatter)
+        , m_TraceScope(name, "Scope")
+    {
+        m_Formatter.PushObject(name);
     }
 
     ~ReportScopeObject()
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
+
+private:
+    ReportFormatter& m_Formatter;
+    // With --Trace, shows what part of the report is being gathered.
+    TraceScope m_TraceScope;
 };
 
 class ReportScopeArray
@@ -107,28 +187,47 @@ class ReportScopeArray
 public:
     ReportScopeArray(
         std::wstring_view name, ReportFormatter::ARRAY_SUFFIX suffix = ReportFormatter::ARRAY_SUFFIX_SQUARE_BRACKETS)
+        : ReportScopeArray(ReportFormatter::GetInstance(), name, suffix)
     {
-        ReportFormatter::GetInstance().PushArray(name, suffix);
+    }
+
+    ReportScopeArray(ReportFormatter& formatter, std::wstring_view name,
+        ReportFormatter::ARRAY_SUFFIX suffix = ReportFormatter::ARRAY_SUFFIX_SQUARE_BRACKETS)
+        : m_Formatter(formatter)
+    {
+        m_Formatter.PushArray(name, suffix);
     }
 
     ~ReportScopeArray()
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
+
+private:
+    ReportFormatter& m_Formatter;
 };
 
 class ReportScopeArrayItem
 {
 public:
     ReportScopeArrayItem()
+        : ReportScopeArrayItem(ReportFormatter::GetInstance())
     {
-        ReportFormatter::GetInstance().PushArrayItem();
+    }
+
+    ReportScopeArrayItem(ReportFormatter& formatter)
+        : m_Formatter(formatter)
+    {
+        m_Formatter.PushArrayItem();
     }
 
     ~ReportScopeArrayItem()
     {
-        ReportFormatter::GetInstance().PopScope();
+        m_Formatter.PopScope();
     }
+
+private:
+    ReportFormatter& m_Formatter;
 };
 
 class ReportScopeObjectConditional
@@ -136,10 +235,12 @@ class ReportScopeObjectConditional
 public:
     ReportScopeObjectConditional(std::wstring_view name);
     ReportScopeObjectConditional(bool enable, std::wstring_view name);
+    ReportScopeObjectConditional(ReportFormatter& formatter, bool enable, std::wstring_view name);
     ~ReportScopeObjectConditional();
     void Enable();
 
 private:
+    ReportFormatter& m_Formatter;
     std::wstring m_Name;
     bool m_Enabled = false;
 };
@@ -151,10 +252,13 @@ public:
         std::wstring_view name, ReportFormatter::ARRAY_SUFFIX suffix = ReportFormatter::ARRAY_SUFFIX_SQUARE_BRACKETS);
     ReportScopeArrayConditional(bool enable, std::wstring_view name,
         ReportFormatter::ARRAY_SUFFIX suffix = ReportFormatter::ARRAY_SUFFIX_SQUARE_BRACKETS);
+    ReportScopeArrayConditional(ReportFormatter& formatter, bool enable, std::wstring_view name,
+        ReportFormatter::ARRAY_SUFFIX suffix = ReportFormatter::ARRAY_SUFFIX_SQUARE_BRACKETS);
     ~ReportScopeArrayConditional();
     void Enable();
 
 private:
+    ReportFormatter& m_Formatter;
     std::wstring m_Name;
     ReportFormatter::ARRAY_SUFFIX m_Suffix;
     bool m_Enabled = false;
@@ -165,10 +269,12 @@ class ReportScopeArrayItemConditional
 public:
     ReportScopeArrayItemConditional();
     ReportScopeArrayItemConditional(bool enable);
+    ReportScopeArrayItemConditional(ReportFormatter& formatter, bool enable);
     ~ReportScopeArrayItemConditional();
     void Enable();
 
 private:
+    ReportFormatter& m_Formatter;
     bool m_Enabled = false;
 };
 
@@ -176,3 +282,5 @@ bool IsTextOutput();
 bool IsJsonOutput();
 std::wstring_view SelectString(std::wstring_view textString, std::wstring_view jsonString);
 std::string_view SelectString(std::string_view textString, std::string_view jsonString);
+// Asks the formatter of the current context, see ReportFormatter::IsScopeNeeded.
+bool IsReportScopeNeeded(std::wstring_view path);
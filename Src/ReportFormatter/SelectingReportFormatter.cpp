@@ -0,0 +1,233 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "SelectingReportFormatter.hpp"
+
+SelectingReportFormatter::SelectingReportFormatter(ReportFormatter& target, const FieldSelection& selection)
+    : m_Target(target)
+    , m_Selection(selection)
+{
+}
+
+SelectingReportFormatter::~SelectingReportFormatter()
+{
+    assert(m_Scopes.empty());
+}
+
+bool SelectingReportFormatter::IsScopeNeeded(std::wstring_view path) const
+{
+    return m_Selection.IsScopeNeeded(m_Path + std::wstring(path));
+}
+
+void SelectingReportFormatter::PushObject(std::wstring_view name)
+{
+    PushScope({ .m_Type = SCOPE_TYPE_OBJECT, .m_Name = std::wstring(name) });
+}
+
+void SelectingReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    PushScope({ .m_Type = SCOPE_TYPE_ARRAY, .m_Name = std::wstring(name), .m_Suffix = suffix });
+}
+
+void SelectingReportFormatter::PushArrayItem()
+{
+    PushScope({ .m_Type = SCOPE_TYPE_ARRAY_ITEM });
+}
+
+void SelectingReportFormatter::PopScope()
+{
+    assert(!m_Scopes.empty());
+    if(m_Scopes.back().m_Passed)
+        m_Target.PopScope();
+    m_Path.resize(m_Scopes.back().m_ParentPathLength);
+    m_Scopes.pop_back();
+}
+
+void SelectingReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldString(name, value);
+}
+
+void SelectingReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldStringArray(name, value);
+}
+
+void SelectingReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldBool(name, value);
+}
+
+void SelectingReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    if(SelectField(name))
+        m_Target.AddFieldUint32(name, value, unit);
+}
+
+void SelectingReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    if(SelectField(name))
+        m_Target.AddFieldUint64(name, value, unit);
+}
+
+void SelectingReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldSize(name, value);
+}
+
+void SelectingReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldSizeKilobytes(name, value);
+}
+
+void SelectingReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldHex32(name, value);
+}
+
+void SelectingReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    if(SelectField(name))
+        m_Target.AddFieldInt32(name, value, unit);
+}
+
+void SelectingReportFormatter::AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count)
+{
+    if(SelectField(name))
+        m_Target.AddFieldUint32Array(name, values, count);
+}
+
+void SelectingReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    if(SelectField(name))
+        m_Target.AddFieldFloat(name, value, unit);
+}
+
+void SelectingReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    if(SelectField(name))
+        m_Target.AddFieldEnum(name, value, enumItems);
+}
+
+void SelectingReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    if(SelectField(name))
+        m_Target.AddFieldEnumSigned(name, value, enumItems);
+}
+
+void SelectingReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    if(SelectField(name))
+        m_Target.AddEnumArray(name, values, count, enumItems);
+}
+
+void SelectingReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    if(SelectField(name))
+        m_Target.AddFieldFlags(name, value, enumItems);
+}
+
+void SelectingReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    if(SelectField(name))
+        m_Target.AddFieldHexBytes(name, data, byteCount);
+}
+
+void SelectingReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldVendorId(name, value);
+}
+
+void SelectingReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldSubsystemId(name, value);
+}
+
+void SelectingReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldMicrosoftVersion(name, value);
+}
+
+void SelectingReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    if(SelectField(name))
+        m_Target.AddFieldAMDVersion(name, value);
+}
+
+void SelectingReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    if(SelectField(name))
+    {
+        m_Target.AddFieldNvidiaImplementationID(
+            name, architectureId, implementationId, architecturePlusImplementationIDEnum);
+    }
+}
+
+void SelectingReportFormatter::PushScope(Scope&& scope)
+{
+    scope.m_ParentPathLength = m_Path.size();
+    if(scope.m_Type == SCOPE_TYPE_ARRAY_ITEM)
+    {
+        assert(!m_Scopes.empty() && m_Scopes.back().m_Type == SCOPE_TYPE_ARRAY);
+        // Replaces the dot after the array name.
+        m_Path.pop_back();
+        m_Path += std::format(L"[{}].", m_Scopes.back().m_ItemCount++);
+    }
+    else
+    {
+        m_Path += scope.m_Name;
+        m_Path += L'.';
+    }
+    m_Scopes.push_back(std::move(scope));
+
+    // A scope selected as a whole is printed even if empty.
+    if(m_Selection.IsSelected(std::wstring_view(m_Path).substr(0, m_Path.size() - 1)))
+        PassScopes();
+}
+
+void SelectingReportFormatter::PassScopes()
+{
+    for(Scope& scope : m_Scopes)
+    {
+        if(scope.m_Passed)
+            continue;
+        switch(scope.m_Type)
+        {
+        case SCOPE_TYPE_OBJECT:
+            m_Target.PushObject(scope.m_Name);
+            break;
+        case SCOPE_TYPE_ARRAY:
+            m_Target.PushArray(scope.m_Name, scope.m_Suffix);
+            break;
+        case SCOPE_TYPE_ARRAY_ITEM:
+            m_Target.PushArrayItem();
+            break;
+        }
+        scope.m_Passed = true;
+    }
+}
+
+bool SelectingReportFormatter::SelectField(std::wstring_view name)
+{
+    if(!m_Selection.IsSelected(m_Path + std::wstring(name)))
+        return false;
+    PassScopes();
+    return true;
+}
@@ -0,0 +1,106 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "ReportFormatter.hpp"
+#include "FieldSelection.hpp"
+
+#include <optional>
+
+// Passes to another formatter only fields chosen by FieldSelection, with scopes containing them. A scope is passed
+// when its first field is, so scopes left empty are not printed, unless selected as a whole. Paths start at the scope
+// current when this formatter is created.
+class SelectingReportFormatter final : public ReportFormatter
+{
+public:
+    SelectingReportFormatter(ReportFormatter& target, const FieldSelection& selection);
+    ~SelectingReportFormatter();
+
+    bool IsScopeNeeded(std::wstring_view path) const final;
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    enum SCOPE_TYPE
+    {
+        SCOPE_TYPE_OBJECT,
+        SCOPE_TYPE_ARRAY,
+        SCOPE_TYPE_ARRAY_ITEM,
+    };
+
+    struct Scope
+    {
+        SCOPE_TYPE m_Type = SCOPE_TYPE_OBJECT;
+        std::wstring m_Name;
+        ARRAY_SUFFIX m_Suffix = ARRAY_SUFFIX_SQUARE_BRACKETS;
+        // Length of m_Path before this scope was entered.
+        size_t m_ParentPathLength = 0;
+        size_t m_ItemCount = 0;
+        // Already pushed to m_Target.
+        bool m_Passed = false;
+    };
+
+    ReportFormatter& m_Target;
+    const FieldSelection& m_Selection;
+    // Path of the current scope, with a trailing dot if not empty.
+    std::wstring m_Path;
+    std::vector<Scope> m_Scopes;
+
+    void PushScope(Scope&& scope);
+    void PassScopes();
+    // If the field is selected, passes scopes containing it and returns true.
+    bool SelectField(std::wstring_view name);
+};
+
+// With --Select or --Exclude, what is printed inside goes through SelectingReportFormatter, with paths starting at
+// the current scope. Without them, the selection is empty and nothing changes.
+class FieldSelectionScope
+{
+public:
+    FieldSelectionScope(const FieldSelection& selection)
+    {
+        if(selection.IsEmpty())
+            return;
+        m_Formatter.emplace(ReportFormatter::GetInstance(), selection);
+        m_Context.emplace(*m_Formatter, ReportFormatter::GetFlags());
+        m_ContextScope.emplace(*m_Context);
+    }
+
+private:
+    std::optional<SelectingReportFormatter> m_Formatter;
+    std::optional<ReportContext> m_Context;
+    std::optional<ReportContextScope> m_ContextScope;
+};
@@ -9,10 +9,12 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "TextReportFormatter.hpp"
 
-#include "Enums.hpp"
+#include "EnumItems.hpp"
 #include "Printer.hpp"
+#include "Stats.hpp"
 
 TextReportFormatter::TextReportFormatter(FLAGS flags)
+    : m_NumericEnums((flags & FLAGS::FLAG_NUMERIC_ENUMS) != FLAGS::FLAG_NONE)
 {
 }
 
@@ -24,6 +26,7 @@ TextReportFormatter::~TextReportFormatter()
 
 void TextReportFormatter::PushObject(std::wstring_view name)
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_OBJECT, 1);
     assert(!name.empty());
 
     // Need to skip new line when outputting first object
@@ -50,6 +53,7 @@ void TextReportFormatter::PushObject(std::wstring_view name)
 
 void TextReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix /* = ArraySuffix::SquareBrackets */)
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_ARRAY, 1);
     assert(!name.empty());
 
     m_ScopeStack.push({ .ArrayName = std::wstring(name), .Type = ScopeType::Array, .Suffix = suffix });
@@ -57,6 +61,7 @@ void TextReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix
 
 void TextReportFormatter::PushArrayItem()
 {
+    ADD_STAT(STAT_FORMATTER_PUSH_ARRAY_ITEM, 1);
     assert(!m_ScopeStack.empty());
 
     ScopeInfo& arrayScope = m_ScopeStack.top();
@@ -91,6 +96,7 @@ void TextReportFormatter::PushArrayItem()
 
 void TextReportFormatter::PopScope()
 {
+    ADD_STAT(STAT_FORMATTER_POP_SCOPE, 1);
     assert(!m_ScopeStack.empty());
     ScopeInfo scope = m_ScopeStack.top();
     m_ScopeStack.pop();
@@ -102,6 +108,7 @@ void TextReportFormatter::PopScope()
 
 void TextReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
 {
+    ADD_STAT(STAT_FORMATTER_STRING, 1);
     assert(!name.empty());
     assert(!value.empty());
     PushElement();
@@ -110,6 +117,7 @@ void TextReportFormatter::AddFieldString(std::wstring_view name, std::wstring_vi
 
 void TextReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
 {
+    ADD_STAT(STAT_FORMATTER_STRING_ARRAY, 1);
     assert(!name.empty());
 
     Printer::PrintNewLine();
@@ -130,6 +138,7 @@ void TextReportFormatter::AddFieldStringArray(std::wstring_view name, const std:
 
 void TextReportFormatter::AddFieldBool(std::wstring_view name, bool value)
 {
+    ADD_STAT(STAT_FORMATTER_BOOL, 1);
     assert(!name.empty());
     PushElement();
     const wchar_t* boolStr = value ? L"TRUE" : L"FALSE";
@@ -138,6 +147,7 @@ void TextReportFormatter::AddFieldBool(std::wstring_view name, bool value)
 
 void TextReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit /*= {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_UINT32, 1);
     assert(!name.empty());
     PushElement();
     Printer::PrintFormat(L"{} = {}", std::make_wformat_args(name, value));
@@ -145,6 +155,7 @@ void TextReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value,
 
 void TextReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit /*= {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_UINT64, 1);
     assert(!name.empty());
     PushElement();
     if(unit.empty())
@@ -159,14 +170,15 @@ void TextReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value,
 
 void TextReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SIZE, 1);
     assert(!name.empty());
     PushElement();
 
     const wchar_t* units[] = { L"B", L"KiB", L"MiB", L"GiB", L"TiB" };
 
-    int selectedUnit = 0;
+    size_t selectedUnit = 0;
     uint64_t scale = 1;
-    for(; selectedUnit < ARRAYSIZE(units) - 1; ++selectedUnit)
+    for(; selectedUnit < std::size(units) - 1; ++selectedUnit)
     {
         if(value / scale < 1024)
         {
@@ -190,11 +202,13 @@ void TextReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
 
 void TextReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SIZE_KILOBYTES, 1);
     AddFieldSize(name, value * 1024);
 }
 
 void TextReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_HEX32, 1);
     assert(!name.empty());
     PushElement();
     Printer::PrintFormat(L"{} = 0x{:X}", std::make_wformat_args(name, value));
@@ -202,6 +216,7 @@ void TextReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
 
 void TextReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit /*= {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_INT32, 1);
     assert(!name.empty());
     PushElement();
     if(unit.empty())
@@ -214,8 +229,30 @@ void TextReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, s
     }
 }
 
+void TextReportFormatter::AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count)
+{
+    ADD_STAT(STAT_FORMATTER_UINT32_ARRAY, 1);
+    assert(!name.empty());
+
+    Printer::PrintNewLine();
+    PushElement();
+    Printer::PrintString(name);
+    Printer::PrintString(L":");
+    PrintDivider(name.size() + 1);
+
+    ++m_IndentLevel;
+    for(size_t i = 0; i < count; ++i)
+    {
+        Printer::PrintNewLine();
+        PrintIndent();
+        Printer::PrintFormat(L"[{}] = {}", std::make_wformat_args(i, values[i]));
+    }
+    --m_IndentLevel;
+}
+
 void TextReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit /*= {}*/)
 {
+    ADD_STAT(STAT_FORMATTER_FLOAT, 1);
     assert(!name.empty());
     PushElement();
     if(unit.empty())
@@ -230,6 +267,7 @@ void TextReportFormatter::AddFieldFloat(std::wstring_view name, float value, std
 
 void TextReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM, 1);
     assert(!name.empty());
     PushElement();
     const wchar_t* enumItemName = FindEnumItemName(value, enumItems);
@@ -245,6 +283,7 @@ void TextReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, c
 
 void TextReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM_SIGNED, 1);
     assert(!name.empty());
     PushElement();
     const wchar_t* enumItemName = FindEnumItemName(value, enumItems);
@@ -261,6 +300,7 @@ void TextReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t val
 void TextReportFormatter::AddEnumArray(
     std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_ENUM_ARRAY, 1);
     assert(!name.empty());
 
     Printer::PrintNewLine();
@@ -289,10 +329,16 @@ void TextReportFormatter::AddEnumArray(
 
 void TextReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
 {
+    ADD_STAT(STAT_FORMATTER_FLAGS, 1);
     assert(!name.empty());
     PushElement();
     Printer::PrintFormat(L"{} = 0x{:X}", std::make_wformat_args(name, value));
 
+    if(m_NumericEnums)
+    {
+        return;
+    }
+
     ++m_IndentLevel;
     size_t zeroFlagIndex = SIZE_MAX;
     for(size_t i = 0; enumItems[i].m_Name != nullptr; ++i)
@@ -322,6 +368,7 @@ void TextReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value,
 
 void TextReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
 {
+    ADD_STAT(STAT_FORMATTER_HEX_BYTES, 1);
     std::wstring valStr;
     for(size_t i = 0; i < byteCount; ++i)
     {
@@ -332,6 +379,7 @@ void TextReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* d
 
 void TextReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_VENDOR_ID, 1);
     assert(!name.empty());
 
     if(value < 0xFFFF)
@@ -384,6 +432,7 @@ void TextReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t valu
 
 void TextReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
 {
+    ADD_STAT(STAT_FORMATTER_SUBSYSTEM_ID, 1);
     assert(!name.empty());
     PushElement();
 
@@ -400,6 +449,7 @@ void TextReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t v
 
 void TextReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_MICROSOFT_VERSION, 1);
     assert(!name.empty());
     PushElement();
     uint64_t major = value >> 48;
@@ -411,6 +461,7 @@ void TextReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint6
 
 void TextReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
 {
+    ADD_STAT(STAT_FORMATTER_AMD_VERSION, 1);
     assert(!name.empty());
     PushElement();
     uint64_t major = value >> 22;
@@ -422,12 +473,19 @@ void TextReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t va
 void TextReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
     uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
 {
+    ADD_STAT(STAT_FORMATTER_NVIDIA_IMPLEMENTATION_ID, 1);
     // Prints only implementationId as the numerical value, but searches enum
     // using architectureId + implementationId.
 
     assert(!name.empty());
     PushElement();
 
+    if(m_NumericEnums)
+    {
+        Printer::PrintFormat(L"{} = 0x{:X}", std::make_wformat_args(name, implementationId));
+        return;
+    }
+
     const wchar_t* enumItemName =
         FindEnumItemName(architectureId + implementationId, architecturePlusImplementationIDEnum);
     if(enumItemName == nullptr)
@@ -438,6 +496,15 @@ void TextReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name,
     Printer::PrintFormat(L"{} = {} (0x{:X})", std::make_wformat_args(name, enumItemName, implementationId));
 }
 
+const wchar_t* TextReportFormatter::FindEnumItemName(uint32_t value, const EnumItem* enumItems) const
+{
+    if(m_NumericEnums)
+    {
+        return nullptr;
+    }
+    return ::FindEnumItemName(value, enumItems);
+}
+
 void TextReportFormatter::PrintIndent() const
 {
     int effectiveIndentLevel = std::max(m_IndentLevel - 1, 0);
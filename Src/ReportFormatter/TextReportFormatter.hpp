@@ -32,6 +32,7 @@ public:
     void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
     void AddFieldHex32(std::wstring_view name, uint32_t value) final;
     void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint32Array(std::wstring_view name, const uint32_t* values, size_t count) final;
     void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
     void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
     void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
@@ -64,7 +65,10 @@ private:
     std::stack<ScopeInfo> m_ScopeStack;
     int m_IndentLevel = 0;
     bool m_SkipNewLine = true;
+    bool m_NumericEnums = false;
 
+    // Returns null if names of enum items shouldn't be printed.
+    const wchar_t* FindEnumItemName(uint32_t value, const EnumItem* enumItems) const;
     void PrintIndent() const;
     void PushElement();
     void PrintDivider(size_t size);
@@ -0,0 +1,837 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+/*
+Command-line tool that generates many synthetic reports in the format of D3d12info,
+for load testing of services that ingest the reports. It doesn't touch any GPU.
+
+Each adapter is based on one of GPU_PROFILES. Values are made up but consistent:
+tiers and optional features grow with the level of the GPU, and with --LevelSpread=0
+the same GPU always gets the same capabilities. Data is printed by the same functions
+and ReportFormatter backends as in D3d12info, so the reports cover the same fields.
+That is also why the tool needs declarations of D3D12, while everything else in it
+uses only the C++ standard library.
+
+Report number N depends only on Seed + N, including its date, so the output doesn't
+depend on the number of threads nor on the day it is generated.
+*/
+
+#include "D3D12Data.hpp"
+#include "Enums.hpp"
+#include "ParallelInspection.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "StructDesc.hpp"
+#include "Utils.hpp"
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <thread>
+
+// Reports are generated in parallel in chunks of this size.
+static const size_t REPORT_CHUNK_SIZE = 64;
+// When printing to standard output, this many chunks are generated before they are printed in order.
+static const size_t CHUNKS_PER_BATCH = 256;
+// "Generated on" of reports is spread over this many days until LAST_REPORT_DATE.
+static const uint32_t REPORT_DATE_RANGE_DAYS = 365;
+static constexpr std::chrono::year_month_day LAST_REPORT_DATE{
+    std::chrono::year(2025), std::chrono::December, std::chrono::day(31) };
+
+struct VendorDesc
+{
+    // Name used in --Vendors.
+    const wchar_t* m_Name;
+    uint32_t m_VendorId;
+    // Newest UMD version, as returned by IDXGIAdapter::CheckInterfaceSupport.
+    uint16_t m_LatestDriverVersion[4];
+    // Difference of the last part of the version between consecutive driver releases.
+    uint16_t m_DriverReleaseStep;
+    uint32_t m_DefaultWeight;
+    std::array<uint32_t, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> m_DescriptorSizes;
+};
+
+static const VendorDesc VENDORS[] = {
+    { L"NVIDIA", VENDOR_ID_NVIDIA, { 32, 0, 15, 6636 }, 20, 60, { 32, 32, 32, 8 } },
+    { L"AMD", VENDOR_ID_AMD, { 32, 0, 13031, 3015 }, 10, 22, { 32, 16, 32, 8 } },
+    { L"Intel", VENDOR_ID_INTEL, { 32, 0, 101, 6559 }, 20, 16, { 64, 32, 64, 64 } },
+    { L"Microsoft", 0x1414, { 10, 0, 26100, 3624 }, 100, 2, { 32, 16, 32, 8 } },
+};
+
+struct GpuProfile
+{
+    const wchar_t* m_Description;
+    uint32_t m_VendorId;
+    uint32_t m_DeviceId;
+    uint32_t m_DedicatedVideoMemoryMB;
+    bool m_Integrated;
+    bool m_Software;
+    // 0..1, how new the GPU is. Tiers and optional features grow with it.
+    float m_Level;
+    D3D_FEATURE_LEVEL m_MaxFeatureLevel;
+    D3D_SHADER_MODEL m_MaxShaderModel;
+    uint32_t m_WaveLaneCountMin;
+    uint32_t m_WaveLaneCountMax;
+    uint32_t m_TotalLaneCount;
+    // Relative popularity among GPUs of the same vendor.
+    uint32_t m_Weight;
+};
+
+// clang-format off
+static const GpuProfile GPU_PROFILES[] = {
+    { L"NVIDIA GeForce RTX 4090",        VENDOR_ID_NVIDIA, 0x2684, 24564, false, false, 1.00f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 32, 16384, 4 },
+    { L"NVIDIA GeForce RTX 4060",        VENDOR_ID_NVIDIA, 0x2882,  7949, false, false, 0.95f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 32,  3072, 14 },
+    { L"NVIDIA GeForce RTX 3060",        VENDOR_ID_NVIDIA, 0x2503, 12120, false, false, 0.85f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 32,  3584, 16 },
+    { L"NVIDIA GeForce GTX 1660 SUPER",  VENDOR_ID_NVIDIA, 0x21C4,  5991, false, false, 0.60f, D3D_FEATURE_LEVEL_12_1, D3D_SHADER_MODEL_6_7, 32, 32,  1408, 8 },
+    { L"NVIDIA GeForce GTX 1060 6GB",    VENDOR_ID_NVIDIA, 0x1C03,  6052, false, false, 0.50f, D3D_FEATURE_LEVEL_12_1, D3D_SHADER_MODEL_6_7, 32, 32,  1280, 6 },
+    { L"AMD Radeon RX 7900 XTX",         VENDOR_ID_AMD,    0x744C, 24560, false, false, 1.00f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 64,  6144, 3 },
+    { L"AMD Radeon RX 6700 XT",          VENDOR_ID_AMD,    0x73DF, 12272, false, false, 0.90f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 64,  2560, 6 },
+    { L"AMD Radeon RX 580 2048SP",       VENDOR_ID_AMD,    0x6FDF,  8148, false, false, 0.45f, D3D_FEATURE_LEVEL_12_0, D3D_SHADER_MODEL_6_7, 64, 64,  2048, 4 },
+    { L"AMD Radeon(TM) Graphics",        VENDOR_ID_AMD,    0x164E,   512, true,  false, 0.80f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8, 32, 64,   128, 5 },
+    { L"Intel(R) Arc(TM) A770 Graphics", VENDOR_ID_INTEL,  0x56A0, 16032, false, false, 0.90f, D3D_FEATURE_LEVEL_12_2, D3D_SHADER_MODEL_6_8,  8, 16,  4096, 2 },
+    { L"Intel(R) Iris(R) Xe Graphics",   VENDOR_ID_INTEL,  0x9A49,   128, true,  false, 0.60f, D3D_FEATURE_LEVEL_12_1, D3D_SHADER_MODEL_6_7,  8, 16,   768, 8 },
+    { L"Intel(R) UHD Graphics 770",      VENDOR_ID_INTEL,  0x4680,   128, true,  false, 0.55f, D3D_FEATURE_LEVEL_12_1, D3D_SHADER_MODEL_6_7,  8, 16,   256, 6 },
+    { L"Microsoft Basic Render Driver",  0x1414,           0x008C,     0, false, true,  0.70f, D3D_FEATURE_LEVEL_12_1, D3D_SHADER_MODEL_6_8,  4,  4,     4, 1 },
+};
+// clang-format on
+
+// Values of UINT32 members that are not in GpuProfile, chosen by the level: below 0.5, below 0.9, from 0.9.
+struct Uint32FieldValues
+{
+    const wchar_t* m_Name;
+    uint32_t m_Values[3];
+};
+
+static const Uint32FieldValues UINT32_FIELD_VALUES[] = {
+    { L"MaxGPUVirtualAddressBitsPerResource", { 40, 40, 44 } },
+    { L"MaxGPUVirtualAddressBitsPerProcess", { 40, 44, 47 } },
+    { L"ShadingRateImageTileSize", { 0, 16, 16 } },
+    { L"SupportedSampleCountsWithNoOutputs", { 0x1, 0x1F, 0x1F } },
+    { L"MaxSamplerDescriptorHeapSize", { 2048, 2048, 4096 } },
+    { L"MaxSamplerDescriptorHeapSizeWithStaticSamplers", { 2048, 4096, 4096 } },
+    { L"MaxViewDescriptorHeapSize", { 1000000, 1000000, 1000000 } },
+    { L"ComputeQueuesPer3DQueue", { 1, 1, 2 } },
+};
+
+static const DXGI_FORMAT PLANAR_FORMATS[] = { DXGI_FORMAT_R32G8X24_TYPELESS, DXGI_FORMAT_D32_FLOAT_S8X24_UINT,
+    DXGI_FORMAT_R24G8_TYPELESS, DXGI_FORMAT_D24_UNORM_S8_UINT, DXGI_FORMAT_NV12, DXGI_FORMAT_P010,
+    DXGI_FORMAT_P016, DXGI_FORMAT_420_OPAQUE, DXGI_FORMAT_NV11 };
+
+struct GeneratorConfig
+{
+    uint64_t m_ReportCount = 1;
+    uint64_t m_Seed = 0;
+    ReportFormatter::FLAGS m_FormatterFlags = ReportFormatter::FLAG_NONE;
+    // Empty means standard output.
+    std::filesystem::path m_OutputDirectory;
+    std::array<uint32_t, std::size(VENDORS)> m_VendorWeights = {};
+    // Mean number of driver releases the installed driver is behind the newest one.
+    double m_DriverAgeMean = 3.0;
+    // Chance that a discrete GPU is accompanied by an integrated one.
+    uint32_t m_SecondAdapterPercent = 20;
+    // Maximum random change of the level of each adapter, in percent, like differences between drivers and boards.
+    uint32_t m_LevelSpreadPercent = 0;
+    bool m_PrintFormats = false;
+    bool m_PrintFormatsMatrix = false;
+    // Time each CheckFeatureSupport call takes, like on a slow driver.
+    std::chrono::microseconds m_CallLatency = {};
+    bool m_SerialQueries = false;
+};
+
+struct SyntheticAdapter
+{
+    const GpuProfile* m_Profile;
+    const VendorDesc* m_Vendor;
+    // m_Level of the profile with the spread applied, 0..1.
+    float m_Level;
+    uint64_t m_UmdVersion;
+    uint32_t m_SubSysId;
+    uint32_t m_Revision;
+    uint32_t m_LuidLowPart;
+    uint64_t m_SystemMemory;
+};
+
+// Like wcsncpy_s with _TRUNCATE: always null-terminated.
+template <size_t N>
+static void CopyTruncated(wchar_t (&dst)[N], const wchar_t* src)
+{
+    const size_t length = std::min(wcslen(src), N - 1);
+    std::copy(src, src + length, dst);
+    dst[length] = L'\0';
+}
+
+static wstring ToLower(std::wstring_view str)
+{
+    wstring result(str);
+    for(wchar_t& ch : result)
+        ch = (wchar_t)std::towlower(ch);
+    return result;
+}
+
+// Date of the report, derived from its seed like all other values.
+static wstring MakeReportDate(uint64_t seed)
+{
+    const uint64_t hash = CalculateHash(&seed, sizeof(seed));
+    const std::chrono::year_month_day date{ std::chrono::sys_days(LAST_REPORT_DATE) -
+        std::chrono::days(hash % REPORT_DATE_RANGE_DAYS) };
+    return std::format(L"{:04}-{:02}-{:02}", (int)date.year(), (unsigned)date.month(), (unsigned)date.day());
+}
+
+static const VendorDesc& FindVendor(uint32_t vendorId)
+{
+    for(const VendorDesc& vendor : VENDORS)
+    {
+        if(vendor.m_VendorId == vendorId)
+            return vendor;
+    }
+    assert(0);
+    return VENDORS[0];
+}
+
+static size_t GetEnumItemCount(const EnumItem* enumItems)
+{
+    size_t count = 0;
+    while(enumItems[count].m_Name != nullptr)
+        ++count;
+    return count;
+}
+
+// Answers CheckFeatureSupport with values made up for the GPU profile of the adapter.
+class SyntheticFeatureSupportSource : public FeatureSupportSource
+{
+public:
+    SyntheticFeatureSupportSource(
+        const SyntheticAdapter& adapter, std::chrono::microseconds callLatency, bool queryInParallel)
+        : m_Adapter(adapter)
+        , m_CallLatency(callLatency)
+        , m_QueryInParallel(queryInParallel)
+    {
+    }
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override;
+    bool ShouldQueryInParallel() const override { return m_QueryInParallel; }
+
+private:
+    const SyntheticAdapter& m_Adapter;
+    const std::chrono::microseconds m_CallLatency;
+    const bool m_QueryInParallel;
+
+    // Level the GPU needs to support the capability identified by key, 0..1. Later features need higher level.
+    float GetRequiredLevel(uint32_t feature, uint64_t key) const;
+    bool IsSupported(uint32_t feature, uint64_t key) const
+    {
+        return m_Adapter.m_Level >= GetRequiredLevel(feature, key);
+    }
+    uint32_t MakeFlags(uint32_t feature, uint64_t key, const EnumItem* enumItems) const;
+    void GetFormatSupport(DXGI_FORMAT format, D3D12_FEATURE_DATA_FORMAT_SUPPORT& outFormatSupport) const;
+    bool FillField(const StructDesc& structDesc, uint32_t fieldIndex, void* data) const;
+};
+
+float SyntheticFeatureSupportSource::GetRequiredLevel(uint32_t feature, uint64_t key) const
+{
+    const uint64_t hash = CalculateHash(&key, sizeof(key), CalculateHash(&feature, sizeof(feature)));
+    const float random = float(hash >> 40) / float(1 << 24);
+    // Support of formats depends only on the format and the capability.
+    if(feature == D3D12_FEATURE_FORMAT_SUPPORT)
+        return random * 0.9f;
+    const float featureAge = std::min(float(feature) / 64.f, 1.f);
+    return featureAge * 0.6f + random * 0.4f;
+}
+
+uint32_t SyntheticFeatureSupportSource::MakeFlags(uint32_t feature, uint64_t key, const EnumItem* enumItems) const
+{
+    uint32_t flags = 0;
+    for(size_t i = 0; enumItems[i].m_Name != nullptr; ++i)
+    {
+        if(IsSupported(feature, key * 64 + i))
+            flags |= enumItems[i].m_Value;
+    }
+    return flags;
+}
+
+void SyntheticFeatureSupportSource::GetFormatSupport(
+    DXGI_FORMAT format, D3D12_FEATURE_DATA_FORMAT_SUPPORT& outFormatSupport) const
+{
+    outFormatSupport.Format = format;
+    if(format == DXGI_FORMAT_UNKNOWN)
+    {
+        outFormatSupport.Support1 = D3D12_FORMAT_SUPPORT1_NONE;
+        outFormatSupport.Support2 = D3D12_FORMAT_SUPPORT2_NONE;
+        return;
+    }
+    outFormatSupport.Support1 =
+        (D3D12_FORMAT_SUPPORT1)MakeFlags(D3D12_FEATURE_FORMAT_SUPPORT, format * 2, Enum_D3D12_FORMAT_SUPPORT1);
+    outFormatSupport.Support2 =
+        (D3D12_FORMAT_SUPPORT2)MakeFlags(D3D12_FEATURE_FORMAT_SUPPORT, format * 2 + 1, Enum_D3D12_FORMAT_SUPPORT2);
+}
+
+bool SyntheticFeatureSupportSource::FillField(const StructDesc& structDesc, uint32_t fieldIndex, void* data) const
+{
+    const FieldDesc& field = structDesc.m_Fields[fieldIndex];
+    const GpuProfile& profile = *m_Adapter.m_Profile;
+    const uint32_t feature = structDesc.m_Id;
+    const uint32_t fieldId = GetFieldId(structDesc, fieldIndex);
+    void* const member = (char*)data + field.m_Offset;
+    switch(field.m_Kind)
+    {
+    case FIELD_KIND_BOOL:
+    {
+        BOOL value = IsSupported(feature, fieldId);
+        if(wcscmp(field.m_Name, L"UMA") == 0 || wcscmp(field.m_Name, L"CacheCoherentUMA") == 0)
+            value = profile.m_Integrated || profile.m_Software;
+        else if(wcscmp(field.m_Name, L"TileBasedRenderer") == 0)
+            value = FALSE;
+        else if(wcscmp(field.m_Name, L"IsolatedMMU") == 0)
+            value = !profile.m_Software;
+        memcpy(member, &value, sizeof(value));
+        return true;
+    }
+    case FIELD_KIND_UINT32:
+    {
+        uint32_t value = 0;
+        if(wcscmp(field.m_Name, L"WaveLaneCountMin") == 0)
+            value = profile.m_WaveLaneCountMin;
+        else if(wcscmp(field.m_Name, L"WaveLaneCountMax") == 0)
+            value = profile.m_WaveLaneCountMax;
+        else if(wcscmp(field.m_Name, L"TotalLaneCount") == 0)
+            value = profile.m_TotalLaneCount;
+        else
+        {
+            const size_t levelIndex = m_Adapter.m_Level < 0.5f ? 0 : m_Adapter.m_Level < 0.9f ? 1 : 2;
+            const auto it = std::find_if(std::begin(UINT32_FIELD_VALUES), std::end(UINT32_FIELD_VALUES),
+                [&](const Uint32FieldValues& values) { return wcscmp(values.m_Name, field.m_Name) == 0; });
+            // Others, like NodeIndex, are inputs.
+            if(it == std::end(UINT32_FIELD_VALUES))
+                return true;
+            value = it->m_Values[levelIndex];
+        }
+        memcpy(member, &value, sizeof(value));
+        return true;
+    }
+    case FIELD_KIND_ENUM:
+    case FIELD_KIND_ENUM_SIGNED:
+    {
+        // Items are declared from the lowest tier, so pick one in proportion to the level above the requirement.
+        const size_t itemCount = GetEnumItemCount(field.m_EnumItems);
+        const float strength =
+            std::clamp(m_Adapter.m_Level - GetRequiredLevel(feature, fieldId) + 0.5f, 0.f, 1.f);
+        const size_t itemIndex = std::min(size_t(strength * float(itemCount)), itemCount - 1);
+        memcpy(member, &field.m_EnumItems[itemIndex].m_Value, sizeof(uint32_t));
+        return true;
+    }
+    case FIELD_KIND_FLAGS:
+    {
+        const uint32_t value = MakeFlags(feature, fieldId, field.m_EnumItems);
+        memcpy(member, &value, sizeof(value));
+        return true;
+    }
+    default:
+        // 64-bit members don't appear in structures of CheckFeatureSupport.
+        return false;
+    }
+}
+
+int32_t SyntheticFeatureSupportSource::CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize)
+{
+    if(m_CallLatency.count() > 0)
+        std::this_thread::sleep_for(m_CallLatency);
+
+    const GpuProfile& profile = *m_Adapter.m_Profile;
+    switch(feature)
+    {
+    case D3D12_FEATURE_SHADER_MODEL:
+    {
+        auto& shaderModel = *(D3D12_FEATURE_DATA_SHADER_MODEL*)data;
+        shaderModel.HighestShaderModel = std::min(shaderModel.HighestShaderModel, profile.m_MaxShaderModel);
+        return S_OK;
+    }
+    case D3D12_FEATURE_FEATURE_LEVELS:
+    {
+        auto& featureLevels = *(D3D12_FEATURE_DATA_FEATURE_LEVELS*)data;
+        featureLevels.MaxSupportedFeatureLevel = D3D_FEATURE_LEVEL(0);
+        for(UINT i = 0; i < featureLevels.NumFeatureLevels; ++i)
+        {
+            const D3D_FEATURE_LEVEL featureLevel = featureLevels.pFeatureLevelsRequested[i];
+            if(featureLevel <= profile.m_MaxFeatureLevel)
+                featureLevels.MaxSupportedFeatureLevel = std::max(featureLevels.MaxSupportedFeatureLevel, featureLevel);
+        }
+        return featureLevels.MaxSupportedFeatureLevel != D3D_FEATURE_LEVEL(0) ? S_OK : DXGI_ERROR_UNSUPPORTED;
+    }
+    case D3D12_FEATURE_ROOT_SIGNATURE:
+    {
+        auto& rootSignature = *(D3D12_FEATURE_DATA_ROOT_SIGNATURE*)data;
+        rootSignature.HighestVersion = std::min(rootSignature.HighestVersion, D3D_ROOT_SIGNATURE_VERSION_1_2);
+        return S_OK;
+    }
+    case D3D12_FEATURE_COMMAND_QUEUE_PRIORITY:
+    {
+        auto& commandQueuePriority = *(D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY*)data;
+        commandQueuePriority.PriorityForTypeIsSupported =
+            commandQueuePriority.Priority != D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME;
+        return S_OK;
+    }
+#ifndef USE_PREVIEW_AGILITY_SDK
+    case D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT:
+    {
+        auto& abiSupport = *(D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT*)data;
+        CopyTruncated(abiSupport.szAdapterFamily, profile.m_Description);
+        abiSupport.MinimumABISupportVersion = m_Adapter.m_UmdVersion;
+        abiSupport.MaximumABISupportVersion = m_Adapter.m_UmdVersion;
+        abiSupport.CompilerVersion.Version = m_Adapter.m_UmdVersion;
+        abiSupport.ApplicationProfileVersion.Version = m_Adapter.m_UmdVersion;
+        return S_OK;
+    }
+#endif
+    case D3D12_FEATURE_FORMAT_SUPPORT:
+    {
+        auto& formatSupport = *(D3D12_FEATURE_DATA_FORMAT_SUPPORT*)data;
+        GetFormatSupport(formatSupport.Format, formatSupport);
+        return formatSupport.Support1 != D3D12_FORMAT_SUPPORT1_NONE ? S_OK : E_FAIL;
+    }
+    case D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS:
+    {
+        auto& msQualityLevels = *(D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS*)data;
+        D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {};
+        GetFormatSupport(msQualityLevels.Format, formatSupport);
+        const UINT maxSampleCount = m_Adapter.m_Level >= 0.5f ? 8 : 4;
+        const bool supported = (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_MULTISAMPLE_RENDERTARGET) != 0 &&
+            msQualityLevels.SampleCount <= maxSampleCount;
+        msQualityLevels.NumQualityLevels = supported ? 1 : 0;
+        msQualityLevels.Flags = D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_NONE;
+        return S_OK;
+    }
+    case D3D12_FEATURE_FORMAT_INFO:
+    {
+        auto& formatInfo = *(D3D12_FEATURE_DATA_FORMAT_INFO*)data;
+        if(formatInfo.Format == DXGI_FORMAT_UNKNOWN)
+            return E_INVALIDARG;
+        const bool planar = std::find(std::begin(PLANAR_FORMATS), std::end(PLANAR_FORMATS), formatInfo.Format) !=
+            std::end(PLANAR_FORMATS);
+        formatInfo.PlaneCount = planar ? 2 : 1;
+        return S_OK;
+    }
+    }
+
+    // Features without a descriptor are unknown to this runtime.
+    const StructDesc* structDesc = StructCollection::GetInstance().FindStruct(feature);
+    if(structDesc == nullptr)
+        return E_INVALIDARG;
+    for(uint32_t fieldIndex = 0; fieldIndex < structDesc->m_FieldCount; ++fieldIndex)
+    {
+        if(structDesc->m_Fields[fieldIndex].m_Offset + GetFieldKindSize(structDesc->m_Fields[fieldIndex].m_Kind) >
+                dataSize ||
+            !FillField(*structDesc, fieldIndex, data))
+            return E_INVALIDARG;
+    }
+    return S_OK;
+}
+
+static const GpuProfile& ChooseProfile(std::mt19937_64& random, uint32_t vendorId, bool integratedOnly)
+{
+    std::vector<const GpuProfile*> profiles;
+    std::vector<uint32_t> weights;
+    for(const GpuProfile& profile : GPU_PROFILES)
+    {
+        if((vendorId == 0 || profile.m_VendorId == vendorId) && (!integratedOnly || profile.m_Integrated))
+        {
+            profiles.push_back(&profile);
+            weights.push_back(profile.m_Weight);
+        }
+    }
+    assert(!profiles.empty());
+    std::discrete_distribution<size_t> distribution(weights.begin(), weights.end());
+    return *profiles[distribution(random)];
+}
+
+static SyntheticAdapter MakeAdapter(
+    const GeneratorConfig& config, std::mt19937_64& random, const GpuProfile& profile, uint64_t systemMemory)
+{
+    SyntheticAdapter adapter = {};
+    adapter.m_Profile = &profile;
+    adapter.m_Vendor = &FindVendor(profile.m_VendorId);
+    adapter.m_SystemMemory = systemMemory;
+    adapter.m_Level = profile.m_Level;
+    // Not drawn without the spread, so reports stay the same as before the option existed.
+    if(config.m_LevelSpreadPercent > 0)
+    {
+        const float spread = (float)config.m_LevelSpreadPercent / 100.f;
+        adapter.m_Level =
+            std::clamp(profile.m_Level + std::uniform_real_distribution<float>(-spread, spread)(random), 0.f, 1.f);
+    }
+
+    // Number of releases behind the newest driver has geometric distribution with the configured mean.
+    std::geometric_distribution<uint32_t> driverAgeDistribution(1.0 / (1.0 + config.m_DriverAgeMean));
+    const uint32_t driverAge = driverAgeDistribution(random);
+    const uint16_t* latest = adapter.m_Vendor->m_LatestDriverVersion;
+    const uint32_t lastPart =
+        (uint32_t)std::max<int64_t>((int64_t)latest[3] - (int64_t)driverAge * adapter.m_Vendor->m_DriverReleaseStep, 0);
+    adapter.m_UmdVersion =
+        ((uint64_t)latest[0] << 48) | ((uint64_t)latest[1] << 32) | ((uint64_t)latest[2] << 16) | lastPart;
+
+    if(!profile.m_Software)
+    {
+        // Board vendor in the upper half, as in SubSysId of real adapters.
+        static const uint16_t BOARD_VENDOR_IDS[] = { 0x1043, 0x1458, 0x1462, 0x3842, 0x1DA2, 0x1028, 0x17AA };
+        std::uniform_int_distribution<size_t> boardVendorDistribution(0, std::size(BOARD_VENDOR_IDS) - 1);
+        std::uniform_int_distribution<uint32_t> boardDistribution(0x1000, 0xFFFF);
+        adapter.m_SubSysId =
+            ((uint32_t)BOARD_VENDOR_IDS[boardVendorDistribution(random)] << 16) | boardDistribution(random);
+        const uint32_t firstRevision = profile.m_Integrated ? 0x4 : 0xA1;
+        adapter.m_Revision = firstRevision + std::uniform_int_distribution<uint32_t>(0, 3)(random);
+    }
+    adapter.m_LuidLowPart = std::uniform_int_distribution<uint32_t>(0x10000, 0xFFFFFF)(random);
+    return adapter;
+}
+
+static void PrintAdapter(const GeneratorConfig& config, const SyntheticAdapter& adapter)
+{
+    const GpuProfile& profile = *adapter.m_Profile;
+    const uint64_t dedicatedVideoMemory = (uint64_t)profile.m_DedicatedVideoMemoryMB * 1024 * 1024;
+    const uint64_t sharedSystemMemory = adapter.m_SystemMemory / 2;
+
+    DXGI_ADAPTER_DESC3 desc = {};
+    CopyTruncated(desc.Description, profile.m_Description);
+    desc.VendorId = profile.m_VendorId;
+    desc.DeviceId = profile.m_DeviceId;
+    desc.SubSysId = adapter.m_SubSysId;
+    desc.Revision = adapter.m_Revision;
+    desc.DedicatedVideoMemory = (SIZE_T)dedicatedVideoMemory;
+    desc.SharedSystemMemory = (SIZE_T)sharedSystemMemory;
+    desc.AdapterLuid.LowPart = adapter.m_LuidLowPart;
+    if(profile.m_Software)
+    {
+        desc.Flags = DXGI_ADAPTER_FLAG3_SOFTWARE;
+        desc.GraphicsPreemptionGranularity = DXGI_GRAPHICS_PREEMPTION_INSTRUCTION_BOUNDARY;
+        desc.ComputePreemptionGranularity = DXGI_COMPUTE_PREEMPTION_INSTRUCTION_BOUNDARY;
+    }
+    else
+    {
+        desc.Flags = DXGI_ADAPTER_FLAG3_SUPPORT_MONITORED_FENCES | DXGI_ADAPTER_FLAG3_SUPPORT_NON_MONITORED_FENCES;
+        desc.GraphicsPreemptionGranularity = DXGI_GRAPHICS_PREEMPTION_PIXEL_BOUNDARY;
+        desc.ComputePreemptionGranularity = DXGI_COMPUTE_PREEMPTION_DISPATCH_BOUNDARY;
+    }
+    PrintAdapterDesc(3, desc);
+
+    const uint64_t localBudget = profile.m_Integrated || profile.m_Software ? sharedSystemMemory
+                                                                            : dedicatedVideoMemory / 10 * 9;
+    const DXGI_QUERY_VIDEO_MEMORY_INFO localMemoryInfo = { localBudget, 0, localBudget / 2, 0 };
+    PrintAdapterMemoryInfo(0, localMemoryInfo);
+    const uint64_t nonLocalBudget = profile.m_Integrated || profile.m_Software ? 0 : sharedSystemMemory / 10 * 9;
+    const DXGI_QUERY_VIDEO_MEMORY_INFO nonLocalMemoryInfo = { nonLocalBudget, 0, nonLocalBudget / 2, 0 };
+    PrintAdapterMemoryInfo(1, nonLocalMemoryInfo);
+
+    PrintAdapterInterfaceSupport(adapter.m_UmdVersion);
+
+    SyntheticFeatureSupportSource featureSupportSource(adapter, config.m_CallLatency, !config.m_SerialQueries);
+    PrintDeviceFeatures(featureSupportSource);
+    PrintDescriptorSizes(adapter.m_Vendor->m_DescriptorSizes);
+    if(config.m_PrintFormatsMatrix)
+        PrintFormatMatrix(featureSupportSource);
+    else if(config.m_PrintFormats)
+        PrintFormatInformation(featureSupportSource);
+}
+
+static void PrintReport(const GeneratorConfig& config, uint64_t reportIndex)
+{
+    const uint64_t seed = config.m_Seed + reportIndex;
+    std::mt19937_64 random(seed);
+
+    std::discrete_distribution<size_t> vendorDistribution(config.m_VendorWeights.begin(), config.m_VendorWeights.end());
+    const GpuProfile& profile = ChooseProfile(random, VENDORS[vendorDistribution(random)].m_VendorId, false);
+    static const uint32_t SYSTEM_MEMORY_GB[] = { 8, 16, 32, 64 };
+    std::uniform_int_distribution<size_t> systemMemoryDistribution(0, std::size(SYSTEM_MEMORY_GB) - 1);
+    const uint64_t systemMemory = (uint64_t)SYSTEM_MEMORY_GB[systemMemoryDistribution(random)] << 30;
+
+    std::vector<SyntheticAdapter> adapters;
+    adapters.push_back(MakeAdapter(config, random, profile, systemMemory));
+    if(!profile.m_Integrated && !profile.m_Software &&
+        std::uniform_int_distribution<uint32_t>(0, 99)(random) < config.m_SecondAdapterPercent)
+    {
+        adapters.push_back(MakeAdapter(config, random, ChooseProfile(random, 0, true), systemMemory));
+    }
+
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    {
+        ReportScopeObject scope(SelectString(L"General", L"Header"));
+        if(IsJsonOutput())
+        {
+            formatter.AddFieldString(L"Program", L"D3d12info");
+            formatter.AddFieldString(L"Version", PROGRAM_VERSION);
+        }
+        formatter.AddFieldString(L"Generated on", MakeReportDate(seed));
+        formatter.AddFieldUint64(L"Synthetic seed", seed);
+        formatter.AddFieldUint32(L"D3D12_SDK_VERSION", uint32_t(D3D12_SDK_VERSION));
+    }
+    {
+        ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+        PrintDXGIFeatureInfo(BOOL(std::uniform_int_distribution<uint32_t>(0, 9)(random) != 0));
+    }
+
+    ReportScopeArray scopeArray(SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+    for(const SyntheticAdapter& adapter : adapters)
+    {
+        ReportScopeArrayItem scopeItem;
+        PrintAdapter(config, adapter);
+    }
+}
+
+// Returns the report as UTF-8.
+static string GenerateReport(const GeneratorConfig& config, uint64_t reportIndex)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(config.m_FormatterFlags);
+        PrintReport(config, reportIndex);
+    }
+    string report = WstrToUtf8(stream.str());
+    // Minimized JSON doesn't end with a new line, but reports printed one after another need to be separated.
+    if(report.empty() || report.back() != '\n')
+        report += '\n';
+    return report;
+}
+
+static void WriteFile(const std::filesystem::path& filePath, const string& content)
+{
+    std::ofstream file(filePath, std::ios::binary);
+    file.write(content.data(), (std::streamsize)content.size());
+    if(!file)
+        throw std::runtime_error(std::format("Could not write file \"{}\".", filePath.string()));
+}
+
+static void GenerateReports(const GeneratorConfig& config)
+{
+    const bool json = (config.m_FormatterFlags & ReportFormatter::FLAG_JSON) != 0;
+    const uint64_t chunkCount = (config.m_ReportCount + REPORT_CHUNK_SIZE - 1) / REPORT_CHUNK_SIZE;
+    for(uint64_t firstChunk = 0; firstChunk < chunkCount; firstChunk += CHUNKS_PER_BATCH)
+    {
+        std::vector<uint64_t> chunkIndices((size_t)std::min<uint64_t>(CHUNKS_PER_BATCH, chunkCount - firstChunk));
+        std::iota(chunkIndices.begin(), chunkIndices.end(), firstChunk);
+        // Only used for standard output, to print chunks in order.
+        std::vector<string> chunkOutputs(config.m_OutputDirectory.empty() ? chunkIndices.size() : 0);
+        ParallelFor(chunkIndices.size(), [&](size_t i) {
+            const uint64_t chunkIndex = chunkIndices[i];
+            const uint64_t firstReport = chunkIndex * REPORT_CHUNK_SIZE;
+            const uint64_t endReport = std::min(firstReport + REPORT_CHUNK_SIZE, config.m_ReportCount);
+            for(uint64_t reportIndex = firstReport; reportIndex < endReport; ++reportIndex)
+            {
+                const string report = GenerateReport(config, reportIndex);
+                if(config.m_OutputDirectory.empty())
+                    chunkOutputs[chunkIndex - firstChunk] += report;
+                else
+                {
+                    const string fileName = std::format("Report_{}.{}", reportIndex, json ? "json" : "txt");
+                    WriteFile(config.m_OutputDirectory / fileName, report);
+                }
+            }
+        });
+        for(const string& chunkOutput : chunkOutputs)
+            std::cout.write(chunkOutput.data(), (std::streamsize)chunkOutput.size());
+    }
+    std::cout.flush();
+    if(!std::cout)
+        throw std::runtime_error("Could not write output.");
+}
+
+static uint64_t ParseUint64(const wstring& str, const wchar_t* optionName)
+{
+    wchar_t* end = nullptr;
+    const uint64_t value = wcstoull(str.c_str(), &end, 10);
+    if(str.empty() || *end != L'\0')
+    {
+        const string optionNameStr = WstrToUtf8(optionName);
+        throw std::runtime_error(std::format("Invalid number in --{}.", optionNameStr));
+    }
+    return value;
+}
+
+// Parses "NVIDIA:60,AMD:25,...". Vendors not listed get weight 0.
+static void ParseVendorWeights(const wstring& str, std::array<uint32_t, std::size(VENDORS)>& outWeights)
+{
+    outWeights = {};
+    for(size_t begin = 0; begin <= str.size();)
+    {
+        size_t end = str.find(L',', begin);
+        if(end == wstring::npos)
+            end = str.size();
+        const wstring item = str.substr(begin, end - begin);
+        const size_t colon = item.find(L':');
+        const wstring name = item.substr(0, colon);
+        const auto it = std::find_if(std::begin(VENDORS), std::end(VENDORS),
+            [&](const VendorDesc& vendor) { return ToLower(vendor.m_Name) == ToLower(name); });
+        if(colon == wstring::npos || it == std::end(VENDORS))
+        {
+            const string itemStr = WstrToUtf8(item);
+            throw std::runtime_error(std::format("Invalid item \"{}\" in --Vendors.", itemStr));
+        }
+        outWeights[it - std::begin(VENDORS)] = (uint32_t)ParseUint64(item.substr(colon + 1), L"Vendors");
+        begin = end + 1;
+    }
+    if(std::all_of(outWeights.begin(), outWeights.end(), [](uint32_t weight) { return weight == 0; }))
+        throw std::runtime_error("All weights in --Vendors are 0.");
+}
+
+static void PrintCommandLineSyntax()
+{
+    // clang-format off
+    ErrorPrinter::PrintString(L"Generates synthetic reports in the format of D3d12info, for load testing of services that ingest them.\n");
+    ErrorPrinter::PrintString(L"Options:\n");
+    ErrorPrinter::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
+    ErrorPrinter::PrintString(L"  -n --Count=<N>                   Number of reports to generate. Default is 1.\n");
+    ErrorPrinter::PrintString(L"  --Seed=<N>                       Report number i is generated from seed N + i. Default is 0.\n");
+    ErrorPrinter::PrintString(L"  -j --JSON                        Print reports in JSON format instead of human-friendly text.\n");
+    ErrorPrinter::PrintString(L"  --MinimizeJson                   Print JSON in minimal size form, one report per line.\n");
+    ErrorPrinter::PrintString(L"  -o --OutputDirectory=<Dir>       Write each report to a separate file instead of standard output.\n");
+    ErrorPrinter::PrintString(L"  -f --Formats                     Include each DXGI_FORMAT support.\n");
+    ErrorPrinter::PrintString(L"  --FormatsMatrix                  Include each DXGI_FORMAT support as compact parallel arrays in JSON, or a table in text.\n");
+    ErrorPrinter::PrintString(L"  --Vendors=<Name:Weight,...>      Relative frequency of vendors of the primary adapter. Default is NVIDIA:60,AMD:22,Intel:16,Microsoft:2.\n");
+    ErrorPrinter::PrintString(L"  --DriverAge=<N>                  Mean number of releases the driver is behind the newest one. Default is 3.\n");
+    ErrorPrinter::PrintString(L"  --SecondAdapterPercent=<N>       Chance of an integrated GPU next to the discrete one, in percent. Default is 20.\n");
+    ErrorPrinter::PrintString(L"  --LevelSpread=<N>                Maximum random change of the level of each GPU, which decides its tiers and optional features, in percent. Default is 0.\n");
+    ErrorPrinter::PrintString(L"  --CallLatency=<Microseconds>     Make each CheckFeatureSupport call take this long, like on a slow driver. Default is 0.\n");
+    ErrorPrinter::PrintString(L"  --SerialQueries                  Query formats one after another, like with D3d12info --Capture.\n");
+    // clang-format on
+}
+
+static int wmain2(int argc, wchar_t** argv)
+{
+    CmdLineParser cmdLineParser(argc, argv);
+
+    enum CMD_LINE_PARAM
+    {
+        CMD_LINE_OPT_HELP,
+        CMD_LINE_OPT_COUNT,
+        CMD_LINE_OPT_SEED,
+        CMD_LINE_OPT_JSON,
+        CMD_LINE_OPT_MINIMIZE_JSON,
+        CMD_LINE_OPT_OUTPUT_DIRECTORY,
+        CMD_LINE_OPT_FORMATS,
+        CMD_LINE_OPT_FORMATS_MATRIX,
+        CMD_LINE_OPT_VENDORS,
+        CMD_LINE_OPT_DRIVER_AGE,
+        CMD_LINE_OPT_SECOND_ADAPTER_PERCENT,
+        CMD_LINE_OPT_LEVEL_SPREAD,
+        CMD_LINE_OPT_CALL_LATENCY,
+        CMD_LINE_OPT_SERIAL_QUERIES,
+    };
+
+    // clang-format off
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,                    L"Help",                 false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,                    L'h',                    false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_COUNT,                   L"Count",                true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_COUNT,                   L'n',                    true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SEED,                    L"Seed",                 true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_JSON,                    L"JSON",                 false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_JSON,                    L'j',                    false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_MINIMIZE_JSON,           L"MinimizeJson",         false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_DIRECTORY,        L"OutputDirectory",      true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_OUTPUT_DIRECTORY,        L'o',                    true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS,                 L"Formats",              false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS,                 L'f',                    false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORMATS_MATRIX,          L"FormatsMatrix",        false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_VENDORS,                 L"Vendors",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_DRIVER_AGE,              L"DriverAge",            true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SECOND_ADAPTER_PERCENT,  L"SecondAdapterPercent", true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_LEVEL_SPREAD,            L"LevelSpread",          true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CALL_LATENCY,            L"CallLatency",          true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SERIAL_QUERIES,          L"SerialQueries",        false);
+    // clang-format on
+
+    GeneratorConfig config;
+    for(size_t i = 0; i < std::size(VENDORS); ++i)
+        config.m_VendorWeights[i] = VENDORS[i].m_DefaultWeight;
+    bool json = false;
+    bool minimizeJson = false;
+
+    CmdLineParser::RESULT cmdLineResult;
+    while((cmdLineResult = cmdLineParser.ReadNextOpt()) != CmdLineParser::RESULT_END)
+    {
+        if(cmdLineResult != CmdLineParser::RESULT_OPT)
+        {
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+        }
+        switch(cmdLineParser.GetOptId())
+        {
+        case CMD_LINE_OPT_HELP:
+            PrintCommandLineSyntax();
+            return PROGRAM_EXIT_SUCCESS;
+        case CMD_LINE_OPT_COUNT:
+            config.m_ReportCount = ParseUint64(cmdLineParser.GetParameter(), L"Count");
+            break;
+        case CMD_LINE_OPT_SEED:
+            config.m_Seed = ParseUint64(cmdLineParser.GetParameter(), L"Seed");
+            break;
+        case CMD_LINE_OPT_JSON:
+            json = true;
+            break;
+        case CMD_LINE_OPT_MINIMIZE_JSON:
+            minimizeJson = true;
+            break;
+        case CMD_LINE_OPT_OUTPUT_DIRECTORY:
+            config.m_OutputDirectory = cmdLineParser.GetParameter();
+            break;
+        case CMD_LINE_OPT_FORMATS:
+            config.m_PrintFormats = true;
+            break;
+        case CMD_LINE_OPT_FORMATS_MATRIX:
+            config.m_PrintFormatsMatrix = true;
+            break;
+        case CMD_LINE_OPT_VENDORS:
+            ParseVendorWeights(cmdLineParser.GetParameter(), config.m_VendorWeights);
+            break;
+        case CMD_LINE_OPT_DRIVER_AGE:
+            config.m_DriverAgeMean = (double)ParseUint64(cmdLineParser.GetParameter(), L"DriverAge");
+            break;
+        case CMD_LINE_OPT_SECOND_ADAPTER_PERCENT:
+            config.m_SecondAdapterPercent =
+                (uint32_t)std::min<uint64_t>(ParseUint64(cmdLineParser.GetParameter(), L"SecondAdapterPercent"), 100);
+            break;
+        case CMD_LINE_OPT_LEVEL_SPREAD:
+            config.m_LevelSpreadPercent =
+                (uint32_t)std::min<uint64_t>(ParseUint64(cmdLineParser.GetParameter(), L"LevelSpread"), 100);
+            break;
+        case CMD_LINE_OPT_CALL_LATENCY:
+            config.m_CallLatency =
+                std::chrono::microseconds(ParseUint64(cmdLineParser.GetParameter(), L"CallLatency"));
+            break;
+        case CMD_LINE_OPT_SERIAL_QUERIES:
+            config.m_SerialQueries = true;
+            break;
+        default:
+            assert(0);
+        }
+    }
+
+    if(json)
+    {
+        config.m_FormatterFlags |= ReportFormatter::FLAG_JSON;
+        if(!minimizeJson)
+            config.m_FormatterFlags |= ReportFormatter::FLAG_JSON_PRETTY_PRINT;
+    }
+    if(!config.m_OutputDirectory.empty())
+        std::filesystem::create_directories(config.m_OutputDirectory);
+
+    GenerateReports(config);
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+int wmain(int argc, wchar_t** argv)
+{
+    try
+    {
+        return wmain2(argc, argv);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+}
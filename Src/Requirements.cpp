@@ -0,0 +1,414 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Requirements.hpp"
+
+#include "EnumItems.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const std::wstring_view WHITESPACE = L" \t\r";
+
+static std::wstring_view Trim(std::wstring_view str)
+{
+    const size_t begin = str.find_first_not_of(WHITESPACE);
+    if(begin == std::wstring_view::npos)
+        return {};
+    return str.substr(begin, str.find_last_not_of(WHITESPACE) + 1 - begin);
+}
+
+static std::vector<std::wstring_view> SplitWords(std::wstring_view str)
+{
+    std::vector<std::wstring_view> words;
+    for(size_t begin = str.find_first_not_of(WHITESPACE); begin != std::wstring_view::npos;)
+    {
+        const size_t end = std::min(str.find_first_of(WHITESPACE, begin), str.size());
+        words.push_back(str.substr(begin, end - begin));
+        begin = str.find_first_not_of(WHITESPACE, end);
+    }
+    return words;
+}
+
+// For messages of exceptions, which are narrow. Other characters are replaced with '?'.
+static std::string ToAscii(std::wstring_view str)
+{
+    std::string result(str.size(), '?');
+    for(size_t i = 0; i < str.size(); ++i)
+    {
+        if(str[i] >= 0x20 && str[i] < 0x7F)
+            result[i] = (char)str[i];
+    }
+    return result;
+}
+
+[[noreturn]] static void ThrowInvalidLine(uint32_t line, std::string_view reason)
+{
+    throw std::runtime_error(std::format("Requirements profile, line {}: {}.", line, reason));
+}
+
+// Full name or its end after '_', e.g. 6_6 for D3D_SHADER_MODEL_6_6.
+static bool MatchesName(std::wstring_view fullName, std::wstring_view name)
+{
+    return fullName == name ||
+        (fullName.size() > name.size() && fullName.ends_with(name) &&
+            fullName[fullName.size() - name.size() - 1] == L'_');
+}
+
+// If not found, returns null. Throws if the end of name matches items with different values.
+static const EnumItem* FindEnumItemByName(const EnumItem* items, std::wstring_view name, uint32_t line)
+{
+    for(size_t i = 0; items[i].m_Name != nullptr; ++i)
+    {
+        if(items[i].m_Name == name)
+            return &items[i];
+    }
+    const EnumItem* found = nullptr;
+    for(size_t i = 0; items[i].m_Name != nullptr; ++i)
+    {
+        if(!MatchesName(items[i].m_Name, name))
+            continue;
+        if(found && found->m_Value != items[i].m_Value)
+            ThrowInvalidLine(line, std::format("'{}' is ambiguous", ToAscii(name)));
+        found = &items[i];
+    }
+    return found;
+}
+
+// Decimal, also negative, or hexadecimal starting with 0x.
+static bool ParseNumber(std::wstring_view str, uint64_t& outValue)
+{
+    const bool negative = str.starts_with(L'-');
+    if(negative)
+        str.remove_prefix(1);
+    uint64_t base = 10;
+    if(str.starts_with(L"0x") || str.starts_with(L"0X"))
+    {
+        base = 16;
+        str.remove_prefix(2);
+    }
+    if(str.empty())
+        return false;
+
+    uint64_t value = 0;
+    for(wchar_t ch : str)
+    {
+        uint64_t digit;
+        if(ch >= L'0' && ch <= L'9')
+            digit = ch - L'0';
+        else if(base == 16 && ch >= L'a' && ch <= L'f')
+            digit = ch - L'a' + 10;
+        else if(base == 16 && ch >= L'A' && ch <= L'F')
+            digit = ch - L'A' + 10;
+        else
+            return false;
+        value = value * base + digit;
+    }
+    outValue = negative ? 0 - value : value;
+    return true;
+}
+
+// Number, name of an enum item or its end, or true/false for BOOL.
+static uint64_t ParseValue(const FieldDesc& field, std::wstring_view str, uint32_t line)
+{
+    uint64_t value = 0;
+    if(ParseNumber(str, value))
+        return value;
+    if(field.m_Kind == FIELD_KIND_BOOL)
+    {
+        if(str == L"true" || str == L"TRUE")
+            return 1;
+        if(str == L"false" || str == L"FALSE")
+            return 0;
+    }
+    else if(field.m_EnumItems)
+    {
+        if(const EnumItem* item = FindEnumItemByName(field.m_EnumItems, str, line))
+        {
+            return field.m_Kind == FIELD_KIND_ENUM_SIGNED ? (uint64_t)(int64_t)(int32_t)item->m_Value
+                                                          : item->m_Value;
+        }
+    }
+    ThrowInvalidLine(line, std::format("'{}' is not a valid value of {}", ToAscii(str), ToAscii(field.m_Name)));
+}
+
+// Name of the field can be preceded by name of the structure or its end and a dot, e.g. D3D12_OPTIONS5.RaytracingTier.
+static void FindField(const RequirementSchema& schema, std::wstring_view name, uint32_t line, RequirementCheck& check)
+{
+    std::wstring_view structName;
+    std::wstring_view fieldName = name;
+    if(const size_t dotPos = name.find(L'.'); dotPos != std::wstring_view::npos)
+    {
+        structName = name.substr(0, dotPos);
+        fieldName = name.substr(dotPos + 1);
+    }
+
+    for(const RequirementQuery& query : schema.m_Queries)
+    {
+        if(!structName.empty() && !MatchesName(query.m_Struct->m_Name, structName))
+            continue;
+        for(uint32_t i = 0; i < query.m_Struct->m_FieldCount; ++i)
+        {
+            if(query.m_Struct->m_Fields[i].m_Name == fieldName)
+            {
+                check.m_Query = query.m_Query;
+                check.m_Field = &query.m_Struct->m_Fields[i];
+                return;
+            }
+        }
+    }
+    ThrowInvalidLine(line, std::format("unknown field '{}'", ToAscii(name)));
+}
+
+// Format <DXGI_FORMAT> supports <flag of any flags field of the structure>
+static void CompileFormatRequirement(
+    const RequirementSchema& schema, const std::vector<std::wstring_view>& words, RequirementCheck& check)
+{
+    if(words.size() != 4 || words[2] != L"supports")
+        ThrowInvalidLine(check.m_Line, "expected Format <DXGI_FORMAT> supports <flag>");
+
+    const EnumItem* const format = FindEnumItemByName(schema.m_Formats, words[1], check.m_Line);
+    if(!format)
+        ThrowInvalidLine(check.m_Line, std::format("unknown format '{}'", ToAscii(words[1])));
+    check.m_Query = schema.m_FormatQuery.m_Query;
+    check.m_Format = format->m_Value;
+    check.m_Op = REQUIREMENT_OP_SUPPORTS;
+
+    const StructDesc& structDesc = *schema.m_FormatQuery.m_Struct;
+    for(uint32_t i = 0; i < structDesc.m_FieldCount; ++i)
+    {
+        const FieldDesc& field = structDesc.m_Fields[i];
+        if(field.m_Kind != FIELD_KIND_FLAGS)
+            continue;
+        if(const EnumItem* const flag = FindEnumItemByName(field.m_EnumItems, words[3], check.m_Line))
+        {
+            check.m_Field = &field;
+            check.m_Value = flag->m_Value;
+            return;
+        }
+    }
+    ThrowInvalidLine(check.m_Line, std::format("unknown format support flag '{}'", ToAscii(words[3])));
+}
+
+static RequirementCheck CompileRequirement(const RequirementSchema& schema, std::wstring_view text, uint32_t line)
+{
+    RequirementCheck check;
+    check.m_Line = line;
+    check.m_Text = text;
+
+    const std::vector<std::wstring_view> words = SplitWords(text);
+    if(words[0] == L"Format")
+    {
+        CompileFormatRequirement(schema, words, check);
+        return check;
+    }
+
+    // <Field> <operator> <value>
+    if(const size_t opPos = text.find_first_of(L"<>=!"); opPos != std::wstring_view::npos)
+    {
+        const bool orEqual = opPos + 1 < text.size() && text[opPos + 1] == L'=';
+        switch(text[opPos])
+        {
+        case L'<':
+            check.m_Op = orEqual ? REQUIREMENT_OP_LESS_EQUAL : REQUIREMENT_OP_LESS;
+            break;
+        case L'>':
+            check.m_Op = orEqual ? REQUIREMENT_OP_GREATER_EQUAL : REQUIREMENT_OP_GREATER;
+            break;
+        case L'=':
+            check.m_Op = REQUIREMENT_OP_EQUAL;
+            break;
+        default:
+            if(!orEqual)
+                ThrowInvalidLine(line, "expected != operator");
+            check.m_Op = REQUIREMENT_OP_NOT_EQUAL;
+        }
+        const std::wstring_view value = Trim(text.substr(opPos + (orEqual ? 2 : 1)));
+        if(value.empty())
+            ThrowInvalidLine(line, "missing value");
+        FindField(schema, Trim(text.substr(0, opPos)), line, check);
+        check.m_Value = ParseValue(*check.m_Field, value, line);
+        return check;
+    }
+
+    // <Field> supports <flag>
+    if(words.size() == 3 && words[1] == L"supports")
+    {
+        FindField(schema, words[0], line, check);
+        if(check.m_Field->m_Kind != FIELD_KIND_FLAGS)
+            ThrowInvalidLine(line, std::format("{} is not a flags field", ToAscii(words[0])));
+        check.m_Op = REQUIREMENT_OP_SUPPORTS;
+        check.m_Value = ParseValue(*check.m_Field, words[2], line);
+        return check;
+    }
+
+    // <Field>, which must be nonzero, e.g. a BOOL that must be TRUE.
+    if(words.size() == 1)
+    {
+        FindField(schema, words[0], line, check);
+        check.m_Op = REQUIREMENT_OP_NOT_EQUAL;
+        check.m_Value = 0;
+        return check;
+    }
+
+    ThrowInvalidLine(line, "expected <Field> <operator> <value>, <Field> supports <flag>, <Field> or Format");
+}
+
+struct QueryResult
+{
+    const FeatureQueryDesc* m_Query = nullptr;
+    std::optional<uint32_t> m_Format;
+    bool m_Succeeded = false;
+    std::vector<unsigned char> m_Data;
+};
+
+// Only valid until the next call.
+static const QueryResult& GetQueryResult(
+    FeatureSupportSource& source, const RequirementCheck& check, std::vector<QueryResult>& results)
+{
+    for(const QueryResult& result : results)
+    {
+        if(result.m_Query == check.m_Query && result.m_Format == check.m_Format)
+            return result;
+    }
+
+    QueryResult result = {
+        check.m_Query, check.m_Format, false, std::vector<unsigned char>(check.m_Query->m_DataSize) };
+    if(check.m_Format)
+        memcpy(result.m_Data.data(), &*check.m_Format, sizeof(uint32_t));
+    result.m_Succeeded = QueryFeature(source, *check.m_Query, result.m_Data.data());
+    results.push_back(std::move(result));
+    return results.back();
+}
+
+static uint64_t ReadFieldValue(const void* data, const FieldDesc& field)
+{
+    const char* const fieldData = (const char*)data + field.m_Offset;
+    switch(field.m_Kind)
+    {
+    case FIELD_KIND_UINT64:
+    case FIELD_KIND_SIZE:
+    {
+        uint64_t value;
+        memcpy(&value, fieldData, sizeof(value));
+        return value;
+    }
+    default:
+    {
+        uint32_t value;
+        memcpy(&value, fieldData, sizeof(value));
+        if(field.m_Kind == FIELD_KIND_BOOL)
+            return value != 0 ? 1 : 0;
+        if(field.m_Kind == FIELD_KIND_ENUM_SIGNED)
+            return (uint64_t)(int64_t)(int32_t)value;
+        return value;
+    }
+    }
+}
+
+static bool IsCheckPassed(const RequirementCheck& check, uint64_t value)
+{
+    if(check.m_Op == REQUIREMENT_OP_SUPPORTS)
+        return (value & check.m_Value) == check.m_Value;
+
+    const std::strong_ordering order = check.m_Field->m_Kind == FIELD_KIND_ENUM_SIGNED
+        ? (int64_t)value <=> (int64_t)check.m_Value
+        : value <=> check.m_Value;
+    switch(check.m_Op)
+    {
+    case REQUIREMENT_OP_EQUAL:
+        return order == 0;
+    case REQUIREMENT_OP_NOT_EQUAL:
+        return order != 0;
+    case REQUIREMENT_OP_LESS:
+        return order < 0;
+    case REQUIREMENT_OP_LESS_EQUAL:
+        return order <= 0;
+    case REQUIREMENT_OP_GREATER:
+        return order > 0;
+    case REQUIREMENT_OP_GREATER_EQUAL:
+        return order >= 0;
+    default:
+        assert(0);
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::vector<RequirementCheck> CompileRequirements(std::wstring_view profile, const RequirementSchema& schema)
+{
+    if(profile.starts_with(L'\xFEFF'))
+        profile.remove_prefix(1);
+
+    std::vector<RequirementCheck> checks;
+    uint32_t line = 1;
+    for(size_t lineBegin = 0; lineBegin <= profile.size(); ++line)
+    {
+        const size_t lineEnd = std::min(profile.find(L'\n', lineBegin), profile.size());
+        const std::wstring_view text = Trim(profile.substr(lineBegin, lineEnd - lineBegin));
+        if(!text.empty() && !text.starts_with(L'#'))
+            checks.push_back(CompileRequirement(schema, text, line));
+        lineBegin = lineEnd + 1;
+    }
+    return checks;
+}
+
+RequirementVerdict EvaluateRequirements(FeatureSupportSource& source, const std::vector<RequirementCheck>& checks)
+{
+    RequirementVerdict verdict;
+    std::vector<QueryResult> results;
+    for(const RequirementCheck& check : checks)
+    {
+        ++verdict.m_CheckedCount;
+        const QueryResult& result = GetQueryResult(source, check, results);
+        if(!result.m_Succeeded)
+        {
+            verdict.m_FailedCheck = &check;
+            verdict.m_QueryFailed = true;
+            break;
+        }
+        const uint64_t value = ReadFieldValue(result.m_Data.data(), *check.m_Field);
+        if(!IsCheckPassed(check, value))
+        {
+            verdict.m_FailedCheck = &check;
+            verdict.m_Value = value;
+            break;
+        }
+    }
+    return verdict;
+}
+
+std::wstring FormatRequirementValue(const FieldDesc& field, uint64_t value)
+{
+    switch(field.m_Kind)
+    {
+    case FIELD_KIND_BOOL:
+        return value != 0 ? L"true" : L"false";
+    case FIELD_KIND_ENUM:
+    case FIELD_KIND_ENUM_SIGNED:
+        if(const wchar_t* const name = FindEnumItemName((uint32_t)value, field.m_EnumItems))
+            return name;
+        if(field.m_Kind == FIELD_KIND_ENUM_SIGNED)
+            return std::to_wstring((int64_t)value);
+        return std::to_wstring(value);
+    case FIELD_KIND_FLAGS:
+        return std::format(L"0x{:X}", value);
+    default:
+        return std::to_wstring(value);
+    }
+}
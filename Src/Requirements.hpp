@@ -0,0 +1,88 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Profiles of minimum capabilities checked with --Require. A profile is compiled into checks of fields of structures
+// described by StructDesc, so only the queries it needs are made. Depends only on FeatureQuery, StructDesc and the C++
+// standard library, so it can run against a fake device.
+
+#include "FeatureQuery.hpp"
+#include "StructDesc.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct RequirementQuery
+{
+    const FeatureQueryDesc* m_Query = nullptr;
+    const StructDesc* m_Struct = nullptr;
+};
+
+// What a profile can refer to.
+struct RequirementSchema
+{
+    // Queries of the device with their structures, in order of the report. Field names not preceded by a structure
+    // name are looked up in this order.
+    std::vector<RequirementQuery> m_Queries;
+    // Query about a format. Its structure starts with DXGI_FORMAT, and its flags fields are what a format supports.
+    RequirementQuery m_FormatQuery;
+    // Items of DXGI_FORMAT.
+    const EnumItem* m_Formats = nullptr;
+};
+
+enum REQUIREMENT_OP
+{
+    REQUIREMENT_OP_EQUAL,
+    REQUIREMENT_OP_NOT_EQUAL,
+    REQUIREMENT_OP_LESS,
+    REQUIREMENT_OP_LESS_EQUAL,
+    REQUIREMENT_OP_GREATER,
+    REQUIREMENT_OP_GREATER_EQUAL,
+    // All bits of the value are set in the field.
+    REQUIREMENT_OP_SUPPORTS,
+};
+
+struct RequirementCheck
+{
+    // Number of the line in the profile, starting from 1, and its text.
+    uint32_t m_Line = 0;
+    std::wstring m_Text;
+    const FeatureQueryDesc* m_Query = nullptr;
+    // For checks of a format: DXGI_FORMAT set as the first member of the structure before the query.
+    std::optional<uint32_t> m_Format;
+    const FieldDesc* m_Field = nullptr;
+    REQUIREMENT_OP m_Op = REQUIREMENT_OP_NOT_EQUAL;
+    // Sign-extended for FIELD_KIND_ENUM_SIGNED.
+    uint64_t m_Value = 0;
+};
+
+struct RequirementVerdict
+{
+    // Including the one that failed.
+    uint32_t m_CheckedCount = 0;
+    // Null if all checks passed.
+    const RequirementCheck* m_FailedCheck = nullptr;
+    // The failed check has no value, as its query failed.
+    bool m_QueryFailed = false;
+    uint64_t m_Value = 0;
+};
+
+// One requirement per line. Empty lines and lines starting with # are ignored. Throws with the number of the line if a
+// line is not valid or refers to an unknown name.
+std::vector<RequirementCheck> CompileRequirements(std::wstring_view profile, const RequirementSchema& schema);
+
+// Checks in order and stops at the first one that fails. Each query is made once, when first needed.
+RequirementVerdict EvaluateRequirements(FeatureSupportSource& source, const std::vector<RequirementCheck>& checks);
+
+// Like in the report, e.g. name of the enum item.
+std::wstring FormatRequirementValue(const FieldDesc& field, uint64_t value);
@@ -0,0 +1,102 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Stats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static const wchar_t* const STAT_NAMES[] = {
+    L"HeapAllocations",
+    L"HeapAllocatedBytes",
+    L"FormatterPushObject",
+    L"FormatterPushArray",
+    L"FormatterPushArrayItem",
+    L"FormatterPopScope",
+    L"FormatterString",
+    L"FormatterStringArray",
+    L"FormatterBool",
+    L"FormatterUint32",
+    L"FormatterUint64",
+    L"FormatterSize",
+    L"FormatterSizeKilobytes",
+    L"FormatterHex32",
+    L"FormatterInt32",
+    L"FormatterUint32Array",
+    L"FormatterFloat",
+    L"FormatterEnum",
+    L"FormatterEnumSigned",
+    L"FormatterEnumArray",
+    L"FormatterFlags",
+    L"FormatterHexBytes",
+    L"FormatterVendorId",
+    L"FormatterSubsystemId",
+    L"FormatterMicrosoftVersion",
+    L"FormatterAMDVersion",
+    L"FormatterNvidiaImplementationID",
+    L"EnumItemProbes",
+    L"EscapedChars",
+    L"PrintedChars",
+    L"PrinterFlushes",
+    L"CheckFeatureSupportCalls",
+    L"DeviceCreations",
+};
+static_assert(_countof(STAT_NAMES) == STAT_COUNT);
+
+const wchar_t* GetStatName(STAT stat)
+{
+    return stat < STAT_COUNT ? STAT_NAMES[stat] : L"";
+}
+
+#if USE_STATS
+
+std::atomic<uint64_t> g_Stats[STAT_COUNT];
+
+uint64_t GetStatValue(STAT stat)
+{
+    return stat < STAT_COUNT ? g_Stats[stat].load(std::memory_order_relaxed) : 0;
+}
+
+// Replaces the global allocation functions to count heap allocations. Array, nothrow and sized forms of the standard
+// library call these ones. Over-aligned allocations are not counted, as the program doesn't make them.
+
+void* operator new(size_t size)
+{
+    ADD_STAT(STAT_HEAP_ALLOCATIONS, 1);
+    ADD_STAT(STAT_HEAP_ALLOCATED_BYTES, size);
+    // Like the standard one: calls the new-handler, which may free some memory, and tries again until there is none.
+    for(;;)
+    {
+        if(void* const ptr = malloc(size > 0 ? size : 1))
+            return ptr;
+        const std::new_handler handler = std::get_new_handler();
+        if(!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+    free(ptr);
+}
+
+#else
+
+uint64_t GetStatValue(STAT stat)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+// Counters of work done on hot paths, printed with --Stats to compare efficiency of the program between versions.
+// Compiled out unless USE_STATS is defined, so code using ADD_STAT costs nothing in other builds. Depends only on the
+// C++ standard library.
+
+#include <atomic>
+#include <cstdint>
+
+enum STAT
+{
+    // Calls to global operator new, made by any code of the process.
+    STAT_HEAP_ALLOCATIONS,
+    STAT_HEAP_ALLOCATED_BYTES,
+
+    // Calls to methods of the formatter printing the report. Calls delegated by one method to another are counted
+    // for both of them.
+    STAT_FORMATTER_PUSH_OBJECT,
+    STAT_FORMATTER_PUSH_ARRAY,
+    STAT_FORMATTER_PUSH_ARRAY_ITEM,
+    STAT_FORMATTER_POP_SCOPE,
+    STAT_FORMATTER_STRING,
+    STAT_FORMATTER_STRING_ARRAY,
+    STAT_FORMATTER_BOOL,
+    STAT_FORMATTER_UINT32,
+    STAT_FORMATTER_UINT64,
+    STAT_FORMATTER_SIZE,
+    STAT_FORMATTER_SIZE_KILOBYTES,
+    STAT_FORMATTER_HEX32,
+    STAT_FORMATTER_INT32,
+    STAT_FORMATTER_UINT32_ARRAY,
+    STAT_FORMATTER_FLOAT,
+    STAT_FORMATTER_ENUM,
+    STAT_FORMATTER_ENUM_SIGNED,
+    STAT_FORMATTER_ENUM_ARRAY,
+    STAT_FORMATTER_FLAGS,
+    STAT_FORMATTER_HEX_BYTES,
+    STAT_FORMATTER_VENDOR_ID,
+    STAT_FORMATTER_SUBSYSTEM_ID,
+    STAT_FORMATTER_MICROSOFT_VERSION,
+    STAT_FORMATTER_AMD_VERSION,
+    STAT_FORMATTER_NVIDIA_IMPLEMENTATION_ID,
+
+    // Items compared by FindEnumItemName.
+    STAT_ENUM_ITEM_PROBES,
+    // Characters of JSON strings that needed an escape sequence.
+    STAT_ESCAPED_CHARS,
+    // Characters written by Printer, before conversion to the encoding of the output.
+    STAT_PRINTED_CHARS,
+    STAT_PRINTER_FLUSHES,
+
+    // Calls made to the driver.
+    STAT_CHECK_FEATURE_SUPPORT_CALLS,
+    STAT_DEVICE_CREATIONS,
+
+    STAT_COUNT
+};
+
+#if USE_STATS
+extern std::atomic<uint64_t> g_Stats[STAT_COUNT];
+// Relaxed, as counters are only read at the end, after all threads finished.
+#define ADD_STAT(stat, value) g_Stats[(stat)].fetch_add((uint64_t)(value), std::memory_order_relaxed)
+#else
+#define ADD_STAT(stat, value) ((void)0)
+#endif
+
+const wchar_t* GetStatName(STAT stat);
+// Always 0 if compiled out.
+uint64_t GetStatValue(STAT stat);
@@ -0,0 +1,85 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "StructDesc.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+template <typename T>
+static T ReadField(const void* data, const FieldDesc& field)
+{
+    T value;
+    memcpy(&value, (const char*)data + field.m_Offset, sizeof(T));
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+const StructDesc* StructCollection::FindStruct(uint32_t structId) const
+{
+    const auto it = m_Structs.find(structId);
+    return it != m_Structs.end() ? it->second : nullptr;
+}
+
+const FieldDesc* StructCollection::FindField(uint32_t fieldId, const StructDesc** outStructDesc) const
+{
+    const StructDesc* const structDesc = FindStruct(fieldId >> FIELD_ID_STRUCT_SHIFT);
+    const uint32_t fieldNumber = fieldId & ((1u << FIELD_ID_STRUCT_SHIFT) - 1);
+    if(!structDesc || fieldNumber == 0 || fieldNumber > structDesc->m_FieldCount)
+        return nullptr;
+    if(outStructDesc)
+        *outStructDesc = structDesc;
+    return &structDesc->m_Fields[fieldNumber - 1];
+}
+
+void PrintStructFields(const StructDesc& structDesc, const void* data)
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    for(uint32_t i = 0; i < structDesc.m_FieldCount; ++i)
+    {
+        const FieldDesc& field = structDesc.m_Fields[i];
+        switch(field.m_Kind)
+        {
+        case FIELD_KIND_BOOL:
+            formatter.AddFieldBool(field.m_Name, ReadField<int32_t>(data, field) != 0);
+            break;
+        case FIELD_KIND_UINT32:
+            formatter.AddFieldUint32(field.m_Name, ReadField<uint32_t>(data, field));
+            break;
+        case FIELD_KIND_UINT64:
+            formatter.AddFieldUint64(field.m_Name, ReadField<uint64_t>(data, field));
+            break;
+        case FIELD_KIND_SIZE:
+            formatter.AddFieldSize(field.m_Name, ReadField<uint64_t>(data, field));
+            break;
+        case FIELD_KIND_ENUM:
+            formatter.AddFieldEnum(field.m_Name, ReadField<uint32_t>(data, field), field.m_EnumItems);
+            break;
+        case FIELD_KIND_ENUM_SIGNED:
+            formatter.AddFieldEnumSigned(field.m_Name, ReadField<int32_t>(data, field), field.m_EnumItems);
+            break;
+        case FIELD_KIND_FLAGS:
+            formatter.AddFieldFlags(field.m_Name, ReadField<uint32_t>(data, field), field.m_EnumItems);
+            break;
+        default:
+            assert(0);
+        }
+    }
+}
+
+void PrintStruct(const StructDesc& structDesc, const void* data)
+{
+    ReportScopeObject scope(structDesc.m_Name);
+    PrintStructFields(structDesc, data);
+}
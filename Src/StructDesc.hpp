@@ -0,0 +1,130 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Compile-time descriptors of structures printed member by member, walked by one generic printer.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+
+struct EnumItem;
+
+enum FIELD_KIND
+{
+    FIELD_KIND_BOOL, // BOOL
+    FIELD_KIND_UINT32,
+    FIELD_KIND_UINT64,
+    FIELD_KIND_SIZE, // uint64_t number of bytes
+    FIELD_KIND_ENUM,
+    FIELD_KIND_ENUM_SIGNED,
+    FIELD_KIND_FLAGS,
+};
+
+constexpr size_t GetFieldKindSize(FIELD_KIND kind)
+{
+    return kind == FIELD_KIND_UINT64 || kind == FIELD_KIND_SIZE ? 8 : 4;
+}
+
+struct FieldDesc
+{
+    const wchar_t* m_Name;
+    uint32_t m_Offset;
+    FIELD_KIND m_Kind;
+    // For FIELD_KIND_ENUM, FIELD_KIND_ENUM_SIGNED, FIELD_KIND_FLAGS.
+    const EnumItem* m_EnumItems;
+};
+
+struct StructDesc
+{
+    const wchar_t* m_Name;
+    // D3D12_FEATURE for structures of ID3D12Device::CheckFeatureSupport, STRUCT_ID_OTHER_FIRST + N for others.
+    uint32_t m_Id;
+    const FieldDesc* m_Fields;
+    uint32_t m_FieldCount;
+};
+
+static const uint32_t STRUCT_ID_OTHER_FIRST = 0x10000;
+
+// Field ID is built from the structure ID and the position of the field in its descriptor, so it stays stable as
+// long as new fields are only appended at the end.
+static const uint32_t FIELD_ID_STRUCT_SHIFT = 8;
+
+constexpr uint32_t GetFieldId(const StructDesc& structDesc, uint32_t fieldIndex)
+{
+    return (structDesc.m_Id << FIELD_ID_STRUCT_SHIFT) | (fieldIndex + 1);
+}
+
+template <typename T, FIELD_KIND Kind>
+constexpr FieldDesc MakeFieldDesc(const wchar_t* name, size_t offset, const EnumItem* enumItems = nullptr)
+{
+    static_assert(sizeof(T) == GetFieldKindSize(Kind), "Member doesn't match field kind.");
+    return { name, (uint32_t)offset, Kind, enumItems };
+}
+
+class StructCollection
+{
+public:
+    static StructCollection& GetInstance()
+    {
+        static StructCollection obj;
+        return obj;
+    }
+
+    void Add(const StructDesc& structDesc)
+    {
+        m_Structs.insert({ structDesc.m_Id, &structDesc });
+    }
+
+    // If not found, returns null.
+    const StructDesc* FindStruct(uint32_t structId) const;
+    // If not found, returns null. Optionally returns the structure containing the field.
+    const FieldDesc* FindField(uint32_t fieldId, const StructDesc** outStructDesc = nullptr) const;
+    const std::unordered_map<uint32_t, const StructDesc*>& GetStructs() const { return m_Structs; }
+
+private:
+    std::unordered_map<uint32_t, const StructDesc*> m_Structs;
+};
+
+class StructRegistration
+{
+public:
+    StructRegistration(const StructDesc& structDesc)
+    {
+        StructCollection::GetInstance().Add(structDesc);
+    }
+};
+
+// Prints fields of the structure pointed by data, in order of the descriptor, within current scope.
+void PrintStructFields(const StructDesc& structDesc, const void* data);
+// Prints the structure as an object named after the structure.
+void PrintStruct(const StructDesc& structDesc, const void* data);
+
+// Define StructDesc_<type> and Print_<type>(const type&) for a structure. The ID must never change once released.
+#define STRUCT_DESC_BEGIN(type) \
+    struct StructFields_##type \
+    { \
+        using Type = type; \
+        static constexpr FieldDesc FIELDS[] = {
+#define STRUCT_DESC_END(type, id) \
+        }; \
+    }; \
+    static constexpr StructDesc StructDesc_##type = { \
+        L"" #type, uint32_t(id), StructFields_##type::FIELDS, (uint32_t)std::size(StructFields_##type::FIELDS) }; \
+    static StructRegistration g_StructDesc_##type##_Registration(StructDesc_##type); \
+    [[maybe_unused]] static void Print_##type(const type& o) \
+    { \
+        PrintStruct(StructDesc_##type, &o); \
+    }
+#define STRUCT_FIELD(kind, member) \
+    MakeFieldDesc<decltype(Type::member), FIELD_KIND_##kind>(L"" #member, offsetof(Type, member)),
+#define STRUCT_FIELD_ENUM(kind, member, enumName) \
+    MakeFieldDesc<decltype(Type::member), FIELD_KIND_##kind>(L"" #member, offsetof(Type, member), Enum_##enumName),
@@ -0,0 +1,212 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Timings.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Per thread, like the current ReportContext.
+static thread_local TimingRecorder* s_CurrentRecorder = nullptr;
+
+// Small numbers instead of system thread IDs, in order threads first add an event. 1 is usually the main thread.
+static std::atomic<uint32_t> s_NextTraceThreadId = 1;
+static thread_local uint32_t s_TraceThreadId = 0;
+
+static uint32_t GetTraceThreadId()
+{
+    if(s_TraceThreadId == 0)
+        s_TraceThreadId = s_NextTraceThreadId++;
+    return s_TraceThreadId;
+}
+
+// As a JSON string, without quotes. Characters outside of ASCII are escaped, so the file doesn't depend on encoding.
+static void AppendJsonString(std::string& out, std::wstring_view str)
+{
+    for(wchar_t ch : str)
+    {
+        if(ch == L'"' || ch == L'\\')
+        {
+            out += '\\';
+            out += (char)ch;
+        }
+        else if(ch >= 0x20 && ch < 0x7F)
+            out += (char)ch;
+        else
+            out += std::format("\\u{:04X}", (uint32_t)ch);
+    }
+}
+
+static double ToMicroseconds(TimingClock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static float ToMilliseconds(TimingClock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+struct CallTotal
+{
+    std::wstring_view m_Name;
+    uint32_t m_Count = 0;
+    TimingClock::duration m_Total = {};
+    TimingClock::duration m_Max = {};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::atomic<TraceWriter*> TraceWriter::s_Instance = nullptr;
+
+TraceWriter* TraceWriter::GetInstance()
+{
+    return s_Instance;
+}
+
+TraceWriter::TraceWriter(const std::filesystem::path& filePath)
+    : m_StartTime(TimingClock::now())
+    , m_File(filePath, std::ios::binary)
+{
+    if(!m_File)
+        throw std::runtime_error(std::format("Could not open {} for writing.", filePath.string()));
+    m_File << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"D3d12info\"}}";
+    assert(s_Instance == nullptr);
+    s_Instance = this;
+}
+
+TraceWriter::~TraceWriter()
+{
+    s_Instance = nullptr;
+    m_File << "\n]\n";
+}
+
+void TraceWriter::AddEvent(std::wstring_view name, const char* category, TimingClock::time_point begin,
+    TimingClock::time_point end, std::wstring_view args)
+{
+    std::string event = ",\n{\"name\":\"";
+    AppendJsonString(event, name);
+    event += std::format("\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}", category,
+        ToMicroseconds(begin - m_StartTime), ToMicroseconds(end - begin), GetTraceThreadId());
+    if(!args.empty())
+    {
+        event += ",\"args\":{\"args\":\"";
+        AppendJsonString(event, args);
+        event += "\"}";
+    }
+    event += '}';
+
+    std::lock_guard lock(m_Mutex);
+    m_File << event;
+}
+
+TimingRecorder* TimingRecorder::GetCurrent()
+{
+    return s_CurrentRecorder;
+}
+
+void TimingRecorder::AddPhase(std::wstring_view name, TimingClock::duration duration)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Phases.push_back({ .m_Name = std::wstring(name), .m_Duration = duration });
+}
+
+void TimingRecorder::AddCall(std::wstring_view name, std::wstring_view args, TimingClock::duration duration)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Calls.push_back({ .m_Name = std::wstring(name), .m_Args = std::wstring(args), .m_Duration = duration });
+}
+
+void TimingRecorder::Print(size_t slowestCallCount) const
+{
+    // Printing itself is not timed, also because Printer would add to this recorder while it is locked.
+    TimingRecorderScope noTimingScope(nullptr);
+    std::lock_guard lock(m_Mutex);
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportScopeObject scope(L"Timings");
+
+    if(!m_Phases.empty())
+    {
+        ReportScopeArray scopeArray(L"Phases");
+        for(const Entry& phase : m_Phases)
+        {
+            ReportScopeArrayItem scopeItem;
+            formatter.AddFieldString(L"Name", phase.m_Name);
+            formatter.AddFieldFloat(L"TimeMs", ToMilliseconds(phase.m_Duration));
+        }
+    }
+
+    if(m_Calls.empty())
+        return;
+
+    std::vector<CallTotal> totals;
+    std::unordered_map<std::wstring_view, size_t> totalIndices;
+    for(const Entry& call : m_Calls)
+    {
+        const auto [it, inserted] = totalIndices.emplace(call.m_Name, totals.size());
+        if(inserted)
+            totals.push_back({ .m_Name = call.m_Name });
+        CallTotal& total = totals[it->second];
+        ++total.m_Count;
+        total.m_Total += call.m_Duration;
+        total.m_Max = std::max(total.m_Max, call.m_Duration);
+    }
+    {
+        ReportScopeArray scopeArray(L"Calls");
+        for(const CallTotal& total : totals)
+        {
+            ReportScopeArrayItem scopeItem;
+            formatter.AddFieldString(L"Name", total.m_Name);
+            formatter.AddFieldUint32(L"Count", total.m_Count);
+            formatter.AddFieldFloat(L"TotalMs", ToMilliseconds(total.m_Total));
+            formatter.AddFieldFloat(L"MaxMs", ToMilliseconds(total.m_Max));
+        }
+    }
+
+    std::vector<const Entry*> slowest;
+    slowest.reserve(m_Calls.size());
+    for(const Entry& call : m_Calls)
+        slowest.push_back(&call);
+    slowestCallCount = std::min(slowestCallCount, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + slowestCallCount, slowest.end(),
+        [](const Entry* lhs, const Entry* rhs) { return lhs->m_Duration > rhs->m_Duration; });
+    ReportScopeArray scopeArray(L"SlowestCalls");
+    for(size_t i = 0; i < slowestCallCount; ++i)
+    {
+        ReportScopeArrayItem scopeItem;
+        formatter.AddFieldString(L"Name", slowest[i]->m_Name);
+        if(!slowest[i]->m_Args.empty())
+            formatter.AddFieldString(L"Args", slowest[i]->m_Args);
+        formatter.AddFieldFloat(L"TimeMs", ToMilliseconds(slowest[i]->m_Duration));
+    }
+}
+
+void AddTimedCall(TimingRecorder* recorder, std::wstring_view name, std::wstring_view args,
+    TimingClock::time_point begin, TimingClock::time_point end)
+{
+    if(recorder)
+        recorder->AddCall(name, args, end - begin);
+    if(TraceWriter* const trace = TraceWriter::GetInstance())
+        trace->AddEvent(name, "Call", begin, end, args);
+}
+
+TimingRecorderScope::TimingRecorderScope(TimingRecorder* recorder)
+    : m_Previous(s_CurrentRecorder)
+{
+    s_CurrentRecorder = recorder;
+}
+
+TimingRecorderScope::~TimingRecorderScope()
+{
+    s_CurrentRecorder = m_Previous;
+}
@@ -0,0 +1,169 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+// Durations of phases of the inspection and of individual driver calls, gathered with --Timings and written as a
+// timeline with --Trace. Depends only on ReportFormatter and the C++ standard library.
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using TimingClock = std::chrono::steady_clock;
+
+// Writes events in Chrome trace event format, which can be opened in Perfetto or chrome://tracing. Events are written
+// as they end, so the file is readable also if the program crashes, as the closing bracket is optional.
+class TraceWriter
+{
+public:
+    // The one being written, or null. Set for the whole process, as events come from all threads.
+    static TraceWriter* GetInstance();
+
+    // Becomes the instance. Throws if the file can't be created.
+    TraceWriter(const std::filesystem::path& filePath);
+    ~TraceWriter();
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    // Thread-safe. Event is on the timeline of the calling thread. args is shown with the event, if not empty.
+    void AddEvent(std::wstring_view name, const char* category, TimingClock::time_point begin,
+        TimingClock::time_point end, std::wstring_view args = {});
+
+private:
+    static std::atomic<TraceWriter*> s_Instance;
+
+    const TimingClock::time_point m_StartTime;
+    std::mutex m_Mutex;
+    std::ofstream m_File;
+};
+
+class TimingRecorder
+{
+public:
+    // Recorder of the current TimingRecorderScope of this thread, or null if nothing is timed.
+    static TimingRecorder* GetCurrent();
+
+    // Thread-safe, as calls of one adapter may be made from multiple threads, like queries of formats.
+    void AddPhase(std::wstring_view name, TimingClock::duration duration);
+    // Calls are summed up by name. args tell apart individual calls in the list of the slowest ones.
+    void AddCall(std::wstring_view name, std::wstring_view args, TimingClock::duration duration);
+
+    // Prints "Timings" object to the current ReportFormatter: phases in order they ended, calls summed up by name in
+    // order of their first use, and slowestCallCount individual calls that took the longest.
+    void Print(size_t slowestCallCount) const;
+
+private:
+    struct Entry
+    {
+        std::wstring m_Name;
+        std::wstring m_Args;
+        TimingClock::duration m_Duration;
+    };
+
+    mutable std::mutex m_Mutex;
+    std::vector<Entry> m_Phases;
+    std::vector<Entry> m_Calls;
+};
+
+// Adds the call to the recorder, if not null, and to the trace, if written.
+void AddTimedCall(TimingRecorder* recorder, std::wstring_view name, std::wstring_view args,
+    TimingClock::time_point begin, TimingClock::time_point end);
+
+// Makes the recorder current for this thread. At the end of the scope, the previous one is current again. Null
+// recorder means nothing is timed in this scope.
+class TimingRecorderScope
+{
+public:
+    TimingRecorderScope(TimingRecorder* recorder);
+    ~TimingRecorderScope();
+    TimingRecorderScope(const TimingRecorderScope&) = delete;
+    TimingRecorderScope& operator=(const TimingRecorderScope&) = delete;
+
+private:
+    TimingRecorder* const m_Previous;
+};
+
+// Adds time from construction to destruction as a phase to the recorder, if not null, and to the trace, if written.
+// name must stay valid until then, e.g. a string literal.
+class TimingScope
+{
+public:
+    TimingScope(std::wstring_view name)
+        : TimingScope(TimingRecorder::GetCurrent(), name)
+    {
+    }
+
+    TimingScope(TimingRecorder* recorder, std::wstring_view name)
+        : m_Recorder(recorder)
+        , m_Trace(TraceWriter::GetInstance())
+        , m_Name(name)
+    {
+        if(m_Recorder || m_Trace)
+            m_Begin = TimingClock::now();
+    }
+
+    ~TimingScope()
+    {
+        if(!m_Recorder && !m_Trace)
+            return;
+        const TimingClock::time_point end = TimingClock::now();
+        if(m_Recorder)
+            m_Recorder->AddPhase(m_Name, end - m_Begin);
+        if(m_Trace)
+            m_Trace->AddEvent(m_Name, "Phase", m_Begin, end);
+    }
+
+    TimingScope(const TimingScope&) = delete;
+    TimingScope& operator=(const TimingScope&) = delete;
+
+private:
+    TimingRecorder* const m_Recorder;
+    TraceWriter* const m_Trace;
+    const std::wstring_view m_Name;
+    TimingClock::time_point m_Begin;
+};
+
+// Adds time from construction to destruction to the trace, if written, but not to Timings. Copies the name, so it can
+// be a temporary, like names of ReportScopeObject.
+class TraceScope
+{
+public:
+    TraceScope(std::wstring_view name, const char* category)
+        : m_Trace(TraceWriter::GetInstance())
+        , m_Category(category)
+    {
+        if(m_Trace)
+        {
+            m_Name = name;
+            m_Begin = TimingClock::now();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if(m_Trace)
+            m_Trace->AddEvent(m_Name, m_Category, m_Begin, TimingClock::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceWriter* const m_Trace;
+    const char* const m_Category;
+    std::wstring m_Name;
+    TimingClock::time_point m_Begin;
+};
@@ -18,20 +18,22 @@ wstring SizeToStr(uint64_t size)
 {
     if(size == 0)
         return L"0";
-    wchar_t s[16];
+    wstring s;
     if(size < 1024llu)
-        swprintf_s(s, L"%llu B", size);
+        s = std::format(L"{} B", size);
     else if(size < 1024llu * 1024)
-        swprintf_s(s, L"%.2f KB", size / 1024.);
+        s = std::format(L"{:.2f} KB", size / 1024.);
     else if(size < 1024llu * 1024 * 1024)
-        swprintf_s(s, L"%.2f MB", size / (1024. * 1024.));
+        s = std::format(L"{:.2f} MB", size / (1024. * 1024.));
     else if(size < 1024llu * 1024 * 1024 * 1024)
-        swprintf_s(s, L"%.2f GB", size / (1024. * 1024. * 1024.));
+        s = std::format(L"{:.2f} GB", size / (1024. * 1024. * 1024.));
     else if(size < 1024llu * 1024 * 1024 * 1024 * 1024)
-        swprintf_s(s, L"%.2f TB", size / (1024. * 1024. * 1024. * 1024.));
+        s = std::format(L"{:.2f} TB", size / (1024. * 1024. * 1024. * 1024.));
     return s;
 }
 
+#ifdef _WIN32
+
 wstring StrToWstr(const char* str, uint32_t codePage)
 {
     if(!str || !*str)
@@ -68,6 +70,145 @@ wstring GuidToStr(const GUID& guid)
     return { str };
 }
 
+#endif // #ifdef _WIN32
+
+wstring Utf8ToWstr(std::string_view str)
+{
+    wstring result;
+    result.reserve(str.length());
+    for(size_t i = 0; i < str.length();)
+    {
+        const uint8_t lead = (uint8_t)str[i];
+        const size_t length = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3
+            : (lead & 0xF8) == 0xF0 ? 4 : 0;
+        uint32_t codePoint = length == 1 ? lead : length == 2 ? lead & 0x1F : length == 3 ? lead & 0x0F : lead & 0x07;
+        bool valid = length > 0 && i + length <= str.length();
+        for(size_t j = 1; valid && j < length; ++j)
+        {
+            const uint8_t continuation = (uint8_t)str[i + j];
+            valid = (continuation & 0xC0) == 0x80;
+            codePoint = (codePoint << 6) | (continuation & 0x3F);
+        }
+        if(!valid || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+        {
+            // Invalid sequence is replaced with U+FFFD, one byte at a time.
+            result += L'\xFFFD';
+            ++i;
+            continue;
+        }
+        if constexpr(sizeof(wchar_t) == 2)
+        {
+            if(codePoint >= 0x10000)
+            {
+                result += (wchar_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+                result += (wchar_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+                i += length;
+                continue;
+            }
+        }
+        result += (wchar_t)codePoint;
+        i += length;
+    }
+    return result;
+}
+
+string WstrToUtf8(std::wstring_view str)
+{
+    string result;
+    result.reserve(str.length());
+    for(size_t i = 0; i < str.length(); ++i)
+    {
+        uint32_t codePoint = (uint32_t)str[i];
+        if constexpr(sizeof(wchar_t) == 2)
+        {
+            if(codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < str.length() && str[i + 1] >= 0xDC00 &&
+                str[i + 1] <= 0xDFFF)
+            {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + ((uint32_t)str[i + 1] - 0xDC00);
+                ++i;
+            }
+        }
+        if(codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            codePoint = 0xFFFD;
+        if(codePoint < 0x80)
+            result += (char)codePoint;
+        else if(codePoint < 0x800)
+        {
+            result += (char)(0xC0 | (codePoint >> 6));
+            result += (char)(0x80 | (codePoint & 0x3F));
+        }
+        else if(codePoint < 0x10000)
+        {
+            result += (char)(0xE0 | (codePoint >> 12));
+            result += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            result += (char)(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            result += (char)(0xF0 | (codePoint >> 18));
+            result += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+            result += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            result += (char)(0x80 | (codePoint & 0x3F));
+        }
+    }
+    return result;
+}
+
+std::u16string WstrToUtf16(std::wstring_view str)
+{
+    if constexpr(sizeof(wchar_t) == 2)
+        return std::u16string(str.begin(), str.end());
+    std::u16string result;
+    result.reserve(str.length());
+    for(wchar_t ch : str)
+    {
+        uint32_t codePoint = (uint32_t)ch;
+        if(codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            codePoint = 0xFFFD;
+        if(codePoint >= 0x10000)
+        {
+            result += (char16_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+            result += (char16_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+        }
+        else
+            result += (char16_t)codePoint;
+    }
+    return result;
+}
+
+wstring Utf16ToWstr(std::u16string_view str)
+{
+    if constexpr(sizeof(wchar_t) == 2)
+        return wstring(str.begin(), str.end());
+    wstring result;
+    result.reserve(str.length());
+    for(size_t i = 0; i < str.length(); ++i)
+    {
+        uint32_t codePoint = str[i];
+        if(codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < str.length() && str[i + 1] >= 0xDC00 &&
+            str[i + 1] <= 0xDFFF)
+        {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + ((uint32_t)str[i + 1] - 0xDC00);
+            ++i;
+        }
+        else if(codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            codePoint = 0xFFFD;
+        result += (wchar_t)codePoint;
+    }
+    return result;
+}
+
+uint64_t CalculateHash(const void* data, size_t byteCount, uint64_t hash)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for(size_t i = 0; i < byteCount; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // class CmdLineParser
 
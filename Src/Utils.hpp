@@ -14,6 +14,14 @@ extern const char* const PROGRAM_NAME_ANSI;
 extern const wchar_t* const PROGRAM_VERSION;
 extern const uint32_t PROGRAM_VERSION_NUMBER;
 
+// VendorIDs used for deciding whether to use Vendor specific APIs with each device
+enum VENDOR_ID
+{
+    VENDOR_ID_AMD = 0x1002,
+    VENDOR_ID_NVIDIA = 0x10de,
+    VENDOR_ID_INTEL = 0x8086
+};
+
 inline bool IsStrEmpty(const char* str)
 {
     return str == nullptr || *str == '\0';
@@ -24,12 +32,33 @@ inline bool IsStrEmpty(const wchar_t* str)
 }
 
 wstring SizeToStr(uint64_t size);
+
+#ifdef _WIN32
+
 // As codePage use e.g. CP_ACP (native Windows), CP_UTF8.
 wstring StrToWstr(const char* str, uint32_t codePage);
 string WstrToStr(const wchar_t* str, uint32_t codePage);
 
 wstring GuidToStr(const GUID& guid);
 
+inline uint64_t LuidToUint64(const LUID& luid)
+{
+    return ((uint64_t)(uint32_t)luid.HighPart << 32) | luid.LowPart;
+}
+
+#endif // #ifdef _WIN32
+
+// Same as StrToWstr, WstrToStr with CP_UTF8, for code that also builds on other platforms, where wchar_t is UTF-32
+// instead of UTF-16. Invalid sequences become U+FFFD.
+wstring Utf8ToWstr(std::string_view str);
+string WstrToUtf8(std::wstring_view str);
+// UTF-16 on every platform, for binary files written on one machine and read on another.
+std::u16string WstrToUtf16(std::wstring_view str);
+wstring Utf16ToWstr(std::u16string_view str);
+
+// 64-bit FNV-1a. Pass result of previous call as `hash` to continue hashing.
+uint64_t CalculateHash(const void* data, size_t byteCount, uint64_t hash = 0xCBF29CE484222325ull);
+
 class CmdLineParser
 {
 public:
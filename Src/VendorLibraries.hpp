@@ -0,0 +1,97 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Libraries of GPU vendors, initialized on first use and only for the vendors of the adapters inspected. Depends only
+// on Timings and the C++ standard library, so the startup can be tested with stub libraries.
+
+#include "Timings.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Vendors of the adapters inspected. Filled before any library is used.
+class VendorLibrarySelection
+{
+public:
+    // force: libraries are used for adapters of any vendor, like with --ForceVendorAPI.
+    // disabled: no library is used, like with --PureD3D12.
+    VendorLibrarySelection(bool force, bool disabled)
+        : m_Force(force)
+        , m_Disabled(disabled)
+    {
+    }
+
+    void AddAdapterVendor(uint32_t vendorId)
+    {
+        m_AdapterVendorIds.push_back(vendorId);
+    }
+
+    // Library of the vendor prints data of its adapters. Without adapters, no library is needed, even if forced.
+    bool IsVendorNeeded(uint32_t vendorId) const
+    {
+        if(!IsAnyVendorNeeded())
+            return false;
+        return m_Force ||
+            std::find(m_AdapterVendorIds.begin(), m_AdapterVendorIds.end(), vendorId) != m_AdapterVendorIds.end();
+    }
+    // Library of any vendor, like Vulkan, prints data of the adapters.
+    bool IsAnyVendorNeeded() const
+    {
+        return !m_Disabled && !m_AdapterVendorIds.empty();
+    }
+
+private:
+    const bool m_Force;
+    const bool m_Disabled;
+    std::vector<uint32_t> m_AdapterVendorIds;
+};
+
+// Library created by the first call to Get that needs it, on whichever thread that is, so Get is thread-safe. The
+// creation is timed as a phase of the recorder given to Get, not of the current one, as it is shared by all adapters.
+template <typename T>
+class LazyVendorLibrary
+{
+public:
+    // timingName must stay valid, e.g. a string literal.
+    LazyVendorLibrary(const wchar_t* timingName)
+        : m_TimingName(timingName)
+    {
+    }
+    LazyVendorLibrary(const LazyVendorLibrary&) = delete;
+    LazyVendorLibrary& operator=(const LazyVendorLibrary&) = delete;
+
+    // Returns null if the library is not needed. Only the first call decides, later ones return the same. create is
+    // called at most once, and other threads wait for it, so it can also register what the library reports.
+    T* Get(bool needed, TimingRecorder* timings, const std::function<std::unique_ptr<T>()>& create)
+    {
+        std::call_once(m_InitFlag, [&]() {
+            if(needed)
+            {
+                TimingScope timing(timings, m_TimingName);
+                m_Object = create();
+            }
+        });
+        return m_Object.get();
+    }
+    T* Get(bool needed, TimingRecorder* timings)
+    {
+        return Get(needed, timings, []() { return std::make_unique<T>(); });
+    }
+
+private:
+    const wchar_t* const m_TimingName;
+    std::once_flag m_InitFlag;
+    std::unique_ptr<T> m_Object;
+};
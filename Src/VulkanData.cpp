@@ -9,7 +9,7 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "VulkanData.hpp"
 
-#include "Enums.hpp"
+#include "EnumItems.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
 #include "Utils.hpp"
 
@@ -57,7 +57,9 @@ ENUM_BEGIN(VkPhysicalDeviceType)
     ENUM_ITEM(VK_PHYSICAL_DEVICE_TYPE_CPU)
 ENUM_END(VkPhysicalDeviceType)
 
+#ifdef _WIN32
 static HMODULE g_VulkanModule;
+#endif
 
 static PFN_vkGetInstanceProcAddr g_vkGetInstanceProcAddr;
 static PFN_vkCreateInstance g_vkCreateInstance;
@@ -74,6 +76,9 @@ struct PhysicalDevicePropertySet
     VkPhysicalDeviceProperties2 properties2;
     VkPhysicalDeviceVulkan12Properties vulkan12Properties;
     VkPhysicalDeviceIDProperties IDProperties;
+    // properties2 and IDProperties are queried for all devices, to match them with adapters. The rest is queried only
+    // for devices that get printed.
+    bool allPropertiesQueried;
 };
 static std::vector<PhysicalDevicePropertySet> g_PhysicalDeviceProperties;
 
@@ -84,32 +89,32 @@ static inline void AddToPnextChain(DstStruct* dst, SrcStruct* src)
     dst->pNext = src;
 }
 
-static bool FindPhysicalDevice(const DXGI_ADAPTER_DESC& adapterDesc, size_t& outIndex)
+static void QueryPhysicalDeviceProperties(size_t physicalDeviceIndex, bool allProperties)
 {
-    outIndex = SIZE_MAX;
-    // Match LUID
-    for(size_t i = 0; i < g_PhysicalDeviceProperties.size(); ++i)
-    {
-        if(g_PhysicalDeviceProperties[i].IDProperties.deviceLUIDValid &&
-            memcmp(g_PhysicalDeviceProperties[i].IDProperties.deviceLUID, &adapterDesc.AdapterLuid, VK_LUID_SIZE) == 0)
-        {
-            outIndex = i;
-            return true;
-        }
-    }
-    // Match VendorID and DeviceID
-    for(size_t i = 0; i < g_PhysicalDeviceProperties.size(); ++i)
+    PhysicalDevicePropertySet& propSet = g_PhysicalDeviceProperties[physicalDeviceIndex];
+    propSet.properties2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+    propSet.IDProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
+    AddToPnextChain(&propSet.properties2, &propSet.IDProperties);
+    if(allProperties && g_ApiVersion >= VK_API_VERSION_1_2)
     {
-        if(g_PhysicalDeviceProperties[i].properties2.properties.vendorID == adapterDesc.VendorId &&
-            g_PhysicalDeviceProperties[i].properties2.properties.deviceID == adapterDesc.DeviceId)
-        {
-            if(outIndex != SIZE_MAX)
-                // Multiple matches found.
-                return false;
-            outIndex = i;
-        }
+        propSet.vulkan12Properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES };
+        AddToPnextChain(&propSet.properties2, &propSet.vulkan12Properties);
     }
-    return outIndex != SIZE_MAX;
+    g_vkGetPhysicalDeviceProperties2(g_PhysicalDevices[physicalDeviceIndex], &propSet.properties2);
+    propSet.allPropertiesQueried = allProperties;
+}
+
+// Returns vkGetInstanceProcAddr of the Vulkan loader, or null if it is not available.
+static void* LoadVulkanLoader()
+{
+#ifdef _WIN32
+    g_VulkanModule = LoadLibrary(L"vulkan-1.dll");
+    if(!g_VulkanModule)
+        return nullptr;
+    return (void*)GetProcAddress(g_VulkanModule, "vkGetInstanceProcAddr");
+#else
+    return nullptr;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,21 +126,18 @@ void Vulkan_Initialize_RAII::PrintStaticParams()
 }
 
 Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
+    : Vulkan_Initialize_RAII(LoadVulkanLoader())
 {
-    g_VulkanModule = LoadLibrary(L"vulkan-1.dll");
-    if(!g_VulkanModule)
-        return;
-
-    g_vkGetInstanceProcAddr = PFN_vkGetInstanceProcAddr(GetProcAddress(g_VulkanModule, "vkGetInstanceProcAddr"));
-    g_vkCreateInstance = PFN_vkCreateInstance(GetProcAddress(g_VulkanModule, "vkCreateInstance"));
-    g_vkDestroyInstance = PFN_vkDestroyInstance(GetProcAddress(g_VulkanModule, "vkDestroyInstance"));
-    g_vkEnumeratePhysicalDevices =
-        PFN_vkEnumeratePhysicalDevices(GetProcAddress(g_VulkanModule, "vkEnumeratePhysicalDevices"));
-    g_vkGetPhysicalDeviceProperties2 =
-        PFN_vkGetPhysicalDeviceProperties2(GetProcAddress(g_VulkanModule, "vkGetPhysicalDeviceProperties2"));
+}
 
-    if(!g_vkGetInstanceProcAddr || !g_vkCreateInstance || !g_vkDestroyInstance || !g_vkEnumeratePhysicalDevices ||
-        !g_vkGetPhysicalDeviceProperties2)
+Vulkan_Initialize_RAII::Vulkan_Initialize_RAII(void* vkGetInstanceProcAddr)
+{
+    // Other functions are taken from the loader through vkGetInstanceProcAddr, like the Vulkan specification says.
+    g_vkGetInstanceProcAddr = PFN_vkGetInstanceProcAddr(vkGetInstanceProcAddr);
+    if(!g_vkGetInstanceProcAddr)
+        return;
+    g_vkCreateInstance = PFN_vkCreateInstance(g_vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkCreateInstance"));
+    if(!g_vkCreateInstance)
         return;
 
     VkApplicationInfo appInfo = { .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -154,6 +156,14 @@ Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
     }
     g_ApiVersion = appInfo.apiVersion;
 
+    g_vkDestroyInstance = PFN_vkDestroyInstance(g_vkGetInstanceProcAddr(g_vkInstance, "vkDestroyInstance"));
+    g_vkEnumeratePhysicalDevices =
+        PFN_vkEnumeratePhysicalDevices(g_vkGetInstanceProcAddr(g_vkInstance, "vkEnumeratePhysicalDevices"));
+    g_vkGetPhysicalDeviceProperties2 =
+        PFN_vkGetPhysicalDeviceProperties2(g_vkGetInstanceProcAddr(g_vkInstance, "vkGetPhysicalDeviceProperties2"));
+    if(!g_vkDestroyInstance || !g_vkEnumeratePhysicalDevices || !g_vkGetPhysicalDeviceProperties2)
+        return;
+
     uint32_t physDeviceCount = 0;
     if(g_vkEnumeratePhysicalDevices(g_vkInstance, &physDeviceCount, nullptr) != VK_SUCCESS)
         return;
@@ -166,35 +176,58 @@ Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
 
     g_PhysicalDeviceProperties.resize(physDeviceCount);
     for(uint32_t i = 0; i < physDeviceCount; ++i)
-    {
-        g_PhysicalDeviceProperties[i].properties2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
-        g_PhysicalDeviceProperties[i].IDProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
-        g_PhysicalDeviceProperties[i].vulkan12Properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES };
-        AddToPnextChain(&g_PhysicalDeviceProperties[i].properties2, &g_PhysicalDeviceProperties[i].IDProperties);
-        if(g_ApiVersion >= VK_API_VERSION_1_2)
-            AddToPnextChain(
-                &g_PhysicalDeviceProperties[i].properties2, &g_PhysicalDeviceProperties[i].vulkan12Properties);
-        g_vkGetPhysicalDeviceProperties2(g_PhysicalDevices[i], &g_PhysicalDeviceProperties[i].properties2);
-    }
+        QueryPhysicalDeviceProperties(i, false);
 
     m_Initialized = true;
 }
 
 Vulkan_Initialize_RAII::~Vulkan_Initialize_RAII()
 {
-    if(g_vkInstance)
+    if(g_vkInstance && g_vkDestroyInstance)
         g_vkDestroyInstance(g_vkInstance, nullptr);
+    g_vkInstance = VK_NULL_HANDLE;
+    g_ApiVersion = 0;
+    g_PhysicalDevices.clear();
+    g_PhysicalDeviceProperties.clear();
+    g_vkCreateInstance = nullptr;
+    g_vkDestroyInstance = nullptr;
+    g_vkEnumeratePhysicalDevices = nullptr;
+    g_vkGetPhysicalDeviceProperties2 = nullptr;
+}
+
+void Vulkan_Initialize_RAII::GetPhysicalDeviceIdentities(std::vector<AdapterIdentity>& outIdentities) const
+{
+    assert(IsInitialized());
+    outIdentities.resize(g_PhysicalDeviceProperties.size());
+    for(size_t i = 0; i < g_PhysicalDeviceProperties.size(); ++i)
+    {
+        const PhysicalDevicePropertySet& propSet = g_PhysicalDeviceProperties[i];
+        AdapterIdentity& identity = outIdentities[i];
+        identity = { .m_VendorId = propSet.properties2.properties.vendorID,
+            .m_DeviceId = propSet.properties2.properties.deviceID };
+        if(propSet.IDProperties.deviceLUIDValid)
+        {
+            // Bytes of LUID, which on little-endian Windows read as uint64_t give the same value as LuidToUint64.
+            static_assert(VK_LUID_SIZE == sizeof(uint64_t));
+            uint64_t luid = 0;
+            memcpy(&luid, propSet.IDProperties.deviceLUID, sizeof(luid));
+            identity.m_Luid = luid;
+        }
+    }
 }
 
-void Vulkan_Initialize_RAII::PrintData(const DXGI_ADAPTER_DESC& adapterDesc)
+void Vulkan_Initialize_RAII::PrintData(size_t physicalDeviceIndex)
 {
     assert(IsInitialized());
+    assert(physicalDeviceIndex < g_PhysicalDeviceProperties.size());
     ReportFormatter& formatter = ReportFormatter::GetInstance();
 
-    size_t physDevIndex = SIZE_MAX;
-    if(!FindPhysicalDevice(adapterDesc, physDevIndex))
+    if(!IsReportScopeNeeded(L"VkPhysicalDeviceProperties") && !IsReportScopeNeeded(L"VkPhysicalDeviceIDProperties") &&
+        !IsReportScopeNeeded(L"VkPhysicalDeviceVulkan12Properties"))
         return;
-    const PhysicalDevicePropertySet& propSet = g_PhysicalDeviceProperties[physDevIndex];
+    if(!g_PhysicalDeviceProperties[physicalDeviceIndex].allPropertiesQueried)
+        QueryPhysicalDeviceProperties(physicalDeviceIndex, true);
+    const PhysicalDevicePropertySet& propSet = g_PhysicalDeviceProperties[physicalDeviceIndex];
 
     {
         const VkPhysicalDeviceProperties& props = propSet.properties2.properties;
@@ -207,7 +240,7 @@ void Vulkan_Initialize_RAII::PrintData(const DXGI_ADAPTER_DESC& adapterDesc)
         formatter.AddFieldVendorId(L"vendorID", props.vendorID);
         formatter.AddFieldHex32(L"deviceID", props.deviceID);
         formatter.AddFieldEnum(L"deviceType", props.deviceType, Enum_VkPhysicalDeviceType);
-        formatter.AddFieldString(L"deviceName", StrToWstr(props.deviceName, CP_UTF8).c_str());
+        formatter.AddFieldString(L"deviceName", Utf8ToWstr(props.deviceName).c_str());
     }
 
     {
@@ -224,8 +257,8 @@ void Vulkan_Initialize_RAII::PrintData(const DXGI_ADAPTER_DESC& adapterDesc)
         const VkPhysicalDeviceVulkan12Properties& vulkan12Props = propSet.vulkan12Properties;
         ReportScopeObject region(L"VkPhysicalDeviceVulkan12Properties");
         formatter.AddFieldEnum(L"driverID", vulkan12Props.driverID, Enum_VkDriverId);
-        formatter.AddFieldString(L"driverName", StrToWstr(vulkan12Props.driverName, CP_UTF8).c_str());
-        formatter.AddFieldString(L"driverInfo", StrToWstr(vulkan12Props.driverInfo, CP_UTF8).c_str());
+        formatter.AddFieldString(L"driverName", Utf8ToWstr(vulkan12Props.driverName).c_str());
+        formatter.AddFieldString(L"driverInfo", Utf8ToWstr(vulkan12Props.driverInfo).c_str());
     }
 }
 
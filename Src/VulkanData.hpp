@@ -9,6 +9,8 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
+#include "AdapterIndex.hpp"
+
 // Macro set by Cmake.
 #if USE_VULKAN
 
@@ -18,15 +20,22 @@ public:
     // Prints parameters related to Vulkan itself, regardless of whether intialization succeeded.
     static void PrintStaticParams();
 
+    // Uses the Vulkan loader, vulkan-1.dll. Not available on other platforms than Windows.
     Vulkan_Initialize_RAII();
+    // Uses given vkGetInstanceProcAddr instead, e.g. of a stub loader in tests. Only one object can exist at a time.
+    explicit Vulkan_Initialize_RAII(void* vkGetInstanceProcAddr);
     ~Vulkan_Initialize_RAII();
     bool IsInitialized() const
     {
         return m_Initialized;
     }
 
-    // Prints structs from Vulkan related to the specific adapter.
-    void PrintData(const DXGI_ADAPTER_DESC& adapterDesc);
+    // One identity per physical device, to be matched with DXGI adapters by LUID, then by vendor and device ID.
+    void GetPhysicalDeviceIdentities(std::vector<AdapterIdentity>& outIdentities) const;
+    // Prints structs from Vulkan related to the specific adapter. Properties not needed for the identity are queried
+    // on the first call for the device. Not thread-safe.
+    // physicalDeviceIndex is index of the identity returned by GetPhysicalDeviceIdentities.
+    void PrintData(size_t physicalDeviceIndex);
 
 private:
     bool m_Initialized = false;
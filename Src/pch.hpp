@@ -27,41 +27,11 @@ For more information, see files README.md, LICENSE.txt.
 #include <wrl/client.h> // for ComPtr
 #include <initguid.h> // for DEFINE_GUID
 
-#include <algorithm>
-#include <array>
-#include <exception>
-#include <format>
-#include <fstream>
-#include <iostream>
-#include <numeric>
-#include <optional>
-#include <set>
-#include <stack>
-#include <stdexcept>
-#include <string>
-#include <string_view>
-#include <unordered_map>
-#include <vector>
-
-#include <cassert>
-#include <cmath>
-#include <cstdint>
-#include <cstdio>
-#include <cstdlib>
-#include <cwchar>
-#include <cwctype>
+// Everything that doesn't depend on WinAPI, shared with tools and tests built on other platforms.
+#include "PortablePch.hpp"
 
 using Microsoft::WRL::ComPtr;
-using std::string;
-using std::wstring;
 
 #define CHECK_HR(expr)		do { HRESULT hr__ = (expr); if(FAILED(hr__)) { \
 		throw std::runtime_error(std::format("{} returned 0x{:08X}", #expr, (uint32_t)hr__)); \
 	} } while(false)
-
-static const int PROGRAM_EXIT_SUCCESS = 0;
-static const int PROGRAM_EXIT_ERROR_INIT = -1;
-static const int PROGRAM_EXIT_ERROR_COMMAND_LINE = -2;
-static const int PROGRAM_EXIT_ERROR_EXCEPTION = -3;
-static const int PROGRAM_EXIT_ERROR_SEH_EXCEPTION = -4;
-static const int PROGRAM_EXIT_ERROR_D3D12 = -5;
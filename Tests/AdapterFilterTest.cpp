@@ -0,0 +1,188 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks parsing of --Adapter filters and their evaluation against made-up adapters.
+
+#include "AdapterFilter.hpp"
+#include "TestUtils.hpp"
+
+#include <stdexcept>
+
+static const AdapterFilterInput ADAPTER_NVIDIA = { .m_Description = L"NVIDIA GeForce RTX 4090",
+    .m_VendorName = L"NVIDIA",
+    .m_VendorId = 0x10DE,
+    .m_DeviceId = 0x2684,
+    .m_Luid = 0x0000000100000AB3,
+    .m_DedicatedVideoMemory = 24ull << 30 };
+static const AdapterFilterInput ADAPTER_INTEL = { .m_Description = L"Intel(R) UHD Graphics 770",
+    .m_VendorName = L"Intel",
+    .m_VendorId = 0x8086,
+    .m_DeviceId = 0x4680,
+    .m_Luid = 0x000000000001A2B3,
+    .m_DedicatedVideoMemory = 128ull << 20 };
+static const AdapterFilterInput ADAPTER_AMD = { .m_Description = L"AMD Radeon RX 7900 XTX",
+    .m_VendorName = L"AMD/ATI",
+    .m_VendorId = 0x1002,
+    .m_DeviceId = 0x744C,
+    .m_Luid = 5,
+    .m_DedicatedVideoMemory = 24ull << 30 };
+static const AdapterFilterInput ADAPTER_WARP = { .m_Description = L"Microsoft Basic Render Driver",
+    .m_VendorName = L"Microsoft",
+    .m_VendorId = 0x1414,
+    .m_DeviceId = 0x008C,
+    .m_Luid = 7,
+    .m_Flags = ADAPTER_FILTER_FLAG_SOFTWARE };
+static const AdapterFilterInput ADAPTER_UNKNOWN_VENDOR = { .m_Description = L"Some GPU",
+    .m_VendorId = 0x1234,
+    .m_DeviceId = 0x0001,
+    .m_Luid = 9,
+    .m_Flags = ADAPTER_FILTER_FLAG_REMOTE };
+
+static bool Matches(std::wstring_view terms, const AdapterFilterInput& adapter)
+{
+    AdapterFilter filter;
+    filter.AddTerms(terms);
+    return filter.Matches(adapter);
+}
+
+// Message of the exception thrown by AddTerms, or empty if it didn't throw.
+static std::string GetError(std::wstring_view terms)
+{
+    try
+    {
+        AdapterFilter filter;
+        filter.AddTerms(terms);
+    }
+    catch(const std::runtime_error& ex)
+    {
+        return ex.what();
+    }
+    return {};
+}
+
+static void TestVendor()
+{
+    CHECK(Matches(L"vendor:nvidia", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"vendor:nvidia", ADAPTER_INTEL));
+    // Whole name or any of its parts, not case-sensitive, but not a prefix.
+    CHECK(Matches(L"vendor:AMD", ADAPTER_AMD));
+    CHECK(Matches(L"vendor:ati", ADAPTER_AMD));
+    CHECK(Matches(L"vendor:amd/ati", ADAPTER_AMD));
+    CHECK(!Matches(L"vendor:am", ADAPTER_AMD));
+    CHECK(!Matches(L"vendor:nvidia", ADAPTER_UNKNOWN_VENDOR));
+
+    CHECK(Matches(L"vendor:0x10DE", ADAPTER_NVIDIA));
+    CHECK(Matches(L"vendor:0x1234", ADAPTER_UNKNOWN_VENDOR));
+    CHECK(!Matches(L"vendor:0x10DE", ADAPTER_AMD));
+}
+
+static void TestDeviceAndLuid()
+{
+    CHECK(Matches(L"device:2684", ADAPTER_NVIDIA));
+    CHECK(Matches(L"device:0x2684", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"device:2685", ADAPTER_NVIDIA));
+
+    CHECK(Matches(L"luid:00000000-0001A2B3", ADAPTER_INTEL));
+    CHECK(Matches(L"luid:00000001-00000ab3", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"luid:00000000-0001A2B3", ADAPTER_NVIDIA));
+}
+
+static void TestName()
+{
+    CHECK(Matches(L"name:*RTX*", ADAPTER_NVIDIA));
+    CHECK(Matches(L"name:*rtx 40?0", ADAPTER_NVIDIA));
+    CHECK(Matches(L"name:NVIDIA GeForce RTX 4090", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"name:NVIDIA", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"name:*RTX*", ADAPTER_AMD));
+    // The last * takes more characters after a mismatch.
+    CHECK(Matches(L"name:*x*x", ADAPTER_AMD));
+}
+
+static void TestDedicatedUnits()
+{
+    CHECK(Matches(L"dedicated>=8GiB", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"dedicated>=8GiB", ADAPTER_INTEL));
+    CHECK(Matches(L"dedicated < 1 GiB", ADAPTER_INTEL));
+    CHECK(Matches(L"Dedicated==128MiB", ADAPTER_INTEL));
+    CHECK(Matches(L"dedicated==131072KiB", ADAPTER_INTEL));
+    CHECK(Matches(L"dedicated==134217728b", ADAPTER_INTEL));
+    CHECK(Matches(L"dedicated==134217728", ADAPTER_INTEL));
+    CHECK(Matches(L"dedicated<=24GIB", ADAPTER_AMD));
+    CHECK(!Matches(L"dedicated<24GiB", ADAPTER_AMD));
+    CHECK(Matches(L"dedicated>16GiB", ADAPTER_AMD));
+    CHECK(Matches(L"dedicated<1TiB", ADAPTER_AMD));
+    CHECK(Matches(L"dedicated!=0b", ADAPTER_AMD));
+    CHECK(!Matches(L"dedicated>0", ADAPTER_WARP));
+}
+
+static void TestFlagsAndNegation()
+{
+    CHECK(Matches(L"software", ADAPTER_WARP));
+    CHECK(!Matches(L"software", ADAPTER_NVIDIA));
+    CHECK(Matches(L"!software", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"!software", ADAPTER_WARP));
+    CHECK(Matches(L"remote", ADAPTER_UNKNOWN_VENDOR));
+    CHECK(!Matches(L"remote", ADAPTER_WARP));
+
+    CHECK(Matches(L"!vendor:intel", ADAPTER_AMD));
+    CHECK(!Matches(L"!vendor:intel", ADAPTER_INTEL));
+    CHECK(Matches(L"! name:microsoft*", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"!dedicated>=8GiB", ADAPTER_NVIDIA));
+}
+
+static void TestAllTermsMustMatch()
+{
+    CHECK(Matches(L"vendor:nvidia, dedicated>=8GiB, !software", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"vendor:nvidia,dedicated>=32GiB", ADAPTER_NVIDIA));
+    CHECK(!Matches(L"vendor:nvidia,vendor:amd", ADAPTER_NVIDIA));
+
+    // Terms can be added by multiple options.
+    AdapterFilter filter;
+    CHECK(filter.IsEmpty());
+    CHECK(filter.Matches(ADAPTER_WARP));
+    filter.AddTerms(L"!software");
+    filter.AddTerms(L"dedicated>=1GiB");
+    CHECK(!filter.IsEmpty());
+    CHECK(filter.Matches(ADAPTER_AMD));
+    CHECK(!filter.Matches(ADAPTER_INTEL));
+    CHECK(!filter.Matches(ADAPTER_WARP));
+}
+
+static void TestErrors()
+{
+    CHECK(GetError(L"vendor:") == "Adapter filter \"vendor:\": missing value.");
+    CHECK(GetError(L"foo:bar") == "Adapter filter \"foo:bar\": unknown key.");
+    CHECK(GetError(L"hardware") == "Adapter filter \"hardware\": unknown term.");
+    CHECK(GetError(L"dedicated") == "Adapter filter \"dedicated\": unknown term.");
+    CHECK(GetError(L"dedicated>=8XB") == "Adapter filter \"dedicated>=8XB\": invalid size.");
+    // Overflows 64 bits.
+    CHECK(GetError(L"dedicated>=99999999999TiB") == "Adapter filter \"dedicated>=99999999999TiB\": invalid size.");
+    CHECK(GetError(L"device:xyz") == "Adapter filter \"device:xyz\": invalid device ID.");
+    CHECK(GetError(L"vendor:0xG") == "Adapter filter \"vendor:0xG\": invalid vendor ID.");
+    CHECK(GetError(L"luid:123") == "Adapter filter \"luid:123\": LUID must be like 00000000-0001A2B3.");
+    CHECK(GetError(L"luid:100000000-0") == "Adapter filter \"luid:100000000-0\": LUID must be like 00000000-0001A2B3.");
+    // Whole parameter in the message, as the empty term has no text.
+    CHECK(GetError(L"software,,remote") == "Adapter filter \"software,,remote\": empty term.");
+    CHECK(GetError(L"") == "Adapter filter \"\": empty term.");
+    // Characters that are not ASCII are replaced.
+    CHECK(GetError(L"name\u00E9") == "Adapter filter \"name?\": unknown term.");
+    CHECK(GetError(L"vendor:nvidia, !software").empty());
+}
+
+int main()
+{
+    TestVendor();
+    TestDeviceAndLuid();
+    TestName();
+    TestDedicatedUnits();
+    TestFlagsAndNegation();
+    TestAllTermsMustMatch();
+    TestErrors();
+    return GetTestExitCode();
+}
@@ -0,0 +1,142 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks matching of adapters against fake identity tables of the vendor sources.
+
+#include "AdapterIndex.hpp"
+#include "TestUtils.hpp"
+
+static const uint32_t VENDOR_NVIDIA = 0x10DE;
+static const uint32_t VENDOR_AMD = 0x1002;
+
+static bool IsFound(const AdapterMatch& match, size_t index)
+{
+    return match.m_Result == AdapterMatch::RESULT_FOUND && match.m_Index == index;
+}
+
+static void TestMatchByLuid()
+{
+    AdapterIndex index;
+    index.SetSourceDevices(ADAPTER_SOURCE_NVAPI,
+        { { .m_Luid = 20 }, { .m_Luid = 10 }, { .m_Luid = 30 }, { .m_Luid = 30 } },
+        { ADAPTER_MATCH_KEY_LUID });
+    index.AddAdapter({ .m_Luid = 10, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2684 });
+    index.AddAdapter({ .m_Luid = 30, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2684 });
+    index.AddAdapter({ .m_Luid = 40, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2684 });
+
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_NVAPI), 1));
+    CHECK(index.Find(30, ADAPTER_SOURCE_NVAPI).m_Result == AdapterMatch::RESULT_AMBIGUOUS);
+    // Same vendor and device, but the source matches only by LUID.
+    CHECK(index.Find(40, ADAPTER_SOURCE_NVAPI).m_Result == AdapterMatch::RESULT_NONE);
+}
+
+static void TestFallbackToVendorDevice()
+{
+    AdapterIndex index;
+    index.SetSourceDevices(ADAPTER_SOURCE_VULKAN,
+        {
+            { .m_Luid = 10, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2684 },
+            { .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x744C },
+            { .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2704 },
+            { .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2704 },
+        },
+        { ADAPTER_MATCH_KEY_LUID, ADAPTER_MATCH_KEY_VENDOR_DEVICE });
+    index.AddAdapter({ .m_Luid = 10, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2704 });
+    index.AddAdapter({ .m_Luid = 20, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x744C });
+    index.AddAdapter({ .m_Luid = 30, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2704 });
+
+    // LUID is tried first and decides, even though vendor and device would match other devices.
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_VULKAN), 0));
+    CHECK(IsFound(index.Find(20, ADAPTER_SOURCE_VULKAN), 1));
+    // Two identical GPUs without LUID can't be told apart.
+    CHECK(index.Find(30, ADAPTER_SOURCE_VULKAN).m_Result == AdapterMatch::RESULT_AMBIGUOUS);
+}
+
+static void TestMatchByRevision()
+{
+    AdapterIndex index;
+    index.SetSourceDevices(ADAPTER_SOURCE_AGS,
+        {
+            { .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x73BF, .m_RevisionId = 0xC1 },
+            { .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x73BF, .m_RevisionId = 0xC3 },
+        },
+        { ADAPTER_MATCH_KEY_VENDOR_DEVICE_REVISION });
+    index.AddAdapter({ .m_Luid = 10, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x73BF, .m_RevisionId = 0xC3 });
+    index.AddAdapter({ .m_Luid = 20, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x73BF, .m_RevisionId = 0xC0 });
+    index.AddAdapter({ .m_Luid = 30, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x73BF });
+
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_AGS), 1));
+    CHECK(index.Find(20, ADAPTER_SOURCE_AGS).m_Result == AdapterMatch::RESULT_NONE);
+    CHECK(index.Find(30, ADAPTER_SOURCE_AGS).m_Result == AdapterMatch::RESULT_NONE);
+}
+
+static void TestResolver()
+{
+    AdapterIndex index;
+    size_t resolverCalls = 0;
+    index.SetSourceResolver(ADAPTER_SOURCE_AMD_DEVICE_INFO, [&resolverCalls](const AdapterIdentity& adapter) {
+        ++resolverCalls;
+        if(adapter.m_VendorId == VENDOR_AMD && adapter.m_DeviceId == 0x744C)
+            return AdapterMatch{ AdapterMatch::RESULT_FOUND, 42 };
+        return AdapterMatch{};
+    });
+    index.AddAdapter({ .m_Luid = 10, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x744C });
+    index.AddAdapter({ .m_Luid = 20, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x744C });
+
+    // Resolved once when the adapter is added, not on every Find.
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_AMD_DEVICE_INFO), 42));
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_AMD_DEVICE_INFO), 42));
+    CHECK(index.Find(20, ADAPTER_SOURCE_AMD_DEVICE_INFO).m_Result == AdapterMatch::RESULT_NONE);
+    CHECK(resolverCalls == 2);
+}
+
+static void TestSourceRegisteredAfterAdapters()
+{
+    // Like a vendor library initialized on first use, after all adapters are known.
+    AdapterIndex index;
+    index.SetSourceDevices(ADAPTER_SOURCE_VULKAN, { { .m_Luid = 20 } }, { ADAPTER_MATCH_KEY_LUID });
+    index.AddAdapter({ .m_Luid = 10, .m_VendorId = VENDOR_NVIDIA, .m_DeviceId = 0x2684 });
+    index.AddAdapter({ .m_Luid = 20, .m_VendorId = VENDOR_AMD, .m_DeviceId = 0x744C });
+    CHECK(index.Find(10, ADAPTER_SOURCE_NVAPI).m_Result == AdapterMatch::RESULT_NONE);
+
+    index.SetSourceDevices(ADAPTER_SOURCE_NVAPI, { { .m_Luid = 30 }, { .m_Luid = 10 } }, { ADAPTER_MATCH_KEY_LUID });
+    CHECK(IsFound(index.Find(10, ADAPTER_SOURCE_NVAPI), 1));
+    CHECK(index.Find(20, ADAPTER_SOURCE_NVAPI).m_Result == AdapterMatch::RESULT_NONE);
+    // Matches of other sources stay.
+    CHECK(IsFound(index.Find(20, ADAPTER_SOURCE_VULKAN), 0));
+
+    index.SetSourceResolver(ADAPTER_SOURCE_AMD_DEVICE_INFO, [](const AdapterIdentity& adapter) {
+        return adapter.m_VendorId == VENDOR_AMD ? AdapterMatch{ AdapterMatch::RESULT_FOUND, 7 } : AdapterMatch{};
+    });
+    CHECK(IsFound(index.Find(20, ADAPTER_SOURCE_AMD_DEVICE_INFO), 7));
+    CHECK(index.Find(10, ADAPTER_SOURCE_AMD_DEVICE_INFO).m_Result == AdapterMatch::RESULT_NONE);
+}
+
+static void TestUnknownAdapterAndSource()
+{
+    AdapterIndex index;
+    index.SetSourceDevices(ADAPTER_SOURCE_NVAPI, { { .m_Luid = 10 } }, { ADAPTER_MATCH_KEY_LUID });
+    index.AddAdapter({ .m_Luid = 10 });
+
+    CHECK(index.Find(99, ADAPTER_SOURCE_NVAPI).m_Result == AdapterMatch::RESULT_NONE);
+    // Sources not registered don't match anything.
+    CHECK(index.Find(10, ADAPTER_SOURCE_VULKAN).m_Result == AdapterMatch::RESULT_NONE);
+    CHECK(index.Find(10, ADAPTER_SOURCE_VULKAN).m_Index == SIZE_MAX);
+}
+
+int main()
+{
+    TestMatchByLuid();
+    TestFallbackToVendorDevice();
+    TestMatchByRevision();
+    TestResolver();
+    TestSourceRegisteredAfterAdapters();
+    TestUnknownAdapterAndSource();
+    return GetTestExitCode();
+}
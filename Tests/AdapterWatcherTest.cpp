@@ -0,0 +1,181 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks change detection of --Watch with scripted adapters and reports flattened by FlatReportFormatter.
+
+#include "AdapterWatcher.hpp"
+#include "TestUtils.hpp"
+#include "EnumItems.hpp"
+#include "ReportFormatter/FlatReportFormatter.hpp"
+
+static const uint32_t VENDOR_NVIDIA = 0x10DE;
+
+enum FAKE_TIER
+{
+    FAKE_TIER_1 = 1,
+    FAKE_TIER_2 = 2,
+};
+
+ENUM_BEGIN(FAKE_TIER)
+    ENUM_ITEM(FAKE_TIER_1)
+    ENUM_ITEM(FAKE_TIER_2)
+ENUM_END(FAKE_TIER)
+
+static WatchedAdapter MakeAdapter(uint64_t luid, uint32_t deviceId, uint64_t umdVersion, uint32_t revision = 1)
+{
+    return { .m_Luid = luid,
+        .m_VendorId = VENDOR_NVIDIA,
+        .m_DeviceId = deviceId,
+        .m_SubSysId = 0x16F11043,
+        .m_Revision = revision,
+        .m_UmdVersion = umdVersion,
+        .m_Description = L"Fake GPU" };
+}
+
+// What probing the adapter would print, depending on its driver.
+static std::vector<ReportField> ProbeReport(FAKE_TIER tier, bool newField, uint32_t formatCount)
+{
+    FlatReportFormatter formatter;
+    formatter.PushObject(L"D3D12_OPTIONS");
+    formatter.AddFieldEnum(L"ResourceBindingTier", tier, Enum_FAKE_TIER);
+    formatter.AddFieldBool(L"TypedUAVLoadAdditionalFormats", true);
+    if(newField)
+        formatter.AddFieldUint32(L"NewField", 5);
+    formatter.PopScope();
+    formatter.PushArray(L"Formats");
+    for(uint32_t i = 0; i < formatCount; ++i)
+    {
+        formatter.PushArrayItem();
+        formatter.AddFieldHex32(L"Support1", 0x10 + i);
+        formatter.PopScope();
+    }
+    formatter.PopScope();
+    // Repeated scope names get a number.
+    formatter.PushObject(L"Format");
+    formatter.AddFieldUint32(L"Index", 1);
+    formatter.PopScope();
+    formatter.PushObject(L"Format");
+    formatter.AddFieldUint32(L"Index", 2);
+    formatter.PopScope();
+    return formatter.TakeFields();
+}
+
+static void TestFlattenedReport()
+{
+    const std::vector<ReportField> fields = ProbeReport(FAKE_TIER_1, false, 2);
+    CHECK(fields.size() == 6);
+    CHECK(fields[0].m_Path == L"D3D12_OPTIONS.ResourceBindingTier" && fields[0].m_Value == L"FAKE_TIER_1");
+    CHECK(fields[2].m_Path == L"Formats[0].Support1" && fields[2].m_Value == L"0x10");
+    CHECK(fields[3].m_Path == L"Formats[1].Support1");
+    CHECK(fields[4].m_Path == L"Format.Index" && fields[5].m_Path == L"Format#2.Index");
+}
+
+static void TestDriverUpdate()
+{
+    AdapterWatcher watcher;
+    std::vector<AdapterChange> changes = watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(2, 0x2704, 20) });
+    CHECK(changes.size() == 2);
+    CHECK(changes[0].m_Type == ADAPTER_CHANGE_ADDED && changes[1].m_Type == ADAPTER_CHANGE_ADDED);
+    CHECK(watcher.UpdateReport(1, ProbeReport(FAKE_TIER_1, false, 2)).empty());
+    CHECK(watcher.UpdateReport(2, ProbeReport(FAKE_TIER_1, false, 2)).empty());
+
+    // Nothing changed, so nothing needs to be probed.
+    CHECK(watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(2, 0x2704, 20) }).empty());
+
+    changes = watcher.Update({ MakeAdapter(1, 0x2684, 11), MakeAdapter(2, 0x2704, 20) });
+    CHECK(changes.size() == 1);
+    CHECK(changes[0].m_Type == ADAPTER_CHANGE_DRIVER && changes[0].m_Previous.m_UmdVersion == 10);
+    const std::vector<ReportFieldChange> fieldChanges = watcher.UpdateReport(1, ProbeReport(FAKE_TIER_2, true, 1));
+    CHECK(fieldChanges.size() == 3);
+    CHECK(fieldChanges[0].m_Path == L"D3D12_OPTIONS.ResourceBindingTier");
+    CHECK(fieldChanges[0].m_OldValue == L"FAKE_TIER_1" && fieldChanges[0].m_NewValue == L"FAKE_TIER_2");
+    // New fields first, in order of the new report, then the removed ones.
+    CHECK(fieldChanges[1].m_Path == L"D3D12_OPTIONS.NewField" && !fieldChanges[1].m_OldValue);
+    CHECK(fieldChanges[2].m_Path == L"Formats[1].Support1" && !fieldChanges[2].m_NewValue);
+
+    // Revision counts as a driver change too.
+    changes = watcher.Update({ MakeAdapter(1, 0x2684, 11, 2), MakeAdapter(2, 0x2704, 20) });
+    CHECK(changes.size() == 1 && changes[0].m_Type == ADAPTER_CHANGE_DRIVER);
+}
+
+static void TestDriverReinstalledWithNewLuid()
+{
+    AdapterWatcher watcher;
+    watcher.Update({ MakeAdapter(1, 0x2684, 10) });
+    watcher.UpdateReport(1, ProbeReport(FAKE_TIER_1, false, 2));
+
+    const std::vector<AdapterChange> changes = watcher.Update({ MakeAdapter(5, 0x2684, 12) });
+    CHECK(changes.size() == 1 && changes[0].m_Type == ADAPTER_CHANGE_DRIVER);
+    CHECK(changes[0].m_Previous.m_Luid == 1 && changes[0].m_Adapter.m_Luid == 5);
+    // The report follows the adapter to its new LUID.
+    CHECK(watcher.UpdateReport(5, ProbeReport(FAKE_TIER_1, false, 2)).empty());
+}
+
+static void TestIdenticalAdapters()
+{
+    // Only the one that disappeared can have got the new LUID.
+    AdapterWatcher watcher;
+    watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(2, 0x2684, 10) });
+    const std::vector<AdapterChange> changes =
+        watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(7, 0x2684, 11) });
+    CHECK(changes.size() == 1 && changes[0].m_Type == ADAPTER_CHANGE_DRIVER);
+    CHECK(changes[0].m_Previous.m_Luid == 2 && changes[0].m_Adapter.m_Luid == 7);
+}
+
+static void TestAddedAndRemoved()
+{
+    AdapterWatcher watcher;
+    watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(2, 0x2704, 20) });
+    watcher.UpdateReport(2, ProbeReport(FAKE_TIER_1, false, 2));
+
+    std::vector<AdapterChange> changes = watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(3, 0x2782, 30) });
+    CHECK(changes.size() == 2);
+    CHECK(changes[0].m_Type == ADAPTER_CHANGE_ADDED && changes[0].m_Adapter.m_Luid == 3);
+    CHECK(changes[1].m_Type == ADAPTER_CHANGE_REMOVED && changes[1].m_Adapter.m_Luid == 2);
+
+    // The report of a removed adapter is forgotten, so it starts again when the adapter comes back.
+    changes = watcher.Update({ MakeAdapter(1, 0x2684, 10), MakeAdapter(3, 0x2782, 30), MakeAdapter(2, 0x2704, 20) });
+    CHECK(changes.size() == 1 && changes[0].m_Type == ADAPTER_CHANGE_ADDED);
+    CHECK(watcher.UpdateReport(2, ProbeReport(FAKE_TIER_2, true, 1)).empty());
+
+    changes = watcher.Update({});
+    CHECK(changes.size() == 3);
+    for(const AdapterChange& change : changes)
+        CHECK(change.m_Type == ADAPTER_CHANGE_REMOVED);
+    CHECK(std::wstring(GetAdapterChangeTypeName(ADAPTER_CHANGE_DRIVER)) == L"Driver");
+}
+
+static void TestParseWatchInterval()
+{
+    uint32_t seconds = 0;
+    CHECK(ParseWatchInterval(L"5", seconds) && seconds == 5);
+    CHECK(ParseWatchInterval(L"86400", seconds) && seconds == WATCH_INTERVAL_MAX_SECONDS);
+    seconds = 7;
+    CHECK(!ParseWatchInterval(L"86401", seconds));
+    // Would overflow 32 bits, as seconds or as milliseconds.
+    CHECK(!ParseWatchInterval(L"4294968", seconds));
+    CHECK(!ParseWatchInterval(L"99999999999999999999", seconds));
+    CHECK(!ParseWatchInterval(L"0", seconds));
+    CHECK(!ParseWatchInterval(L"", seconds));
+    CHECK(!ParseWatchInterval(L"-5", seconds));
+    CHECK(!ParseWatchInterval(L"10s", seconds));
+    // Not changed on failure.
+    CHECK(seconds == 7);
+}
+
+int main()
+{
+    TestFlattenedReport();
+    TestDriverUpdate();
+    TestDriverReinstalledWithNewLuid();
+    TestIdenticalAdapters();
+    TestAddedAndRemoved();
+    TestParseWatchInterval();
+    return GetTestExitCode();
+}
@@ -0,0 +1,363 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks the layout of capture files, reading back what CaptureWriter wrote, and replaying it without D3D12, also
+// decoding structures with the descriptors stored in the capture.
+
+#include "Capture.hpp"
+#include "Printer.hpp"
+#include "Replay.hpp"
+#include "TestUtils.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <sstream>
+
+static const std::filesystem::path CAPTURE_FILE_PATH = std::filesystem::temp_directory_path() / "CaptureTest.bin";
+
+static std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+}
+
+static std::string SaveRecording(const RecordingReportFormatter& recording)
+{
+    std::ostringstream stream;
+    recording.Save(stream);
+    return stream.str();
+}
+
+static ReportHeader MakeTestHeader()
+{
+    ReportHeader header;
+    header.m_ProgramVersion = L"9.8.7";
+    header.m_BuildDate = L"Jan  2 2024 10:20:30";
+    header.m_Configuration = L"Release";
+    header.m_ConfigurationBits = L"64-bit";
+    header.m_GeneratedOn = L"2024-01-02";
+    header.m_D3D12SdkVersion = 616;
+    return header;
+}
+
+// Vendor data of the adapter, as Main.cpp records it with PrintCaptured.
+static void RecordVendorData(RecordingReportFormatter& recording)
+{
+    ReportContext context(recording, ReportFormatter::FLAGS::FLAG_NONE);
+    ReportContextScope contextScope(context);
+    ReportScopeObject scope(L"NvPhysicalGpuHandle");
+    ReportFormatter::GetInstance().AddFieldString(L"NvAPI_GPU_GetFullName", L"GeForce \u00C9\u4E2D\U0001F600");
+    ReportFormatter::GetInstance().AddFieldUint64(L"NvAPI_GPU_GetMemoryInfoEx", 0x123456789ABCull);
+}
+
+static void WriteTestCapture(RecordingReportFormatter& vendorData)
+{
+    RecordVendorData(vendorData);
+
+    CaptureWriter writer(CAPTURE_FILE_PATH);
+    writer.AddReportHeader(MakeTestHeader());
+    writer.AddUint32(CAPTURE_TAG_DXGI_FEATURE, 0, 1);
+    writer.BeginAdapter(3);
+    CaptureAdapterDesc desc;
+    desc.m_Description = L"Adapter \u00C9\u4E2D\U0001F600";
+    desc.m_VendorId = 0x10DE;
+    desc.m_DeviceId = 0x2684;
+    desc.m_DedicatedVideoMemory = 24ull << 30;
+    desc.m_AdapterLuid = 0x0000000100000002ull;
+    desc.m_Flags = 4;
+    writer.AddAdapterDesc(3, desc, 0);
+    writer.AddVideoMemoryInfo(0, { 1, 2, 3, 4 });
+    writer.AddUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, 0x001F000E000D0C0Bull);
+    writer.AddReport(CAPTURE_REPORT_ADAPTER_VENDOR_DATA, vendorData);
+    const uint32_t input[] = { 7, 0 };
+    const uint32_t output[] = { 7, 1 };
+    writer.AddRecord(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, 0, input, sizeof(input), output, sizeof(output), 0);
+    for(uint32_t i = 0; i < 4; ++i)
+        writer.AddUint32(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, i, 32 + i);
+}
+
+static void TestByteLayout()
+{
+    {
+        CaptureWriter writer(CAPTURE_FILE_PATH);
+        writer.AddUint32(CAPTURE_TAG_DXGI_FEATURE, 0x01020304, 0xA1B2C3D4, (int32_t)0x80004005);
+        writer.AddUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, 0x0102030405060708ull);
+    }
+    const std::vector<uint8_t> expected = {
+        0x44, 0x31, 0x32, 0x43, 0x02, 0x00, 0x00, 0x00, // magic, version
+        0x03, 0x00, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01, // tag, key
+        0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, // inputSize, outputSize
+        0x05, 0x40, 0x00, 0x80, 0xD4, 0xC3, 0xB2, 0xA1, // result, output
+        0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // tag, key
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, // inputSize, outputSize
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x07, 0x06, 0x05, // result, output
+        0x04, 0x03, 0x02, 0x01,
+    };
+    CHECK(ReadFileBytes(CAPTURE_FILE_PATH) == expected);
+}
+
+static void TestStringLayout()
+{
+    {
+        CaptureWriter writer(CAPTURE_FILE_PATH);
+        ReportHeader header;
+        header.m_ProgramVersion = L"\u00C9\U0001F600";
+        writer.AddReportHeader(header);
+    }
+    const std::vector<uint8_t> bytes = ReadFileBytes(CAPTURE_FILE_PATH);
+    // After the file header and the record header: length in UTF-16 code units, then a surrogate pair.
+    const std::vector<uint8_t> expected = { 0x03, 0x00, 0x00, 0x00, 0xC9, 0x00, 0x3D, 0xD8, 0x00, 0xDE };
+    CHECK(bytes.size() > 28 + expected.size());
+    CHECK(std::equal(expected.begin(), expected.end(), bytes.begin() + 28));
+}
+
+static void TestRoundTrip()
+{
+    RecordingReportFormatter vendorData;
+    WriteTestCapture(vendorData);
+    const CaptureReader reader(CAPTURE_FILE_PATH);
+
+    ReportHeader header;
+    CHECK(reader.GetGlobal().FindReportHeader(header));
+    CHECK(header.m_ProgramVersion == L"9.8.7");
+    CHECK(header.m_GeneratedOn == L"2024-01-02");
+    CHECK(header.m_D3D12SdkVersion == 616);
+    CHECK(!header.m_PreviewAgilitySdk);
+
+    CHECK(reader.GetAdapters().size() == 1);
+    const CaptureSection& section = reader.GetAdapters()[0];
+    CHECK(section.m_AdapterIndex == 3);
+    CaptureAdapterDesc desc;
+    CHECK(section.FindAdapterDesc(3, desc));
+    CHECK(desc.m_Description == L"Adapter \u00C9\u4E2D\U0001F600");
+    CHECK(desc.m_DeviceId == 0x2684);
+    CHECK(desc.m_DedicatedVideoMemory == 24ull << 30);
+    CHECK(desc.m_AdapterLuid == 0x0000000100000002ull);
+    CHECK(!section.FindAdapterDesc(2, desc));
+    CaptureVideoMemoryInfo videoMemoryInfo;
+    CHECK(section.FindVideoMemoryInfo(0, videoMemoryInfo));
+    CHECK(videoMemoryInfo.m_Budget == 1 && videoMemoryInfo.m_CurrentReservation == 4);
+    uint64_t umdVersion = 0;
+    CHECK(section.FindUint64(CAPTURE_TAG_DXGI_UMD_VERSION, 0, umdVersion));
+    CHECK(umdVersion == 0x001F000E000D0C0Bull);
+
+    RecordingReportFormatter loadedVendorData;
+    CHECK(section.FindReport(CAPTURE_REPORT_ADAPTER_VENDOR_DATA, loadedVendorData));
+    CHECK(SaveRecording(loadedVendorData) == SaveRecording(vendorData));
+    CHECK(!section.FindReport(CAPTURE_REPORT_DEVICE_DATA, loadedVendorData));
+
+    uint32_t data[2] = { 7, 0 };
+    ReplayFeatureSupportSource featureSupportSource(section);
+    CHECK(featureSupportSource.CheckFeatureSupport(0, data, sizeof(data)));
+    CHECK(data[1] == 1);
+}
+
+static void TestRawReplay()
+{
+    RecordingReportFormatter vendorData;
+    WriteTestCapture(vendorData);
+    const CaptureReader reader(CAPTURE_FILE_PATH);
+
+    std::wostringstream output;
+    {
+        PrinterScope printerScope(output);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAGS::FLAG_JSON);
+        RawReplayDecoder decoder(reader.GetGlobal());
+        ReplayCapture(reader, decoder, ReplayOptions{});
+    }
+    const wstring report = output.str();
+    // The header comes from the capture, not from the program that replays it.
+    CHECK(report.find(L"\"Version\":\"9.8.7\"") != wstring::npos);
+    CHECK(report.find(L"\"Generated on\":\"2024-01-02\"") != wstring::npos);
+    CHECK(report.find(L"\"D3D12_SDK_VERSION\":616") != wstring::npos);
+    CHECK(report.find(L"\"DXGI_FEATURE_PRESENT_ALLOW_TEARING\":true") != wstring::npos);
+    CHECK(report.find(L"\"AdapterLuid\":\"00000001-00000002\"") != wstring::npos);
+    CHECK(report.find(L"\"NvAPI_GPU_GetMemoryInfoEx\":\"20015998343868\"") != wstring::npos);
+    CHECK(report.find(L"\"GetDescriptorHandleIncrementSize\":[32,33,34,35]") != wstring::npos);
+}
+
+struct FakeOptions5
+{
+    uint32_t SRVOnlyTiledResourceTier3;
+    uint32_t RenderPassesTier;
+    uint32_t RaytracingTier;
+};
+
+static const EnumItem Enum_RenderPassTier[] = {
+    { L"D3D12_RENDER_PASS_TIER_0", 0 },
+    { L"D3D12_RENDER_PASS_TIER_1", 1 },
+    { L"D3D12_RENDER_PASS_TIER_2", 2 },
+    { nullptr, UINT32_MAX } };
+static const EnumItem Enum_RaytracingTier[] = {
+    { L"D3D12_RAYTRACING_TIER_NOT_SUPPORTED", 0 },
+    { L"D3D12_RAYTRACING_TIER_1_0", 10 },
+    { L"D3D12_RAYTRACING_TIER_1_1", 11 },
+    { nullptr, UINT32_MAX } };
+static const EnumItem Enum_AdapterFlag[] = {
+    { L"DXGI_ADAPTER_FLAG_NONE", 0 },
+    { L"DXGI_ADAPTER_FLAG_REMOTE", 1 },
+    { L"DXGI_ADAPTER_FLAG_SOFTWARE", 2 },
+    { nullptr, UINT32_MAX } };
+
+// RaytracingTier uses a table that is not registered, so it is captured without names.
+static const FieldDesc OPTIONS5_FIELDS[] = {
+    MakeFieldDesc<uint32_t, FIELD_KIND_BOOL>(
+        L"SRVOnlyTiledResourceTier3", offsetof(FakeOptions5, SRVOnlyTiledResourceTier3)),
+    MakeFieldDesc<uint32_t, FIELD_KIND_ENUM>(
+        L"RenderPassesTier", offsetof(FakeOptions5, RenderPassesTier), Enum_RenderPassTier),
+    MakeFieldDesc<uint32_t, FIELD_KIND_ENUM>(
+        L"RaytracingTier", offsetof(FakeOptions5, RaytracingTier), Enum_RaytracingTier),
+};
+static const uint32_t FEATURE_OPTIONS5 = 27;
+static const uint32_t FEATURE_FORMAT_SUPPORT = 2;
+static const StructDesc OPTIONS5_STRUCT = { L"D3D12_FEATURE_DATA_D3D12_OPTIONS5", FEATURE_OPTIONS5, OPTIONS5_FIELDS,
+    (uint32_t)std::size(OPTIONS5_FIELDS) };
+
+// Like a capture of D3d12info, with descriptors of the structures.
+static void WriteDescribedCapture(bool withDescriptors, uint32_t options5Size)
+{
+    StructCollection structs;
+    structs.Add(OPTIONS5_STRUCT);
+    EnumCollection enums;
+    enums.Add(L"D3D12_RENDER_PASS_TIER", Enum_RenderPassTier);
+
+    CaptureWriter writer(CAPTURE_FILE_PATH);
+    writer.AddReportHeader(MakeTestHeader());
+    if(withDescriptors)
+    {
+        writer.AddStructDescs(structs, enums);
+        writer.AddEnum(L"DXGI_ADAPTER_FLAG", Enum_AdapterFlag);
+    }
+    writer.BeginAdapter(0);
+    CaptureAdapterDesc desc;
+    desc.m_Description = L"Adapter";
+    desc.m_Flags = 2;
+    desc.m_GraphicsPreemptionGranularity = 1;
+    writer.AddAdapterDesc(2, desc, 0);
+    const FakeOptions5 options5 = { 1, 2, 11 };
+    writer.AddRecord(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, FEATURE_OPTIONS5, &options5, options5Size, &options5,
+        options5Size, 0);
+    const uint32_t formatSupport[] = { 28, 0x4000, 0 };
+    writer.AddRecord(CAPTURE_TAG_CHECK_FEATURE_SUPPORT, FEATURE_FORMAT_SUPPORT, formatSupport, sizeof(formatSupport),
+        formatSupport, sizeof(formatSupport), 0);
+    for(uint32_t i = 0; i < 4; ++i)
+        writer.AddUint32(CAPTURE_TAG_DESCRIPTOR_HANDLE_INCREMENT_SIZE, i, 32 + i);
+}
+
+static wstring ReplayDescribedCapture(ReportFormatter::FLAGS flags)
+{
+    const CaptureReader reader(CAPTURE_FILE_PATH);
+    std::wostringstream output;
+    {
+        PrinterScope printerScope(output);
+        ReportFormatterScope formatterScope(flags);
+        RawReplayDecoder decoder(reader.GetGlobal());
+        ReplayCapture(reader, decoder, ReplayOptions{});
+    }
+    return output.str();
+}
+
+static void TestStructDescriptors()
+{
+    WriteDescribedCapture(true, sizeof(FakeOptions5));
+    {
+        const CaptureReader reader(CAPTURE_FILE_PATH);
+        const CaptureStructCollection structs(reader.GetGlobal());
+        const StructDesc* const structDesc = structs.FindStruct(FEATURE_OPTIONS5);
+        CHECK(structDesc != nullptr);
+        if(structDesc)
+        {
+            CHECK(wstring(structDesc->m_Name) == L"D3D12_FEATURE_DATA_D3D12_OPTIONS5");
+            CHECK(structDesc->m_Id == FEATURE_OPTIONS5);
+            CHECK(structDesc->m_FieldCount == 3);
+            CHECK(wstring(structDesc->m_Fields[1].m_Name) == L"RenderPassesTier");
+            CHECK(structDesc->m_Fields[1].m_Offset == 4);
+            CHECK(structDesc->m_Fields[1].m_Kind == FIELD_KIND_ENUM);
+            CHECK(wstring(FindEnumItemName(2, structDesc->m_Fields[1].m_EnumItems)) == L"D3D12_RENDER_PASS_TIER_2");
+            // Without the table, only the terminator.
+            CHECK(structDesc->m_Fields[2].m_EnumItems && structDesc->m_Fields[2].m_EnumItems[0].m_Name == nullptr);
+        }
+        CHECK(structs.FindStruct(FEATURE_FORMAT_SUPPORT) == nullptr);
+        CHECK(structs.FindEnum(L"DXGI_ADAPTER_FLAG") != nullptr);
+        CHECK(structs.FindEnum(L"D3D12_RAYTRACING_TIER") == nullptr);
+    }
+
+    // Decoded the same as printed by D3d12info, with names of enums in text output.
+    const wstring text = ReplayDescribedCapture(ReportFormatter::FLAG_NONE);
+    CHECK(text.find(L"D3D12_FEATURE_DATA_D3D12_OPTIONS5:") != wstring::npos);
+    CHECK(text.find(L"SRVOnlyTiledResourceTier3 = TRUE") != wstring::npos);
+    CHECK(text.find(L"RenderPassesTier = D3D12_RENDER_PASS_TIER_2 (0x2)") != wstring::npos);
+    CHECK(text.find(L"RaytracingTier = 0xB") != wstring::npos);
+    CHECK(text.find(L"DXGI_ADAPTER_FLAG_SOFTWARE") != wstring::npos);
+    // The enum is not in the capture.
+    CHECK(text.find(L"GraphicsPreemptionGranularity = 1") != wstring::npos);
+
+    // Only the query without a descriptor is printed as bytes.
+    const wstring json = ReplayDescribedCapture(ReportFormatter::FLAG_JSON);
+    CHECK(json.find(L"\"D3D12_FEATURE_DATA_D3D12_OPTIONS5\":{\"SRVOnlyTiledResourceTier3\":true,"
+        L"\"RenderPassesTier\":2,\"RaytracingTier\":11}") != wstring::npos);
+    CHECK(json.find(L"\"CheckFeatureSupport\":[{\"Feature\":2,") != wstring::npos);
+    CHECK(json.find(L"\"Feature\":27") == wstring::npos);
+
+    // Smaller than the descriptor, e.g. an older version of the structure, so printed as bytes.
+    WriteDescribedCapture(true, 8);
+    const wstring truncated = ReplayDescribedCapture(ReportFormatter::FLAG_JSON);
+    CHECK(truncated.find(L"\"D3D12_FEATURE_DATA_D3D12_OPTIONS5\"") == wstring::npos);
+    CHECK(truncated.find(L"\"Feature\":27") != wstring::npos);
+
+    // Captures written before the descriptors were added.
+    WriteDescribedCapture(false, sizeof(FakeOptions5));
+    const wstring old = ReplayDescribedCapture(ReportFormatter::FLAG_JSON);
+    CHECK(old.find(L"\"D3D12_FEATURE_DATA_D3D12_OPTIONS5\"") == wstring::npos);
+    CHECK(old.find(L"\"CheckFeatureSupport\":[{\"Feature\":27,") != wstring::npos);
+    CHECK(old.find(L"\"Flags\":2") != wstring::npos);
+}
+
+static void TestInvalidFiles()
+{
+    // Version 1 had platform-dependent layout.
+    WriteFileBytes(CAPTURE_FILE_PATH, { 0x44, 0x31, 0x32, 0x43, 0x01, 0x00, 0x00, 0x00 });
+    CHECK_THROWS(CaptureReader(CAPTURE_FILE_PATH), std::runtime_error);
+
+    // Record with output going past the end of file.
+    WriteFileBytes(CAPTURE_FILE_PATH, { 0x44, 0x31, 0x32, 0x43, 0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 });
+    CHECK_THROWS(CaptureReader(CAPTURE_FILE_PATH), std::runtime_error);
+
+    // Replay needs the header.
+    {
+        CaptureWriter writer(CAPTURE_FILE_PATH);
+        writer.AddUint32(CAPTURE_TAG_DXGI_FEATURE, 0, 1);
+    }
+    const CaptureReader reader(CAPTURE_FILE_PATH);
+    std::wostringstream output;
+    PrinterScope printerScope(output);
+    ReportFormatterScope formatterScope(ReportFormatter::FLAGS::FLAG_JSON);
+    RawReplayDecoder decoder(reader.GetGlobal());
+    CHECK_THROWS(ReplayCapture(reader, decoder, ReplayOptions{}), std::runtime_error);
+}
+
+int main()
+{
+    TestByteLayout();
+    TestStringLayout();
+    TestRoundTrip();
+    TestRawReplay();
+    TestStructDescriptors();
+    TestInvalidFiles();
+    std::error_code errorCode;
+    std::filesystem::remove(CAPTURE_FILE_PATH, errorCode);
+    return GetTestExitCode();
+}
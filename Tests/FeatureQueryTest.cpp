@@ -0,0 +1,182 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks the table-driven query engine against a fake device that implements only CheckFeatureSupport.
+
+#include "FeatureQuery.hpp"
+#include "TestUtils.hpp"
+
+#include <map>
+
+static const int32_t RESULT_OK = 0;
+static const int32_t RESULT_INVALID_ARG = (int32_t)0x80070057;
+
+struct FakeData
+{
+    // Input member, set by Init.
+    uint32_t m_Input;
+    // Output member, set by the fake device.
+    uint32_t m_Output;
+};
+
+// Answers queries for the features it has values for, and records all calls.
+class FakeDevice : public FeatureSupportSource
+{
+public:
+    std::map<uint32_t, uint32_t> m_SupportedFeatures;
+    std::vector<uint32_t> m_Calls;
+    bool m_DataWasZeroed = true;
+
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override
+    {
+        m_Calls.push_back(feature);
+        if(dataSize != sizeof(FakeData))
+            return RESULT_INVALID_ARG;
+        FakeData& fakeData = *(FakeData*)data;
+        if(fakeData.m_Output != 0)
+            m_DataWasZeroed = false;
+        const auto it = m_SupportedFeatures.find(feature);
+        if(it == m_SupportedFeatures.end())
+            return RESULT_INVALID_ARG;
+        fakeData.m_Output = it->second + fakeData.m_Input;
+        return RESULT_OK;
+    }
+};
+
+// What the print functions were called with, as (feature, output) pairs.
+static std::vector<std::pair<uint32_t, uint32_t>> g_Printed;
+
+template <uint32_t Feature>
+static void PrintFakeData(const FakeData& data)
+{
+    g_Printed.push_back({ Feature, data.m_Output });
+}
+
+static void InitFakeData(FakeData& data)
+{
+    data.m_Input = 1000;
+}
+
+// Succeeds without asking the device, like queries that need a loop of calls.
+static bool QueryFakeData(FeatureSupportSource& source, FakeData& data)
+{
+    data.m_Output = 7;
+    return true;
+}
+
+static const uint32_t FEATURE_NEWEST = 1;
+static const uint32_t FEATURE_NEWER = 2;
+static const uint32_t FEATURE_OLDEST = 3;
+static const uint32_t FEATURE_OTHER = 4;
+
+// Chain of fallbacks, e.g. D3D12_FEATURE_D3D12_OPTIONS with versions of the structure from newest to oldest.
+static const FeatureQueryDesc FALLBACK_QUERIES[] = {
+    MakeFeatureQuery<PrintFakeData<FEATURE_NEWEST>>(FEATURE_NEWEST, L"NEWEST", L"Scope"),
+    MakeFeatureQuery<PrintFakeData<FEATURE_NEWER>>(
+        FEATURE_NEWER, L"NEWER", L"Scope", FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED),
+    MakeFeatureQuery<PrintFakeData<FEATURE_OLDEST>>(
+        FEATURE_OLDEST, L"OLDEST", L"Scope", FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED),
+    MakeFeatureQuery<PrintFakeData<FEATURE_OTHER>>(FEATURE_OTHER, L"OTHER", L"OtherScope"),
+};
+
+static void Run(FakeDevice& device, bool (*isNeeded)(const FeatureQueryDesc& query) = nullptr)
+{
+    g_Printed.clear();
+    RunFeatureQueries(device, FALLBACK_QUERIES, std::size(FALLBACK_QUERIES), isNeeded);
+}
+
+static void TestFirstInChainSucceeds()
+{
+    FakeDevice device;
+    device.m_SupportedFeatures = { { FEATURE_NEWEST, 10 }, { FEATURE_NEWER, 20 }, { FEATURE_OTHER, 40 } };
+    Run(device);
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST, FEATURE_OTHER }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_NEWEST, 10 }, { FEATURE_OTHER, 40 } }));
+}
+
+static void TestFallbackStopsAtFirstSuccess()
+{
+    FakeDevice device;
+    device.m_SupportedFeatures = { { FEATURE_NEWER, 20 }, { FEATURE_OLDEST, 30 } };
+    Run(device);
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST, FEATURE_NEWER, FEATURE_OTHER }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_NEWER, 20 } }));
+}
+
+static void TestWholeChainFails()
+{
+    FakeDevice device;
+    device.m_SupportedFeatures = { { FEATURE_OTHER, 40 } };
+    Run(device);
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST, FEATURE_NEWER, FEATURE_OLDEST, FEATURE_OTHER }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_OTHER, 40 } }));
+}
+
+static void TestPruningKeepsQueriesBeforeNeededFallback()
+{
+    // Only the oldest version is selected, but whether it is queried depends on the results of the newer ones.
+    FakeDevice device;
+    device.m_SupportedFeatures = { { FEATURE_NEWER, 20 }, { FEATURE_OLDEST, 30 }, { FEATURE_OTHER, 40 } };
+    Run(device, [](const FeatureQueryDesc& query) { return query.m_Feature == FEATURE_OLDEST; });
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST, FEATURE_NEWER }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_NEWER, 20 } }));
+
+    device.m_Calls.clear();
+    device.m_SupportedFeatures.erase(FEATURE_NEWER);
+    Run(device, [](const FeatureQueryDesc& query) { return query.m_Feature == FEATURE_OLDEST; });
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST, FEATURE_NEWER, FEATURE_OLDEST }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_OLDEST, 30 } }));
+}
+
+static void TestPruningSkipsFallbacksNotNeeded()
+{
+    FakeDevice device;
+    Run(device, [](const FeatureQueryDesc& query) { return query.m_Feature == FEATURE_NEWEST; });
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST }));
+    CHECK(g_Printed.empty());
+
+    device.m_Calls.clear();
+    device.m_SupportedFeatures = { { FEATURE_OTHER, 40 } };
+    Run(device, [](const FeatureQueryDesc& query) { return query.m_Feature == FEATURE_OTHER; });
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_OTHER }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_OTHER, 40 } }));
+}
+
+static void TestInitAndCustomQuery()
+{
+    static const FeatureQueryDesc queries[] = {
+        MakeFeatureQuery<PrintFakeData<FEATURE_NEWEST>, InitFakeData>(FEATURE_NEWEST, L"NEWEST", L"Scope"),
+        MakeFeatureQuery<PrintFakeData<FEATURE_OTHER>, nullptr, QueryFakeData>(FEATURE_OTHER, L"OTHER", L"Scope"),
+    };
+    FakeDevice device;
+    device.m_SupportedFeatures = { { FEATURE_NEWEST, 10 } };
+    g_Printed.clear();
+    RunFeatureQueries(device, queries, std::size(queries));
+    // The custom query doesn't call the device.
+    CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_NEWEST }));
+    CHECK((g_Printed == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_NEWEST, 1010 }, { FEATURE_OTHER, 7 } }));
+    CHECK(device.m_DataWasZeroed);
+
+    // Single query with input members set by the caller, like the format in the sweep over DXGI_FORMAT.
+    FakeData data = { 5, 0 };
+    CHECK(QueryFeature(device, FALLBACK_QUERIES[0], &data));
+    CHECK(data.m_Output == 15);
+    CHECK(!QueryFeature(device, FALLBACK_QUERIES[1], &data));
+}
+
+int main()
+{
+    TestFirstInChainSucceeds();
+    TestFallbackStopsAtFirstSuccess();
+    TestWholeChainFails();
+    TestPruningKeepsQueriesBeforeNeededFallback();
+    TestPruningSkipsFallbacksNotNeeded();
+    TestInitAndCustomQuery();
+    return GetTestExitCode();
+}
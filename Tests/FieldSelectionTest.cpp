@@ -0,0 +1,319 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks matching of --Select and --Exclude patterns, the report printed through SelectingReportFormatter, and that
+// queries for scopes pruned by the selection are not made.
+
+#include "FieldSelection.hpp"
+#include "TestUtils.hpp"
+
+#include "FeatureQuery.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportFormatter/SelectingReportFormatter.hpp"
+
+#include <map>
+#include <sstream>
+
+static FieldSelection MakeSelection(std::wstring_view selects, std::wstring_view excludes = {})
+{
+    FieldSelection selection;
+    selection.AddSelect(selects);
+    selection.AddExclude(excludes);
+    return selection;
+}
+
+static void TestMatchName()
+{
+    CHECK(MakeSelection(L"").IsEmpty());
+    CHECK(MakeSelection(L" , ").IsEmpty());
+    CHECK(MakeSelection(L"").IsSelected(L"Anything.At.All"));
+
+    const FieldSelection exact = MakeSelection(L"D3D12_OPTIONS5.RaytracingTier");
+    CHECK(!exact.IsEmpty());
+    CHECK(exact.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!exact.IsSelected(L"D3D12_OPTIONS5.RaytracingTie"));
+    CHECK(!exact.IsSelected(L"D3D12_OPTIONS5.RaytracingTierX"));
+    CHECK(!exact.IsSelected(L"D3D12_OPTIONS5"));
+    CHECK(!exact.IsSelected(L"D3D12_OPTIONS1.RaytracingTier"));
+
+    // * and ? stay within one name.
+    const FieldSelection wildcards = MakeSelection(L"D3D12_OPTIONS?.*Tier*");
+    CHECK(wildcards.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(wildcards.IsSelected(L"D3D12_OPTIONS5.Tier"));
+    CHECK(wildcards.IsSelected(L"D3D12_OPTIONS1.TiledResourcesTier2"));
+    CHECK(!wildcards.IsSelected(L"D3D12_OPTIONS.RaytracingTier"));
+    CHECK(!wildcards.IsSelected(L"D3D12_OPTIONS12.RaytracingTier"));
+    CHECK(!wildcards.IsSelected(L"D3D12_OPTIONS5.Raytracing"));
+    CHECK(!wildcards.IsSelected(L"D3D12_OPTIONS5.X.RaytracingTier"));
+    CHECK(MakeSelection(L"*").IsSelected(L"D3D12_OPTIONS5"));
+    CHECK(MakeSelection(L"*.RaytracingTier").IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!MakeSelection(L"*.RaytracingTier").IsSelected(L"Adapter.D3D12_OPTIONS5.RaytracingTier"));
+    // The last * takes more characters on a mismatch.
+    CHECK(MakeSelection(L"*a*ab").IsSelected(L"aaaab"));
+    CHECK(!MakeSelection(L"*a*ab").IsSelected(L"aaaba"));
+
+    // Multiple patterns in one call, with spaces around.
+    const FieldSelection list = MakeSelection(L" Driver , ,D3D12_OPTIONS5.RaytracingTier ");
+    CHECK(list.IsSelected(L"Driver.Version"));
+    CHECK(list.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!list.IsSelected(L"D3D12_OPTIONS5.RenderPassesTier"));
+}
+
+static void TestAnyNames()
+{
+    const FieldSelection anywhere = MakeSelection(L"**.RaytracingTier");
+    CHECK(anywhere.IsSelected(L"RaytracingTier"));
+    CHECK(anywhere.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(anywhere.IsSelected(L"Adapters[0].D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!anywhere.IsSelected(L"Adapters[0].D3D12_OPTIONS5.RenderPassesTier"));
+
+    const FieldSelection middle = MakeSelection(L"Adapters.**.Description");
+    CHECK(middle.IsSelected(L"Adapters[0].Description"));
+    CHECK(middle.IsSelected(L"Adapters[1].DXGI_ADAPTER_DESC1.Description"));
+    CHECK(!middle.IsSelected(L"Adapters[1].DXGI_ADAPTER_DESC1.VendorId"));
+    CHECK(!middle.IsSelected(L"Description"));
+
+    CHECK(MakeSelection(L"**").IsSelected(L"A.B.C"));
+}
+
+static void TestArrayItems()
+{
+    // The name of an array matches all its items.
+    const FieldSelection all = MakeSelection(L"Adapters");
+    CHECK(all.IsSelected(L"Adapters"));
+    CHECK(all.IsSelected(L"Adapters[0]"));
+    CHECK(all.IsSelected(L"Adapters[12].Description"));
+    CHECK(!all.IsSelected(L"Adapter[0]"));
+
+    const FieldSelection one = MakeSelection(L"Adapters[1].Description");
+    CHECK(one.IsSelected(L"Adapters[1].Description"));
+    CHECK(!one.IsSelected(L"Adapters[0].Description"));
+    CHECK(!one.IsSelected(L"Adapters[11].Description"));
+
+    CHECK(MakeSelection(L"Adapters[?]").IsSelected(L"Adapters[3].VendorId"));
+    CHECK(!MakeSelection(L"Adapters[?]").IsSelected(L"Adapters[10].VendorId"));
+    CHECK(MakeSelection(L"*[0]").IsSelected(L"Outputs[0]"));
+}
+
+static void TestExclude()
+{
+    const FieldSelection excludeOnly = MakeSelection(L"", L"Driver, D3D12_OPTIONS5.RaytracingTier");
+    CHECK(!excludeOnly.IsEmpty());
+    CHECK(excludeOnly.IsSelected(L"D3D12_OPTIONS5.RenderPassesTier"));
+    CHECK(!excludeOnly.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!excludeOnly.IsSelected(L"Driver.Version"));
+
+    // Exclude takes precedence, also over a more specific select.
+    const FieldSelection both = MakeSelection(L"D3D12_OPTIONS5, Adapters.Description", L"**.RaytracingTier, Adapters");
+    CHECK(both.IsSelected(L"D3D12_OPTIONS5.RenderPassesTier"));
+    CHECK(!both.IsSelected(L"D3D12_OPTIONS5.RaytracingTier"));
+    CHECK(!both.IsSelected(L"Adapters[0].Description"));
+    CHECK(!both.IsSelected(L"D3D12_OPTIONS1.WaveOps"));
+}
+
+static void TestScopeNeeded()
+{
+    CHECK(MakeSelection(L"").IsScopeNeeded(L"Anything"));
+
+    const FieldSelection field = MakeSelection(L"Adapters.D3D12_OPTIONS5.RaytracingTier");
+    CHECK(field.IsScopeNeeded(L"Adapters"));
+    CHECK(field.IsScopeNeeded(L"Adapters[0]"));
+    CHECK(field.IsScopeNeeded(L"Adapters[0].D3D12_OPTIONS5"));
+    CHECK(!field.IsScopeNeeded(L"Adapters[0].D3D12_OPTIONS1"));
+    CHECK(!field.IsScopeNeeded(L"Driver"));
+    // Not selected itself, only something inside it.
+    CHECK(!field.IsSelected(L"Adapters[0].D3D12_OPTIONS5"));
+
+    const FieldSelection anywhere = MakeSelection(L"**.RaytracingTier");
+    CHECK(anywhere.IsScopeNeeded(L"Driver"));
+    CHECK(anywhere.IsScopeNeeded(L"Adapters[0].D3D12_OPTIONS1"));
+
+    const FieldSelection excluded = MakeSelection(L"Adapters.D3D12_OPTIONS5", L"Adapters[1], **.D3D12_OPTIONS1");
+    CHECK(excluded.IsScopeNeeded(L"Adapters[0]"));
+    CHECK(!excluded.IsScopeNeeded(L"Adapters[1]"));
+    CHECK(!excluded.IsScopeNeeded(L"Adapters[1].D3D12_OPTIONS5"));
+    CHECK(!MakeSelection(L"", L"**.D3D12_OPTIONS1").IsScopeNeeded(L"Adapters[0].D3D12_OPTIONS1"));
+    CHECK(MakeSelection(L"", L"**.D3D12_OPTIONS1").IsScopeNeeded(L"Adapters[0].D3D12_OPTIONS5"));
+}
+
+static void PrintTestReport()
+{
+    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    {
+        ReportScopeArray adapters(L"Adapters");
+        for(uint32_t i = 0; i < 2; ++i)
+        {
+            ReportScopeArrayItem item;
+            formatter.AddFieldString(L"Description", i == 0 ? L"First" : L"Second");
+            formatter.AddFieldHex32(L"DeviceId", 0x1000 + i);
+        }
+    }
+    {
+        ReportScopeObject options(L"D3D12_OPTIONS5");
+        formatter.AddFieldUint32(L"RaytracingTier", 11);
+        formatter.AddFieldUint32(L"RenderPassesTier", 2);
+    }
+    {
+        ReportScopeObject empty(L"Empty");
+    }
+    formatter.AddFieldBool(L"Last", true);
+}
+
+static std::wstring PrintSelected(const FieldSelection& selection)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+        ReportScopeObject root(L"Root");
+        FieldSelectionScope selectionScope(selection);
+        PrintTestReport();
+    }
+    return stream.str();
+}
+
+static void TestSelectingFormatter()
+{
+    const std::wstring all = PrintSelected(FieldSelection());
+    CHECK(all.find(L"\"RenderPassesTier\":2") != std::wstring::npos);
+    CHECK(all.find(L"\"Empty\":{}") != std::wstring::npos);
+
+    // Scopes are printed only with the fields selected inside them. Paths start at the scope current when selecting.
+    CHECK(PrintSelected(MakeSelection(L"Adapters[1].Description, **.RaytracingTier")) ==
+        L"{\"Root\":{\"Adapters\":[{\"Description\":\"Second\"}],\"D3D12_OPTIONS5\":{\"RaytracingTier\":11}}}");
+    // A scope selected as a whole is printed even if empty.
+    CHECK(PrintSelected(MakeSelection(L"Empty, Last")) == L"{\"Root\":{\"Empty\":{},\"Last\":true}}");
+    CHECK(PrintSelected(MakeSelection(L"Adapters, D3D12_OPTIONS5", L"**.Description, **.RenderPassesTier")) ==
+        L"{\"Root\":{\"Adapters\":[{\"DeviceId\":4096},{\"DeviceId\":4097}],"
+        L"\"D3D12_OPTIONS5\":{\"RaytracingTier\":11}}}");
+    CHECK(PrintSelected(MakeSelection(L"Nothing")) == L"{\"Root\":{}}");
+}
+
+static const int32_t RESULT_OK = 0;
+static const int32_t RESULT_INVALID_ARG = (int32_t)0x80070057;
+
+static const uint32_t FEATURE_OPTIONS5 = 27;
+static const uint32_t FEATURE_ARCHITECTURE1 = 16;
+static const uint32_t FEATURE_ARCHITECTURE = 1;
+static const uint32_t FEATURE_SHADER_MODEL = 7;
+
+// Records all calls. The features in m_SupportedFeatures succeed with the value.
+class FakeDevice : public FeatureSupportSource
+{
+public:
+    std::map<uint32_t, uint32_t> m_SupportedFeatures;
+    std::vector<uint32_t> m_Calls;
+
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override
+    {
+        m_Calls.push_back(feature);
+        const auto it = m_SupportedFeatures.find(feature);
+        if(it == m_SupportedFeatures.end() || dataSize != sizeof(uint32_t))
+            return RESULT_INVALID_ARG;
+        *(uint32_t*)data = it->second;
+        return RESULT_OK;
+    }
+};
+
+template <const wchar_t* ScopeName>
+static void PrintFakeData(const uint32_t& data)
+{
+    ReportScopeObject scope(ScopeName);
+    ReportFormatter::GetInstance().AddFieldUint32(L"Value", data);
+}
+
+static const wchar_t SCOPE_OPTIONS5[] = L"D3D12_FEATURE_DATA_D3D12_OPTIONS5";
+static const wchar_t SCOPE_ARCHITECTURE1[] = L"D3D12_FEATURE_DATA_ARCHITECTURE1";
+static const wchar_t SCOPE_ARCHITECTURE[] = L"D3D12_FEATURE_DATA_ARCHITECTURE";
+static const wchar_t SCOPE_SHADER_MODEL[] = L"D3D12_FEATURE_DATA_SHADER_MODEL";
+
+// Like the table of D3D12Data.cpp, with ARCHITECTURE as the fallback of ARCHITECTURE1.
+static const FeatureQueryDesc QUERIES[] = {
+    MakeFeatureQuery<PrintFakeData<SCOPE_OPTIONS5>>(FEATURE_OPTIONS5, L"D3D12_OPTIONS5", SCOPE_OPTIONS5),
+    MakeFeatureQuery<PrintFakeData<SCOPE_ARCHITECTURE1>>(
+        FEATURE_ARCHITECTURE1, L"ARCHITECTURE1", SCOPE_ARCHITECTURE1),
+    MakeFeatureQuery<PrintFakeData<SCOPE_ARCHITECTURE>>(
+        FEATURE_ARCHITECTURE, L"ARCHITECTURE", SCOPE_ARCHITECTURE, FEATURE_QUERY_FLAG_ONLY_IF_PREVIOUS_FAILED),
+    MakeFeatureQuery<PrintFakeData<SCOPE_SHADER_MODEL>>(FEATURE_SHADER_MODEL, L"SHADER_MODEL", SCOPE_SHADER_MODEL),
+};
+
+// Queries like PrintDeviceFeatures of D3D12Data.cpp, asking the current formatter which scopes are needed.
+static std::wstring QuerySelected(FakeDevice& device, const FieldSelection& selection)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+        ReportScopeObject root(L"Root");
+        FieldSelectionScope selectionScope(selection);
+        RunFeatureQueries(device, QUERIES, std::size(QUERIES),
+            [](const FeatureQueryDesc& query) { return IsReportScopeNeeded(query.m_ScopeName); });
+    }
+    return stream.str();
+}
+
+static void TestPrunedQueries()
+{
+    {
+        FakeDevice device;
+        device.m_SupportedFeatures = { { FEATURE_OPTIONS5, 5 }, { FEATURE_ARCHITECTURE1, 11 },
+            { FEATURE_ARCHITECTURE, 10 }, { FEATURE_SHADER_MODEL, 0x66 } };
+        QuerySelected(device, FieldSelection());
+        CHECK((device.m_Calls ==
+            std::vector<uint32_t>{ FEATURE_OPTIONS5, FEATURE_ARCHITECTURE1, FEATURE_SHADER_MODEL }));
+    }
+    {
+        FakeDevice device;
+        device.m_SupportedFeatures = { { FEATURE_OPTIONS5, 5 }, { FEATURE_SHADER_MODEL, 0x66 } };
+        CHECK(QuerySelected(device, MakeSelection(L"**.Value", L"D3D12_FEATURE_DATA_ARCHITECTURE*")) ==
+            L"{\"Root\":{\"D3D12_FEATURE_DATA_D3D12_OPTIONS5\":{\"Value\":5},"
+            L"\"D3D12_FEATURE_DATA_SHADER_MODEL\":{\"Value\":102}}}");
+        CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_OPTIONS5, FEATURE_SHADER_MODEL }));
+    }
+    {
+        FakeDevice device;
+        device.m_SupportedFeatures = { { FEATURE_OPTIONS5, 5 }, { FEATURE_SHADER_MODEL, 0x66 } };
+        CHECK(QuerySelected(device, MakeSelection(L"D3D12_FEATURE_DATA_SHADER_MODEL.Value")) ==
+            L"{\"Root\":{\"D3D12_FEATURE_DATA_SHADER_MODEL\":{\"Value\":102}}}");
+        CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_SHADER_MODEL }));
+    }
+    {
+        // Only the fallback is selected, but whether it is queried depends on the result of the one before it.
+        FakeDevice device;
+        device.m_SupportedFeatures = { { FEATURE_ARCHITECTURE, 10 } };
+        CHECK(QuerySelected(device, MakeSelection(L"D3D12_FEATURE_DATA_ARCHITECTURE")) ==
+            L"{\"Root\":{\"D3D12_FEATURE_DATA_ARCHITECTURE\":{\"Value\":10}}}");
+        CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_ARCHITECTURE1, FEATURE_ARCHITECTURE }));
+
+        device.m_Calls.clear();
+        device.m_SupportedFeatures[FEATURE_ARCHITECTURE1] = 11;
+        CHECK(QuerySelected(device, MakeSelection(L"D3D12_FEATURE_DATA_ARCHITECTURE")) == L"{\"Root\":{}}");
+        CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_ARCHITECTURE1 }));
+    }
+    {
+        // Excluding the fallback leaves the one before it.
+        FakeDevice device;
+        device.m_SupportedFeatures = { { FEATURE_ARCHITECTURE, 10 } };
+        QuerySelected(device, MakeSelection(L"D3D12_FEATURE_DATA_ARCHITECTURE*", L"D3D12_FEATURE_DATA_ARCHITECTURE"));
+        CHECK((device.m_Calls == std::vector<uint32_t>{ FEATURE_ARCHITECTURE1 }));
+    }
+}
+
+int main()
+{
+    TestMatchName();
+    TestAnyNames();
+    TestArrayItems();
+    TestExclude();
+    TestScopeNeeded();
+    TestSelectingFormatter();
+    TestPrunedQueries();
+    return GetTestExitCode();
+}
@@ -0,0 +1,67 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks the table generated by Scripts/GenerateIntelGfxTable.cmake from Tests/Data/IntelGfx.cfg.
+
+#include "IntelGfxTable.hpp"
+#include "TestUtils.hpp"
+
+#include <cstring>
+
+static_assert(std::size(INTEL_GFX_TABLE) == 5);
+static_assert(FindIntelGfxPresetLevel(0x0042) == INTEL_GFX_PRESET_LEVEL_MEDIUM);
+
+static void TestLookup()
+{
+    CHECK(FindIntelGfxPresetLevel(0x0046) == INTEL_GFX_PRESET_LEVEL_LOW);
+    CHECK(FindIntelGfxPresetLevel(0x0166) == INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS);
+    CHECK(FindIntelGfxPresetLevel(0x56A0) == INTEL_GFX_PRESET_LEVEL_HIGH);
+    CHECK(FindIntelGfxPresetLevel(0xA780) == INTEL_GFX_PRESET_LEVEL_NOT_COMPATIBLE);
+}
+
+static void TestFirstEntryWins()
+{
+    CHECK(FindIntelGfxPresetLevel(0x0042) == INTEL_GFX_PRESET_LEVEL_MEDIUM);
+}
+
+static void TestSkippedEntries()
+{
+    // Other vendor, missing preset, and IDs that are not listed at all.
+    CHECK(FindIntelGfxPresetLevel(0x1234) == INTEL_GFX_PRESET_LEVEL_UNDEFINED);
+    CHECK(FindIntelGfxPresetLevel(0x0152) == INTEL_GFX_PRESET_LEVEL_UNDEFINED);
+    CHECK(FindIntelGfxPresetLevel(0x0000) == INTEL_GFX_PRESET_LEVEL_UNDEFINED);
+    CHECK(FindIntelGfxPresetLevel(0xFFFF) == INTEL_GFX_PRESET_LEVEL_UNDEFINED);
+}
+
+static void TestBatchLookup()
+{
+    const uint32_t deviceIds[] = { 0x56A0, 0x0001, 0x0046, 0x0166 };
+    INTEL_GFX_PRESET_LEVEL presetLevels[std::size(deviceIds)] = {};
+    FindIntelGfxPresetLevels(deviceIds, std::size(deviceIds), presetLevels);
+    CHECK(presetLevels[0] == INTEL_GFX_PRESET_LEVEL_HIGH);
+    CHECK(presetLevels[1] == INTEL_GFX_PRESET_LEVEL_UNDEFINED);
+    CHECK(presetLevels[2] == INTEL_GFX_PRESET_LEVEL_LOW);
+    CHECK(presetLevels[3] == INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS);
+}
+
+static void TestPresetLevelNames()
+{
+    CHECK(strcmp(GetIntelGfxPresetLevelName(INTEL_GFX_PRESET_LEVEL_MEDIUM_PLUS), "MediumPlus") == 0);
+    CHECK(strcmp(GetIntelGfxPresetLevelName(INTEL_GFX_PRESET_LEVEL_UNDEFINED), "Undefined") == 0);
+}
+
+int main()
+{
+    TestLookup();
+    TestFirstEntryWins();
+    TestSkippedEntries();
+    TestBatchLookup();
+    TestPresetLevelNames();
+    return GetTestExitCode();
+}
@@ -0,0 +1,146 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks that adapters inspected in parallel are printed like in a serial loop, with fake adapters that finish in
+// reverse order.
+
+#include "ParallelInspection.hpp"
+#include "TestUtils.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+static const size_t ADAPTER_COUNT = 8;
+static const int NEVER = -1;
+
+struct FakeInspection
+{
+    // Index of the adapter that returns an error or throws.
+    int m_FailAt = NEVER;
+    int m_ThrowAt = NEVER;
+    std::atomic<size_t> m_CallCount = 0;
+
+    int Inspect(size_t i)
+    {
+        ++m_CallCount;
+        // Later adapters finish first.
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * (ADAPTER_COUNT - i)));
+        ReportScopeArrayItem scope;
+        ReportFormatter::GetInstance().AddFieldString(L"Description", std::format(L"Adapter {}", i));
+        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", (uint32_t)i);
+        if((int)i == m_ThrowAt)
+            throw std::runtime_error(std::format("Adapter {} failed.", i));
+        return (int)i == m_FailAt ? PROGRAM_EXIT_ERROR_D3D12 : PROGRAM_EXIT_SUCCESS;
+    }
+};
+
+struct InspectionOutput
+{
+    int m_Result = PROGRAM_EXIT_SUCCESS;
+    string m_ExceptionMessage;
+    // Calls recorded by RecordingReportFormatter, saved to compare them.
+    string m_Report;
+};
+
+static InspectionOutput Inspect(bool parallel, FakeInspection& inspection)
+{
+    InspectionOutput output;
+    RecordingReportFormatter recording;
+    {
+        ReportContext context(recording, ReportFormatter::FLAGS::FLAG_JSON);
+        ReportContextScope contextScope(context);
+        ReportScopeArray scope(L"Adapters");
+        try
+        {
+            if(parallel)
+                output.m_Result = InspectInParallel(ADAPTER_COUNT, [&](size_t i) { return inspection.Inspect(i); });
+            else
+            {
+                for(size_t i = 0; i < ADAPTER_COUNT && output.m_Result == PROGRAM_EXIT_SUCCESS; ++i)
+                    output.m_Result = inspection.Inspect(i);
+            }
+        }
+        catch(const std::runtime_error& ex)
+        {
+            output.m_ExceptionMessage = ex.what();
+        }
+    }
+    std::ostringstream stream;
+    recording.Save(stream);
+    output.m_Report = stream.str();
+    return output;
+}
+
+static void CheckSameAsSerial(int failAt, int throwAt)
+{
+    FakeInspection serialInspection;
+    serialInspection.m_FailAt = failAt;
+    serialInspection.m_ThrowAt = throwAt;
+    FakeInspection parallelInspection;
+    parallelInspection.m_FailAt = failAt;
+    parallelInspection.m_ThrowAt = throwAt;
+
+    const InspectionOutput serial = Inspect(false, serialInspection);
+    const InspectionOutput parallel = Inspect(true, parallelInspection);
+    CHECK(parallel.m_Result == serial.m_Result);
+    CHECK(parallel.m_ExceptionMessage == serial.m_ExceptionMessage);
+    CHECK(parallel.m_Report == serial.m_Report);
+    // Adapters after the failed one still run, but their output is discarded.
+    CHECK(parallelInspection.m_CallCount == ADAPTER_COUNT);
+}
+
+static void TestOrderedStitching()
+{
+    CheckSameAsSerial(NEVER, NEVER);
+}
+
+static void TestEarlyErrorReturn()
+{
+    CheckSameAsSerial(3, NEVER);
+    CheckSameAsSerial(0, NEVER);
+    CheckSameAsSerial((int)ADAPTER_COUNT - 1, NEVER);
+}
+
+static void TestExceptionRethrow()
+{
+    CheckSameAsSerial(NEVER, 5);
+    // The first of an error and an exception wins.
+    CheckSameAsSerial(6, 2);
+    CheckSameAsSerial(2, 6);
+}
+
+static void TestParallelFor()
+{
+    std::vector<std::atomic<uint32_t>> calls(1000);
+    ParallelFor(calls.size(), [&](size_t i) { ++calls[i]; });
+    CHECK(std::all_of(calls.begin(), calls.end(), [](const std::atomic<uint32_t>& count) { return count == 1; }));
+
+    ParallelFor(0, [](size_t i) { CHECK(false); });
+
+    std::atomic<size_t> callCount = 0;
+    CHECK_THROWS(ParallelFor(calls.size(), [&](size_t i) {
+        ++callCount;
+        if(i == 10)
+            throw std::runtime_error("Failed.");
+    }), std::runtime_error);
+    // Remaining indices are skipped, except ones already taken by other threads.
+    CHECK(callCount < calls.size());
+}
+
+int main()
+{
+    TestOrderedStitching();
+    TestEarlyErrorReturn();
+    TestExceptionRethrow();
+    TestParallelFor();
+    return GetTestExitCode();
+}
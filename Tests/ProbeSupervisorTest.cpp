@@ -0,0 +1,268 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks restarting of workers of --Isolate with stand-in workers that crash on demand, in setup or on items.
+
+#include "ProbeSupervisor.hpp"
+#include "TestUtils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+static const uint32_t EXIT_CODE_ACCESS_VIOLATION = 0xC0000005;
+static const uint32_t EXIT_CODE_STACK_BUFFER_OVERRUN = 0xC0000409;
+
+// What stand-in workers of a section do.
+struct WorkerScript
+{
+    uint32_t m_ItemCount = 0;
+    // Number of workers crashing in their setup, before the ready frame, when started at the item.
+    std::map<uint32_t, uint32_t> m_SetupCrashes;
+    // Items crashing every worker that probes them, with the exit code.
+    std::map<uint32_t, uint32_t> m_ItemCrashes;
+    // Items for which the worker writes something that is not a frame.
+    std::set<uint32_t> m_Garbage;
+    // Items whose frame is cut in the middle by a crash.
+    std::set<uint32_t> m_CutFrames;
+    // Items written before the ready frame.
+    bool m_NoReadyFrame = false;
+};
+
+// Returns output prepared by the launcher in chunks of given size, like a pipe.
+class StandInWorker : public ProbeWorker
+{
+public:
+    std::string m_Output;
+    uint32_t m_ExitCode = 0;
+    bool m_Terminated = false;
+
+    StandInWorker(size_t chunkSize)
+        : m_ChunkSize(chunkSize)
+    {
+    }
+    size_t Read(void* buffer, size_t size) override
+    {
+        const size_t readSize = std::min({ size, m_ChunkSize, m_Output.size() - m_ReadOffset });
+        memcpy(buffer, m_Output.data() + m_ReadOffset, readSize);
+        m_ReadOffset += readSize;
+        return readSize;
+    }
+    void Terminate() override
+    {
+        m_Terminated = true;
+        m_ExitCode = 1;
+    }
+    uint32_t Wait() override
+    {
+        return m_ExitCode;
+    }
+
+private:
+    const size_t m_ChunkSize;
+    size_t m_ReadOffset = 0;
+};
+
+static std::string MakeItemData(size_t sectionIndex, uint32_t itemIndex)
+{
+    return std::format("Section {} item {}", sectionIndex, itemIndex);
+}
+
+static std::unique_ptr<ProbeWorker> LaunchStandInWorker(
+    WorkerScript& script, size_t sectionIndex, uint32_t firstItem, size_t chunkSize)
+{
+    auto worker = std::make_unique<StandInWorker>(chunkSize);
+    if(auto it = script.m_SetupCrashes.find(firstItem); it != script.m_SetupCrashes.end() && it->second > 0)
+    {
+        --it->second;
+        worker->m_ExitCode = EXIT_CODE_STACK_BUFFER_OVERRUN;
+        return worker;
+    }
+    if(!script.m_NoReadyFrame)
+        worker->m_Output = MakeProbeReadyFrame();
+    for(uint32_t item = firstItem; item < script.m_ItemCount; ++item)
+    {
+        if(auto it = script.m_ItemCrashes.find(item); it != script.m_ItemCrashes.end())
+        {
+            worker->m_ExitCode = it->second;
+            break;
+        }
+        if(script.m_Garbage.count(item))
+        {
+            worker->m_Output += "Not a frame of the item";
+            break;
+        }
+        const std::string frame = MakeProbeFrame(item, MakeItemData(sectionIndex, item));
+        if(script.m_CutFrames.count(item))
+        {
+            worker->m_Output += frame.substr(0, frame.size() - 2);
+            worker->m_ExitCode = EXIT_CODE_ACCESS_VIOLATION;
+            break;
+        }
+        worker->m_Output += frame;
+    }
+    return worker;
+}
+
+// Sections are probed in parallel, each by one worker at a time, so each script is used by one thread.
+static std::vector<ProbeSectionResult> Run(std::vector<WorkerScript> scripts, size_t chunkSize)
+{
+    std::vector<uint32_t> itemCounts;
+    for(const WorkerScript& script : scripts)
+        itemCounts.push_back(script.m_ItemCount);
+    return RunProbeSections(itemCounts, [&](size_t sectionIndex, uint32_t firstItem) {
+        return LaunchStandInWorker(scripts[sectionIndex], sectionIndex, firstItem, chunkSize);
+    });
+}
+
+static bool IsDone(const ProbeSectionResult& section, size_t sectionIndex, uint32_t itemIndex)
+{
+    const ProbeItemResult& item = section.m_Items[itemIndex];
+    return item.m_Status == PROBE_ITEM_STATUS_DONE && item.m_Data == MakeItemData(sectionIndex, itemIndex);
+}
+
+static bool IsCrashed(const ProbeSectionResult& section, uint32_t itemIndex, uint32_t exitCode)
+{
+    const ProbeItemResult& item = section.m_Items[itemIndex];
+    return item.m_Status == PROBE_ITEM_STATUS_CRASHED && item.m_ExitCode == exitCode;
+}
+
+static void TestItemCrashes(size_t chunkSize)
+{
+    const std::vector<ProbeSectionResult> results = Run(
+        {
+            { .m_ItemCount = 4 },
+            { .m_ItemCount = 5, .m_ItemCrashes = { { 2, EXIT_CODE_ACCESS_VIOLATION } } },
+            // Crashes after the ready frame are blamed on items, so they don't add up, even without progress.
+            { .m_ItemCount = 6,
+                .m_ItemCrashes = { { 0, 10 }, { 1, 11 }, { 2, 12 }, { 3, 13 } } },
+        },
+        chunkSize);
+    CHECK(results.size() == 3);
+
+    CHECK(results[0].m_WorkerCount == 1);
+    for(uint32_t i = 0; i < 4; ++i)
+        CHECK(IsDone(results[0], 0, i));
+
+    CHECK(results[1].m_WorkerCount == 2);
+    CHECK(IsDone(results[1], 1, 1));
+    CHECK(IsCrashed(results[1], 2, EXIT_CODE_ACCESS_VIOLATION));
+    CHECK(IsDone(results[1], 1, 3) && IsDone(results[1], 1, 4));
+
+    CHECK(results[2].m_WorkerCount == 5);
+    for(uint32_t i = 0; i < 4; ++i)
+        CHECK(IsCrashed(results[2], i, 10 + i));
+    CHECK(IsDone(results[2], 2, 4) && IsDone(results[2], 2, 5));
+}
+
+static void TestSetupCrashes(size_t chunkSize)
+{
+    const std::vector<ProbeSectionResult> results = Run(
+        {
+            // Flaky setup: the same item is tried again, and nothing is lost.
+            { .m_ItemCount = 3, .m_SetupCrashes = { { 0, 2 } } },
+            // Like creating the device for formats: the first format crashes, and so does every restart at the next.
+            { .m_ItemCount = 6,
+                .m_SetupCrashes = { { 3, PROBE_MAX_CRASHES_IN_A_ROW } },
+                .m_ItemCrashes = { { 2, EXIT_CODE_ACCESS_VIOLATION } } },
+            // Setup crashes are counted only in a row, until a worker is ready.
+            { .m_ItemCount = 5,
+                .m_SetupCrashes = { { 0, PROBE_MAX_CRASHES_IN_A_ROW - 1 }, { 2, PROBE_MAX_CRASHES_IN_A_ROW - 1 } },
+                .m_ItemCrashes = { { 1, EXIT_CODE_ACCESS_VIOLATION } } },
+        },
+        chunkSize);
+
+    CHECK(results[0].m_WorkerCount == 3);
+    for(uint32_t i = 0; i < 3; ++i)
+        CHECK(IsDone(results[0], 0, i));
+
+    CHECK(results[1].m_WorkerCount == 1 + PROBE_MAX_CRASHES_IN_A_ROW);
+    CHECK(IsDone(results[1], 1, 1));
+    CHECK(IsCrashed(results[1], 2, EXIT_CODE_ACCESS_VIOLATION));
+    // Given up with the exit code of the setup.
+    CHECK(IsCrashed(results[1], 3, EXIT_CODE_STACK_BUFFER_OVERRUN));
+    CHECK(results[1].m_Items[4].m_Status == PROBE_ITEM_STATUS_SKIPPED);
+    CHECK(results[1].m_Items[5].m_Status == PROBE_ITEM_STATUS_SKIPPED);
+
+    CHECK(results[2].m_WorkerCount == 2 * PROBE_MAX_CRASHES_IN_A_ROW);
+    CHECK(IsDone(results[2], 2, 0));
+    CHECK(IsCrashed(results[2], 1, EXIT_CODE_ACCESS_VIOLATION));
+    for(uint32_t i = 2; i < 5; ++i)
+        CHECK(IsDone(results[2], 2, i));
+}
+
+static void TestInvalidOutput(size_t chunkSize)
+{
+    const std::vector<ProbeSectionResult> results = Run(
+        {
+            { .m_ItemCount = 6, .m_Garbage = { 2 }, .m_CutFrames = { 4 } },
+            // Without the ready frame, the output is not valid, as a crash in setup.
+            { .m_ItemCount = 2, .m_NoReadyFrame = true },
+        },
+        chunkSize);
+
+    CHECK(results[0].m_WorkerCount == 3);
+    CHECK(IsDone(results[0], 0, 1));
+    // Terminated.
+    CHECK(IsCrashed(results[0], 2, 1));
+    CHECK(IsDone(results[0], 0, 3));
+    CHECK(IsCrashed(results[0], 4, EXIT_CODE_ACCESS_VIOLATION));
+    CHECK(IsDone(results[0], 0, 5));
+
+    CHECK(results[1].m_WorkerCount == PROBE_MAX_CRASHES_IN_A_ROW);
+    CHECK(IsCrashed(results[1], 0, 1));
+    CHECK(results[1].m_Items[1].m_Status == PROBE_ITEM_STATUS_SKIPPED);
+}
+
+static void TestFrames()
+{
+    const std::string ready = MakeProbeReadyFrame();
+    CHECK(ready.size() == 3 * sizeof(uint32_t));
+    uint32_t header[3];
+    memcpy(header, ready.data(), sizeof(header));
+    CHECK(header[0] == PROBE_FRAME_MAGIC && header[1] == PROBE_READY_ITEM_INDEX && header[2] == 0);
+
+    const std::string frame = MakeProbeFrame(7, "data");
+    memcpy(header, frame.data(), sizeof(header));
+    CHECK(header[0] == PROBE_FRAME_MAGIC && header[1] == 7 && header[2] == 4);
+    CHECK(frame.substr(sizeof(header)) == "data");
+}
+
+static void TestNoItemsAndLauncherError()
+{
+    size_t launchCount = 0;
+    const std::vector<ProbeSectionResult> results =
+        RunProbeSections(std::vector<uint32_t>{ 0 }, [&](size_t sectionIndex, uint32_t firstItem) {
+            ++launchCount;
+            return std::make_unique<StandInWorker>(1);
+        });
+    CHECK(results.size() == 1 && results[0].m_WorkerCount == 0 && launchCount == 0);
+
+    CHECK_THROWS(RunProbeSections(std::vector<uint32_t>{ 2, 3 },
+                     [](size_t sectionIndex, uint32_t firstItem) -> std::unique_ptr<ProbeWorker> {
+                         throw std::runtime_error("Could not start a worker.");
+                     }),
+        std::runtime_error);
+}
+
+int main()
+{
+    // Frames split between reads in different places.
+    for(size_t chunkSize : { 1, 5, 7, 65536 })
+    {
+        TestItemCrashes(chunkSize);
+        TestSetupCrashes(chunkSize);
+        TestInvalidOutput(chunkSize);
+    }
+    TestFrames();
+    TestNoItemsAndLauncherError();
+    return GetTestExitCode();
+}
@@ -0,0 +1,148 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks storing and loading of cache entries, and deletion of entries of adapters no longer present.
+
+#include "ReportCache.hpp"
+#include "TestUtils.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+
+static const std::filesystem::path CACHE_DIRECTORY_PATH = std::filesystem::temp_directory_path() / "ReportCacheTest";
+
+static const ReportCacheKey KEY_GPU_A = { .m_AdapterLuid = 10, .m_VendorId = 0x10DE, .m_DeviceId = 0x2684,
+    .m_SubSysId = 0x16F11043, .m_UmdVersion = 1 };
+static const ReportCacheKey KEY_GPU_B = { .m_AdapterLuid = 30, .m_VendorId = 0x1002, .m_DeviceId = 0x744C,
+    .m_SubSysId = 0x0E3E1002, .m_UmdVersion = 1 };
+
+// Same hardware as key, with the LUID it got after a reboot.
+static ReportCacheKey WithLuid(ReportCacheKey key, uint64_t adapterLuid)
+{
+    key.m_AdapterLuid = adapterLuid;
+    return key;
+}
+
+static void ResetDirectory()
+{
+    std::filesystem::remove_all(CACHE_DIRECTORY_PATH);
+}
+
+static void Store(const ReportCache& cache, std::span<const ReportCacheKey> keys)
+{
+    RecordingReportFormatter recording;
+    recording.AddFieldUint32(L"Field", 1);
+    cache.Store(keys, recording);
+}
+
+static bool IsStored(std::span<const ReportCacheKey> keys)
+{
+    RecordingReportFormatter recording;
+    return ReportCache(CACHE_DIRECTORY_PATH).Load(keys, recording);
+}
+
+static size_t CountFiles()
+{
+    return (size_t)std::distance(
+        std::filesystem::directory_iterator(CACHE_DIRECTORY_PATH), std::filesystem::directory_iterator());
+}
+
+static void TestStoreAndLoad()
+{
+    ResetDirectory();
+    ReportCache cache(CACHE_DIRECTORY_PATH);
+    CHECK(!IsStored({ &KEY_GPU_A, 1 }));
+    Store(cache, { &KEY_GPU_A, 1 });
+    CHECK(IsStored({ &KEY_GPU_A, 1 }));
+    // A new driver makes a new entry.
+    const ReportCacheKey newDriver = { .m_AdapterLuid = 10, .m_VendorId = 0x10DE, .m_DeviceId = 0x2684,
+        .m_SubSysId = 0x16F11043, .m_UmdVersion = 2 };
+    CHECK(!IsStored({ &newDriver, 1 }));
+}
+
+static void TestDeleteEntriesAfterReboot()
+{
+    ResetDirectory();
+    const ReportCacheKey systemKeys[] = { KEY_GPU_A, KEY_GPU_B };
+    {
+        ReportCache cache(CACHE_DIRECTORY_PATH);
+        cache.AddPresentAdapter(KEY_GPU_A.m_AdapterLuid);
+        cache.AddPresentAdapter(KEY_GPU_B.m_AdapterLuid);
+        Store(cache, { &KEY_GPU_A, 1 });
+        Store(cache, { &KEY_GPU_B, 1 });
+        Store(cache, systemKeys);
+    }
+    CHECK(CountFiles() == 3);
+
+    // After a reboot, only GPU A is stored again, with its new LUID.
+    const ReportCacheKey newKeyGpuA = WithLuid(KEY_GPU_A, 20);
+    const ReportCacheKey newKeyGpuB = WithLuid(KEY_GPU_B, 40);
+    {
+        ReportCache cache(CACHE_DIRECTORY_PATH);
+        cache.AddPresentAdapter(newKeyGpuA.m_AdapterLuid);
+        cache.AddPresentAdapter(newKeyGpuB.m_AdapterLuid);
+        Store(cache, { &newKeyGpuA, 1 });
+    }
+    CHECK(IsStored({ &newKeyGpuA, 1 }));
+    CHECK(!IsStored({ &KEY_GPU_A, 1 }));
+    // Has a key of GPU A too.
+    CHECK(!IsStored(systemKeys));
+    // Other hardware, deleted only when it is stored again.
+    CHECK(IsStored({ &KEY_GPU_B, 1 }));
+    CHECK(CountFiles() == 2);
+}
+
+static void TestKeepEntriesOfPresentAdapters()
+{
+    // Two identical GPUs in the system, each with its own entry.
+    ResetDirectory();
+    const ReportCacheKey keySecondGpuA = WithLuid(KEY_GPU_A, 11);
+    ReportCache cache(CACHE_DIRECTORY_PATH);
+    cache.AddPresentAdapter(KEY_GPU_A.m_AdapterLuid);
+    cache.AddPresentAdapter(keySecondGpuA.m_AdapterLuid);
+    Store(cache, { &KEY_GPU_A, 1 });
+    Store(cache, { &keySecondGpuA, 1 });
+    CHECK(IsStored({ &KEY_GPU_A, 1 }));
+    CHECK(IsStored({ &keySecondGpuA, 1 }));
+}
+
+static void TestNothingDeletedWithoutPresentAdapters()
+{
+    ResetDirectory();
+    const ReportCacheKey newKeyGpuA = WithLuid(KEY_GPU_A, 20);
+    ReportCache cache(CACHE_DIRECTORY_PATH);
+    Store(cache, { &KEY_GPU_A, 1 });
+    Store(cache, { &newKeyGpuA, 1 });
+    CHECK(IsStored({ &KEY_GPU_A, 1 }));
+    CHECK(IsStored({ &newKeyGpuA, 1 }));
+}
+
+static void TestOtherFilesKept()
+{
+    ResetDirectory();
+    std::filesystem::create_directories(CACHE_DIRECTORY_PATH);
+    std::ofstream(CACHE_DIRECTORY_PATH / "Other.bin") << "Not an entry";
+    std::ofstream(CACHE_DIRECTORY_PATH / "D3d12info_Cache_Broken.bin") << "D12";
+    const ReportCacheKey newKeyGpuA = WithLuid(KEY_GPU_A, 20);
+    ReportCache cache(CACHE_DIRECTORY_PATH);
+    cache.AddPresentAdapter(newKeyGpuA.m_AdapterLuid);
+    Store(cache, { &newKeyGpuA, 1 });
+    CHECK(std::filesystem::exists(CACHE_DIRECTORY_PATH / "Other.bin"));
+    CHECK(std::filesystem::exists(CACHE_DIRECTORY_PATH / "D3d12info_Cache_Broken.bin"));
+    CHECK(CountFiles() == 3);
+}
+
+int main()
+{
+    TestStoreAndLoad();
+    TestDeleteEntriesAfterReboot();
+    TestKeepEntriesOfPresentAdapters();
+    TestNothingDeletedWithoutPresentAdapters();
+    TestOtherFilesKept();
+    ResetDirectory();
+    return GetTestExitCode();
+}
@@ -0,0 +1,142 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Prints many reports at the same time on separate threads and checks each against the same report printed alone.
+
+#include "ParallelInspection.hpp"
+#include "TestUtils.hpp"
+#include "EnumItems.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/RecordingReportFormatter.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <sstream>
+#include <thread>
+
+static const size_t REPORT_COUNT = 64;
+static const size_t ADAPTER_COUNT = 4;
+static const size_t REPETITION_COUNT = 8;
+
+static const EnumItem Enum_FakeTier[] = {
+    { L"FAKE_TIER_NOT_SUPPORTED", 0 },
+    { L"FAKE_TIER_1", 1 },
+    { L"FAKE_TIER_2", 2 },
+    { NULL, UINT32_MAX }
+};
+
+static const ReportFormatter::FLAGS REPORT_FLAGS[] = {
+    ReportFormatter::FLAG_NONE,
+    ReportFormatter::FLAG_JSON,
+    (ReportFormatter::FLAGS)(ReportFormatter::FLAG_JSON | ReportFormatter::FLAG_JSON_PRETTY_PRINT),
+    ReportFormatter::FLAG_NUMERIC_ENUMS,
+};
+
+static ReportFormatter::FLAGS GetReportFlags(size_t reportIndex)
+{
+    return REPORT_FLAGS[reportIndex % std::size(REPORT_FLAGS)];
+}
+
+// Content differs between reports, and parts of it depend on the flags of the current context, so a report printed
+// with the context or formatter of another thread doesn't match.
+static void PrintFakeReport(size_t reportIndex)
+{
+    {
+        ReportScopeObject scope(L"Header");
+        ReportFormatter::GetInstance().AddFieldString(L"Name", std::format(L"Report {}", reportIndex));
+        ReportFormatter::GetInstance().AddFieldString(L"Output", SelectString(L"Text", L"JSON"));
+        ReportFormatter::GetInstance().AddFieldBool(L"IsJsonOutput", IsJsonOutput());
+    }
+    ReportScopeArray scope(L"Adapters");
+    const int result = InspectInParallel(ADAPTER_COUNT, [reportIndex](size_t adapterIndex) {
+        ReportScopeArrayItem itemScope;
+        ReportFormatter& formatter = ReportFormatter::GetInstance();
+        formatter.AddFieldUint32(L"AdapterIndex", (uint32_t)adapterIndex);
+        formatter.AddFieldUint64(L"DedicatedVideoMemory", (uint64_t)(reportIndex + 1) << 30, L"B");
+        formatter.AddFieldEnum(L"Tier", (uint32_t)((reportIndex + adapterIndex) % 3), Enum_FakeTier);
+        const uint32_t tiers[] = { 0, (uint32_t)(adapterIndex % 3), 2 };
+        formatter.AddEnumArray(L"Tiers", tiers, std::size(tiers), Enum_FakeTier);
+        {
+            ReportScopeObject featuresScope(L"Features");
+            for(uint32_t featureIndex = 0; featureIndex < 16; ++featureIndex)
+            {
+                const bool supported = ((reportIndex >> featureIndex) & 1) != 0;
+                formatter.AddFieldBool(std::format(L"Feature{}", featureIndex), supported);
+            }
+        }
+        return PROGRAM_EXIT_SUCCESS;
+    });
+    CHECK(result == PROGRAM_EXIT_SUCCESS);
+}
+
+// Printed through Printer, like the program does.
+static std::wstring PrintReport(size_t reportIndex)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(GetReportFlags(reportIndex));
+        PrintFakeReport(reportIndex);
+    }
+    return stream.str();
+}
+
+// Calls recorded by RecordingReportFormatter, saved to compare them.
+static string RecordReport(size_t reportIndex)
+{
+    RecordingReportFormatter recording;
+    {
+        ReportContext context(recording, GetReportFlags(reportIndex));
+        ReportContextScope contextScope(context);
+        PrintFakeReport(reportIndex);
+    }
+    std::ostringstream stream;
+    recording.Save(stream);
+    return stream.str();
+}
+
+template <typename T>
+static void CheckConcurrentSameAsSerial(T (*generate)(size_t))
+{
+    std::vector<T> serial(REPORT_COUNT);
+    for(size_t i = 0; i < REPORT_COUNT; ++i)
+        serial[i] = generate(i);
+    // Reports with different flags are really different.
+    CHECK(serial[0] != serial[1]);
+    CHECK(serial[1] != serial[2]);
+
+    for(size_t repetition = 0; repetition < REPETITION_COUNT; ++repetition)
+    {
+        std::vector<T> concurrent(REPORT_COUNT);
+        std::vector<std::thread> threads;
+        threads.reserve(REPORT_COUNT);
+        for(size_t i = 0; i < REPORT_COUNT; ++i)
+            threads.emplace_back([&concurrent, generate, i]() { concurrent[i] = generate(i); });
+        for(std::thread& thread : threads)
+            thread.join();
+        for(size_t i = 0; i < REPORT_COUNT; ++i)
+            CHECK(concurrent[i] == serial[i]);
+    }
+}
+
+static void TestConcurrentPrintedReports()
+{
+    CheckConcurrentSameAsSerial(PrintReport);
+}
+
+static void TestConcurrentRecordedReports()
+{
+    CheckConcurrentSameAsSerial(RecordReport);
+}
+
+int main()
+{
+    TestConcurrentPrintedReports();
+    TestConcurrentRecordedReports();
+    return GetTestExitCode();
+}
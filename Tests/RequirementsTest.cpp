@@ -0,0 +1,359 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks compiling of requirements profiles and their evaluation against a fake device, with a schema mirroring the
+// D3D12 structures it is used with.
+
+#include "Requirements.hpp"
+#include "TestUtils.hpp"
+
+#include "EnumItems.hpp"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+static const int32_t RESULT_OK = 0;
+static const int32_t RESULT_INVALID_ARG = (int32_t)0x80070057;
+
+static const uint32_t FEATURE_OPTIONS = 0;
+static const uint32_t FEATURE_FORMAT_SUPPORT = 2;
+static const uint32_t FEATURE_SHADER_MODEL = 7;
+
+static const uint32_t FORMAT_R8G8B8A8_UNORM = 28;
+static const uint32_t FORMAT_BC7_UNORM = 98;
+
+static const uint32_t FORMAT_SUPPORT1_TEXTURE2D = 0x20;
+static const uint32_t FORMAT_SUPPORT1_RENDER_TARGET = 0x4000;
+static const uint32_t FORMAT_SUPPORT2_UAV_TYPED_LOAD = 0x40;
+
+struct FakeOptions
+{
+    uint32_t DoublePrecisionFloatShaderOps;
+    uint32_t ResourceBindingTier;
+};
+
+struct FakeShaderModel
+{
+    uint32_t HighestShaderModel;
+};
+
+struct FakeFormatSupport
+{
+    uint32_t Format;
+    uint32_t Support1;
+    uint32_t Support2;
+};
+
+static const EnumItem Enum_ShaderModel[] = {
+    { L"D3D_SHADER_MODEL_6_5", 0x65 },
+    { L"D3D_SHADER_MODEL_6_6", 0x66 },
+    { L"D3D_SHADER_MODEL_6_7", 0x67 },
+    { nullptr, UINT32_MAX } };
+static const EnumItem Enum_Format[] = {
+    { L"DXGI_FORMAT_R8G8B8A8_UNORM", FORMAT_R8G8B8A8_UNORM },
+    { L"DXGI_FORMAT_BC7_UNORM", FORMAT_BC7_UNORM },
+    { nullptr, UINT32_MAX } };
+static const EnumItem Enum_FormatSupport1[] = {
+    { L"D3D12_FORMAT_SUPPORT1_TEXTURE2D", FORMAT_SUPPORT1_TEXTURE2D },
+    { L"D3D12_FORMAT_SUPPORT1_RENDER_TARGET", FORMAT_SUPPORT1_RENDER_TARGET },
+    { nullptr, UINT32_MAX } };
+static const EnumItem Enum_FormatSupport2[] = {
+    { L"D3D12_FORMAT_SUPPORT2_UAV_TYPED_LOAD", FORMAT_SUPPORT2_UAV_TYPED_LOAD },
+    { nullptr, UINT32_MAX } };
+
+static const FieldDesc OPTIONS_FIELDS[] = {
+    MakeFieldDesc<uint32_t, FIELD_KIND_BOOL>(
+        L"DoublePrecisionFloatShaderOps", offsetof(FakeOptions, DoublePrecisionFloatShaderOps)),
+    MakeFieldDesc<uint32_t, FIELD_KIND_UINT32>(L"ResourceBindingTier", offsetof(FakeOptions, ResourceBindingTier)),
+};
+static const FieldDesc SHADER_MODEL_FIELDS[] = {
+    MakeFieldDesc<uint32_t, FIELD_KIND_ENUM>(
+        L"HighestShaderModel", offsetof(FakeShaderModel, HighestShaderModel), Enum_ShaderModel),
+};
+static const FieldDesc FORMAT_SUPPORT_FIELDS[] = {
+    MakeFieldDesc<uint32_t, FIELD_KIND_ENUM>(L"Format", offsetof(FakeFormatSupport, Format), Enum_Format),
+    MakeFieldDesc<uint32_t, FIELD_KIND_FLAGS>(
+        L"Support1", offsetof(FakeFormatSupport, Support1), Enum_FormatSupport1),
+    MakeFieldDesc<uint32_t, FIELD_KIND_FLAGS>(
+        L"Support2", offsetof(FakeFormatSupport, Support2), Enum_FormatSupport2),
+};
+
+static const StructDesc OPTIONS_STRUCT = {
+    L"D3D12_FEATURE_DATA_D3D12_OPTIONS", FEATURE_OPTIONS, OPTIONS_FIELDS, (uint32_t)std::size(OPTIONS_FIELDS) };
+static const StructDesc SHADER_MODEL_STRUCT = { L"D3D12_FEATURE_DATA_SHADER_MODEL", FEATURE_SHADER_MODEL,
+    SHADER_MODEL_FIELDS, (uint32_t)std::size(SHADER_MODEL_FIELDS) };
+static const StructDesc FORMAT_SUPPORT_STRUCT = { L"D3D12_FEATURE_DATA_FORMAT_SUPPORT", FEATURE_FORMAT_SUPPORT,
+    FORMAT_SUPPORT_FIELDS, (uint32_t)std::size(FORMAT_SUPPORT_FIELDS) };
+
+template <typename T>
+static void PrintNothing(const T&)
+{
+}
+
+// Like the real query, which asks for the highest shader model the application knows.
+static void InitShaderModel(FakeShaderModel& data)
+{
+    data.HighestShaderModel = 0x67;
+}
+
+static const FeatureQueryDesc OPTIONS_QUERY =
+    MakeFeatureQuery<PrintNothing<FakeOptions>>(FEATURE_OPTIONS, L"D3D12_OPTIONS", L"D3D12_OPTIONS");
+static const FeatureQueryDesc SHADER_MODEL_QUERY = MakeFeatureQuery<PrintNothing<FakeShaderModel>, InitShaderModel>(
+    FEATURE_SHADER_MODEL, L"SHADER_MODEL", L"SHADER_MODEL");
+static const FeatureQueryDesc FORMAT_SUPPORT_QUERY = MakeFeatureQuery<PrintNothing<FakeFormatSupport>>(
+    FEATURE_FORMAT_SUPPORT, L"FORMAT_SUPPORT", L"FORMAT_SUPPORT");
+
+static const RequirementSchema SCHEMA = {
+    { { &OPTIONS_QUERY, &OPTIONS_STRUCT }, { &SHADER_MODEL_QUERY, &SHADER_MODEL_STRUCT } },
+    { &FORMAT_SUPPORT_QUERY, &FORMAT_SUPPORT_STRUCT },
+    Enum_Format };
+
+// Device with resource binding tier 3, shader model 6.6 and formats that support what is in m_FormatSupport.
+// Records all calls, as (feature, format) pairs.
+class FakeDevice : public FeatureSupportSource
+{
+public:
+    FakeOptions m_Options = { 1, 3 };
+    bool m_ShaderModelSupported = true;
+    std::map<uint32_t, FakeFormatSupport> m_FormatSupport = {
+        { FORMAT_R8G8B8A8_UNORM,
+            { FORMAT_R8G8B8A8_UNORM, FORMAT_SUPPORT1_TEXTURE2D | FORMAT_SUPPORT1_RENDER_TARGET,
+                FORMAT_SUPPORT2_UAV_TYPED_LOAD } },
+        { FORMAT_BC7_UNORM, { FORMAT_BC7_UNORM, FORMAT_SUPPORT1_TEXTURE2D, 0 } } };
+    std::vector<std::pair<uint32_t, uint32_t>> m_Calls;
+
+    int32_t CheckFeatureSupportResult(uint32_t feature, void* data, uint32_t dataSize) override
+    {
+        switch(feature)
+        {
+        case FEATURE_OPTIONS:
+            m_Calls.push_back({ feature, 0 });
+            if(dataSize != sizeof(FakeOptions))
+                return RESULT_INVALID_ARG;
+            *(FakeOptions*)data = m_Options;
+            return RESULT_OK;
+        case FEATURE_SHADER_MODEL:
+        {
+            m_Calls.push_back({ feature, 0 });
+            if(dataSize != sizeof(FakeShaderModel) || !m_ShaderModelSupported)
+                return RESULT_INVALID_ARG;
+            FakeShaderModel& shaderModel = *(FakeShaderModel*)data;
+            // Fails if the application doesn't know any shader model the device supports, like the real one.
+            if(shaderModel.HighestShaderModel < 0x60)
+                return RESULT_INVALID_ARG;
+            shaderModel.HighestShaderModel = std::min<uint32_t>(shaderModel.HighestShaderModel, 0x66);
+            return RESULT_OK;
+        }
+        case FEATURE_FORMAT_SUPPORT:
+        {
+            if(dataSize != sizeof(FakeFormatSupport))
+                return RESULT_INVALID_ARG;
+            FakeFormatSupport& formatSupport = *(FakeFormatSupport*)data;
+            m_Calls.push_back({ feature, formatSupport.Format });
+            const auto it = m_FormatSupport.find(formatSupport.Format);
+            if(it == m_FormatSupport.end())
+                return RESULT_INVALID_ARG;
+            formatSupport = it->second;
+            return RESULT_OK;
+        }
+        default:
+            m_Calls.push_back({ feature, 0 });
+            return RESULT_INVALID_ARG;
+        }
+    }
+};
+
+// Returns the message of the exception thrown by compiling the profile, or empty string if it compiles.
+static std::string GetCompileError(std::wstring_view profile)
+{
+    try
+    {
+        CompileRequirements(profile, SCHEMA);
+    }
+    catch(const std::runtime_error& ex)
+    {
+        return ex.what();
+    }
+    return {};
+}
+
+static void TestCompile()
+{
+    const std::vector<RequirementCheck> checks = CompileRequirements(
+        L"\xFEFF# Minimum for the renderer.\r\n"
+        L"ResourceBindingTier>=3\r\n"
+        L"\r\n"
+        L"  HighestShaderModel >= 6_6  \r\n"
+        L"Format DXGI_FORMAT_R8G8B8A8_UNORM supports RENDER_TARGET\r\n"
+        L"D3D12_OPTIONS.DoublePrecisionFloatShaderOps\r\n"
+        L"Format BC7_UNORM supports D3D12_FORMAT_SUPPORT2_UAV_TYPED_LOAD\n"
+        L"ResourceBindingTier != 0x1",
+        SCHEMA);
+    CHECK(checks.size() == 6);
+    if(checks.size() != 6)
+        return;
+
+    CHECK(checks[0].m_Line == 2);
+    CHECK(checks[0].m_Text == L"ResourceBindingTier>=3");
+    CHECK(checks[0].m_Query == &OPTIONS_QUERY);
+    CHECK(!checks[0].m_Format);
+    CHECK(checks[0].m_Field == &OPTIONS_FIELDS[1]);
+    CHECK(checks[0].m_Op == REQUIREMENT_OP_GREATER_EQUAL);
+    CHECK(checks[0].m_Value == 3);
+
+    // The end of the enum item name after '_' is enough, and spaces around the operator are allowed.
+    CHECK(checks[1].m_Line == 4);
+    CHECK(checks[1].m_Text == L"HighestShaderModel >= 6_6");
+    CHECK(checks[1].m_Query == &SHADER_MODEL_QUERY);
+    CHECK(checks[1].m_Field == &SHADER_MODEL_FIELDS[0]);
+    CHECK(checks[1].m_Op == REQUIREMENT_OP_GREATER_EQUAL);
+    CHECK(checks[1].m_Value == 0x66);
+
+    // The flag is looked up in all flags fields of the structure.
+    CHECK(checks[2].m_Line == 5);
+    CHECK(checks[2].m_Query == &FORMAT_SUPPORT_QUERY);
+    CHECK(checks[2].m_Format == FORMAT_R8G8B8A8_UNORM);
+    CHECK(checks[2].m_Field == &FORMAT_SUPPORT_FIELDS[1]);
+    CHECK(checks[2].m_Op == REQUIREMENT_OP_SUPPORTS);
+    CHECK(checks[2].m_Value == FORMAT_SUPPORT1_RENDER_TARGET);
+
+    // A field alone must be nonzero. The structure name can be shortened like enum items.
+    CHECK(checks[3].m_Line == 6);
+    CHECK(checks[3].m_Field == &OPTIONS_FIELDS[0]);
+    CHECK(checks[3].m_Op == REQUIREMENT_OP_NOT_EQUAL);
+    CHECK(checks[3].m_Value == 0);
+
+    CHECK(checks[4].m_Line == 7);
+    CHECK(checks[4].m_Format == FORMAT_BC7_UNORM);
+    CHECK(checks[4].m_Field == &FORMAT_SUPPORT_FIELDS[2]);
+    CHECK(checks[4].m_Value == FORMAT_SUPPORT2_UAV_TYPED_LOAD);
+
+    // The last line doesn't need the line end.
+    CHECK(checks[5].m_Line == 8);
+    CHECK(checks[5].m_Op == REQUIREMENT_OP_NOT_EQUAL);
+    CHECK(checks[5].m_Value == 1);
+
+    CHECK(CompileRequirements(L"", SCHEMA).empty());
+    CHECK(CompileRequirements(L"# Nothing required.\n\n", SCHEMA).empty());
+}
+
+static void TestCompileErrors()
+{
+    CHECK_THROWS(CompileRequirements(L"UnknownField>=1", SCHEMA), std::runtime_error);
+
+    CHECK(GetCompileError(L"ResourceBindingTier>=3\nUnknownField>=1") ==
+        "Requirements profile, line 2: unknown field 'UnknownField'.");
+    CHECK(GetCompileError(L"# Comment\r\n\r\nHighestShaderModel>=9_9") ==
+        "Requirements profile, line 3: '9_9' is not a valid value of HighestShaderModel.");
+    CHECK(GetCompileError(L"Format DXGI_FORMAT_UNKNOWN_ONE supports RENDER_TARGET") ==
+        "Requirements profile, line 1: unknown format 'DXGI_FORMAT_UNKNOWN_ONE'.");
+    CHECK(GetCompileError(L"\nFormat R8G8B8A8_UNORM supports DEPTH_STENCIL") ==
+        "Requirements profile, line 2: unknown format support flag 'DEPTH_STENCIL'.");
+    CHECK(GetCompileError(L"Format R8G8B8A8_UNORM RENDER_TARGET") ==
+        "Requirements profile, line 1: expected Format <DXGI_FORMAT> supports <flag>.");
+    CHECK(GetCompileError(L"\n\n\nResourceBindingTier>=") == "Requirements profile, line 4: missing value.");
+    CHECK(GetCompileError(L"ResourceBindingTier ! 3") == "Requirements profile, line 1: expected != operator.");
+    CHECK(GetCompileError(L"ResourceBindingTier supports 1") ==
+        "Requirements profile, line 1: ResourceBindingTier is not a flags field.");
+    CHECK(GetCompileError(L"ResourceBindingTier is 3").starts_with("Requirements profile, line 1: expected "));
+    // Non-ASCII characters are replaced in the message, which is narrow.
+    CHECK(GetCompileError(L"Resource\u00E9>=1") == "Requirements profile, line 1: unknown field 'Resource?'.");
+}
+
+static void TestAllPassed()
+{
+    const std::vector<RequirementCheck> checks = CompileRequirements(
+        L"ResourceBindingTier>=3\n"
+        L"HighestShaderModel>=6_6\n"
+        L"Format DXGI_FORMAT_R8G8B8A8_UNORM supports RENDER_TARGET\n"
+        L"DoublePrecisionFloatShaderOps\n"
+        L"Format DXGI_FORMAT_R8G8B8A8_UNORM supports TEXTURE2D\n"
+        L"Format DXGI_FORMAT_BC7_UNORM supports TEXTURE2D\n",
+        SCHEMA);
+    FakeDevice device;
+    const RequirementVerdict verdict = EvaluateRequirements(device, checks);
+    CHECK(verdict.m_CheckedCount == 6);
+    CHECK(verdict.m_FailedCheck == nullptr);
+    // Each structure is queried once, and the format support once per format.
+    CHECK((device.m_Calls == std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_OPTIONS, 0 },
+        { FEATURE_SHADER_MODEL, 0 }, { FEATURE_FORMAT_SUPPORT, FORMAT_R8G8B8A8_UNORM },
+        { FEATURE_FORMAT_SUPPORT, FORMAT_BC7_UNORM } }));
+}
+
+static void TestStopsAtFirstFailed()
+{
+    const std::vector<RequirementCheck> checks = CompileRequirements(
+        L"HighestShaderModel>=6_6\n"
+        L"ResourceBindingTier>=3\n"
+        L"Format DXGI_FORMAT_BC7_UNORM supports RENDER_TARGET\n"
+        L"HighestShaderModel>=6_7\n",
+        SCHEMA);
+
+    {
+        FakeDevice device;
+        device.m_Options.ResourceBindingTier = 2;
+        const RequirementVerdict verdict = EvaluateRequirements(device, checks);
+        CHECK(verdict.m_CheckedCount == 2);
+        CHECK(verdict.m_FailedCheck == &checks[1]);
+        CHECK(!verdict.m_QueryFailed);
+        CHECK(verdict.m_Value == 2);
+        CHECK((device.m_Calls ==
+            std::vector<std::pair<uint32_t, uint32_t>>{ { FEATURE_SHADER_MODEL, 0 }, { FEATURE_OPTIONS, 0 } }));
+    }
+    {
+        FakeDevice device;
+        const RequirementVerdict verdict = EvaluateRequirements(device, checks);
+        CHECK(verdict.m_CheckedCount == 3);
+        CHECK(verdict.m_FailedCheck == &checks[2]);
+        CHECK(verdict.m_Value == FORMAT_SUPPORT1_TEXTURE2D);
+        CHECK(FormatRequirementValue(*verdict.m_FailedCheck->m_Field, verdict.m_Value) == L"0x20");
+        CHECK(device.m_Calls.size() == 3);
+    }
+    {
+        FakeDevice device;
+        device.m_ShaderModelSupported = false;
+        const RequirementVerdict verdict = EvaluateRequirements(device, checks);
+        CHECK(verdict.m_CheckedCount == 1);
+        CHECK(verdict.m_FailedCheck == &checks[0]);
+        CHECK(verdict.m_QueryFailed);
+        CHECK(device.m_Calls.size() == 1);
+    }
+    {
+        // Passes all but the last, which is checked on the result of the first query.
+        FakeDevice device;
+        device.m_FormatSupport[FORMAT_BC7_UNORM].Support1 |= FORMAT_SUPPORT1_RENDER_TARGET;
+        const RequirementVerdict verdict = EvaluateRequirements(device, checks);
+        CHECK(verdict.m_CheckedCount == 4);
+        CHECK(verdict.m_FailedCheck == &checks[3]);
+        CHECK(verdict.m_Value == 0x66);
+        CHECK(FormatRequirementValue(*verdict.m_FailedCheck->m_Field, verdict.m_Value) == L"D3D_SHADER_MODEL_6_6");
+        CHECK(device.m_Calls.size() == 3);
+    }
+}
+
+static void TestFormatValue()
+{
+    CHECK(FormatRequirementValue(OPTIONS_FIELDS[0], 1) == L"true");
+    CHECK(FormatRequirementValue(OPTIONS_FIELDS[0], 0) == L"false");
+    CHECK(FormatRequirementValue(OPTIONS_FIELDS[1], 3) == L"3");
+    CHECK(FormatRequirementValue(SHADER_MODEL_FIELDS[0], 0x65) == L"D3D_SHADER_MODEL_6_5");
+    CHECK(FormatRequirementValue(SHADER_MODEL_FIELDS[0], 0x70) == L"112");
+}
+
+int main()
+{
+    TestCompile();
+    TestCompileErrors();
+    TestAllPassed();
+    TestStopsAtFirstFailed();
+    TestFormatValue();
+    return GetTestExitCode();
+}
@@ -0,0 +1,36 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Minimal checks shared by the tests. A failed check prints its location and the test continues, so one run reports
+// all failures. main() of a test returns GetTestExitCode(), nonzero if any check failed, for ctest.
+
+#include <cstdio>
+
+inline int g_FailedCheckCount = 0;
+
+#define CHECK(expr) do { if(!(expr)) { \
+        std::fprintf(stderr, "%s(%d): CHECK failed: %s\n", __FILE__, __LINE__, #expr); \
+        ++g_FailedCheckCount; \
+    } } while(false)
+
+// Checks that evaluating expr throws an exception of given type.
+#define CHECK_THROWS(expr, exceptionType) do { bool thrown__ = false; \
+        try { (void)(expr); } catch(const exceptionType&) { thrown__ = true; } \
+        CHECK(thrown__ && "expected " #exceptionType " from " #expr); \
+    } while(false)
+
+inline int GetTestExitCode()
+{
+    if(g_FailedCheckCount == 0)
+        return 0;
+    std::fprintf(stderr, "%d check(s) failed.\n", g_FailedCheckCount);
+    return 1;
+}
@@ -0,0 +1,448 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks the Timings section printed from recorded phases and calls, which recorder is current in nested scopes and
+// on other threads, and that the trace written from multiple threads parses as JSON.
+
+#include "Timings.hpp"
+#include "TestUtils.hpp"
+
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <charconv>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static std::wstring PrintTimings(const TimingRecorder& recorder, size_t slowestCallCount)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+        recorder.Print(slowestCallCount);
+    }
+    return stream.str();
+}
+
+static void TestCallTotals()
+{
+    TimingRecorder recorder;
+    recorder.AddPhase(L"CreateDevice", 5ms);
+    recorder.AddCall(L"CheckFeatureSupport", L"FORMAT_SUPPORT R8G8B8A8_UNORM", 3ms);
+    recorder.AddCall(L"GetDesc", {}, 2ms);
+    recorder.AddCall(L"CheckFeatureSupport", L"D3D12_OPTIONS", 500us);
+    recorder.AddCall(L"CheckFeatureSupport", L"FORMAT_SUPPORT BC7_UNORM", 4ms);
+    recorder.AddPhase(L"Features", 9ms);
+
+    // Calls are summed up by name in order of first use, the slowest ones are sorted by time, without empty args.
+    CHECK(PrintTimings(recorder, 2) ==
+        L"{\"Timings\":{"
+        L"\"Phases\":[{\"Name\":\"CreateDevice\",\"TimeMs\":5},{\"Name\":\"Features\",\"TimeMs\":9}],"
+        L"\"Calls\":[{\"Name\":\"CheckFeatureSupport\",\"Count\":3,\"TotalMs\":7.5,\"MaxMs\":4},"
+        L"{\"Name\":\"GetDesc\",\"Count\":1,\"TotalMs\":2,\"MaxMs\":2}],"
+        L"\"SlowestCalls\":["
+        L"{\"Name\":\"CheckFeatureSupport\",\"Args\":\"FORMAT_SUPPORT BC7_UNORM\",\"TimeMs\":4},"
+        L"{\"Name\":\"CheckFeatureSupport\",\"Args\":\"FORMAT_SUPPORT R8G8B8A8_UNORM\",\"TimeMs\":3}]}}");
+
+    // More than there are calls.
+    const std::wstring all = PrintTimings(recorder, 100);
+    CHECK(all.ends_with(L"\"SlowestCalls\":["
+        L"{\"Name\":\"CheckFeatureSupport\",\"Args\":\"FORMAT_SUPPORT BC7_UNORM\",\"TimeMs\":4},"
+        L"{\"Name\":\"CheckFeatureSupport\",\"Args\":\"FORMAT_SUPPORT R8G8B8A8_UNORM\",\"TimeMs\":3},"
+        L"{\"Name\":\"GetDesc\",\"TimeMs\":2},"
+        L"{\"Name\":\"CheckFeatureSupport\",\"Args\":\"D3D12_OPTIONS\",\"TimeMs\":0.5}]}}"));
+
+    CHECK(PrintTimings(recorder, 0).ends_with(L"\"SlowestCalls\":[]}}"));
+}
+
+static void TestEmpty()
+{
+    TimingRecorder recorder;
+    CHECK(PrintTimings(recorder, 10) == L"{\"Timings\":{}}");
+
+    recorder.AddCall(L"GetDesc", {}, 1ms);
+    CHECK(PrintTimings(recorder, 10) ==
+        L"{\"Timings\":{\"Calls\":[{\"Name\":\"GetDesc\",\"Count\":1,\"TotalMs\":1,\"MaxMs\":1}],"
+        L"\"SlowestCalls\":[{\"Name\":\"GetDesc\",\"TimeMs\":1}]}}");
+}
+
+static void TestRecorderScope()
+{
+    CHECK(TimingRecorder::GetCurrent() == nullptr);
+    TimingRecorder outer, inner;
+    {
+        TimingRecorderScope outerScope(&outer);
+        CHECK(TimingRecorder::GetCurrent() == &outer);
+        {
+            TimingRecorderScope innerScope(&inner);
+            CHECK(TimingRecorder::GetCurrent() == &inner);
+            TimingScope phase(L"Inner");
+        }
+        CHECK(TimingRecorder::GetCurrent() == &outer);
+        {
+            // Nothing is timed inside, also by TimingScope.
+            TimingRecorderScope nullScope(nullptr);
+            CHECK(TimingRecorder::GetCurrent() == nullptr);
+            TimingScope phase(L"NotTimed");
+            AddTimedCall(TimingRecorder::GetCurrent(), L"NotTimed", {}, TimingClock::now(), TimingClock::now());
+        }
+        CHECK(TimingRecorder::GetCurrent() == &outer);
+
+        // Current per thread.
+        TimingRecorder* otherThreadRecorder = &outer;
+        std::thread thread([&otherThreadRecorder]() { otherThreadRecorder = TimingRecorder::GetCurrent(); });
+        thread.join();
+        CHECK(otherThreadRecorder == nullptr);
+
+        TimingScope phase(L"Outer");
+    }
+    CHECK(TimingRecorder::GetCurrent() == nullptr);
+
+    const std::wstring outerTimings = PrintTimings(outer, 10);
+    CHECK(outerTimings.starts_with(L"{\"Timings\":{\"Phases\":[{\"Name\":\"Outer\",\"TimeMs\":"));
+    CHECK(outerTimings.find(L"NotTimed") == std::wstring::npos);
+    CHECK(outerTimings.find(L"Inner") == std::wstring::npos);
+    const std::wstring innerTimings = PrintTimings(inner, 10);
+    CHECK(innerTimings.starts_with(L"{\"Timings\":{\"Phases\":[{\"Name\":\"Inner\",\"TimeMs\":"));
+    CHECK(innerTimings.find(L"Outer") == std::wstring::npos);
+}
+
+static void TestConcurrentCalls()
+{
+    // Like queries of formats made from multiple threads.
+    constexpr uint32_t THREAD_COUNT = 8;
+    constexpr uint32_t CALL_COUNT = 1000;
+    TimingRecorder recorder;
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back([&recorder]() {
+            TimingRecorderScope recorderScope(&recorder);
+            for(uint32_t j = 0; j < CALL_COUNT; ++j)
+            {
+                const TimingClock::time_point begin = TimingClock::now();
+                AddTimedCall(TimingRecorder::GetCurrent(), L"CheckFeatureSupport", {}, begin, begin + 1us);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+        thread.join();
+    CHECK(PrintTimings(recorder, 0).find(L"\"Count\":8000,") != std::wstring::npos);
+}
+
+// Minimal JSON value, enough to check that the trace parses as a whole.
+struct JsonValue
+{
+    enum TYPE
+    {
+        TYPE_NULL,
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT,
+    };
+
+    TYPE m_Type = TYPE_NULL;
+    double m_Number = 0.0;
+    std::wstring m_String;
+    std::vector<JsonValue> m_Items;
+    std::vector<std::pair<std::wstring, JsonValue>> m_Members;
+
+    // If not found, returns null.
+    const JsonValue* Find(std::wstring_view name) const
+    {
+        for(const auto& [memberName, value] : m_Members)
+        {
+            if(memberName == name)
+                return &value;
+        }
+        return nullptr;
+    }
+};
+
+// Throws std::runtime_error if the text is not valid JSON.
+class JsonParser
+{
+public:
+    JsonParser(std::string_view text)
+        : m_Text(text)
+    {
+    }
+
+    JsonValue ParseDocument()
+    {
+        JsonValue value = ParseValue();
+        SkipWhitespace();
+        if(m_Pos != m_Text.size())
+            Fail();
+        return value;
+    }
+
+private:
+    std::string_view m_Text;
+    size_t m_Pos = 0;
+
+    [[noreturn]] void Fail() const
+    {
+        throw std::runtime_error(std::format("Invalid JSON at offset {}.", m_Pos));
+    }
+
+    void SkipWhitespace()
+    {
+        while(m_Pos < m_Text.size() && (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r' ||
+            m_Text[m_Pos] == '\t'))
+        {
+            ++m_Pos;
+        }
+    }
+
+    bool Accept(char ch)
+    {
+        SkipWhitespace();
+        if(m_Pos < m_Text.size() && m_Text[m_Pos] == ch)
+        {
+            ++m_Pos;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(char ch)
+    {
+        if(!Accept(ch))
+            Fail();
+    }
+
+    bool AcceptWord(std::string_view word)
+    {
+        if(!m_Text.substr(m_Pos).starts_with(word))
+            return false;
+        m_Pos += word.size();
+        return true;
+    }
+
+    std::wstring ParseString()
+    {
+        Expect('"');
+        std::wstring result;
+        for(;;)
+        {
+            if(m_Pos >= m_Text.size() || (unsigned char)m_Text[m_Pos] < 0x20)
+                Fail();
+            const char ch = m_Text[m_Pos++];
+            if(ch == '"')
+                return result;
+            if(ch != '\\')
+            {
+                result += (wchar_t)ch;
+                continue;
+            }
+            if(m_Pos >= m_Text.size())
+                Fail();
+            const char escaped = m_Text[m_Pos++];
+            if(escaped == '"' || escaped == '\\' || escaped == '/')
+                result += (wchar_t)escaped;
+            else if(escaped == 'n')
+                result += L'\n';
+            else if(escaped == 'u' && m_Pos + 4 <= m_Text.size())
+            {
+                uint32_t code = 0;
+                const std::from_chars_result parsed =
+                    std::from_chars(m_Text.data() + m_Pos, m_Text.data() + m_Pos + 4, code, 16);
+                if(parsed.ptr != m_Text.data() + m_Pos + 4)
+                    Fail();
+                m_Pos += 4;
+                result += (wchar_t)code;
+            }
+            else
+                Fail();
+        }
+    }
+
+    JsonValue ParseValue()
+    {
+        SkipWhitespace();
+        JsonValue value;
+        if(m_Pos >= m_Text.size())
+            Fail();
+        const char ch = m_Text[m_Pos];
+        if(ch == '{')
+        {
+            value.m_Type = JsonValue::TYPE_OBJECT;
+            ++m_Pos;
+            if(Accept('}'))
+                return value;
+            do
+            {
+                SkipWhitespace();
+                std::wstring name = ParseString();
+                Expect(':');
+                value.m_Members.emplace_back(std::move(name), ParseValue());
+            } while(Accept(','));
+            Expect('}');
+        }
+        else if(ch == '[')
+        {
+            value.m_Type = JsonValue::TYPE_ARRAY;
+            ++m_Pos;
+            if(Accept(']'))
+                return value;
+            do
+                value.m_Items.push_back(ParseValue());
+            while(Accept(','));
+            Expect(']');
+        }
+        else if(ch == '"')
+        {
+            value.m_Type = JsonValue::TYPE_STRING;
+            value.m_String = ParseString();
+        }
+        else if(AcceptWord("true") || AcceptWord("false"))
+            value.m_Type = JsonValue::TYPE_BOOL;
+        else if(AcceptWord("null"))
+            value.m_Type = JsonValue::TYPE_NULL;
+        else
+        {
+            value.m_Type = JsonValue::TYPE_NUMBER;
+            const std::from_chars_result parsed =
+                std::from_chars(m_Text.data() + m_Pos, m_Text.data() + m_Text.size(), value.m_Number);
+            if(parsed.ec != std::errc())
+                Fail();
+            m_Pos = parsed.ptr - m_Text.data();
+        }
+        return value;
+    }
+};
+
+static const std::filesystem::path TRACE_FILE_PATH = std::filesystem::temp_directory_path() / "TimingsTest.json";
+
+static std::string ReadTextFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void TestTrace()
+{
+    constexpr uint32_t THREAD_COUNT = 4;
+    constexpr uint32_t CALL_COUNT = 100;
+    CHECK(TraceWriter::GetInstance() == nullptr);
+    {
+        TraceWriter writer(TRACE_FILE_PATH);
+        CHECK(TraceWriter::GetInstance() == &writer);
+
+        std::vector<std::thread> threads;
+        for(uint32_t i = 0; i < THREAD_COUNT; ++i)
+        {
+            threads.emplace_back([i]() {
+                const std::wstring name = std::format(L"Thread{}", i);
+                TraceScope traceScope(name, "Scope");
+                TimingScope timingScope(nullptr, name);
+                for(uint32_t j = 0; j < CALL_COUNT; ++j)
+                {
+                    const TimingClock::time_point begin = TimingClock::now();
+                    AddTimedCall(nullptr, name, std::format(L"Call{}", j), begin, TimingClock::now());
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+            thread.join();
+
+        const TimingClock::time_point begin = TimingClock::now();
+        writer.AddEvent(L"Quote\"Back\\slash\u00E9", "Call", begin, begin + 2ms);
+    }
+    CHECK(TraceWriter::GetInstance() == nullptr);
+
+    JsonValue root;
+    try
+    {
+        root = JsonParser(ReadTextFile(TRACE_FILE_PATH)).ParseDocument();
+    }
+    catch(const std::runtime_error& ex)
+    {
+        std::fprintf(stderr, "%s\n", ex.what());
+        CHECK(0 && "trace is not valid JSON");
+        return;
+    }
+    CHECK(root.m_Type == JsonValue::TYPE_ARRAY);
+    CHECK(root.m_Items.size() == 1 + THREAD_COUNT * (CALL_COUNT + 2) + 1);
+    if(root.m_Items.empty())
+        return;
+
+    const JsonValue* const metadataPhase = root.m_Items[0].Find(L"ph");
+    CHECK(metadataPhase && metadataPhase->m_String == L"M");
+
+    // Each thread has one ID, different from the others.
+    std::map<std::wstring, std::set<double>> threadIdsByName;
+    std::set<double> allThreadIds;
+    for(size_t i = 1; i < root.m_Items.size(); ++i)
+    {
+        const JsonValue& event = root.m_Items[i];
+        const JsonValue* const name = event.Find(L"name");
+        const JsonValue* const phase = event.Find(L"ph");
+        const JsonValue* const begin = event.Find(L"ts");
+        const JsonValue* const duration = event.Find(L"dur");
+        const JsonValue* const threadId = event.Find(L"tid");
+        CHECK(name && name->m_Type == JsonValue::TYPE_STRING);
+        CHECK(phase && phase->m_String == L"X");
+        CHECK(begin && begin->m_Type == JsonValue::TYPE_NUMBER && begin->m_Number >= 0.0);
+        CHECK(duration && duration->m_Type == JsonValue::TYPE_NUMBER && duration->m_Number >= 0.0);
+        CHECK(threadId && threadId->m_Type == JsonValue::TYPE_NUMBER);
+        if(!name || !threadId)
+            continue;
+        threadIdsByName[name->m_String].insert(threadId->m_Number);
+        allThreadIds.insert(threadId->m_Number);
+
+        const JsonValue* const category = event.Find(L"cat");
+        const JsonValue* const args = event.Find(L"args");
+        if(name->m_String == L"Quote\"Back\\slash\u00E9")
+        {
+            CHECK(category && category->m_String == L"Call");
+            CHECK(duration && duration->m_Number == 2000.0);
+            CHECK(args == nullptr);
+        }
+        else if(category && category->m_String == L"Call")
+            CHECK(args && args->Find(L"args") && args->Find(L"args")->m_String.starts_with(L"Call"));
+        else
+            CHECK(args == nullptr);
+    }
+    CHECK(threadIdsByName.size() == THREAD_COUNT + 1);
+    for(const auto& [name, threadIds] : threadIdsByName)
+        CHECK(threadIds.size() == 1);
+    CHECK(allThreadIds.size() == THREAD_COUNT + 1);
+
+    // Characters outside of ASCII are escaped.
+    CHECK(ReadTextFile(TRACE_FILE_PATH).find("\"Quote\\\"Back\\\\slash\\u00E9\"") != std::string::npos);
+}
+
+static void TestTraceInvalidPath()
+{
+    CHECK_THROWS(TraceWriter(std::filesystem::temp_directory_path() / "TimingsTestNoSuchDir" / "Trace.json"),
+        std::runtime_error);
+    CHECK(TraceWriter::GetInstance() == nullptr);
+}
+
+int main()
+{
+    TestCallTotals();
+    TestEmpty();
+    TestRecorderScope();
+    TestConcurrentCalls();
+    TestTrace();
+    TestTraceInvalidPath();
+    std::error_code errorCode;
+    std::filesystem::remove(TRACE_FILE_PATH, errorCode);
+    return GetTestExitCode();
+}
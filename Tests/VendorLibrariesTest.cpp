@@ -0,0 +1,191 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks which stub vendor libraries are initialized at startup, and how long the startup takes, for sets of adapters.
+
+#include "VendorLibraries.hpp"
+#include "TestUtils.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#include <sstream>
+#include <thread>
+
+static const uint32_t VENDOR_NVIDIA = 0x10DE;
+static const uint32_t VENDOR_AMD = 0x1002;
+static const uint32_t VENDOR_INTEL = 0x8086;
+
+// Much longer than the rest of the startup, so it decides its duration.
+static const std::chrono::milliseconds STUB_INIT_TIME = std::chrono::milliseconds(50);
+
+// Counts instances created, and takes time to initialize, like loading a DLL.
+template <uint32_t VendorId>
+struct StubLibrary
+{
+    static inline std::atomic<uint32_t> s_CreatedCount = 0;
+
+    StubLibrary()
+    {
+        ++s_CreatedCount;
+        std::this_thread::sleep_for(STUB_INIT_TIME);
+    }
+};
+using StubNvApi = StubLibrary<VENDOR_NVIDIA>;
+using StubAgs = StubLibrary<VENDOR_AMD>;
+
+static void ResetCreatedCounts()
+{
+    StubNvApi::s_CreatedCount = 0;
+    StubAgs::s_CreatedCount = 0;
+}
+
+// Like VendorApis of D3d12info, with adapters of given vendors inspected.
+struct StubVendorApis
+{
+    VendorLibrarySelection m_Selection;
+    LazyVendorLibrary<StubNvApi> m_NvApi{ L"StubNvApi" };
+    LazyVendorLibrary<StubAgs> m_Ags{ L"StubAgs" };
+
+    StubVendorApis(const std::vector<uint32_t>& inspectedVendorIds, bool force = false, bool disabled = false)
+        : m_Selection(force, disabled)
+    {
+        for(uint32_t vendorId : inspectedVendorIds)
+            m_Selection.AddAdapterVendor(vendorId);
+    }
+};
+
+struct StartupResult
+{
+    TimingClock::duration m_Duration;
+    bool m_NvApiUsed;
+    bool m_AgsUsed;
+    // Timings printed in JSON.
+    std::wstring m_Timings;
+};
+
+// Like the start of D3d12info: System Info asks for the libraries of all vendors, which initializes only the needed
+// ones.
+static StartupResult RunStartup(StubVendorApis& apis)
+{
+    TimingRecorder timings;
+    StartupResult result;
+    const TimingClock::time_point begin = TimingClock::now();
+    result.m_NvApiUsed = apis.m_NvApi.Get(apis.m_Selection.IsVendorNeeded(VENDOR_NVIDIA), &timings) != nullptr;
+    result.m_AgsUsed = apis.m_Ags.Get(apis.m_Selection.IsVendorNeeded(VENDOR_AMD), &timings) != nullptr;
+    result.m_Duration = TimingClock::now() - begin;
+
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+        timings.Print(0);
+    }
+    result.m_Timings = stream.str();
+    return result;
+}
+
+static bool HasPhase(const StartupResult& result, std::wstring_view name)
+{
+    return result.m_Timings.find(std::format(L"\"{}\"", name)) != std::wstring::npos;
+}
+
+static void TestOnlySelectedAdapterVendor()
+{
+    // Like -a 0 on a machine with NVIDIA and AMD GPUs, where adapter 0 is NVIDIA.
+    ResetCreatedCounts();
+    StubVendorApis apis({ VENDOR_NVIDIA });
+    const StartupResult result = RunStartup(apis);
+    CHECK(result.m_NvApiUsed);
+    CHECK(!result.m_AgsUsed);
+    CHECK(StubNvApi::s_CreatedCount == 1);
+    CHECK(StubAgs::s_CreatedCount == 0);
+    CHECK(HasPhase(result, L"StubNvApi"));
+    CHECK(!HasPhase(result, L"StubAgs"));
+    CHECK(result.m_Duration >= STUB_INIT_TIME);
+    // AGS would take as long again.
+    CHECK(result.m_Duration < 2 * STUB_INIT_TIME);
+}
+
+static void TestNoLibraryForOtherVendors()
+{
+    // Like an Intel-only laptop: nothing is loaded, so the startup takes no time.
+    ResetCreatedCounts();
+    StubVendorApis apis({ VENDOR_INTEL, VENDOR_INTEL });
+    const StartupResult result = RunStartup(apis);
+    CHECK(!result.m_NvApiUsed && !result.m_AgsUsed);
+    CHECK(StubNvApi::s_CreatedCount == 0 && StubAgs::s_CreatedCount == 0);
+    CHECK(!HasPhase(result, L"StubNvApi") && !HasPhase(result, L"StubAgs"));
+    CHECK(result.m_Duration < STUB_INIT_TIME);
+}
+
+static void TestAllVendors()
+{
+    ResetCreatedCounts();
+    StubVendorApis apis({ VENDOR_AMD, VENDOR_NVIDIA });
+    const StartupResult result = RunStartup(apis);
+    CHECK(result.m_NvApiUsed && result.m_AgsUsed);
+    CHECK(HasPhase(result, L"StubNvApi") && HasPhase(result, L"StubAgs"));
+    CHECK(result.m_Duration >= 2 * STUB_INIT_TIME);
+}
+
+static void TestForcedAndDisabled()
+{
+    ResetCreatedCounts();
+    StubVendorApis forced({ VENDOR_INTEL }, true);
+    const StartupResult forcedResult = RunStartup(forced);
+    CHECK(forcedResult.m_NvApiUsed && forcedResult.m_AgsUsed);
+
+    // Like --PureD3D12, and like probing a single adapter for --Watch, where no adapter needs vendor libraries.
+    ResetCreatedCounts();
+    StubVendorApis disabled({ VENDOR_NVIDIA, VENDOR_AMD }, true, true);
+    StubVendorApis noAdapters({}, true);
+    const StartupResult disabledResult = RunStartup(disabled);
+    const StartupResult noAdaptersResult = RunStartup(noAdapters);
+    CHECK(!disabledResult.m_NvApiUsed && !disabledResult.m_AgsUsed);
+    CHECK(!noAdaptersResult.m_NvApiUsed && !noAdaptersResult.m_AgsUsed);
+    CHECK(StubNvApi::s_CreatedCount == 0 && StubAgs::s_CreatedCount == 0);
+}
+
+static void TestFirstUseFromManyThreads()
+{
+    // Like adapters inspected in parallel, each asking for the library when it prints its data.
+    ResetCreatedCounts();
+    StubVendorApis apis({ VENDOR_NVIDIA });
+    TimingRecorder timings;
+    std::atomic<uint32_t> createCallCount = 0;
+    std::vector<StubNvApi*> results(16);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            results[i] = apis.m_NvApi.Get(true, &timings, [&]() {
+                ++createCallCount;
+                return std::make_unique<StubNvApi>();
+            });
+        });
+    }
+    for(std::thread& thread : threads)
+        thread.join();
+    CHECK(createCallCount == 1);
+    CHECK(StubNvApi::s_CreatedCount == 1);
+    CHECK(results[0] != nullptr);
+    CHECK(std::all_of(results.begin(), results.end(), [&](StubNvApi* result) { return result == results[0]; }));
+    // The first call decides.
+    CHECK(apis.m_NvApi.Get(false, &timings) == results[0]);
+}
+
+int main()
+{
+    TestOnlySelectedAdapterVendor();
+    TestNoLibraryForOtherVendors();
+    TestAllVendors();
+    TestForcedAndDisabled();
+    TestFirstUseFromManyThreads();
+    return GetTestExitCode();
+}
@@ -0,0 +1,230 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Checks the Vulkan part against a stub loader that implements only the functions D3d12info uses.
+
+#include "VulkanData.hpp"
+#include "TestUtils.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+#define VK_NO_PROTOTYPES 1
+#include <vulkan/vulkan.h>
+
+#include <cstring>
+#include <sstream>
+
+struct StubPhysicalDevice
+{
+    uint32_t m_VendorId;
+    uint32_t m_DeviceId;
+    // 0 means the LUID is not valid, like on platforms other than Windows.
+    uint64_t m_Luid;
+    const char* m_DriverName;
+};
+
+// What the stub loader reports, and what it was asked for.
+struct StubLoader
+{
+    std::vector<StubPhysicalDevice> m_Devices;
+    // Fails creation of the instance for Vulkan 1.2, like an old loader.
+    bool m_Only11 = false;
+
+    uint32_t m_InstanceApiVersion = 0;
+    bool m_InstanceDestroyed = false;
+    // Number of calls to vkGetPhysicalDeviceProperties2, and how many of them had the 1.2 structure in the chain.
+    uint32_t m_PropertyQueryCount = 0;
+    uint32_t m_Vulkan12QueryCount = 0;
+};
+static StubLoader g_Stub;
+
+// Handles are pointers to these.
+static int g_StubInstance;
+static int g_StubDevices[4];
+
+static VkResult VKAPI_PTR StubCreateInstance(
+    const VkInstanceCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkInstance* instance)
+{
+    if(g_Stub.m_Only11 && createInfo->pApplicationInfo->apiVersion >= VK_API_VERSION_1_2)
+        return VK_ERROR_INCOMPATIBLE_DRIVER;
+    g_Stub.m_InstanceApiVersion = createInfo->pApplicationInfo->apiVersion;
+    *instance = (VkInstance)&g_StubInstance;
+    return VK_SUCCESS;
+}
+
+static void VKAPI_PTR StubDestroyInstance(VkInstance instance, const VkAllocationCallbacks* allocator)
+{
+    CHECK(instance == (VkInstance)&g_StubInstance);
+    g_Stub.m_InstanceDestroyed = true;
+}
+
+static VkResult VKAPI_PTR StubEnumeratePhysicalDevices(
+    VkInstance instance, uint32_t* physicalDeviceCount, VkPhysicalDevice* physicalDevices)
+{
+    if(!physicalDevices)
+    {
+        *physicalDeviceCount = (uint32_t)g_Stub.m_Devices.size();
+        return VK_SUCCESS;
+    }
+    CHECK(*physicalDeviceCount == g_Stub.m_Devices.size());
+    for(size_t i = 0; i < g_Stub.m_Devices.size(); ++i)
+        physicalDevices[i] = (VkPhysicalDevice)&g_StubDevices[i];
+    return VK_SUCCESS;
+}
+
+static void VKAPI_PTR StubGetPhysicalDeviceProperties2(
+    VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties2* properties)
+{
+    const StubPhysicalDevice& device = g_Stub.m_Devices[(int*)physicalDevice - g_StubDevices];
+    ++g_Stub.m_PropertyQueryCount;
+    properties->properties.apiVersion = VK_API_VERSION_1_2;
+    properties->properties.vendorID = device.m_VendorId;
+    properties->properties.deviceID = device.m_DeviceId;
+    properties->properties.deviceType = VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+    strcpy(properties->properties.deviceName, "Stub GPU");
+    for(VkBaseOutStructure* s = (VkBaseOutStructure*)properties->pNext; s; s = s->pNext)
+    {
+        if(s->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES)
+        {
+            VkPhysicalDeviceIDProperties& IDProps = *(VkPhysicalDeviceIDProperties*)s;
+            memcpy(IDProps.deviceLUID, &device.m_Luid, VK_LUID_SIZE);
+            IDProps.deviceLUIDValid = device.m_Luid != 0;
+        }
+        else if(s->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES)
+        {
+            ++g_Stub.m_Vulkan12QueryCount;
+            VkPhysicalDeviceVulkan12Properties& vulkan12Props = *(VkPhysicalDeviceVulkan12Properties*)s;
+            vulkan12Props.driverID = VK_DRIVER_ID_MESA_LLVMPIPE;
+            strcpy(vulkan12Props.driverName, device.m_DriverName);
+            strcpy(vulkan12Props.driverInfo, "1.0");
+        }
+    }
+}
+
+static PFN_vkVoidFunction VKAPI_PTR StubGetInstanceProcAddr(VkInstance instance, const char* name)
+{
+    // Like the real loader, only global functions are available without an instance.
+    if(strcmp(name, "vkCreateInstance") == 0)
+        return (PFN_vkVoidFunction)StubCreateInstance;
+    if(!instance)
+        return nullptr;
+    if(strcmp(name, "vkDestroyInstance") == 0)
+        return (PFN_vkVoidFunction)StubDestroyInstance;
+    if(strcmp(name, "vkEnumeratePhysicalDevices") == 0)
+        return (PFN_vkVoidFunction)StubEnumeratePhysicalDevices;
+    if(strcmp(name, "vkGetPhysicalDeviceProperties2") == 0)
+        return (PFN_vkVoidFunction)StubGetPhysicalDeviceProperties2;
+    return nullptr;
+}
+
+static void ResetStub(bool only11 = false)
+{
+    g_Stub = {};
+    g_Stub.m_Devices = {
+        { 0x10DE, 0x2684, 0x0000000100000ABC, "NVIDIA" },
+        { 0x1002, 0x744C, 0x0000000000000DEF, "AMD proprietary driver" },
+        { 0x10005, 0x0000, 0, "llvmpipe" },
+    };
+    g_Stub.m_Only11 = only11;
+}
+
+static std::wstring PrintData(Vulkan_Initialize_RAII& vulkan, size_t physicalDeviceIndex)
+{
+    std::wostringstream stream;
+    {
+        PrinterScope printerScope(stream);
+        ReportFormatterScope formatterScope(ReportFormatter::FLAG_JSON);
+        vulkan.PrintData(physicalDeviceIndex);
+    }
+    return stream.str();
+}
+
+static void TestIdentities()
+{
+    ResetStub();
+    {
+        Vulkan_Initialize_RAII vulkan((void*)StubGetInstanceProcAddr);
+        CHECK(vulkan.IsInitialized());
+        CHECK(g_Stub.m_InstanceApiVersion == VK_API_VERSION_1_2);
+
+        std::vector<AdapterIdentity> identities;
+        vulkan.GetPhysicalDeviceIdentities(identities);
+        CHECK(identities.size() == 3);
+        CHECK(identities[0].m_Luid == 0x0000000100000ABC);
+        CHECK(identities[0].m_VendorId == 0x10DE && identities[0].m_DeviceId == 0x2684);
+        CHECK(identities[1].m_Luid == 0x0000000000000DEF);
+        // No valid LUID, so it can be matched only by vendor and device ID.
+        CHECK(!identities[2].m_Luid.has_value());
+        CHECK(identities[2].m_VendorId == 0x10005);
+
+        // Only what is needed for the identities is queried up front.
+        CHECK(g_Stub.m_PropertyQueryCount == 3);
+        CHECK(g_Stub.m_Vulkan12QueryCount == 0);
+    }
+    CHECK(g_Stub.m_InstanceDestroyed);
+}
+
+static void TestPrintDataQueriesOnce()
+{
+    ResetStub();
+    Vulkan_Initialize_RAII vulkan((void*)StubGetInstanceProcAddr);
+    CHECK(vulkan.IsInitialized());
+
+    const std::wstring first = PrintData(vulkan, 1);
+    CHECK(g_Stub.m_PropertyQueryCount == 4);
+    CHECK(g_Stub.m_Vulkan12QueryCount == 1);
+    CHECK(first.find(L"\"VkPhysicalDeviceVulkan12Properties\"") != std::wstring::npos);
+    CHECK(first.find(L"AMD proprietary driver") != std::wstring::npos);
+    CHECK(first.find(L"Stub GPU") != std::wstring::npos);
+
+    // Printed again from what was queried before.
+    const std::wstring second = PrintData(vulkan, 1);
+    CHECK(g_Stub.m_PropertyQueryCount == 4);
+    CHECK(second == first);
+
+    // Other devices are still queried on their first print.
+    const std::wstring other = PrintData(vulkan, 2);
+    CHECK(g_Stub.m_Vulkan12QueryCount == 2);
+    CHECK(other.find(L"llvmpipe") != std::wstring::npos);
+    CHECK(other.find(L"\"deviceLUID\"") == std::wstring::npos);
+}
+
+static void TestFallbackToVulkan11()
+{
+    ResetStub(true);
+    Vulkan_Initialize_RAII vulkan((void*)StubGetInstanceProcAddr);
+    CHECK(vulkan.IsInitialized());
+    CHECK(g_Stub.m_InstanceApiVersion == VK_API_VERSION_1_1);
+
+    const std::wstring printed = PrintData(vulkan, 0);
+    CHECK(g_Stub.m_Vulkan12QueryCount == 0);
+    CHECK(printed.find(L"\"VkPhysicalDeviceProperties\"") != std::wstring::npos);
+    CHECK(printed.find(L"\"deviceLUID\"") != std::wstring::npos);
+    CHECK(printed.find(L"\"VkPhysicalDeviceVulkan12Properties\"") == std::wstring::npos);
+}
+
+static void TestNoLoader()
+{
+    ResetStub();
+    {
+        Vulkan_Initialize_RAII vulkan(nullptr);
+        CHECK(!vulkan.IsInitialized());
+    }
+    CHECK(g_Stub.m_InstanceApiVersion == 0);
+    CHECK(!g_Stub.m_InstanceDestroyed);
+}
+
+int main()
+{
+    TestIdentities();
+    TestPrintDataQueriesOnce();
+    TestFallbackToVulkan11();
+    TestNoLoader();
+    return GetTestExitCode();
+}